@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2020/08/21     ShaoJinchun  first version
+ * 2026-10-19     agent        shrink the dirent cache on memory pressure
  */
 
 #include <rtthread.h>
@@ -25,6 +26,11 @@
 #include "dfs_pcache.h"
 #endif
 
+#ifdef RT_MM_RECLAIM
+#include <mmu.h>
+#include "mm_shrinker.h"
+#endif
+
 /**********************************/
 
 #define CROMFS_PATITION_HEAD_SIZE 256
@@ -105,6 +111,9 @@ typedef struct st_cromfs_info
     rt_list_t cromfs_dirent_cache_head;
     int cromfs_dirent_cache_nr;
     const void *data;
+#ifdef RT_MM_RECLAIM
+    struct rt_shrinker shrinker;
+#endif
 } cromfs_info;
 
 typedef struct
@@ -504,6 +513,55 @@ static void cromfs_dirent_cache_destroy(cromfs_info *ci)
     }
 }
 
+#ifdef RT_MM_RECLAIM
+static rt_size_t cromfs_dirent_cache_count(struct rt_shrinker *shrinker)
+{
+    cromfs_info *ci = (cromfs_info *)shrinker->data;
+    rt_list_t *l = NULL;
+    size_t bytes = 0;
+
+    if (rt_mutex_take(&ci->lock, 0) != RT_EOK)
+    {
+        return 0;
+    }
+    for (l = ci->cromfs_dirent_cache_head.next; l != &ci->cromfs_dirent_cache_head; l = l->next)
+    {
+        bytes += sizeof(cromfs_dirent_cache) + ((cromfs_dirent_cache *)l)->size;
+    }
+    rt_mutex_release(&ci->lock);
+
+    return (bytes + ARCH_PAGE_SIZE - 1) / ARCH_PAGE_SIZE;
+}
+
+static rt_size_t cromfs_dirent_cache_scan(struct rt_shrinker *shrinker, rt_size_t nr_to_scan)
+{
+    cromfs_info *ci = (cromfs_info *)shrinker->data;
+    rt_list_t *l = NULL;
+    cromfs_dirent_cache *dir = NULL;
+    size_t bytes = 0;
+
+    /* the buffer of cache is used with the lock held, never wait for it */
+    if (rt_mutex_take(&ci->lock, 0) != RT_EOK)
+    {
+        return 0;
+    }
+    /* free from the least recently used */
+    while (bytes / ARCH_PAGE_SIZE < nr_to_scan &&
+           (l = ci->cromfs_dirent_cache_head.prev) != &ci->cromfs_dirent_cache_head)
+    {
+        rt_list_remove(l);
+        dir = (cromfs_dirent_cache *)l;
+        bytes += sizeof *dir + dir->size;
+        free(dir->buff);
+        free(dir);
+        ci->cromfs_dirent_cache_nr--;
+    }
+    rt_mutex_release(&ci->lock);
+
+    return bytes / ARCH_PAGE_SIZE;
+}
+#endif /* RT_MM_RECLAIM */
+
 /**********************************/
 
 #ifdef RT_USING_PAGECACHE
@@ -578,6 +636,15 @@ static int dfs_cromfs_mount(struct dfs_mnt *mnt, unsigned long rwflag, const voi
     rt_list_init(&ci->cromfs_dirent_cache_head);
     ci->cromfs_dirent_cache_nr = 0;
 
+#ifdef RT_MM_RECLAIM
+    ci->shrinker.name = "cromfs";
+    ci->shrinker.priority = RT_SHRINKER_PRIO_META;
+    ci->shrinker.count = cromfs_dirent_cache_count;
+    ci->shrinker.scan = cromfs_dirent_cache_scan;
+    ci->shrinker.data = ci;
+    rt_shrinker_register(&ci->shrinker);
+#endif
+
     return RT_EOK;
 }
 
@@ -588,6 +655,10 @@ static int dfs_cromfs_unmount(struct dfs_mnt *mnt)
 
     ci = (cromfs_info *)mnt->data;
 
+#ifdef RT_MM_RECLAIM
+    rt_shrinker_unregister(&ci->shrinker);
+#endif
+
     result =  rt_mutex_take(&ci->lock, RT_WAITING_FOREVER);
     if (result != RT_EOK)
     {
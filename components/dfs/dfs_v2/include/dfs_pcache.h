@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2023-05-05     RTT          Implement dentry in dfs v2.0
+ * 2026-10-19     agent        add dfs_aspace_mmap_cached()
  */
 
 #ifndef DFS_PAGE_CACHE_H__
@@ -106,6 +107,7 @@ int dfs_aspace_flush(struct dfs_aspace *aspace);
 int dfs_aspace_clean(struct dfs_aspace *aspace);
 
 void *dfs_aspace_mmap(struct dfs_file *file, struct rt_varea *varea, void *vaddr);
+void *dfs_aspace_mmap_cached(struct dfs_file *file, struct rt_varea *varea, void *vaddr);
 int dfs_aspace_unmap(struct dfs_file *file, struct rt_varea *varea);
 int dfs_aspace_page_unmap(struct dfs_file *file, struct rt_varea *varea, void *vaddr);
 int dfs_aspace_page_dirty(struct dfs_file *file, struct rt_varea *varea, void *vaddr);
@@ -5,6 +5,7 @@
  *
  * Change Logs:
  * Date           Author       Notes
+ * 2026-10-19     agent        map the cached pages around a fault
  */
 
 #include "dfs_file.h"
@@ -123,6 +124,23 @@ static void on_page_fault(struct rt_varea *varea, struct rt_aspace_fault_msg *ms
     }
 }
 
+static void on_page_fault_around(struct rt_varea *varea, struct rt_aspace_fault_msg *msg)
+{
+    void *page;
+    struct dfs_file *file = dfs_mem_obj_get_file(varea->mem_obj);
+
+    if (file)
+    {
+        page = dfs_aspace_mmap_cached(file, varea, msg->fault_vaddr);
+        if (page)
+        {
+            msg->response.status = MM_FAULT_STATUS_OK_MAPPED;
+            msg->response.size = ARCH_PAGE_SIZE;
+            msg->response.vaddr = page;
+        }
+    }
+}
+
 /* do pre open bushiness like inc a ref */
 static void on_varea_open(struct rt_varea *varea)
 {
@@ -399,6 +417,8 @@ static struct rt_mem_obj _mem_obj =
     .on_varea_merge     = on_varea_merge,
 
     .on_varea_mremap    = on_varea_mremap,
+
+    .on_page_fault_around = on_page_fault_around,
 };
 
 struct dfs_mem_obj {
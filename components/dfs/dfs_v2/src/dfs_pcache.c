@@ -7,6 +7,8 @@
  * Date           Author       Notes
  * 2023-05-05     RTT          Implement mnt in dfs v2.0
  * 2023-10-23     Shell        fix synchronization of data to icache
+ * 2026-10-19     agent        add dfs_aspace_mmap_cached() for fault-around
+ * 2026-10-19     agent        shrink the page cache on memory pressure
  */
 
 #define DBG_TAG "dfs.pcache"
@@ -17,6 +19,7 @@
 #include "dfs_dentry.h"
 #include "dfs_mnt.h"
 #include "mm_page.h"
+#include "mm_shrinker.h"
 #include <mmu.h>
 #include <tlb.h>
 
@@ -334,6 +337,47 @@ static int dfs_pcache_init(void)
 }
 INIT_PREV_EXPORT(dfs_pcache_init);
 
+#ifdef RT_MM_RECLAIM
+static rt_size_t dfs_pcache_shrink_count(struct rt_shrinker *shrinker)
+{
+    return rt_atomic_load(&(__pcache.pages_count));
+}
+
+static rt_size_t dfs_pcache_shrink_scan(struct rt_shrinker *shrinker, rt_size_t nr_to_scan)
+{
+    rt_size_t before, after;
+
+    /* skip it if the cache is busy, the owner may be waiting for memory */
+    if (rt_mutex_take(&__pcache.lock, 0) != RT_EOK)
+    {
+        return 0;
+    }
+
+    before = rt_atomic_load(&(__pcache.pages_count));
+    dfs_pcache_release(nr_to_scan);
+    after = rt_atomic_load(&(__pcache.pages_count));
+
+    rt_mutex_release(&__pcache.lock);
+
+    return before > after ? before - after : 0;
+}
+
+static struct rt_shrinker dfs_pcache_shrinker =
+{
+    .name = "pcache",
+    .priority = RT_SHRINKER_PRIO_CACHE,
+    .count = dfs_pcache_shrink_count,
+    .scan = dfs_pcache_shrink_scan,
+};
+
+static int dfs_pcache_shrinker_init(void)
+{
+    rt_shrinker_register(&dfs_pcache_shrinker);
+    return 0;
+}
+INIT_COMPONENT_EXPORT(dfs_pcache_shrinker_init);
+#endif /* RT_MM_RECLAIM */
+
 static rt_ubase_t dfs_pcache_mq_work(rt_uint32_t cmd)
 {
     rt_err_t err;
@@ -1272,63 +1316,87 @@ int dfs_aspace_clean(struct dfs_aspace *aspace)
     return 0;
 }
 
-void *dfs_aspace_mmap(struct dfs_file *file, struct rt_varea *varea, void *vaddr)
+/* map a referenced page into varea, the reference is dropped in any case */
+static void *_dfs_aspace_map_page(struct dfs_file *file, struct rt_varea *varea, void *vaddr,
+                                  struct dfs_page *page)
 {
     void *ret = RT_NULL;
-    struct dfs_page *page;
     struct dfs_aspace *aspace = file->vnode->aspace;
     rt_aspace_t target_aspace = varea->aspace;
+    struct dfs_mmap *map = (struct dfs_mmap *)rt_calloc(1, sizeof(struct dfs_mmap));
 
-    page = dfs_page_lookup(file, dfs_aspace_fpos(varea, vaddr));
-    if (page)
+    if (map)
     {
-        struct dfs_mmap *map = (struct dfs_mmap *)rt_calloc(1, sizeof(struct dfs_mmap));
-        if (map)
+        void *pg_vaddr = page->page;
+        void *pg_paddr = rt_kmem_v2p(pg_vaddr);
+        int err = rt_varea_map_range(varea, vaddr, pg_paddr, page->size);
+        if (err == RT_EOK)
         {
-            void *pg_vaddr = page->page;
-            void *pg_paddr = rt_kmem_v2p(pg_vaddr);
-            int err = rt_varea_map_range(varea, vaddr, pg_paddr, page->size);
-            if (err == RT_EOK)
-            {
-                /**
-                 * Note: While the page is mapped into user area, the data writing into the page
-                 * is not guaranteed to be visible for machines with the *weak* memory model and
-                 * those Harvard architecture (especially for those ARM64) cores for their
-                 * out-of-order pipelines of data buffer. Besides if the instruction cache in the
-                 * L1 memory system is a VIPT cache, there are chances to have the alias matching
-                 * entry if we reuse the same page frame and map it into the same virtual address
-                 * of the previous one.
-                 *
-                 * That's why we have to do synchronization and cleanup manually to ensure that
-                 * fetching of the next instruction can see the coherent data with the data cache,
-                 * TLB, MMU, main memory, and all the other observers in the computer system.
-                 */
-                rt_hw_cpu_dcache_ops(RT_HW_CACHE_FLUSH, vaddr, ARCH_PAGE_SIZE);
-                rt_hw_cpu_icache_ops(RT_HW_CACHE_INVALIDATE, vaddr, ARCH_PAGE_SIZE);
-
-                ret = pg_vaddr;
-                map->aspace = target_aspace;
-                map->vaddr = vaddr;
-                dfs_aspace_lock(aspace);
-                rt_list_insert_after(&page->mmap_head, &map->mmap_node);
-                dfs_page_release(page);
-                dfs_aspace_unlock(aspace);
-            }
-            else
-            {
-                dfs_page_release(page);
-                rt_free(map);
-            }
+            /**
+             * Note: While the page is mapped into user area, the data writing into the page
+             * is not guaranteed to be visible for machines with the *weak* memory model and
+             * those Harvard architecture (especially for those ARM64) cores for their
+             * out-of-order pipelines of data buffer. Besides if the instruction cache in the
+             * L1 memory system is a VIPT cache, there are chances to have the alias matching
+             * entry if we reuse the same page frame and map it into the same virtual address
+             * of the previous one.
+             *
+             * That's why we have to do synchronization and cleanup manually to ensure that
+             * fetching of the next instruction can see the coherent data with the data cache,
+             * TLB, MMU, main memory, and all the other observers in the computer system.
+             */
+            rt_hw_cpu_dcache_ops(RT_HW_CACHE_FLUSH, vaddr, ARCH_PAGE_SIZE);
+            rt_hw_cpu_icache_ops(RT_HW_CACHE_INVALIDATE, vaddr, ARCH_PAGE_SIZE);
+
+            ret = pg_vaddr;
+            map->aspace = target_aspace;
+            map->vaddr = vaddr;
+            dfs_aspace_lock(aspace);
+            rt_list_insert_after(&page->mmap_head, &map->mmap_node);
+            dfs_page_release(page);
+            dfs_aspace_unlock(aspace);
         }
         else
         {
             dfs_page_release(page);
+            rt_free(map);
         }
     }
+    else
+    {
+        dfs_page_release(page);
+    }
 
     return ret;
 }
 
+void *dfs_aspace_mmap(struct dfs_file *file, struct rt_varea *varea, void *vaddr)
+{
+    struct dfs_page *page;
+
+    page = dfs_page_lookup(file, dfs_aspace_fpos(varea, vaddr));
+    if (page)
+    {
+        return _dfs_aspace_map_page(file, varea, vaddr, page);
+    }
+
+    return RT_NULL;
+}
+
+/* like dfs_aspace_mmap(), but only map the page already in the cache and never read the file */
+void *dfs_aspace_mmap_cached(struct dfs_file *file, struct rt_varea *varea, void *vaddr)
+{
+    struct dfs_page *page;
+
+    page = dfs_page_search(file->vnode->aspace, dfs_aspace_fpos(varea, vaddr));
+    if (page)
+    {
+        return _dfs_aspace_map_page(file, varea, vaddr, page);
+    }
+
+    return RT_NULL;
+}
+
 int dfs_aspace_unmap(struct dfs_file *file, struct rt_varea *varea)
 {
     struct dfs_vnode *vnode = file->vnode;
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author            Notes
  * 2017-12-23     Bernard           first version
+ * 2026-10-19     agent             provide the clock of lock statistics
  */
 
 #include <rtdevice.h>
@@ -43,6 +44,17 @@ uint64_t clock_cpu_gettime(void)
     return 0;
 }
 
+#ifdef RT_USING_LOCKSTAT
+/* measure the spinlocks in cpu time once a cputime device is registered */
+rt_uint64_t rt_lockstat_clock(void)
+{
+    if (_cputime_ops)
+        return _cputime_ops->cputime_gettime();
+
+    return rt_tick_get();
+}
+#endif /* RT_USING_LOCKSTAT */
+
 /**
  * The clock_cpu_settimeout() fucntion set timeout time and timeout callback function
  * The timeout callback function will be called when the timeout time is reached
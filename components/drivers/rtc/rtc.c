@@ -19,6 +19,10 @@
 #include <rtthread.h>
 #include <drivers/rtc.h>
 
+#ifdef LWP_USING_VDSO
+#include <lwp_vdso.h>
+#endif
+
 #ifdef RT_USING_RTC
 
 static rt_device_t _rtc_device;
@@ -87,6 +91,14 @@ static rt_err_t rt_rtc_control(struct rt_device *dev, int cmd, void *args)
             break;
     }
 
+#ifdef LWP_USING_VDSO
+    /* the realtime read by user space without syscall follows the new time */
+    if (ret == RT_EOK && (cmd == RT_DEVICE_CTRL_RTC_SET_TIME || cmd == RT_DEVICE_CTRL_RTC_SET_TIMEVAL))
+    {
+        lwp_vdso_realtime_sync();
+    }
+#endif /* LWP_USING_VDSO */
+
     return ret;
 
 #undef TRY_DO_RTC_FUNC
@@ -17,6 +17,10 @@
 #include <ktime.h>
 #endif
 
+#ifdef LWP_USING_VDSO
+#include <lwp_vdso.h>
+#endif
+
 #ifdef RT_USING_SOFT_RTC
 
 /* 2018-01-30 14:44:50 = RTC_TIME_INIT(2018, 1, 30, 14, 44, 50)  */
@@ -202,6 +206,15 @@ static rt_err_t soft_rtc_control(rt_device_t dev, int cmd, void *args)
         return -RT_EINVAL;
     }
 
+#ifdef LWP_USING_VDSO
+    /* the realtime read by user space without syscall follows the new time */
+    if (cmd == RT_DEVICE_CTRL_RTC_SET_TIME || cmd == RT_DEVICE_CTRL_RTC_SET_TIMEVAL ||
+        cmd == RT_DEVICE_CTRL_RTC_SET_TIMESPEC)
+    {
+        lwp_vdso_realtime_sync();
+    }
+#endif /* LWP_USING_VDSO */
+
     return RT_EOK;
 }
 
@@ -32,6 +32,7 @@
  * 2022-07-02     Stanley Lwin add list command
  * 2023-09-15     xqyjlj       perf rt_hw_interrupt_disable/enable
  * 2024-02-09     Bernard      fix the version command
+ * 2026-10-19     agent        list_thread shows the last cpu and migrations
  */
 
 #include <rthw.h>
@@ -173,9 +174,9 @@ long list_thread(void)
     maxlen = RT_NAME_MAX;
 
 #ifdef RT_USING_SMP
-    rt_kprintf("%-*.*s cpu bind pri  status      sp     stack size max used left tick   error  tcb addr\n", maxlen, maxlen, item_title);
+    rt_kprintf("%-*.*s cpu bind last    migr pri  status      sp     stack size max used left tick   error  tcb addr\n", maxlen, maxlen, item_title);
     object_split(maxlen);
-    rt_kprintf(" --- ---- ---  ------- ---------- ----------  ------  ---------- -------");
+    rt_kprintf(" --- ---- ---- -------- ---  ------- ---------- ----------  ------  ---------- -------");
     rt_kprintf(" ");
     object_split(tcb_strlen);
     rt_kprintf("\n");
@@ -218,14 +219,18 @@ long list_thread(void)
 #ifdef RT_USING_SMP
                     /* no synchronization applied since it's only for debug */
                     if (RT_SCHED_CTX(thread).oncpu != RT_CPU_DETACHED)
-                        rt_kprintf("%-*.*s %3d %3d %4d ", maxlen, RT_NAME_MAX,
+                        rt_kprintf("%-*.*s %3d %4d %4d %8d %3d ", maxlen, RT_NAME_MAX,
                                    thread->parent.name, RT_SCHED_CTX(thread).oncpu,
                                    RT_SCHED_CTX(thread).bind_cpu,
+                                   RT_SCHED_CTX(thread).last_cpu,
+                                   RT_SCHED_CTX(thread).migrations,
                                    RT_SCHED_PRIV(thread).current_priority);
                     else
-                        rt_kprintf("%-*.*s N/A %3d %4d ", maxlen, RT_NAME_MAX,
+                        rt_kprintf("%-*.*s N/A %4d %4d %8d %3d ", maxlen, RT_NAME_MAX,
                                    thread->parent.name,
                                    RT_SCHED_CTX(thread).bind_cpu,
+                                   RT_SCHED_CTX(thread).last_cpu,
+                                   RT_SCHED_CTX(thread).migrations,
                                    RT_SCHED_PRIV(thread).current_priority);
 
 #else
@@ -14,6 +14,7 @@
  *                                  mechanism wakeup algorithm does not correctly distinguish
  *                                  the current wait state.
  * 2024-03-29     TroyMitchelle     Add all function comments and comments to structure members
+ * 2026-10-19     agent             Add readiness cache to only re-poll the woken fds
  */
 
 #include <stdint.h>
@@ -37,6 +38,10 @@ struct rt_poll_table
     enum rt_poll_status status;     /**< Status of the poll operation. */
     rt_thread_t polling_thread;     /**< Polling thread associated with the table. */
     struct rt_poll_node *nodes;     /**< Linked list of poll nodes. */
+#ifdef RT_USING_POSIX_POLL_READY_CACHE
+    nfds_t polling_index;           /**< Index of the pollfd being registered. */
+    struct rt_poll_node *fired;     /**< Linked list of the nodes woken up since the last scan. */
+#endif
 };
 
 
@@ -45,6 +50,11 @@ struct rt_poll_node
     struct rt_wqueue_node wqn;     /**< Wait queue node for the poll node. */
     struct rt_poll_table *pt;       /**< Pointer to the parent poll table. */
     struct rt_poll_node *next;      /**< Pointer to the next poll node. */
+#ifdef RT_USING_POSIX_POLL_READY_CACHE
+    nfds_t index;                   /**< Index of the pollfd which the node is registered for. */
+    rt_bool_t is_fired;             /**< The node is in the fired list of the poll table. */
+    struct rt_poll_node *fired_next; /**< Pointer to the next fired poll node. */
+#endif
 };
 
 static RT_DEFINE_SPINLOCK(_spinlock);
@@ -73,6 +83,15 @@ static int __wqueue_pollwake(struct rt_wqueue_node *wait, void *key)
     is_waiting = (pn->pt->status == RT_POLL_STAT_WAITING);
 
     pn->pt->status = RT_POLL_STAT_TRIG;
+#ifdef RT_USING_POSIX_POLL_READY_CACHE
+    /* record the fd so that the next scan only checks the fired ones */
+    if (!pn->is_fired)
+    {
+        pn->is_fired = RT_TRUE;
+        pn->fired_next = pn->pt->fired;
+        pn->pt->fired = pn;
+    }
+#endif
     rt_spin_unlock_irqrestore(&_spinlock, level);
 
     if (is_waiting)
@@ -107,6 +126,11 @@ static void _poll_add(rt_wqueue_t *wq, rt_pollreq_t *req)
     node->wqn.wakeup = __wqueue_pollwake;
     node->next = pt->nodes;
     node->pt = pt;
+#ifdef RT_USING_POSIX_POLL_READY_CACHE
+    node->index = pt->polling_index;
+    node->is_fired = RT_FALSE;
+    node->fired_next = RT_NULL;
+#endif
     pt->nodes = node;
     rt_wqueue_add(wq, &node->wqn);
 }
@@ -125,6 +149,10 @@ static void poll_table_init(struct rt_poll_table *pt)
     pt->status = RT_POLL_STAT_INIT;
     pt->nodes = RT_NULL;
     pt->polling_thread = rt_thread_self();
+#ifdef RT_USING_POSIX_POLL_READY_CACHE
+    pt->polling_index = 0;
+    pt->fired = RT_NULL;
+#endif
 }
 
 /**
@@ -240,6 +268,98 @@ static int do_pollfd(struct pollfd *pollfd, rt_pollreq_t *req)
     return mask;
 }
 
+/**
+ * @brief   Polls every file descriptor of the array.
+ *
+ * The wait queue nodes are registered while the poll request still has a
+ * proc, which is dropped as soon as one file descriptor is ready.
+ *
+ * @param   fds     Pointer to the array of pollfd structures.
+ * @param   nfds    Number of file descriptors in the array.
+ * @param   pt      Pointer to the poll table.
+ * @return  Upon successful completion, returns the number of file descriptors
+ *          for which events were received. If an error occurs, the negative
+ *          error code of the device is returned.
+ */
+static int poll_scan(struct pollfd *fds, nfds_t nfds, struct rt_poll_table *pt)
+{
+    int num = 0;
+    int ret;
+    nfds_t n;
+
+    for (n = 0; n < nfds; n ++)
+    {
+#ifdef RT_USING_POSIX_POLL_READY_CACHE
+        pt->polling_index = n;
+#endif
+        ret = do_pollfd(&fds[n], &pt->req);
+        if(ret < 0)
+        {
+            /*dealwith the device return error -1  */
+            pt->req._proc = RT_NULL;
+            return ret;
+        }
+        else if(ret > 0)
+        {
+            num ++;
+            pt->req._proc = RT_NULL;
+        }
+    }
+
+    return num;
+}
+
+#ifdef RT_USING_POSIX_POLL_READY_CACHE
+/**
+ * @brief   Polls the file descriptors woken up since the last scan.
+ *
+ * The previous scan found nothing, so every revents is still zero and only
+ * the fds whose wait queues fired can have changed. A node is taken off the
+ * fired list before its fd is polled, a wakeup racing with the poll records
+ * it again and is not lost.
+ *
+ * @param   fds     Pointer to the array of pollfd structures.
+ * @param   pt      Pointer to the poll table.
+ * @return  Upon successful completion, returns the number of file descriptors
+ *          for which events were received. If an error occurs, the negative
+ *          error code of the device is returned.
+ */
+static int poll_scan_fired(struct pollfd *fds, struct rt_poll_table *pt)
+{
+    int num = 0;
+    int ret;
+    rt_base_t level;
+    struct rt_poll_node *node, *next;
+
+    level = rt_spin_lock_irqsave(&_spinlock);
+    next = pt->fired;
+    pt->fired = RT_NULL;
+    rt_spin_unlock_irqrestore(&_spinlock, level);
+
+    while (next)
+    {
+        node = next;
+
+        level = rt_spin_lock_irqsave(&_spinlock);
+        next = node->fired_next;
+        node->is_fired = RT_FALSE;
+        rt_spin_unlock_irqrestore(&_spinlock, level);
+
+        /* a fd waiting on several queues may fire more than once */
+        if (fds[node->index].revents)
+            continue;
+
+        ret = do_pollfd(&fds[node->index], &pt->req);
+        if (ret < 0)
+            return ret;
+        else if (ret > 0)
+            num ++;
+    }
+
+    return num;
+}
+#endif /* RT_USING_POSIX_POLL_READY_CACHE */
+
 /**
  * @brief   Performs the poll operation on an array of file descriptors.
  *
@@ -259,8 +379,9 @@ static int poll_do(struct pollfd *fds, nfds_t nfds, struct rt_poll_table *pt, in
 {
     int num;
     int istimeout = 0;
-    nfds_t n;
-    struct pollfd *pf;
+#ifdef RT_USING_POSIX_POLL_READY_CACHE
+    rt_bool_t full_scan = RT_TRUE;
+#endif
     int  ret = 0;
 
     if (msec == 0)
@@ -271,26 +392,17 @@ static int poll_do(struct pollfd *fds, nfds_t nfds, struct rt_poll_table *pt, in
 
     while (1)
     {
-        pf = fds;
-        num = 0;
         pt->status = RT_POLL_STAT_INIT;
 
-        for (n = 0; n < nfds; n ++)
-        {
-            ret = do_pollfd(pf, &pt->req);
-            if(ret < 0)
-            {
-                /*dealwith the device return error -1  */
-                pt->req._proc = RT_NULL;
-                return ret;
-            }
-            else if(ret > 0)
-            {
-                num ++;
-                pt->req._proc = RT_NULL;
-            }
-            pf ++;
-        }
+#ifdef RT_USING_POSIX_POLL_READY_CACHE
+        /* the final check on timeout still looks at every fd */
+        if (!full_scan && !istimeout)
+            num = poll_scan_fired(fds, pt);
+        else
+#endif
+        num = poll_scan(fds, nfds, pt);
+        if (num < 0)
+            return num;
 
         pt->req._proc = RT_NULL;
 
@@ -304,6 +416,9 @@ static int poll_do(struct pollfd *fds, nfds_t nfds, struct rt_poll_table *pt, in
             istimeout = 1;
         else
             istimeout = 0;
+#ifdef RT_USING_POSIX_POLL_READY_CACHE
+        full_scan = RT_FALSE;
+#endif
     }
 
     return num;
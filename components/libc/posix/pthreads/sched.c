@@ -5,6 +5,7 @@
  *
  * Change Logs:
  * Date           Author       Notes
+ * 2026-10-19     agent        add SCHED_DEADLINE and sched_setattr/sched_getattr
  */
 
 #include <sched.h>
@@ -55,3 +56,97 @@ int sched_rr_get_interval(pid_t pid, struct timespec *tp)
     return -1;
 }
 RTM_EXPORT(sched_rr_get_interval);
+
+#ifdef RT_USING_SCHED_EDF
+#define NSEC_PER_SEC    1000000000ULL
+
+/* round up, a budget shorter than a tick is still a tick */
+static rt_tick_t _ns_to_tick(uint64_t ns)
+{
+    return (rt_tick_t)((ns * RT_TICK_PER_SECOND + NSEC_PER_SEC - 1) / NSEC_PER_SEC);
+}
+
+static uint64_t _tick_to_ns(rt_tick_t tick)
+{
+    return (uint64_t)tick * NSEC_PER_SEC / RT_TICK_PER_SECOND;
+}
+
+int sched_setattr(pid_t pid, const struct sched_attr *attr, unsigned int flags)
+{
+    struct rt_thread_deadline_attr dl = {0};
+    uint64_t deadline, period;
+
+    /* only the calling thread */
+    if (pid != 0 || attr == RT_NULL || flags != 0)
+    {
+        rt_set_errno(EINVAL);
+        return -1;
+    }
+
+    if (attr->sched_policy == SCHED_DEADLINE)
+    {
+        deadline = attr->sched_deadline;
+        period = attr->sched_period ? attr->sched_period : deadline;
+        if (attr->sched_runtime == 0 || attr->sched_runtime > deadline || deadline > period)
+        {
+            rt_set_errno(EINVAL);
+            return -1;
+        }
+
+        dl.runtime = _ns_to_tick(attr->sched_runtime);
+        dl.deadline = _ns_to_tick(deadline);
+        dl.period = _ns_to_tick(period);
+    }
+    else if (attr->sched_policy > SCHED_MAX)
+    {
+        rt_set_errno(EINVAL);
+        return -1;
+    }
+
+    /* a zero runtime moves the thread back to its fixed priority */
+    switch (rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_SET_DEADLINE, &dl))
+    {
+    case RT_EOK:
+        return 0;
+    case -RT_EFULL:
+        rt_set_errno(EBUSY);
+        return -1;
+    default:
+        rt_set_errno(EINVAL);
+        return -1;
+    }
+}
+RTM_EXPORT(sched_setattr);
+
+int sched_getattr(pid_t pid, struct sched_attr *attr, unsigned int size, unsigned int flags)
+{
+    struct rt_thread_deadline_attr dl;
+    rt_thread_t thread = rt_thread_self();
+
+    if (pid != 0 || attr == RT_NULL || size < sizeof(struct sched_attr) || flags != 0)
+    {
+        rt_set_errno(EINVAL);
+        return -1;
+    }
+
+    rt_thread_control(thread, RT_THREAD_CTRL_GET_DEADLINE, &dl);
+
+    rt_memset(attr, 0, sizeof(struct sched_attr));
+    attr->size = sizeof(struct sched_attr);
+    if (dl.runtime != 0)
+    {
+        attr->sched_policy = SCHED_DEADLINE;
+        attr->sched_runtime = _tick_to_ns(dl.runtime);
+        attr->sched_deadline = _tick_to_ns(dl.deadline);
+        attr->sched_period = _tick_to_ns(dl.period);
+    }
+    else
+    {
+        attr->sched_policy = SCHED_FIFO;
+        attr->sched_priority = RT_SCHED_PRIV(thread).current_priority;
+    }
+
+    return 0;
+}
+RTM_EXPORT(sched_getattr);
+#endif /* RT_USING_SCHED_EDF */
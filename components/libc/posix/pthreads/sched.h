@@ -5,6 +5,7 @@
  *
  * Change Logs:
  * Date           Author       Notes
+ * 2026-10-19     agent        add SCHED_DEADLINE and sched_setattr/sched_getattr
  */
 
 #ifndef __SCHED_H__
@@ -12,6 +13,7 @@
 
 #include <rtthread.h>
 #include <pthread.h>
+#include <stdint.h>
 
 /* Thread scheduling policies */
 enum
@@ -19,10 +21,26 @@ enum
     SCHED_OTHER = 0,
     SCHED_FIFO,
     SCHED_RR,
+    SCHED_DEADLINE = 6,
     SCHED_MIN = SCHED_OTHER,
     SCHED_MAX = SCHED_RR
 };
 
+#ifdef RT_USING_SCHED_EDF
+/* Scheduling attributes, the times of SCHED_DEADLINE are in nanoseconds */
+struct sched_attr
+{
+    uint32_t size;
+    uint32_t sched_policy;
+    uint64_t sched_flags;
+    int32_t  sched_nice;
+    uint32_t sched_priority;
+    uint64_t sched_runtime;
+    uint64_t sched_deadline;
+    uint64_t sched_period;
+};
+#endif /* RT_USING_SCHED_EDF */
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -33,6 +51,10 @@ int sched_get_priority_min(int policy);
 int sched_get_priority_max(int policy);
 int sched_rr_get_interval(pid_t pid, struct timespec *tp);
 int sched_setscheduler(pid_t pid, int policy);
+#ifdef RT_USING_SCHED_EDF
+int sched_setattr(pid_t pid, const struct sched_attr *attr, unsigned int flags);
+int sched_getattr(pid_t pid, struct sched_attr *attr, unsigned int size, unsigned int flags);
+#endif
 
 #ifdef __cplusplus
 }
@@ -16,6 +16,7 @@
  * 2021-11-30     JasonHu      add clone/fork support
  * 2023-07-16     Shell        Move part of the codes to C from asm in signal handling
  * 2023-10-16     Shell        Support a new backtrace framework
+ * 2026-10-19     agent        Call the vfork() fast path
  */
 #include <rthw.h>
 #include <rtthread.h>
@@ -151,7 +152,7 @@ long sys_fork(void)
 long _sys_vfork(void);
 long sys_vfork(void)
 {
-    return _sys_fork();
+    return _sys_vfork();
 }
 
 /**
@@ -14,6 +14,7 @@
  * 2023-10-16     Shell        Support a new backtrace framework
  * 2023-11-17     xqyjlj       add process group and session support
  * 2023-11-30     Shell        add lwp_startup()
+ * 2026-10-19     agent        pass the pages of vdso data by aux vector
  */
 
 #define DBG_TAG "lwp"
@@ -40,6 +41,7 @@
 #include "lwp_arch.h"
 #include "lwp_arch_comm.h"
 #include "lwp_signal.h"
+#include "lwp_vdso.h"
 #include "lwp_dbg.h"
 #include <terminal/terminal.h>
 
@@ -800,6 +802,15 @@ static int load_elf(int fd, int len, struct rt_lwp *lwp, uint8_t *load_addr, str
         aux->item[4].value = eheader.e_phnum;
         aux->item[5].key = AT_PHENT;
         aux->item[5].value = sizeof pheader;
+#ifdef LWP_USING_VDSO
+        if (lwp->vdso_data)
+        {
+            aux->item[6].key = AT_RT_VDSO_DATA;
+            aux->item[6].value = (size_t)lwp->vdso_data;
+            aux->item[7].key = AT_RT_VDSO_PROC;
+            aux->item[7].value = (size_t)lwp->vdso_proc;
+        }
+#endif /* LWP_USING_VDSO */
 #ifdef ARCH_MM_MMU
         rt_hw_cpu_dcache_ops(RT_HW_CACHE_FLUSH, aux, sizeof *aux);
 #endif
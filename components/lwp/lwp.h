@@ -12,6 +12,11 @@
  * 2023-11-17     xqyjlj       add process group and session support
  * 2023-12-02     Shell        Add macro to create lwp status and
  *                             fix dead lock problem on pgrp
+ * 2026-10-19     agent        Add page fault statistics
+ * 2026-10-19     agent        Borrow the aspace of parent on vfork()
+ * 2026-10-19     agent        Add lwp_elf_cache_flush()
+ * 2026-10-19     agent        Add the pages of vdso data
+ * 2026-10-19     agent        Add the system call ring
  */
 
 /*
@@ -122,6 +127,18 @@ struct rt_lwp
 #ifdef ARCH_MM_MMU
     size_t end_heap;
     rt_aspace_t aspace;
+    rt_atomic_t fault_count;        /* page faults trapped */
+    rt_atomic_t fault_around_count; /* pages mapped around the faults */
+    struct rt_lwp *vfork_parent;    /* lends the aspace, referenced until it is given back */
+    struct rt_semaphore *vfork_done; /* parent waiting for the borrowed aspace */
+#ifdef LWP_USING_VDSO
+    void *vdso_data;                /* user address of the time data page */
+    void *vdso_proc;                /* user address of the process data page */
+    struct rt_vdso_proc *vdso_kproc; /* kernel address of the process data page */
+#endif /* LWP_USING_VDSO */
+#ifdef LWP_USING_SYSRING
+    struct lwp_sysring *sysring;    /* batched system calls */
+#endif /* LWP_USING_SYSRING */
 #else
 #ifdef ARCH_MM_MPU
     struct rt_mpu_info mpu_info;
@@ -214,6 +231,7 @@ void lwp_setcwd(char *buf);
 char *lwp_getcwd(void);
 int  lwp_check_exit_request(void);
 void lwp_terminate(struct rt_lwp *lwp);
+void lwp_vfork_release(struct rt_lwp *lwp);
 
 int lwp_tid_init(void);
 int lwp_tid_get(void);
@@ -238,6 +256,18 @@ void lwp_tid_set_thread(int tid, rt_thread_t thread);
 
 int lwp_execve(char *filename, int debug, int argc, char **argv, char **envp);
 
+#ifdef LWP_USING_ELF_CACHE
+/**
+ * @brief Drop the headers of images cached by the ELF loader
+ */
+void lwp_elf_cache_flush(void);
+
+/**
+ * @brief Get the numbers of lookups hit and missed in the cache of ELF loader
+ */
+void lwp_elf_cache_stat(rt_size_t *hit, rt_size_t *miss);
+#endif
+
 /*create by lwp_setsid.c*/
 int setsid(void);
 #ifdef ARCH_MM_MMU
@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2023-08-23     zhangsz      first version
+ * 2026-10-19     agent        cache the headers of images loaded recently
+ * 2026-10-19     agent        pass the pages of vdso data by aux vector
  */
 
 #include <rtthread.h>
@@ -23,6 +25,7 @@
 
 #ifdef ARCH_MM_MMU
 #include <lwp_user_mm.h>
+#include <lwp_vdso.h>
 #endif
 
 #define DBG_TAG "load.elf"
@@ -59,6 +62,7 @@ typedef struct
     int fd;
     char *filename;
     rt_size_t file_len;
+    time_t mtime;
     Elf_Ehdr ehdr;
     Elf_Phdr *phdr;
     rt_ubase_t map_size;
@@ -157,18 +161,19 @@ static int elf_file_close(int fd)
     return close(fd);
 }
 
-static int elf_file_length(char *filename, rt_size_t *file_len)
+static int elf_file_stat(int fd, rt_size_t *file_len, time_t *mtime)
 {
     int ret;
     struct stat s = { 0 };
 
-    ret = stat(filename, &s);
+    ret = fstat(fd, &s);
     if (ret != 0)
     {
         LOG_E("%s : error", __func__);
         return -RT_ERROR;
     }
     *file_len = (rt_size_t)s.st_size;
+    *mtime = s.st_mtime;
 
     return RT_EOK;
 }
@@ -198,6 +203,200 @@ static int elf_file_read(rt_int32_t fd, rt_uint8_t *buffer, size_t size, off_t o
     return RT_EOK;
 }
 
+#ifdef LWP_USING_ELF_CACHE
+
+#ifndef LWP_ELF_CACHE_NR
+#define LWP_ELF_CACHE_NR 16
+#endif
+
+/**
+ * The parsed headers of the images loaded recently, keyed by the path and
+ * validated by the modification time and length of file. The pages of text
+ * are shared by the page cache of file already.
+ */
+struct elf_cache_entry
+{
+    rt_list_t node;     /* in the order of recently used */
+    char *path;
+    time_t mtime;
+    rt_size_t file_len;
+    Elf_Ehdr ehdr;
+    Elf_Phdr *phdr;
+};
+
+static rt_list_t _elf_cache = RT_LIST_OBJECT_INIT(_elf_cache);
+static struct rt_mutex _elf_cache_lock;
+static int _elf_cache_nr;
+static rt_size_t _elf_cache_hit;
+static rt_size_t _elf_cache_miss;
+
+/**
+ * A file system without times (tmpfs, romfs) reports the same mtime for a
+ * file rewritten in place, so the images on it are never cached.
+ */
+static rt_bool_t elf_cache_usable(elf_info_t *elf_info)
+{
+    return elf_info->mtime != 0;
+}
+
+static struct elf_cache_entry *elf_cache_find_locked(const char *path)
+{
+    struct elf_cache_entry *entry;
+
+    rt_list_for_each_entry(entry, &_elf_cache, node)
+    {
+        if (rt_strcmp(entry->path, path) == 0)
+            return entry;
+    }
+    return RT_NULL;
+}
+
+static void elf_cache_remove_locked(struct elf_cache_entry *entry)
+{
+    rt_list_remove(&entry->node);
+    _elf_cache_nr--;
+    rt_free(entry);
+}
+
+static rt_bool_t elf_cache_lookup(elf_info_t *elf_info)
+{
+    struct elf_cache_entry *entry;
+    rt_bool_t hit = RT_FALSE;
+    rt_size_t size;
+    char *path;
+
+    if (!elf_cache_usable(elf_info))
+    {
+        return RT_FALSE;
+    }
+
+    path = dfs_normalize_path(NULL, elf_info->filename);
+    if (path == RT_NULL)
+    {
+        return RT_FALSE;
+    }
+
+    rt_mutex_take(&_elf_cache_lock, RT_WAITING_FOREVER);
+    entry = elf_cache_find_locked(path);
+    if (entry && entry->mtime == elf_info->mtime && entry->file_len == elf_info->file_len)
+    {
+        size = sizeof(Elf_Phdr) * entry->ehdr.e_phnum;
+        elf_info->phdr = rt_malloc(size);
+        if (elf_info->phdr)
+        {
+            rt_memcpy(elf_info->phdr, entry->phdr, size);
+            elf_info->ehdr = entry->ehdr;
+            rt_list_remove(&entry->node);
+            rt_list_insert_after(&_elf_cache, &entry->node);
+            hit = RT_TRUE;
+        }
+    }
+
+    if (hit)
+        _elf_cache_hit++;
+    else
+        _elf_cache_miss++;
+    rt_mutex_release(&_elf_cache_lock);
+
+    rt_free(path);
+
+    return hit;
+}
+
+static void elf_cache_insert(elf_info_t *elf_info)
+{
+    struct elf_cache_entry *entry;
+    struct elf_cache_entry *stale;
+    rt_size_t phdr_size;
+    char *path;
+
+    if (!elf_cache_usable(elf_info))
+    {
+        return;
+    }
+
+    path = dfs_normalize_path(NULL, elf_info->filename);
+    if (path == RT_NULL)
+    {
+        return;
+    }
+
+    /* the entry, program headers and path in one block */
+    phdr_size = sizeof(Elf_Phdr) * elf_info->ehdr.e_phnum;
+    entry = rt_malloc(sizeof(*entry) + phdr_size + rt_strlen(path) + 1);
+    if (entry)
+    {
+        entry->phdr = (Elf_Phdr *)(entry + 1);
+        entry->path = (char *)entry->phdr + phdr_size;
+        entry->mtime = elf_info->mtime;
+        entry->file_len = elf_info->file_len;
+        entry->ehdr = elf_info->ehdr;
+        rt_memcpy(entry->phdr, elf_info->phdr, phdr_size);
+        rt_strcpy(entry->path, path);
+
+        /* replace the stale one, or the least recently used */
+        rt_mutex_take(&_elf_cache_lock, RT_WAITING_FOREVER);
+        stale = elf_cache_find_locked(path);
+        if (stale)
+            elf_cache_remove_locked(stale);
+        else if (_elf_cache_nr >= LWP_ELF_CACHE_NR)
+            elf_cache_remove_locked(rt_list_entry(_elf_cache.prev, struct elf_cache_entry, node));
+        rt_list_insert_after(&_elf_cache, &entry->node);
+        _elf_cache_nr++;
+        rt_mutex_release(&_elf_cache_lock);
+    }
+
+    rt_free(path);
+}
+
+void lwp_elf_cache_flush(void)
+{
+    rt_mutex_take(&_elf_cache_lock, RT_WAITING_FOREVER);
+    while (!rt_list_isempty(&_elf_cache))
+    {
+        elf_cache_remove_locked(rt_list_entry(_elf_cache.next, struct elf_cache_entry, node));
+    }
+    rt_mutex_release(&_elf_cache_lock);
+}
+
+void lwp_elf_cache_stat(rt_size_t *hit, rt_size_t *miss)
+{
+    rt_mutex_take(&_elf_cache_lock, RT_WAITING_FOREVER);
+    *hit = _elf_cache_hit;
+    *miss = _elf_cache_miss;
+    rt_mutex_release(&_elf_cache_lock);
+}
+
+static int elf_cache_init(void)
+{
+    rt_mutex_init(&_elf_cache_lock, "elfcache", RT_IPC_FLAG_PRIO);
+    return 0;
+}
+INIT_PREV_EXPORT(elf_cache_init);
+
+#if defined(RT_USING_FINSH) && defined(FINSH_USING_MSH)
+static int list_elf_cache(void)
+{
+    struct elf_cache_entry *entry;
+
+    rt_mutex_take(&_elf_cache_lock, RT_WAITING_FOREVER);
+    rt_kprintf("%d images cached, hit %ld, miss %ld\n", _elf_cache_nr, _elf_cache_hit, _elf_cache_miss);
+    rt_list_for_each_entry(entry, &_elf_cache, node)
+    {
+        rt_kprintf("%8ld %s\n", entry->file_len, entry->path);
+    }
+    rt_mutex_release(&_elf_cache_lock);
+
+    return 0;
+}
+MSH_CMD_EXPORT(list_elf_cache, show the headers of images cached);
+#endif /* RT_USING_FINSH && FINSH_USING_MSH */
+
+#else
+#define elf_cache_lookup(elf_info) RT_FALSE
+#define elf_cache_insert(elf_info)
+#endif /* LWP_USING_ELF_CACHE */
+
 static rt_int32_t elf_check_ehdr(const Elf_Ehdr *ehdr, rt_uint32_t file_len)
 {
     if (memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0)
@@ -273,12 +472,18 @@ static int elf_load_ehdr(elf_info_t *elf_info)
 
     elf_info->fd = ret;
 
-    ret = elf_file_length(elf_info->filename, &elf_info->file_len);
+    ret = elf_file_stat(elf_info->fd, &elf_info->file_len, &elf_info->mtime);
     if (ret != RT_EOK)
     {
         return -RT_ERROR;
     }
 
+    /* the headers checked before, and the program headers are got as well */
+    if (elf_cache_lookup(elf_info))
+    {
+        return RT_EOK;
+    }
+
     ret = elf_file_read(elf_info->fd, (rt_uint8_t *)&elf_info->ehdr, sizeof(Elf_Ehdr), 0);
     if (ret != RT_EOK)
     {
@@ -302,6 +507,12 @@ static int elf_load_phdr(elf_info_t *elf_info)
     uint32_t size;
     int ret;
 
+    /* got from the cache */
+    if (elf_info->phdr != RT_NULL)
+    {
+        return RT_EOK;
+    }
+
     if (ehdr->e_phnum < 1)
     {
         return -RT_ERROR;
@@ -334,6 +545,8 @@ static int elf_load_phdr(elf_info_t *elf_info)
         return -RT_ERROR;
     }
 
+    elf_cache_insert(elf_info);
+
     return RT_EOK;
 }
 
@@ -603,6 +816,13 @@ static int elf_aux_fill(elf_load_info_t *load_info)
     ELF_AUX_ENT(aux_info, AT_HWCAP, 0);
     ELF_AUX_ENT(aux_info, AT_CLKTCK, 0);
     ELF_AUX_ENT(aux_info, AT_SECURE, 0);
+#ifdef LWP_USING_VDSO
+    if (load_info->lwp->vdso_data)
+    {
+        ELF_AUX_ENT(aux_info, AT_RT_VDSO_DATA, (size_t)load_info->lwp->vdso_data);
+        ELF_AUX_ENT(aux_info, AT_RT_VDSO_PROC, (size_t)load_info->lwp->vdso_proc);
+    }
+#endif /* LWP_USING_VDSO */
 
 #ifdef ARCH_MM_MMU
     rt_hw_cpu_dcache_ops(RT_HW_CACHE_FLUSH, aux, sizeof(*aux));
@@ -12,6 +12,7 @@
  *                             FUTEX_PRIVATE is supported currently
  * 2023-11-03     Shell        Add Support for ~FUTEX_PRIVATE
  * 2023-11-16     xqyjlj       Add Support for futex requeue and futex pi
+ * 2026-10-19     agent        Lock shared futexes by hash buckets
  */
 #define __RT_IPC_SOURCE__
 
@@ -19,46 +20,96 @@
 #include "sys/time.h"
 #include <stdatomic.h>
 
-struct rt_mutex _glob_futex;
-
 rt_err_t lwp_futex_init(void)
 {
-    return rt_mutex_init(&_glob_futex, "glob_ftx", RT_IPC_FLAG_PRIO);
+    return futex_global_table_init();
 }
 
-static void _futex_lock(rt_lwp_t lwp, int op_flags)
+static void _bucket_lock(struct shared_futex_bucket *bucket)
 {
     rt_err_t error;
+
+    error = lwp_mutex_take_safe(&bucket->lock, RT_WAITING_FOREVER, 0);
+    if (error)
+    {
+        LOG_E("%s: Should not failed", __func__);
+        RT_ASSERT(0);
+    }
+}
+
+static void _bucket_unlock(struct shared_futex_bucket *bucket)
+{
+    rt_err_t error;
+
+    error = lwp_mutex_release_safe(&bucket->lock);
+    if (error)
+    {
+        LOG_E("%s: Should not failed", __func__);
+        RT_ASSERT(0);
+    }
+}
+
+/**
+ * The private futexes are protected by the lwp lock, and the shared ones by
+ * the lock of the bucket they are hashed to
+ */
+static void _futex_lock(rt_lwp_t lwp, rt_futex_t futex, int op_flags)
+{
     if (op_flags & FUTEX_PRIVATE)
     {
         LWP_LOCK(lwp);
     }
     else
     {
-        error = lwp_mutex_take_safe(&_glob_futex, RT_WAITING_FOREVER, 0);
-        if (error)
-        {
-            LOG_E("%s: Should not failed", __func__);
-            RT_ASSERT(0);
-        }
+        _bucket_lock(futex->bucket);
     }
 }
 
-static void _futex_unlock(rt_lwp_t lwp, int op_flags)
+static void _futex_unlock(rt_lwp_t lwp, rt_futex_t futex, int op_flags)
 {
-    rt_err_t error;
     if (op_flags & FUTEX_PRIVATE)
     {
         LWP_UNLOCK(lwp);
     }
     else
     {
-        error = lwp_mutex_release_safe(&_glob_futex);
-        if (error)
-        {
-            LOG_E("%s: Should not failed", __func__);
-            RT_ASSERT(0);
-        }
+        _bucket_unlock(futex->bucket);
+    }
+}
+
+/* lock the buckets in address order, against a requeue in the other way */
+static void _futex_lock2(rt_lwp_t lwp, rt_futex_t futex1, rt_futex_t futex2,
+                         int op_flags)
+{
+    struct shared_futex_bucket *first, *second;
+
+    if (op_flags & FUTEX_PRIVATE)
+    {
+        LWP_LOCK(lwp);
+    }
+    else
+    {
+        first = futex1->bucket < futex2->bucket ? futex1->bucket : futex2->bucket;
+        second = futex1->bucket < futex2->bucket ? futex2->bucket : futex1->bucket;
+
+        _bucket_lock(first);
+        if (second != first)
+            _bucket_lock(second);
+    }
+}
+
+static void _futex_unlock2(rt_lwp_t lwp, rt_futex_t futex1, rt_futex_t futex2,
+                           int op_flags)
+{
+    if (op_flags & FUTEX_PRIVATE)
+    {
+        LWP_UNLOCK(lwp);
+    }
+    else
+    {
+        if (futex2->bucket != futex1->bucket)
+            _bucket_unlock(futex2->bucket);
+        _bucket_unlock(futex1->bucket);
     }
 }
 
@@ -206,7 +257,7 @@ static rt_futex_t _pftx_get(void *uaddr, struct rt_lwp *lwp, int op,
 
 /**
  * Destroy a Shared FuTeX (pftx)
- * Note: must have futex address_search_head taken
+ * Note: takes the bucket lock, must not be called with it held
  */
 static rt_err_t _sftx_destroy(void *data)
 {
@@ -216,7 +267,12 @@ static rt_err_t _sftx_destroy(void *data)
     if (futex)
     {
         /* delete it even it's not in the table */
-        futex_global_table_delete(&futex->entry.key);
+        if (futex->bucket)
+        {
+            _bucket_lock(futex->bucket);
+            futex_global_table_delete(futex->bucket, &futex->entry.key);
+            _bucket_unlock(futex->bucket);
+        }
         if (futex->mutex)
         {
             rt_mutex_delete(futex->mutex);
@@ -230,8 +286,10 @@ static rt_err_t _sftx_destroy(void *data)
 
 /**
  * Create a Shared FuTeX (sftx)
+ * Note: must have the bucket of key taken
  */
-static rt_futex_t _sftx_create(struct shared_futex_key *key, struct rt_lwp *lwp)
+static rt_futex_t _sftx_create(struct shared_futex_bucket *bucket,
+                               struct shared_futex_key *key, struct rt_lwp *lwp)
 {
     rt_futex_t futex = RT_NULL;
     struct rt_object *obj = RT_NULL;
@@ -250,7 +308,7 @@ static rt_futex_t _sftx_create(struct shared_futex_key *key, struct rt_lwp *lwp)
             }
             else
             {
-                if (futex_global_table_add(key, futex))
+                if (futex_global_table_add(bucket, key, futex))
                 {
                     rt_object_delete(obj);
                     rt_free(futex);
@@ -268,6 +326,36 @@ static rt_futex_t _sftx_create(struct shared_futex_key *key, struct rt_lwp *lwp)
     return futex;
 }
 
+/**
+ * Get a Shared FuTeX (sftx) match the key, only the bucket of key is locked
+ */
+rt_futex_t futex_shared_get(struct shared_futex_key *key, struct rt_lwp *lwp,
+                            rt_err_t *rc)
+{
+    rt_futex_t futex = RT_NULL;
+    struct shared_futex_bucket *bucket;
+    rt_err_t error;
+
+    bucket = futex_global_table_bucket(key);
+
+    /* query for the key */
+    _bucket_lock(bucket);
+    error = futex_global_table_find(bucket, key, &futex);
+    if (error != RT_EOK)
+    {
+        /* not found, do allocation */
+        futex = _sftx_create(bucket, key, lwp);
+        if (!futex)
+            error = -ENOMEM;
+        else
+            error = 0;
+    }
+    _bucket_unlock(bucket);
+
+    *rc = error;
+    return futex;
+}
+
 /**
  * Get a Shared FuTeX (sftx) match the (lwp, uaddr, op)
  */
@@ -288,19 +376,7 @@ static rt_futex_t _sftx_get(void *uaddr, struct rt_lwp *lwp, int op,
                      ((long)uaddr & ((1 << MM_PAGE_SHIFT) - 1));
         RD_UNLOCK(lwp->aspace);
 
-        /* query for the key */
-        _futex_lock(lwp, op & ~FUTEX_PRIVATE);
-        error = futex_global_table_find(&key, &futex);
-        if (error != RT_EOK)
-        {
-            /* not found, do allocation */
-            futex = _sftx_create(&key, lwp);
-            if (!futex)
-                error = -ENOMEM;
-            else
-                error = 0;
-        }
-        _futex_unlock(lwp, op & ~FUTEX_PRIVATE);
+        futex = futex_shared_get(&key, lwp, &error);
     }
     else
     {
@@ -389,8 +465,8 @@ exit:
     return err;
 }
 
-static int _futex_wait(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr,
-                       int value, const struct timespec *timeout, int op_flags)
+int futex_wait(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr, int value,
+               const struct timespec *timeout, int op_flags)
 {
     rt_tick_t to;
     rt_thread_t thread;
@@ -405,7 +481,7 @@ static int _futex_wait(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr,
      * - futex.waiting (RW; Protected by lwp_lock)
      * - the local cpu
      */
-    _futex_lock(lwp, op_flags);
+    _futex_lock(lwp, futex, op_flags);
     if (*uaddr == value)
     {
         thread = rt_thread_self();
@@ -419,13 +495,13 @@ static int _futex_wait(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr,
             if (to < 0)
             {
                 rc = -EINVAL;
-                _futex_unlock(lwp, op_flags);
+                _futex_unlock(lwp, futex, op_flags);
             }
             else
             {
                 rt_enter_critical();
                 rc = _suspend_thread_timeout_locked(thread, futex, to);
-                _futex_unlock(lwp, op_flags);
+                _futex_unlock(lwp, futex, op_flags);
                 rt_exit_critical();
             }
         }
@@ -433,7 +509,7 @@ static int _futex_wait(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr,
         {
             rt_enter_critical();
             rc = _suspend_thread_locked(thread, futex);
-            _futex_unlock(lwp, op_flags);
+            _futex_unlock(lwp, futex, op_flags);
             rt_exit_critical();
         }
 
@@ -448,7 +524,7 @@ static int _futex_wait(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr,
     }
     else
     {
-        _futex_unlock(lwp, op_flags);
+        _futex_unlock(lwp, futex, op_flags);
         rc = -EAGAIN;
         rt_set_errno(EAGAIN);
     }
@@ -456,8 +532,7 @@ static int _futex_wait(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr,
     return rc;
 }
 
-static long _futex_wake(rt_futex_t futex, struct rt_lwp *lwp, int number,
-                        int op_flags)
+long futex_wake(rt_futex_t futex, struct rt_lwp *lwp, int number, int op_flags)
 {
     long woken_cnt = 0;
     int is_empty = 0;
@@ -470,7 +545,7 @@ static long _futex_wake(rt_futex_t futex, struct rt_lwp *lwp, int number,
      */
     while (number && !is_empty)
     {
-        _futex_lock(lwp, op_flags);
+        _futex_lock(lwp, futex, op_flags);
         if (rt_susp_list_dequeue(&futex->waiting_thread, RT_EOK))
         {
             number--;
@@ -481,7 +556,7 @@ static long _futex_wake(rt_futex_t futex, struct rt_lwp *lwp, int number,
         {
             is_empty = RT_TRUE;
         }
-        _futex_unlock(lwp, op_flags);
+        _futex_unlock(lwp, futex, op_flags);
     }
 
     /* do schedule */
@@ -580,7 +655,7 @@ static long _futex_lock_pi(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr,
 
     current_thread = rt_thread_self();
 
-    _futex_lock(lwp, op_flags);
+    _futex_lock(lwp, futex, op_flags);
 
     lwp_get_from_user(&word, (void *)uaddr, sizeof(int));
     tid = word & FUTEX_TID_MASK;
@@ -591,10 +666,10 @@ static long _futex_lock_pi(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr,
         nword = current_thread->tid;
         if (_futex_cmpxchg_value(&cword, uaddr, word, nword))
         {
-            _futex_unlock(lwp, op_flags);
+            _futex_unlock(lwp, futex, op_flags);
             return -EAGAIN;
         }
-        _futex_unlock(lwp, op_flags);
+        _futex_unlock(lwp, futex, op_flags);
         return 0;
     }
     else
@@ -602,7 +677,7 @@ static long _futex_lock_pi(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr,
         thread = lwp_tid_get_thread_and_inc_ref(tid);
         if (thread == RT_NULL)
         {
-            _futex_unlock(lwp, op_flags);
+            _futex_unlock(lwp, futex, op_flags);
             return -ESRCH;
         }
         lwp_tid_dec_ref(thread);
@@ -611,7 +686,7 @@ static long _futex_lock_pi(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr,
             word | FUTEX_WAITERS;
         if (_futex_cmpxchg_value(&cword, uaddr, word, nword))
         {
-            _futex_unlock(lwp, op_flags);
+            _futex_unlock(lwp, futex, op_flags);
             return -EAGAIN;
         }
         word = nword;
@@ -622,7 +697,7 @@ static long _futex_lock_pi(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr,
         futex->mutex = rt_mutex_create("futexpi", RT_IPC_FLAG_PRIO);
         if (futex->mutex == RT_NULL)
         {
-            _futex_unlock(lwp, op_flags);
+            _futex_unlock(lwp, futex, op_flags);
             return -ENOMEM;
         }
 
@@ -641,7 +716,7 @@ static long _futex_lock_pi(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr,
     {
         to = RT_WAITING_NO;
     }
-    _futex_unlock(lwp, op_flags);
+    _futex_unlock(lwp, futex, op_flags);
 
     err = rt_mutex_take_interruptible(futex->mutex, to);
     if (err == -RT_ETIMEOUT)
@@ -649,13 +724,13 @@ static long _futex_lock_pi(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr,
         err = -EDEADLK;
     }
 
-    _futex_lock(lwp, op_flags);
+    _futex_lock(lwp, futex, op_flags);
     nword = current_thread->tid | FUTEX_WAITERS;
     if (_futex_cmpxchg_value(&cword, uaddr, word, nword))
     {
         err = -EAGAIN;
     }
-    _futex_unlock(lwp, op_flags);
+    _futex_unlock(lwp, futex, op_flags);
 
     return err;
 }
@@ -663,13 +738,13 @@ static long _futex_lock_pi(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr,
 static long _futex_unlock_pi(rt_futex_t futex, struct rt_lwp *lwp, int op_flags)
 {
     rt_err_t err = 0;
-    _futex_lock(lwp, op_flags);
+    _futex_lock(lwp, futex, op_flags);
     if (!futex->mutex)
     {
-        _futex_unlock(lwp, op_flags);
+        _futex_unlock(lwp, futex, op_flags);
         return -EPERM;
     }
-    _futex_unlock(lwp, op_flags);
+    _futex_unlock(lwp, futex, op_flags);
 
     err = rt_mutex_release(futex->mutex);
     return err;
@@ -730,24 +805,28 @@ rt_err_t lwp_futex(struct rt_lwp *lwp, int *uaddr, int op, int val,
         switch (op_type)
         {
             case FUTEX_WAIT:
-                rc = _futex_wait(futex, lwp, uaddr, val, timeout, op_flags);
+                rc = futex_wait(futex, lwp, uaddr, val, timeout, op_flags);
                 break;
             case FUTEX_WAKE:
-                rc = _futex_wake(futex, lwp, val, op_flags);
+                rc = futex_wake(futex, lwp, val, op_flags);
                 break;
             case FUTEX_REQUEUE:
                 futex2 = _futex_get(uaddr2, lwp, op_flags, &rc);
                 if (!rc)
                 {
-                    _futex_lock(lwp, op_flags);
+                    _futex_lock2(lwp, futex, futex2, op_flags);
                     rc = _futex_requeue(futex, futex2, lwp, val, (long)timeout,
                                         op_flags);
-                    _futex_unlock(lwp, op_flags);
+                    _futex_unlock2(lwp, futex, futex2, op_flags);
                 }
                 break;
             case FUTEX_CMP_REQUEUE:
                 futex2 = _futex_get(uaddr2, lwp, op_flags, &rc);
-                _futex_lock(lwp, op_flags);
+                if (rc)
+                {
+                    break;
+                }
+                _futex_lock2(lwp, futex, futex2, op_flags);
                 if (*uaddr == val3)
                 {
                     rc = 0;
@@ -761,7 +840,7 @@ rt_err_t lwp_futex(struct rt_lwp *lwp, int *uaddr, int op, int val,
                     rc = _futex_requeue(futex, futex2, lwp, val,
                                         (long)timeout, op_flags);
                 }
-                _futex_unlock(lwp, op_flags);
+                _futex_unlock2(lwp, futex, futex2, op_flags);
                 break;
             case FUTEX_LOCK_PI:
                 rc = _futex_lock_pi(futex, lwp, uaddr, timeout, op_flags,
@@ -834,7 +913,7 @@ retry:
     futex = _futex_get(uaddr, lwp, FUTEX_PRIVATE, &rc);
     if (is_pending_op && !is_pi && !word)
     {
-        _futex_wake(futex, lwp, 1, FUTEX_PRIVATE);
+        futex_wake(futex, lwp, 1, FUTEX_PRIVATE);
         return 0;
     }
 
@@ -862,7 +941,7 @@ retry:
         goto retry;
 
     if (!is_pi && (word & FUTEX_WAITERS))
-        _futex_wake(futex, lwp, 1, FUTEX_PRIVATE);
+        futex_wake(futex, lwp, 1, FUTEX_PRIVATE);
 
     return 0;
 }
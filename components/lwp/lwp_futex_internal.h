@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2023-11-01     Shell        Init ver.
+ * 2026-10-19     agent        split the table of shared futexes into buckets
  */
 #ifndef __LWP_FUTEX_INTERNAL_H__
 #define __LWP_FUTEX_INTERNAL_H__
@@ -25,6 +26,10 @@
 #include <lwp_user_mm.h>
 #endif /* ARCH_MM_MMU */
 
+#ifndef LWP_FUTEX_HASH_BUCKETS
+#define LWP_FUTEX_HASH_BUCKETS 32
+#endif
+
 struct shared_futex_key
 {
     rt_mem_obj_t mobj;
@@ -32,6 +37,13 @@ struct shared_futex_key
 };
 DEFINE_RT_UTHASH_TYPE(shared_futex_entry, struct shared_futex_key, key);
 
+/* a bucket of the shared futexes, the unrelated futexes never share a lock */
+struct shared_futex_bucket
+{
+    struct rt_mutex lock;
+    struct shared_futex_entry *head;
+};
+
 struct rt_futex
 {
     union {
@@ -44,11 +56,25 @@ struct rt_futex
     rt_list_t waiting_thread;
     struct rt_object *custom_obj;
     rt_mutex_t mutex;
+
+    /* for shared futex, the bucket locking it */
+    struct shared_futex_bucket *bucket;
 };
 typedef struct rt_futex *rt_futex_t;
 
-rt_err_t futex_global_table_add(struct shared_futex_key *key, rt_futex_t futex);
-rt_err_t futex_global_table_find(struct shared_futex_key *key, rt_futex_t *futex);
-rt_err_t futex_global_table_delete(struct shared_futex_key *key);
+rt_err_t futex_global_table_init(void);
+struct shared_futex_bucket *futex_global_table_bucket(struct shared_futex_key *key);
+rt_err_t futex_global_table_add(struct shared_futex_bucket *bucket,
+                                struct shared_futex_key *key, rt_futex_t futex);
+rt_err_t futex_global_table_find(struct shared_futex_bucket *bucket,
+                                 struct shared_futex_key *key, rt_futex_t *futex);
+rt_err_t futex_global_table_delete(struct shared_futex_bucket *bucket,
+                                   struct shared_futex_key *key);
+
+rt_futex_t futex_shared_get(struct shared_futex_key *key, struct rt_lwp *lwp,
+                            rt_err_t *rc);
+int futex_wait(rt_futex_t futex, struct rt_lwp *lwp, int *uaddr, int value,
+               const struct timespec *timeout, int op_flags);
+long futex_wake(rt_futex_t futex, struct rt_lwp *lwp, int number, int op_flags);
 
 #endif /* __LWP_FUTEX_INTERNAL_H__ */
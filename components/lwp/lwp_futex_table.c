@@ -6,30 +6,67 @@
  * Change Logs:
  * Date           Author       Notes
  * 2023-11-01     Shell        Init ver.
+ * 2026-10-19     agent        split the table into buckets with their own locks
  */
 
 #include "lwp_futex_internal.h"
 
-static struct shared_futex_entry *_futex_hash_head;
+#if (LWP_FUTEX_HASH_BUCKETS & (LWP_FUTEX_HASH_BUCKETS - 1)) != 0
+#error "LWP_FUTEX_HASH_BUCKETS must be a power of 2"
+#endif
 
-rt_err_t futex_global_table_add(struct shared_futex_key *key, rt_futex_t futex)
+static struct shared_futex_bucket _futex_buckets[LWP_FUTEX_HASH_BUCKETS];
+
+rt_err_t futex_global_table_init(void)
+{
+    rt_err_t rc = RT_EOK;
+
+    for (int i = 0; i < LWP_FUTEX_HASH_BUCKETS && rc == RT_EOK; i++)
+    {
+        _futex_buckets[i].head = RT_NULL;
+        rc = rt_mutex_init(&_futex_buckets[i].lock, "ftxbkt", RT_IPC_FLAG_PRIO);
+    }
+
+    return rc;
+}
+
+/**
+ * Get the bucket of a shared futex. The futexes of different memory objects
+ * or different words in one page are spread over the buckets.
+ */
+struct shared_futex_bucket *futex_global_table_bucket(struct shared_futex_key *key)
+{
+    rt_ubase_t hash;
+
+    /* the word is 4 bytes aligned, and so is the object */
+    hash = ((rt_ubase_t)key->mobj >> 4) ^ ((rt_ubase_t)key->offset >> 2);
+    hash *= 0x9e3779b1u;
+    hash ^= hash >> 16;
+
+    return &_futex_buckets[hash & (LWP_FUTEX_HASH_BUCKETS - 1)];
+}
+
+rt_err_t futex_global_table_add(struct shared_futex_bucket *bucket,
+                                struct shared_futex_key *key, rt_futex_t futex)
 {
     rt_err_t rc = 0;
     struct shared_futex_entry *entry = &futex->entry;
     futex->entry.key.mobj = key->mobj;
     futex->entry.key.offset = key->offset;
+    futex->bucket = bucket;
 
-    RT_UTHASH_ADD(_futex_hash_head, key, sizeof(struct shared_futex_key), entry);
+    RT_UTHASH_ADD(bucket->head, key, sizeof(struct shared_futex_key), entry);
     return rc;
 }
 
-rt_err_t futex_global_table_find(struct shared_futex_key *key, rt_futex_t *futex)
+rt_err_t futex_global_table_find(struct shared_futex_bucket *bucket,
+                                 struct shared_futex_key *key, rt_futex_t *futex)
 {
     rt_err_t rc;
     rt_futex_t found_futex;
     struct shared_futex_entry *entry;
 
-    RT_UTHASH_FIND(_futex_hash_head, key, sizeof(struct shared_futex_key), entry);
+    RT_UTHASH_FIND(bucket->head, key, sizeof(struct shared_futex_key), entry);
     if (entry)
     {
         rc = RT_EOK;
@@ -45,15 +82,16 @@ rt_err_t futex_global_table_find(struct shared_futex_key *key, rt_futex_t *futex
     return rc;
 }
 
-rt_err_t futex_global_table_delete(struct shared_futex_key *key)
+rt_err_t futex_global_table_delete(struct shared_futex_bucket *bucket,
+                                   struct shared_futex_key *key)
 {
     rt_err_t rc;
     struct shared_futex_entry *entry;
 
-    RT_UTHASH_FIND(_futex_hash_head, key, sizeof(struct shared_futex_key), entry);
+    RT_UTHASH_FIND(bucket->head, key, sizeof(struct shared_futex_key), entry);
     if (entry)
     {
-        RT_UTHASH_DELETE(_futex_hash_head, entry);
+        RT_UTHASH_DELETE(bucket->head, entry);
         rc = RT_EOK;
     }
     else
@@ -9,6 +9,7 @@
  * 2023-07-25     Shell        Remove usage of rt_hw_interrupt API in the lwp
  * 2023-09-16     zmq810150896 Increased versatility of some features on dfs v2
  * 2024-01-25     Shell        porting to susp_list API
+ * 2026-10-19     agent        add RT_CHANNEL_PAGES to move pages without copying
  */
 #define __RT_IPC_SOURCE__
 
@@ -22,6 +23,7 @@
 #include "lwp_internal.h"
 #include "lwp_ipc.h"
 #include "lwp_ipc_internal.h"
+#include "lwp_user_mm.h"
 
 #include <dfs_file.h>
 #include <poll.h>
@@ -95,6 +97,129 @@ static void _ipc_msg_free(rt_ipc_msg_t p_msg)
     rt_spin_unlock_irqrestore(&_msg_list_lock, level);
 }
 
+#ifdef ARCH_MM_MMU
+/**
+ * Page frames of a RT_CHANNEL_PAGES message on the way. They are taken away
+ * from the sender and mapped into the receiver without copying.
+ */
+struct rt_ipc_pages
+{
+    void *uaddr;                /* the buffer of sender */
+    rt_size_t nr;
+    void *page[];
+};
+
+/**
+ * Replace the user buffer of message with the page frames of it.
+ */
+static rt_err_t _ipc_msg_pages_detach(rt_channel_msg_t data)
+{
+    struct rt_ipc_pages *pages;
+    struct rt_lwp *lwp = lwp_self();
+    rt_size_t nr = data->u.b.length >> ARCH_PAGE_SHIFT;
+    rt_err_t rc;
+
+    if (data->type != RT_CHANNEL_PAGES)
+        return RT_EOK;
+    if (!lwp || !nr)
+        return -RT_EINVAL;
+
+    pages = rt_malloc(sizeof(*pages) + nr * sizeof(void *));
+    if (!pages)
+        return -RT_ENOMEM;
+
+    rc = lwp_pages_detach(lwp, data->u.b.buf, data->u.b.length, pages->page);
+    if (rc == RT_EOK)
+    {
+        pages->uaddr = data->u.b.buf;
+        pages->nr = nr;
+        data->u.b.buf = pages;
+    }
+    else
+    {
+        rt_free(pages);
+    }
+
+    return rc;
+}
+
+/**
+ * Release the page frames of a message never received.
+ */
+static void _ipc_msg_pages_put(rt_channel_msg_t data)
+{
+    struct rt_ipc_pages *pages = data->u.b.buf;
+
+    if (data->type != RT_CHANNEL_PAGES)
+        return;
+
+    lwp_pages_put(pages->page, pages->nr);
+    rt_free(pages);
+    data->u.b.buf = RT_NULL;
+    data->u.b.length = 0;
+}
+
+/**
+ * Give the page frames of a message not sent back to the sender, at the
+ * address they were detached from.
+ */
+static void _ipc_msg_pages_restore(rt_channel_msg_t data)
+{
+    struct rt_ipc_pages *pages = data->u.b.buf;
+    struct rt_lwp *lwp = lwp_self();
+    void *uaddr;
+
+    if (data->type != RT_CHANNEL_PAGES)
+        return;
+
+    uaddr = pages->uaddr;
+    if (lwp_pages_attach(lwp, &uaddr, pages->page, pages->nr) == RT_EOK)
+    {
+        rt_free(pages);
+        data->u.b.buf = uaddr;
+    }
+    else
+    {
+        /* the range is taken by another thread of sender meanwhile */
+        LOG_W("%s: drop %ld pages at %p", __func__, pages->nr, pages->uaddr);
+        _ipc_msg_pages_put(data);
+    }
+}
+
+/**
+ * Map the page frames of message into the receiver.
+ */
+static void _ipc_msg_pages_attach(rt_channel_msg_t data)
+{
+    struct rt_ipc_pages *pages = data->u.b.buf;
+    struct rt_lwp *lwp = lwp_self();
+    void *uaddr = RT_NULL;
+
+    if (data->type != RT_CHANNEL_PAGES)
+        return;
+
+    if (lwp && lwp_pages_attach(lwp, &uaddr, pages->page, pages->nr) == RT_EOK)
+    {
+        rt_free(pages);
+        data->u.b.buf = uaddr;
+    }
+    else
+    {
+        /* a receiver without user space gets nothing */
+        LOG_W("%s: drop %ld pages", __func__, pages->nr);
+        _ipc_msg_pages_put(data);
+    }
+}
+#else
+rt_inline rt_err_t _ipc_msg_pages_detach(rt_channel_msg_t data)
+{
+    return data->type == RT_CHANNEL_PAGES ? -RT_ENOSYS : RT_EOK;
+}
+rt_inline void _ipc_msg_pages_put(rt_channel_msg_t data) {}
+rt_inline void _ipc_msg_pages_restore(rt_channel_msg_t data) {}
+rt_inline void _ipc_msg_pages_attach(rt_channel_msg_t data) {}
+#endif /* ARCH_MM_MMU */
+
 /**
  * Initialized the IPC message.
  */
@@ -301,8 +426,14 @@ rt_err_t rt_raw_channel_close(rt_channel_t ch)
                 _channel_list_resume_all_locked(&ch->parent.suspend_thread);
                 _channel_list_resume_all_locked(&ch->wait_thread);
 
-                /* all ipc msg will lost */
-                rt_list_init(&ch->wait_msg);
+                /* all ipc msg will lost, only the pages carried are released */
+                while (!rt_list_isempty(&ch->wait_msg))
+                {
+                    rt_ipc_msg_t msg = rt_list_entry(ch->wait_msg.next, struct rt_ipc_msg, mlist);
+                    rt_list_remove(&msg->mlist);
+                    _ipc_msg_pages_put(&msg->msg);
+                    _ipc_msg_free(msg);
+                }
 
                 rt_object_delete(&ch->parent.parent); /* release the IPC channel structure */
             }
@@ -525,6 +656,14 @@ static rt_err_t _do_send_recv_timeout(rt_channel_t ch, rt_channel_msg_t data, in
         data->u.fd.file = _ipc_msg_get_file(data->u.fd.fd);
     }
 
+    /* IPC message : pages moved out of the sender, it may sleep */
+    rc = _ipc_msg_pages_detach(data);
+    if (rc != RT_EOK)
+    {
+        _ipc_msg_free(msg);
+        return rc;
+    }
+
     rt_ipc_msg_init(msg, data, need_reply);
 
     if (need_reply)
@@ -660,12 +799,14 @@ static rt_err_t _do_send_recv_timeout(rt_channel_t ch, rt_channel_msg_t data, in
                 _ipc_msg_free(thread_send->msg_ret);                     /* put back the message to kernel */
 
                 thread_send->msg_ret = RT_NULL;
+                _ipc_msg_pages_attach(data_ret);
             }
         }
     }
     else
     {
         rt_spin_unlock_irqrestore(&ch->slock, level);
+        _ipc_msg_pages_restore(data);
     }
 
     return rc;
@@ -709,7 +850,7 @@ rt_err_t rt_raw_channel_reply(rt_channel_t ch, rt_channel_msg_t data)
     {
         rc = -RT_EIO;
     }
-    else
+    else if ((rc = _ipc_msg_pages_detach(data)) == RT_EOK)
     {
         level = rt_spin_lock_irqsave(&ch->slock);
 
@@ -749,6 +890,9 @@ rt_err_t rt_raw_channel_reply(rt_channel_t ch, rt_channel_msg_t data)
         }
         rt_spin_unlock_irqrestore(&ch->slock, level);
 
+        if (rc != RT_EOK)
+            _ipc_msg_pages_restore(data);
+
         rt_schedule();
     }
 
@@ -911,6 +1055,10 @@ static rt_err_t _rt_raw_channel_recv_timeout(rt_channel_t ch, rt_channel_msg_t d
 
     rt_spin_unlock_irqrestore(&ch->slock, level);
 
+    /* map the pages out of the lock of channel */
+    if (rc == RT_EOK)
+        _ipc_msg_pages_attach(data);
+
     LWP_RETURN(rc);
 }
 
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2019-10-12     Jesven       first version
+ * 2026-10-19     agent        add RT_CHANNEL_PAGES
  */
 
 #ifndef LWP_IPC_H__
@@ -19,7 +20,8 @@ enum
 {
     RT_CHANNEL_RAW,
     RT_CHANNEL_BUFFER,
-    RT_CHANNEL_FD
+    RT_CHANNEL_FD,
+    RT_CHANNEL_PAGES    /* page-aligned buffer in u.b moved to the receiver */
 };
 
 struct rt_channel_msg
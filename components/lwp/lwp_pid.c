@@ -22,6 +22,8 @@
  *                             with waitpid(pid=-1)/waitpid(pid=-pgid)/waitpid(pid=0) that only one
  *                             process can be traced while waiter suspend
  * 2024-01-25     shell        porting to new sched API
+ * 2026-10-19     agent        report page faults in rusage and list_fault
+ * 2026-10-19     agent        give the borrowed aspace back to vfork parent
  */
 
 /* includes scheduler related API */
@@ -542,6 +544,16 @@ void _thread_exit(rt_lwp_t lwp, rt_thread_t thread)
     LWP_UNLOCK(lwp);
     lwp_futex_exit_robust_list(thread);
 
+#ifdef ARCH_MM_MMU
+    if (lwp->vfork_parent && rt_list_isempty(&lwp->t_grp))
+    {
+        /* never touch the borrowed aspace after the parent resumes */
+        lwp->aspace = RT_NULL;
+        lwp_aspace_switch(thread);
+        lwp_vfork_release(lwp);
+    }
+#endif /* ARCH_MM_MMU */
+
     /**
      * Note: the tid tree always hold a reference to thread, hence the tid must
      * be release before cleanup of thread
@@ -567,6 +579,36 @@ rt_inline void _clear_child_tid(rt_thread_t thread)
     }
 }
 
+#ifdef ARCH_MM_MMU
+/**
+ * Resume the parent suspended in vfork(), which is called on execve() with a
+ * new aspace installed, or by the last thread on exit.
+ */
+void lwp_vfork_release(struct rt_lwp *lwp)
+{
+    struct rt_semaphore *done;
+    struct rt_lwp *parent;
+
+    LWP_LOCK(lwp);
+    done = lwp->vfork_done;
+    parent = lwp->vfork_parent;
+    lwp->vfork_done = RT_NULL;
+    lwp->vfork_parent = RT_NULL;
+    LWP_UNLOCK(lwp);
+
+    /* the parent may have been killed and stopped waiting */
+    if (done)
+    {
+        rt_sem_release(done);
+    }
+    /* the aspace is not used any more, the parent can free it now */
+    if (parent)
+    {
+        lwp_ref_dec(parent);
+    }
+}
+#endif /* ARCH_MM_MMU */
+
 void lwp_exit(rt_lwp_t lwp, lwp_status_t status)
 {
     rt_thread_t thread;
@@ -785,13 +827,16 @@ int lwp_getpid(void)
 
 rt_inline void _update_ru(struct rt_lwp *child, struct rt_lwp *self_lwp, struct rusage *uru)
 {
-    struct rusage rt_rusage;
+    struct rusage rt_rusage = {0};
     if (uru != RT_NULL)
     {
         rt_rusage.ru_stime.tv_sec = child->rt_rusage.ru_stime.tv_sec;
         rt_rusage.ru_stime.tv_usec = child->rt_rusage.ru_stime.tv_usec;
         rt_rusage.ru_utime.tv_sec = child->rt_rusage.ru_utime.tv_sec;
         rt_rusage.ru_utime.tv_usec = child->rt_rusage.ru_utime.tv_usec;
+#ifdef ARCH_MM_MMU
+        rt_rusage.ru_minflt = rt_atomic_load(&child->fault_count);
+#endif
         lwp_data_put(self_lwp, uru, &rt_rusage, sizeof(*uru));
     }
 }
@@ -1284,6 +1329,35 @@ long list_process(void)
 }
 MSH_CMD_EXPORT(list_process, list process);
 
+#ifdef ARCH_MM_MMU
+long list_fault(void)
+{
+    int index;
+    int maxlen = RT_NAME_MAX;
+
+    rt_kprintf("%-*.s %-*.s     faults     around\n", 4, "PID", maxlen, "CMD");
+    object_split(4);rt_kprintf(" ");object_split(maxlen);rt_kprintf(" ");
+    rt_kprintf("---------- ----------\n");
+
+    lwp_pid_lock_take();
+    for (index = 0; index < RT_LWP_MAX_NR; index++)
+    {
+        struct rt_lwp *lwp = (struct rt_lwp *)lwp_pid_ary[index].data;
+
+        if (lwp)
+        {
+            rt_kprintf("%4d %-*.*s %10ld %10ld\n", lwp_to_pid(lwp), maxlen, RT_NAME_MAX, lwp->cmd,
+                       (long)rt_atomic_load(&lwp->fault_count),
+                       (long)rt_atomic_load(&lwp->fault_around_count));
+        }
+    }
+    lwp_pid_lock_release();
+
+    return 0;
+}
+MSH_CMD_EXPORT(list_fault, list page faults and the pages mapped around of process);
+#endif /* ARCH_MM_MMU */
+
 static void cmd_kill(int argc, char** argv)
 {
     int pid;
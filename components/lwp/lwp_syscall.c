@@ -16,6 +16,10 @@
  * 2023-11-16     xqyjlj       fix some syscalls (about sched_*, get/setpriority)
  * 2023-11-17     xqyjlj       add process group and session support
  * 2023-11-30     Shell        Fix sys_setitimer() and exit(status)
+ * 2026-10-19     agent        Support madvise() on fault-around
+ * 2026-10-19     agent        Add vfork() fast path without aspace duplication
+ * 2026-10-19     agent        Keep the pages of vdso data on exec() and clock_settime()
+ * 2026-10-19     agent        Add the system call ring, fix the buffer of recv()
  */
 #define __RT_IPC_SOURCE__
 #define _GNU_SOURCE
@@ -40,6 +44,7 @@
 #include <mm_aspace.h>
 #include <lwp_user_mm.h>
 #include <lwp_arch.h>
+#include <lwp_vdso.h>
 #endif
 
 #include <fcntl.h>
@@ -1245,7 +1250,17 @@ void *sys_mremap(void *old_address, size_t old_size,
 
 sysret_t sys_madvise(void *addr, size_t len, int behav)
 {
-    return -ENOSYS;
+    switch (behav)
+    {
+    case POSIX_MADV_NORMAL:
+    case POSIX_MADV_SEQUENTIAL:
+    case POSIX_MADV_WILLNEED:
+        return lwp_mm_fault_around(lwp_self(), addr, len, RT_TRUE);
+    case POSIX_MADV_RANDOM:
+        return lwp_mm_fault_around(lwp_self(), addr, len, RT_FALSE);
+    default:
+        return -ENOSYS;
+    }
 }
 #endif
 
@@ -1826,6 +1841,8 @@ fail:
 
 #ifdef ARCH_MM_MMU
 
+static sysret_t _fork_process(void *user_stack, void (*exit_entry)(void), rt_bool_t borrow_vm);
+
 long _sys_clone(void *arg[])
 {
     struct rt_lwp *lwp = 0;
@@ -1850,6 +1867,15 @@ long _sys_clone(void *arg[])
     }
 
     flags = (unsigned long)(size_t)arg[0];
+    if ((flags & (CLONE_VM | CLONE_VFORK | CLONE_THREAD)) == (CLONE_VM | CLONE_VFORK))
+    {
+        /* posix_spawn() from musl, a process runs on the given stack */
+        if (!arg[1])
+        {
+            return -EINVAL;
+        }
+        return _fork_process(arg[1], arch_clone_exit, RT_TRUE);
+    }
     if ((flags & (CLONE_VM | CLONE_FS | CLONE_FILES | CLONE_THREAD | CLONE_SYSVSEM))
             != (CLONE_VM | CLONE_FS | CLONE_FILES | CLONE_THREAD | CLONE_SYSVSEM))
     {
@@ -2023,7 +2049,13 @@ static int lwp_copy_files(struct rt_lwp *dst, struct rt_lwp *src)
     return -RT_ERROR;
 }
 
-sysret_t _sys_fork(void)
+/**
+ * Create a child process running on user_stack, or the stack of caller if it's
+ * RT_NULL. With borrow_vm, the child borrows the aspace of parent instead of a
+ * duplication, and the parent is suspended until the child calls execve() or
+ * exits. So a fork then exec never pays for the mappings of parent.
+ */
+static sysret_t _fork_process(void *user_stack, void (*exit_entry)(void), rt_bool_t borrow_vm)
 {
     int tid = 0;
     sysret_t falival = 0;
@@ -2031,8 +2063,9 @@ sysret_t _sys_fork(void)
     struct rt_lwp *self_lwp = RT_NULL;
     rt_thread_t thread = RT_NULL;
     rt_thread_t self_thread = RT_NULL;
-    void *user_stack = RT_NULL;
     rt_processgroup_t group;
+    struct rt_semaphore vfork_done;
+    pid_t pid;
 
     /* new lwp */
     lwp = lwp_create(LWP_CREATE_FLAG_ALLOC_PID);
@@ -2049,20 +2082,23 @@ sysret_t _sys_fork(void)
         goto fail;
     }
 
-    /* user space init */
-    if (lwp_user_space_init(lwp, 1) != 0)
-    {
-        SET_ERRNO(ENOMEM);
-        goto fail;
-    }
-
     self_lwp = lwp_self();
 
-    /* copy address space of process from this proc to forked one */
-    if (lwp_fork_aspace(lwp, self_lwp) != 0)
+    if (!borrow_vm)
     {
-        SET_ERRNO(ENOMEM);
-        goto fail;
+        /* user space init */
+        if (lwp_user_space_init(lwp, 1) != 0)
+        {
+            SET_ERRNO(ENOMEM);
+            goto fail;
+        }
+
+        /* copy address space of process from this proc to forked one */
+        if (lwp_fork_aspace(lwp, self_lwp) != 0)
+        {
+            SET_ERRNO(ENOMEM);
+            goto fail;
+        }
     }
 
     /* copy lwp struct data */
@@ -2100,6 +2136,17 @@ sysret_t _sys_fork(void)
     thread->lwp = (void *)lwp;
     thread->tid = tid;
 
+    if (borrow_vm)
+    {
+        /* nothing can fail from here, the aspace is never freed by child */
+        rt_sem_init(&vfork_done, "vfork", 0, RT_IPC_FLAG_FIFO);
+        lwp->aspace = self_lwp->aspace;
+        lwp->vfork_done = &vfork_done;
+        /* the aspace is freed with parent, which is kept until it is given back */
+        lwp_ref_inc(self_lwp);
+        lwp->vfork_parent = self_lwp;
+    }
+
     LWP_LOCK(self_lwp);
     /* add thread to lwp process */
     rt_list_insert_after(&lwp->t_grp, &thread->sibling);
@@ -2125,13 +2172,54 @@ sysret_t _sys_fork(void)
     /* duplicate user objects */
     lwp_user_object_dup(lwp, self_lwp);
 
-    user_stack = arch_get_user_sp();
-    arch_set_thread_context(arch_fork_exit,
+    if (!user_stack)
+    {
+        user_stack = arch_get_user_sp();
+    }
+    arch_set_thread_context(exit_entry,
             (void *)((char *)thread->stack_addr + thread->stack_size),
             user_stack, &thread->sp);
 
+    /* the child may have gone as soon as it starts */
+    pid = lwp_to_pid(lwp);
+    if (borrow_vm)
+    {
+        /* kept to withdraw from waiting for it */
+        lwp_ref_inc(lwp);
+#ifdef LWP_USING_VDSO
+        lwp_vdso_vfork(self_lwp, RT_TRUE);
+#endif /* LWP_USING_VDSO */
+    }
     rt_thread_startup(thread);
-    return lwp_to_pid(lwp);
+
+    if (borrow_vm)
+    {
+        rt_bool_t borrowed = RT_FALSE;
+
+        if (rt_sem_take_killable(&vfork_done, RT_WAITING_FOREVER) != RT_EOK)
+        {
+            /**
+             * killed, stop waiting while the child may still run in the
+             * borrowed aspace, which is kept by the reference of child
+             */
+            LWP_LOCK(lwp);
+            borrowed = lwp->vfork_done == &vfork_done;
+            lwp->vfork_done = RT_NULL;
+            LWP_UNLOCK(lwp);
+
+            /* the child is releasing it right now */
+            if (!borrowed)
+                rt_sem_take(&vfork_done, RT_WAITING_FOREVER);
+        }
+        rt_sem_detach(&vfork_done);
+        lwp_ref_dec(lwp);
+#ifdef LWP_USING_VDSO
+        /* the process data stays shared if the child still borrows the aspace */
+        if (!borrowed)
+            lwp_vdso_vfork(self_lwp, RT_FALSE);
+#endif /* LWP_USING_VDSO */
+    }
+    return pid;
 fail:
     falival = GET_ERRNO();
 
@@ -2150,6 +2238,16 @@ fail:
     return falival;
 }
 
+sysret_t _sys_fork(void)
+{
+    return _fork_process(RT_NULL, arch_fork_exit, RT_FALSE);
+}
+
+sysret_t _sys_vfork(void)
+{
+    return _fork_process(RT_NULL, arch_fork_exit, RT_TRUE);
+}
+
 /* arm needs to wrap fork/clone call to preserved lr & caller saved regs */
 
 rt_weak sysret_t sys_fork(void)
@@ -2159,7 +2257,7 @@ rt_weak sysret_t sys_fork(void)
 
 rt_weak sysret_t sys_vfork(void)
 {
-    return sys_fork();
+    return _sys_vfork();
 }
 
 struct process_aux *lwp_argscopy(struct rt_lwp *lwp, int argc, char **argv, char **envp);
@@ -2711,6 +2809,16 @@ sysret_t sys_execve(const char *path, char *const argv[], char *const envp[])
         _swap_lwp_data(lwp, new_lwp, struct rt_aspace *, aspace);
 
         _swap_lwp_data(lwp, new_lwp, size_t, end_heap);
+#ifdef LWP_USING_VDSO
+        _swap_lwp_data(lwp, new_lwp, void *, vdso_data);
+        _swap_lwp_data(lwp, new_lwp, void *, vdso_proc);
+        _swap_lwp_data(lwp, new_lwp, struct rt_vdso_proc *, vdso_kproc);
+        lwp_vdso_proc_update(lwp);
+#endif /* LWP_USING_VDSO */
+#ifdef LWP_USING_SYSRING
+        /* the ring goes with the old user space */
+        _swap_lwp_data(lwp, new_lwp, struct lwp_sysring *, sysring);
+#endif /* LWP_USING_SYSRING */
 #endif
         _swap_lwp_data(lwp, new_lwp, uint8_t, lwp_type);
         _swap_lwp_data(lwp, new_lwp, void *, text_entry);
@@ -2730,6 +2838,13 @@ sysret_t sys_execve(const char *path, char *const argv[], char *const envp[])
 
         lwp_aspace_switch(thread);
 
+        if (lwp->vfork_parent)
+        {
+            /* the old aspace is borrowed from parent of vfork() */
+            new_lwp->aspace = RT_NULL;
+            lwp_vfork_release(lwp);
+        }
+
         lwp_ref_dec(new_lwp);
         arch_start_umode(lwp->args,
                 lwp->text_entry,
@@ -3489,8 +3604,9 @@ sysret_t sys_listen(int socket, int backlog)
 #define MUSLC_MSG_DONTWAIT  0x0040
 #define MUSLC_MSG_WAITALL   0x0100
 #define MUSLC_MSG_MORE      0x8000
+#define MUSLC_MSG_WAITFORONE 0x10000
 
-static int netflags_muslc_2_lwip(int flags)
+int netflags_muslc_2_lwip(int flags)
 {
     int flgs = 0;
 
@@ -3514,6 +3630,10 @@ static int netflags_muslc_2_lwip(int flags)
     {
         flgs |= MSG_MORE;
     }
+    if (flags & MUSLC_MSG_WAITFORONE)
+    {
+        flgs |= MSG_WAITFORONE;
+    }
     return flgs;
 }
 
@@ -3744,7 +3864,7 @@ sysret_t sys_recv(int socket, void *mem, size_t len, int flags)
     if (!lwp_user_accessable((void *)mem, len))
         return -EFAULT;
 
-    kmem = kmem_get(sizeof(*kmem));
+    kmem = kmem_get(len);
     if (kmem == RT_NULL)
     {
         return -ENOMEM;
@@ -3753,7 +3873,8 @@ sysret_t sys_recv(int socket, void *mem, size_t len, int flags)
     flgs = netflags_muslc_2_lwip(flags);
     ret = recvfrom(socket, kmem, len, flgs, NULL, NULL);
 
-    lwp_put_to_user((void *)mem, kmem, len);
+    if (ret > 0)
+        lwp_put_to_user((void *)mem, kmem, ret);
     kmem_put(kmem);
 
     return (ret < 0 ? GET_ERRNO() : ret);
@@ -3810,6 +3931,223 @@ sysret_t sys_sendmsg(int socket, const struct msghdr *msg, int flags)
     return (ret < 0 ? GET_ERRNO() : ret);
 }
 
+/* the same limit of the message vector as Linux UIO_MAXIOV */
+#define LWP_MMSG_VLEN_MAX   1024
+
+#ifdef ARCH_MM_MMU
+struct mmsg_user
+{
+    struct iovec *uiov;
+    void *msg_control;
+};
+
+static int copy_mmsghdr_from_user(struct mmsghdr *kmsgvec, struct mmsg_user *uvec,
+        struct mmsghdr *umsgvec, unsigned int vlen)
+{
+    int ret = 0;
+    unsigned int i;
+
+    for (i = 0; i < vlen; i++)
+    {
+        ret = copy_msghdr_from_user(&kmsgvec[i].msg_hdr, &umsgvec[i].msg_hdr,
+                &uvec[i].uiov, &uvec[i].msg_control);
+        if (ret)
+        {
+            break;
+        }
+    }
+
+    if (ret)
+    {
+        /* release the messages which have been copied */
+        while (i--)
+        {
+            kmem_put(kmsgvec[i].msg_hdr.msg_iov->iov_base);
+            kmem_put(kmsgvec[i].msg_hdr.msg_iov);
+        }
+    }
+
+    return ret;
+}
+
+static void free_mmsghdr(struct mmsghdr *kmsgvec, unsigned int vlen)
+{
+    for (unsigned int i = 0; i < vlen; i++)
+    {
+        kmem_put(kmsgvec[i].msg_hdr.msg_iov->iov_base);
+        kmem_put(kmsgvec[i].msg_hdr.msg_iov);
+    }
+    kmem_put(kmsgvec);
+}
+#endif /* ARCH_MM_MMU */
+
+sysret_t sys_recvmmsg(int socket, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+        struct timespec *timeout)
+{
+    int flgs, ret = -1;
+    struct timespec ktimeout;
+#ifdef ARCH_MM_MMU
+    struct mmsghdr *kmsgvec;
+    struct mmsg_user *uvec;
+#endif
+
+    /* nothing to transfer, the vector is not touched */
+    if (vlen == 0)
+    {
+        return 0;
+    }
+
+    if (!msgvec)
+    {
+        return -EFAULT;
+    }
+
+    if (vlen > LWP_MMSG_VLEN_MAX)
+    {
+        vlen = LWP_MMSG_VLEN_MAX;
+    }
+
+    if (timeout)
+    {
+        if (!lwp_user_accessable(timeout, sizeof(*timeout)))
+        {
+            return -EFAULT;
+        }
+        lwp_get_from_user(&ktimeout, timeout, sizeof(ktimeout));
+    }
+
+    flgs = netflags_muslc_2_lwip(flags);
+
+#ifdef ARCH_MM_MMU
+    if (!lwp_user_accessable(msgvec, sizeof(*msgvec) * vlen))
+    {
+        return -EFAULT;
+    }
+
+    kmsgvec = kmem_get((sizeof(*kmsgvec) + sizeof(*uvec)) * vlen);
+    if (!kmsgvec)
+    {
+        return -ENOMEM;
+    }
+    uvec = (struct mmsg_user *)(kmsgvec + vlen);
+
+    ret = copy_mmsghdr_from_user(kmsgvec, uvec, msgvec, vlen);
+    if (ret)
+    {
+        kmem_put(kmsgvec);
+        return ret;
+    }
+
+    /* one call to SAL for the whole vector */
+    ret = recvmmsg(socket, kmsgvec, vlen, flgs, timeout ? &ktimeout : RT_NULL);
+
+    for (int i = 0; i < ret; ++i)
+    {
+        struct msghdr *kmsg = &kmsgvec[i].msg_hdr;
+        struct iovec *kiov = kmsg->msg_iov, *uiov = uvec[i].uiov;
+        size_t left = kmsgvec[i].msg_len, len;
+
+        /* only the received bytes of a datagram are copied back */
+        for (int j = 0; j < kmsg->msg_iovlen && left > 0; ++j)
+        {
+            len = kiov->iov_len < left ? kiov->iov_len : left;
+            lwp_put_to_user(uiov->iov_base, kiov->iov_base, len);
+            left -= len;
+
+            ++kiov;
+            ++uiov;
+        }
+
+        lwp_put_to_user(uvec[i].msg_control, kmsg->msg_control, kmsg->msg_controllen);
+        lwp_put_to_user(&msgvec[i].msg_hdr.msg_flags, &kmsg->msg_flags, sizeof(kmsg->msg_flags));
+        lwp_put_to_user(&msgvec[i].msg_len, &kmsgvec[i].msg_len, sizeof(kmsgvec[i].msg_len));
+    }
+
+    free_mmsghdr(kmsgvec, vlen);
+#else
+    ret = recvmmsg(socket, msgvec, vlen, flgs, timeout ? &ktimeout : RT_NULL);
+#endif /* ARCH_MM_MMU */
+
+    return (ret < 0 ? GET_ERRNO() : ret);
+}
+
+sysret_t sys_sendmmsg(int socket, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+    int flgs, ret = -1;
+#ifdef ARCH_MM_MMU
+    struct mmsghdr *kmsgvec;
+    struct mmsg_user *uvec;
+#endif
+
+    /* nothing to transfer, the vector is not touched */
+    if (vlen == 0)
+    {
+        return 0;
+    }
+
+    if (!msgvec)
+    {
+        return -EFAULT;
+    }
+
+    if (vlen > LWP_MMSG_VLEN_MAX)
+    {
+        vlen = LWP_MMSG_VLEN_MAX;
+    }
+
+    flgs = netflags_muslc_2_lwip(flags);
+
+#ifdef ARCH_MM_MMU
+    if (!lwp_user_accessable(msgvec, sizeof(*msgvec) * vlen))
+    {
+        return -EFAULT;
+    }
+
+    kmsgvec = kmem_get((sizeof(*kmsgvec) + sizeof(*uvec)) * vlen);
+    if (!kmsgvec)
+    {
+        return -ENOMEM;
+    }
+    uvec = (struct mmsg_user *)(kmsgvec + vlen);
+
+    ret = copy_mmsghdr_from_user(kmsgvec, uvec, msgvec, vlen);
+    if (ret)
+    {
+        kmem_put(kmsgvec);
+        return ret;
+    }
+
+    for (unsigned int i = 0; i < vlen; ++i)
+    {
+        struct msghdr *kmsg = &kmsgvec[i].msg_hdr;
+        struct iovec *kiov = kmsg->msg_iov, *uiov = uvec[i].uiov;
+
+        for (int j = 0; j < kmsg->msg_iovlen; ++j)
+        {
+            lwp_get_from_user(kiov->iov_base, uiov->iov_base, kiov->iov_len);
+
+            ++kiov;
+            ++uiov;
+        }
+
+        lwp_get_from_user(kmsg->msg_control, uvec[i].msg_control, kmsg->msg_controllen);
+    }
+
+    ret = sendmmsg(socket, kmsgvec, vlen, flgs);
+
+    for (int i = 0; i < ret; ++i)
+    {
+        lwp_put_to_user(&msgvec[i].msg_len, &kmsgvec[i].msg_len, sizeof(kmsgvec[i].msg_len));
+    }
+
+    free_mmsghdr(kmsgvec, vlen);
+#else
+    ret = sendmmsg(socket, msgvec, vlen, flgs);
+#endif /* ARCH_MM_MMU */
+
+    return (ret < 0 ? GET_ERRNO() : ret);
+}
+
 sysret_t sys_sendto(int socket, const void *dataptr, size_t size, int flags,
     const struct musl_sockaddr *to, socklen_t tolen)
 {
@@ -7082,6 +7420,15 @@ const static struct rt_syscall_def func_table[] =
     SYSCALL_SIGN(sys_getppid),
     SYSCALL_SIGN(sys_fchdir),
     SYSCALL_SIGN(sys_chown),
+    SYSCALL_NET(SYSCALL_SIGN(sys_recvmmsg)),            /* 215 */
+    SYSCALL_NET(SYSCALL_SIGN(sys_sendmmsg)),
+#ifdef LWP_USING_SYSRING
+    SYSCALL_SIGN(sys_sysring_setup),
+    SYSCALL_SIGN(sys_sysring_enter),
+#else
+    SYSCALL_SIGN(sys_notimpl),
+    SYSCALL_SIGN(sys_notimpl),
+#endif /* LWP_USING_SYSRING */
 };
 
 const void *lwp_get_sys_api(rt_uint32_t number)
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2019-11-12     Jesven       the first version
+ * 2026-10-19     agent        add the system call ring
  */
 
 #ifndef __LWP_SYSCALL_H__
@@ -116,6 +117,19 @@ sysret_t sys_getsid(pid_t pid);
 sysret_t sys_setpgid(pid_t pid, pid_t pgid);
 sysret_t sys_getpgid(pid_t pid);
 
+sysret_t sys_fsync(int fd);
+
+#if defined(RT_USING_SAL) && defined(SAL_USING_POSIX)
+int netflags_muslc_2_lwip(int flags);
+sysret_t sys_send(int socket, const void *dataptr, size_t size, int flags);
+sysret_t sys_recv(int socket, void *mem, size_t len, int flags);
+#endif
+
+#ifdef LWP_USING_SYSRING
+sysret_t sys_sysring_setup(unsigned int entries, void **uaddr);
+sysret_t sys_sysring_enter(unsigned int to_submit, unsigned int flags);
+#endif /* LWP_USING_SYSRING */
+
 
 #ifdef __cplusplus
 }
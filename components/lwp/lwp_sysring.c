@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef LWP_USING_SYSRING
+
+#define DBG_TAG "lwp.sysring"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+#include <mm_aspace.h>
+#include <mm_page.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "lwp_internal.h"
+#include "lwp_syscall.h"
+#include "lwp_sysring.h"
+
+#if defined(RT_USING_SAL) && defined(SAL_USING_POSIX)
+#include <sys/socket.h>
+#endif
+
+#define SYSRING_HEAD_SIZE   RT_ALIGN(sizeof(struct rt_sysring_head), 64)
+#define SYSRING_KBUF_SIZE   ARCH_PAGE_SIZE
+
+static void _sysring_destroy(struct lwp_sysring *ring)
+{
+    rt_pages_free(ring->head, ring->size_bits);
+    rt_pages_free(ring->kbuf, 0);
+    rt_mutex_detach(&ring->lock);
+    rt_free(ring);
+}
+
+static struct lwp_sysring *_sysring_create(struct rt_lwp *lwp, rt_uint32_t entries)
+{
+    struct lwp_sysring *ring;
+    rt_size_t size;
+
+    size = SYSRING_HEAD_SIZE + entries * (sizeof(struct rt_sysring_sqe) + sizeof(struct rt_sysring_cqe));
+
+    ring = rt_calloc(1, sizeof(*ring));
+    if (!ring)
+        return RT_NULL;
+
+    ring->size_bits = rt_page_bits(size);
+    ring->head = rt_pages_alloc_ext(ring->size_bits, PAGE_ANY_AVAILABLE);
+    ring->kbuf = rt_pages_alloc_ext(0, PAGE_ANY_AVAILABLE);
+    if (!ring->head || !ring->kbuf)
+    {
+        if (ring->head)
+            rt_pages_free(ring->head, ring->size_bits);
+        if (ring->kbuf)
+            rt_pages_free(ring->kbuf, 0);
+        rt_free(ring);
+        return RT_NULL;
+    }
+    rt_memset(ring->head, 0, ARCH_PAGE_SIZE << ring->size_bits);
+
+    ring->lwp = lwp;
+    ring->entries = entries;
+    ring->head->entries = entries;
+    ring->head->sqe_off = SYSRING_HEAD_SIZE;
+    ring->head->cqe_off = SYSRING_HEAD_SIZE + entries * sizeof(struct rt_sysring_sqe);
+    ring->sqes = (struct rt_sysring_sqe *)((char *)ring->head + ring->head->sqe_off);
+    ring->cqes = (struct rt_sysring_cqe *)((char *)ring->head + ring->head->cqe_off);
+    rt_mutex_init(&ring->lock, "sysring", RT_IPC_FLAG_PRIO);
+
+    return ring;
+}
+
+int lwp_sysring_setup(struct rt_lwp *lwp, unsigned int entries)
+{
+    struct lwp_sysring *ring;
+    rt_uint32_t nr = 1;
+    int err = 0;
+
+    if (!entries || entries > RT_SYSRING_ENTRIES_MAX)
+        return -EINVAL;
+    /* the aspace borrowed by vfork() is given back before the ring is freed */
+    if (lwp->vfork_parent)
+        return -EPERM;
+
+    while (nr < entries)
+        nr <<= 1;
+
+    ring = _sysring_create(lwp, nr);
+    if (!ring)
+        return -ENOMEM;
+
+    ring->uaddr = lwp_map_user_phy(lwp, RT_NULL, rt_kmem_v2p(ring->head),
+                                   ARCH_PAGE_SIZE << ring->size_bits, 1);
+    if (!ring->uaddr)
+    {
+        _sysring_destroy(ring);
+        return -ENOMEM;
+    }
+
+    LWP_LOCK(lwp);
+    if (lwp->sysring)
+        err = -EBUSY;
+    else
+        lwp->sysring = ring;
+    LWP_UNLOCK(lwp);
+
+    if (err)
+    {
+        lwp_unmap_user_phy(lwp, ring->uaddr);
+        _sysring_destroy(ring);
+    }
+    return err;
+}
+
+/* a bounce buffer of len, in the ring for small I/O */
+static void *_kbuf_get(struct lwp_sysring *ring, rt_size_t len)
+{
+    return len <= SYSRING_KBUF_SIZE ? ring->kbuf : rt_malloc(len);
+}
+
+static void _kbuf_put(struct lwp_sysring *ring, void *kbuf)
+{
+    if (kbuf != ring->kbuf)
+        rt_free(kbuf);
+}
+
+static int _do_read(struct lwp_sysring *ring, struct rt_sysring_sqe *sqe, rt_bool_t is_recv)
+{
+    void *uaddr = (void *)(rt_ubase_t)sqe->addr;
+    void *kbuf;
+    int ret;
+
+    if (!lwp_user_accessible_ext(ring->lwp, uaddr, sqe->len))
+        return -EFAULT;
+    kbuf = _kbuf_get(ring, sqe->len);
+    if (!kbuf)
+        return -ENOMEM;
+
+#if defined(RT_USING_SAL) && defined(SAL_USING_POSIX)
+    if (is_recv)
+        ret = recvfrom(sqe->fd, kbuf, sqe->len, netflags_muslc_2_lwip(sqe->op_flags), RT_NULL, RT_NULL);
+    else
+#endif
+        ret = read(sqe->fd, kbuf, sqe->len);
+
+    if (ret < 0)
+        ret = GET_ERRNO();
+    else if (ret > 0 && lwp_data_put(ring->lwp, uaddr, kbuf, ret) != (size_t)ret)
+        ret = -EFAULT;
+
+    _kbuf_put(ring, kbuf);
+    return ret;
+}
+
+static int _do_write(struct lwp_sysring *ring, struct rt_sysring_sqe *sqe, rt_bool_t is_send)
+{
+    void *uaddr = (void *)(rt_ubase_t)sqe->addr;
+    void *kbuf;
+    int ret;
+
+    if (!lwp_user_accessible_ext(ring->lwp, uaddr, sqe->len))
+        return -EFAULT;
+    kbuf = _kbuf_get(ring, sqe->len);
+    if (!kbuf)
+        return -ENOMEM;
+
+    if (lwp_data_get(ring->lwp, kbuf, uaddr, sqe->len) != sqe->len)
+    {
+        _kbuf_put(ring, kbuf);
+        return -EFAULT;
+    }
+
+#if defined(RT_USING_SAL) && defined(SAL_USING_POSIX)
+    if (is_send)
+        ret = sendto(sqe->fd, kbuf, sqe->len, netflags_muslc_2_lwip(sqe->op_flags), RT_NULL, 0);
+    else
+#endif
+        ret = write(sqe->fd, kbuf, sqe->len);
+
+    if (ret < 0)
+        ret = GET_ERRNO();
+
+    _kbuf_put(ring, kbuf);
+    return ret;
+}
+
+static int _do_poll(struct rt_sysring_sqe *sqe)
+{
+    struct pollfd pfd;
+    int ret;
+
+    pfd.fd = sqe->fd;
+    pfd.events = sqe->op_flags;
+    pfd.revents = 0;
+
+    ret = poll(&pfd, 1, (int32_t)sqe->len);
+    if (ret < 0)
+        return GET_ERRNO();
+    return ret ? pfd.revents : 0;
+}
+
+static int _sysring_do(struct lwp_sysring *ring, struct rt_sysring_sqe *sqe)
+{
+    int ret;
+
+    switch (sqe->opcode)
+    {
+    case RT_SYSRING_OP_NOP:
+        ret = 0;
+        break;
+    case RT_SYSRING_OP_READ:
+        ret = _do_read(ring, sqe, RT_FALSE);
+        break;
+    case RT_SYSRING_OP_WRITE:
+        ret = _do_write(ring, sqe, RT_FALSE);
+        break;
+#if defined(RT_USING_SAL) && defined(SAL_USING_POSIX)
+    case RT_SYSRING_OP_SEND:
+        ret = _do_write(ring, sqe, RT_TRUE);
+        break;
+    case RT_SYSRING_OP_RECV:
+        ret = _do_read(ring, sqe, RT_TRUE);
+        break;
+#endif
+    case RT_SYSRING_OP_POLL:
+        ret = _do_poll(sqe);
+        break;
+    case RT_SYSRING_OP_FSYNC:
+        ret = sys_fsync(sqe->fd);
+        break;
+    default:
+        ret = -EINVAL;
+        break;
+    }
+
+    return ret;
+}
+
+int lwp_sysring_enter(struct rt_lwp *lwp, unsigned int to_submit)
+{
+    struct lwp_sysring *ring = lwp->sysring;
+    struct rt_sysring_head *head;
+    struct rt_sysring_sqe sqe;
+    struct rt_sysring_cqe *cqe;
+    rt_uint32_t mask, avail, done;
+
+    if (!ring)
+        return -ENXIO;
+
+    if (rt_mutex_take_interruptible(&ring->lock, RT_WAITING_FOREVER) != RT_EOK)
+        return -EINTR;
+
+    head = ring->head;
+    mask = ring->entries - 1;
+
+    /* the indexes written by user are never trusted */
+    avail = __atomic_load_n(&head->sq_tail, __ATOMIC_ACQUIRE) - ring->sq_head;
+    if (avail > ring->entries)
+    {
+        rt_mutex_release(&ring->lock);
+        return -EINVAL;
+    }
+    if (to_submit > avail)
+        to_submit = avail;
+
+    for (done = 0; done < to_submit; done++)
+    {
+        /* no room to post the completion */
+        if (ring->cq_tail - __atomic_load_n(&head->cq_head, __ATOMIC_ACQUIRE) > mask)
+            break;
+
+        /* a copy, which is not changed by user under the call */
+        sqe = ring->sqes[ring->sq_head & mask];
+        ring->sq_head++;
+        __atomic_store_n(&head->sq_head, ring->sq_head, __ATOMIC_RELEASE);
+
+        cqe = &ring->cqes[ring->cq_tail & mask];
+        cqe->res = _sysring_do(ring, &sqe);
+        cqe->user_data = sqe.user_data;
+        cqe->flags = 0;
+        ring->cq_tail++;
+        __atomic_store_n(&head->cq_tail, ring->cq_tail, __ATOMIC_RELEASE);
+
+        /* back to user for the signal */
+        if (cqe->res == -EINTR)
+        {
+            done++;
+            break;
+        }
+    }
+
+    rt_mutex_release(&ring->lock);
+
+    return (done || !to_submit) ? (int)done : -EBUSY;
+}
+
+void lwp_sysring_fork(struct rt_lwp *dst, struct rt_lwp *src)
+{
+    struct lwp_sysring *ring = src->sysring;
+
+    /* the pages of ring are duplicated into child, drop them */
+    if (ring)
+        rt_aspace_unmap_range(dst->aspace, ring->uaddr, ARCH_PAGE_SIZE << ring->size_bits);
+}
+
+void lwp_sysring_free(struct rt_lwp *lwp)
+{
+    if (lwp->sysring)
+    {
+        _sysring_destroy(lwp->sysring);
+        lwp->sysring = RT_NULL;
+    }
+}
+
+sysret_t sys_sysring_setup(unsigned int entries, void **uaddr)
+{
+    struct rt_lwp *lwp = lwp_self();
+    int err;
+
+    if (!lwp_user_accessable(uaddr, sizeof(*uaddr)))
+        return -EFAULT;
+
+    err = lwp_sysring_setup(lwp, entries);
+    if (!err)
+        lwp_put_to_user(uaddr, &lwp->sysring->uaddr, sizeof(*uaddr));
+
+    return err;
+}
+
+sysret_t sys_sysring_enter(unsigned int to_submit, unsigned int flags)
+{
+    if (flags)
+        return -EINVAL;
+
+    return lwp_sysring_enter(lwp_self(), to_submit);
+}
+
+#endif /* LWP_USING_SYSRING */
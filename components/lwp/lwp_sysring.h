@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#ifndef __LWP_SYSRING_H__
+#define __LWP_SYSRING_H__
+
+#include <rtthread.h>
+#include "sysring/sysring_abi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct rt_lwp;
+
+/**
+ * @brief System call ring of a process, in pages of kernel mapped into the
+ * user space of process.
+ */
+struct lwp_sysring
+{
+    struct rt_lwp *lwp;
+    struct rt_mutex lock;           /* one batch at a time */
+
+    struct rt_sysring_head *head;   /* kernel address of the ring */
+    struct rt_sysring_sqe *sqes;
+    struct rt_sysring_cqe *cqes;
+    void *uaddr;                    /* user address of the ring */
+    rt_uint32_t size_bits;
+
+    /* private copies of the fields owned by kernel */
+    rt_uint32_t entries;
+    rt_uint32_t sq_head;
+    rt_uint32_t cq_tail;
+
+    void *kbuf;                     /* bounce buffer of small I/O */
+};
+
+/**
+ * @brief Create the ring of lwp with entries rounded up to a power of 2, and
+ * map it into the user space
+ *
+ * @return int 0 on success, or a negative errno
+ */
+int lwp_sysring_setup(struct rt_lwp *lwp, unsigned int entries);
+
+/**
+ * @brief Consume up to to_submit submissions of the ring of lwp and post
+ * their completions
+ *
+ * @return int the number of submissions consumed, or a negative errno
+ */
+int lwp_sysring_enter(struct rt_lwp *lwp, unsigned int to_submit);
+
+/**
+ * @brief Drop the ring inherited by a forked child, which is never shared
+ */
+void lwp_sysring_fork(struct rt_lwp *dst, struct rt_lwp *src);
+
+/**
+ * @brief Release the ring after the user space is freed
+ */
+void lwp_sysring_free(struct rt_lwp *lwp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LWP_SYSRING_H__ */
@@ -15,6 +15,11 @@
  * 2023-08-29     Shell        Add API accessible()/data_get()/data_set()/data_put()
  * 2023-09-13     Shell        Add lwp_memcpy and support run-time choice of memcpy base on memory attr
  * 2023-09-19     Shell        add lwp_user_memory_remap_to_kernel
+ * 2026-10-19     agent        add lwp_mm_fault_around
+ * 2026-10-19     agent        switch to kernel space without aspace
+ * 2026-10-19     agent        add lwp_pages_detach/attach to move pages between lwp
+ * 2026-10-19     agent        map the pages of vdso data into user space
+ * 2026-10-19     agent        drop the system call ring on fork and exit
  */
 
 #include <rtthread.h>
@@ -24,6 +29,8 @@
 #ifdef ARCH_MM_MMU
 
 #include "lwp_internal.h"
+#include "lwp_vdso.h"
+#include "lwp_sysring.h"
 
 #include <mm_aspace.h>
 #include <mm_fault.h>
@@ -127,6 +134,10 @@ int lwp_user_space_init(struct rt_lwp *lwp, rt_bool_t is_fork)
             err = rt_aspace_map(lwp->aspace, &stk_addr,
                                 USER_STACK_VEND - USER_STACK_VSTART,
                                 MMU_MAP_U_RWCB, flags, &STACK_OBJ, 0);
+#ifdef LWP_USING_VDSO
+            if (err == RT_EOK)
+                err = lwp_vdso_map(lwp);
+#endif /* LWP_USING_VDSO */
         }
     }
 
@@ -139,13 +150,14 @@ void lwp_aspace_switch(struct rt_thread *thread)
     rt_aspace_t aspace;
     void *from_tbl;
 
-    if (thread->lwp)
+    if (thread->lwp && ((struct rt_lwp *)thread->lwp)->aspace)
     {
         lwp = (struct rt_lwp *)thread->lwp;
         aspace = lwp->aspace;
     }
     else
     {
+        /* the aspace borrowed by vfork() is given back on exit */
         aspace = &rt_kernel_space;
     }
 
@@ -160,6 +172,12 @@ void lwp_unmap_user_space(struct rt_lwp *lwp)
 {
     if (lwp->aspace)
         arch_user_space_free(lwp);
+#ifdef LWP_USING_VDSO
+    lwp_vdso_unmap(lwp);
+#endif /* LWP_USING_VDSO */
+#ifdef LWP_USING_SYSRING
+    lwp_sysring_free(lwp);
+#endif /* LWP_USING_SYSRING */
 }
 
 static void *_lwp_map_user(struct rt_lwp *lwp, void *map_va, size_t map_size,
@@ -197,6 +215,14 @@ int lwp_fork_aspace(struct rt_lwp *dest_lwp, struct rt_lwp *src_lwp)
 {
     int err;
     err = rt_aspace_fork(&src_lwp->aspace, &dest_lwp->aspace);
+#ifdef LWP_USING_VDSO
+    if (!err)
+        err = lwp_vdso_fork(dest_lwp, src_lwp);
+#endif /* LWP_USING_VDSO */
+#ifdef LWP_USING_SYSRING
+    if (!err)
+        lwp_sysring_fork(dest_lwp, src_lwp);
+#endif /* LWP_USING_SYSRING */
     if (!err)
     {
         /* do a explicit aspace switch if the page table is changed */
@@ -571,6 +597,177 @@ void *lwp_mremap(struct rt_lwp *lwp, void *old_address, size_t old_size,
     return rt_aspace_mremap_range(lwp->aspace, old_address, old_size, new_size, flags, new_address);
 }
 
+struct _fault_around_arg
+{
+    char *start;
+    char *end;
+    rt_bool_t enable;
+    int count;
+};
+
+static int _set_fault_around(rt_varea_t varea, void *arg)
+{
+    struct _fault_around_arg *fa = arg;
+    char *varea_end = (char *)varea->start + varea->size;
+
+    /* the flag is per varea, a varea partially in the range is taken as a whole */
+    if ((char *)varea->start < fa->end && varea_end > fa->start)
+    {
+        if (fa->enable)
+            varea->flag &= ~MMF_NO_FAULT_AROUND;
+        else
+            varea->flag |= MMF_NO_FAULT_AROUND;
+        fa->count++;
+    }
+    return 0;
+}
+
+int lwp_mm_fault_around(struct rt_lwp *lwp, void *addr, size_t length, rt_bool_t enable)
+{
+    struct _fault_around_arg fa;
+
+    RT_ASSERT(lwp);
+
+    fa.start = (char *)((rt_ubase_t)addr & ~ARCH_PAGE_MASK);
+    fa.end = (char *)addr + length;
+    fa.enable = enable;
+    fa.count = 0;
+    rt_aspace_traversal(lwp->aspace, _set_fault_around, &fa);
+
+    return fa.count ? 0 : -ENOMEM;
+}
+
+/* make the page at va a private frame of the aspace and take a reference */
+static void *_get_owned_page(rt_aspace_t aspace, char *va)
+{
+    struct rt_aspace_fault_msg msg;
+    rt_varea_t varea;
+    void *page = RT_NULL;
+    void *pa;
+
+    RD_LOCK(aspace);
+    varea = rt_aspace_query(aspace, va);
+    pa = rt_hw_mmu_v2p(aspace, va);
+    RD_UNLOCK(aspace);
+
+    if (!varea || !(varea->flag & MMF_MAP_PRIVATE))
+        return RT_NULL;
+
+    /* populate the page, or copy it from the file or the aspace before fork */
+    if (pa == ARCH_MAP_FAILED || varea->mem_obj != aspace->private_object)
+    {
+        msg.fault_op = MM_FAULT_OP_WRITE;
+        msg.fault_type = pa == ARCH_MAP_FAILED ? MM_FAULT_TYPE_PAGE_FAULT : MM_FAULT_TYPE_ACCESS_FAULT;
+        msg.fault_vaddr = va;
+        if (rt_aspace_fault_try_fix(aspace, &msg) != MM_FAULT_FIXABLE_TRUE)
+            return RT_NULL;
+    }
+
+    RD_LOCK(aspace);
+    varea = rt_aspace_query(aspace, va);
+    pa = rt_hw_mmu_v2p(aspace, va);
+    if (varea && varea->mem_obj == aspace->private_object && pa != ARCH_MAP_FAILED)
+    {
+        page = rt_kmem_p2v(pa);
+        rt_page_ref_inc(page, 0);
+    }
+    RD_UNLOCK(aspace);
+
+    return page;
+}
+
+int lwp_pages_detach(struct rt_lwp *lwp, void *uaddr, size_t length, void **pages)
+{
+    char *va = uaddr;
+    void *page, *copy;
+    size_t nr = length >> ARCH_PAGE_SHIFT;
+    size_t i;
+    int err = RT_EOK;
+
+    if (!nr || (((rt_ubase_t)uaddr | length) & ARCH_PAGE_MASK))
+        return -RT_EINVAL;
+
+    for (i = 0; i < nr; i++, va += ARCH_PAGE_SIZE)
+    {
+        page = _get_owned_page(lwp->aspace, va);
+        if (!page)
+        {
+            LOG_I("%s: no private page at %p", __func__, va);
+            err = -RT_EINVAL;
+            break;
+        }
+
+        /* a frame still referenced by other mapping can not be moved */
+        if (rt_page_ref_get(page, 0) > 2)
+        {
+            copy = rt_pages_alloc_ext(0, PAGE_ANY_AVAILABLE);
+            if (copy)
+                rt_memcpy(copy, page, ARCH_PAGE_SIZE);
+            rt_pages_free(page, 0);
+            page = copy;
+            if (!page)
+            {
+                err = -RT_ENOMEM;
+                break;
+            }
+        }
+        pages[i] = page;
+    }
+
+    /* the frames are kept alive by the references taken above */
+    if (err == RT_EOK)
+        err = rt_aspace_unmap_range(lwp->aspace, uaddr, length);
+
+    if (err != RT_EOK)
+        lwp_pages_put(pages, i);
+
+    return err;
+}
+
+int lwp_pages_attach(struct rt_lwp *lwp, void **uaddr, void **pages, size_t nr)
+{
+    rt_aspace_t aspace = lwp->aspace;
+    rt_varea_t varea;
+    void *va = *uaddr;
+    char *iter;
+    size_t i;
+    int err;
+
+    err = rt_aspace_map_private(aspace, &va, nr << ARCH_PAGE_SHIFT, MMU_MAP_U_RWCB,
+                                va ? MMF_MAP_FIXED : 0);
+    if (err == RT_EOK)
+    {
+        WR_LOCK(aspace);
+        varea = rt_aspace_query(aspace, va);
+        for (i = 0, iter = va; i < nr && err == RT_EOK; i++, iter += ARCH_PAGE_SIZE)
+        {
+            err = rt_varea_map_page(varea, iter, pages[i]);
+            if (err == RT_EOK)
+                rt_varea_pgmgr_insert(varea, pages[i]);
+        }
+        WR_UNLOCK(aspace);
+
+        if (err == RT_EOK)
+        {
+            /* the mapping holds the frames now */
+            lwp_pages_put(pages, nr);
+            *uaddr = va;
+        }
+        else
+        {
+            rt_aspace_unmap_range(aspace, va, nr << ARCH_PAGE_SHIFT);
+        }
+    }
+
+    return err;
+}
+
+void lwp_pages_put(void **pages, size_t nr)
+{
+    for (size_t i = 0; i < nr; i++)
+        rt_pages_free(pages[i], 0);
+}
+
 size_t lwp_get_from_user(void *dst, void *src, size_t size)
 {
     struct rt_lwp *lwp = RT_NULL;
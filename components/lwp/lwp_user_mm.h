@@ -8,6 +8,9 @@
  * 2019-10-28     Jesven       first version
  * 2021-02-12     lizhirui     add 64-bit support for lwp_brk
  * 2023-09-19     Shell        add lwp_user_memory_remap_to_kernel
+ * 2026-10-19     agent        add lwp_mm_fault_around
+ * 2026-10-19     agent        map MAP_HUGETLB to MMF_HUGEPAGE
+ * 2026-10-19     agent        add lwp_pages_detach/attach
  */
 #ifndef  __LWP_USER_MM_H__
 #define  __LWP_USER_MM_H__
@@ -59,6 +62,48 @@ int lwp_munmap(struct rt_lwp *lwp, void *addr, size_t length);
 void *lwp_mremap(struct rt_lwp *lwp, void *old_address, size_t old_size,
                     size_t new_size, int flags, void *new_address);
 
+/**
+ * @brief Enable or disable the fault-around of the mappings in a range
+ *
+ * @param lwp target process
+ * @param addr start address of the range
+ * @param length length in bytes of the range
+ * @param enable map the resident neighbours on a read fault or not
+ * @return int errno
+ */
+int lwp_mm_fault_around(struct rt_lwp *lwp, void *addr, size_t length, rt_bool_t enable);
+
+/**
+ * @brief Take the page frames of a page-aligned private buffer away from lwp.
+ * The buffer is unmapped, and each frame is referenced by the pages vector.
+ * A frame shared with other mapping is copied instead.
+ *
+ * @param lwp target process
+ * @param uaddr page-aligned address of the buffer
+ * @param length page-aligned length in bytes of the buffer
+ * @param pages vector of (length >> ARCH_PAGE_SHIFT) entries to fill
+ * @return int errno, nothing is taken on failure
+ */
+int lwp_pages_detach(struct rt_lwp *lwp, void *uaddr, size_t length, void **pages);
+
+/**
+ * @brief Map the page frames detached into a new private mapping of lwp.
+ * The references of the pages vector are given to the mapping on success.
+ *
+ * @param lwp target process
+ * @param uaddr in: the fixed address to map at, or RT_NULL for any address;
+ *        out: the address of the new mapping on success
+ * @param pages frames to map
+ * @param nr number of frames
+ * @return int errno, the references are still held by caller on failure
+ */
+int lwp_pages_attach(struct rt_lwp *lwp, void **uaddr, void **pages, size_t nr);
+
+/**
+ * @brief Drop the references of the page frames detached
+ */
+void lwp_pages_put(void **pages, size_t nr);
+
 /**
  * @brief Test if address from user is accessible address by user
  *
@@ -206,6 +251,8 @@ rt_inline rt_size_t lwp_user_mm_flag_to_kernel(int flags)
         k_flags |= MMF_MAP_PRIVATE;
     if (flags & MAP_SHARED)
         k_flags |= MMF_MAP_SHARED;
+    if (flags & MAP_HUGETLB)
+        k_flags |= MMF_HUGEPAGE;
     return k_flags;
 }
 
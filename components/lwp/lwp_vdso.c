@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef LWP_USING_VDSO
+
+#define DBG_TAG "lwp.vdso"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+#include <ktime.h>
+#include <mm_aspace.h>
+#include <mm_page.h>
+#include <mmu.h>
+
+#include "lwp_internal.h"
+#include "lwp_vdso.h"
+
+/* preferred user addresses, below the pages of aux vector */
+#define VDSO_DATA_VADDR ((void *)(USER_VADDR_TOP - ARCH_PAGE_SIZE * 4))
+#define VDSO_PROC_VADDR ((void *)(USER_VADDR_TOP - ARCH_PAGE_SIZE * 3))
+
+static struct rt_vdso_data *_vdso_data;
+static struct rt_timer _vdso_timer;
+static RT_DEFINE_SPINLOCK(_vdso_lock);
+
+rt_inline void _vdso_write_begin(struct rt_vdso_data *vd)
+{
+    __atomic_store_n(&vd->seq, vd->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+rt_inline void _vdso_write_end(struct rt_vdso_data *vd)
+{
+    __atomic_store_n(&vd->seq, vd->seq + 1, __ATOMIC_RELEASE);
+}
+
+static void _vdso_update(void *param)
+{
+    struct rt_vdso_data *vd = param;
+    struct timespec boot;
+    rt_base_t level;
+
+    rt_ktime_boottime_get_ns(&boot);
+
+    level = rt_spin_lock_irqsave(&_vdso_lock);
+    _vdso_write_begin(vd);
+    vd->tick = rt_tick_get();
+    vd->boot_sec = boot.tv_sec;
+    vd->boot_nsec = boot.tv_nsec;
+    _vdso_write_end(vd);
+    rt_spin_unlock_irqrestore(&_vdso_lock, level);
+}
+
+void lwp_vdso_realtime_sync(void)
+{
+    struct rt_vdso_data *vd = _vdso_data;
+    struct timespec real, boot;
+    int64_t sec, nsec;
+    rt_base_t level;
+
+    if (!vd || clock_gettime(CLOCK_REALTIME, &real) != 0)
+        return;
+    rt_ktime_boottime_get_ns(&boot);
+
+    sec = (int64_t)real.tv_sec - boot.tv_sec;
+    nsec = (int64_t)real.tv_nsec - boot.tv_nsec;
+    if (nsec < 0)
+    {
+        sec--;
+        nsec += RT_VDSO_NSEC_PER_SEC;
+    }
+
+    level = rt_spin_lock_irqsave(&_vdso_lock);
+    _vdso_write_begin(vd);
+    vd->real_sec = sec;
+    vd->real_nsec = nsec;
+    _vdso_write_end(vd);
+    rt_spin_unlock_irqrestore(&_vdso_lock, level);
+}
+
+struct rt_vdso_data *lwp_vdso_data_get(void)
+{
+    return _vdso_data;
+}
+
+static int lwp_vdso_init(void)
+{
+    struct rt_vdso_data *vd;
+
+    vd = rt_pages_alloc_ext(0, PAGE_ANY_AVAILABLE);
+    if (!vd)
+    {
+        LOG_E("%s: no memory for data page", __func__);
+        return -RT_ENOMEM;
+    }
+    rt_memset(vd, 0, ARCH_PAGE_SIZE);
+    vd->tick_per_second = RT_TICK_PER_SECOND;
+    vd->res_nsec = RT_VDSO_NSEC_PER_SEC / RT_TICK_PER_SECOND;
+
+    _vdso_update(vd);
+    _vdso_data = vd;
+    lwp_vdso_realtime_sync();
+
+    /* update it in the tick interrupt, without waking up any thread */
+    rt_timer_init(&_vdso_timer, "vdso", _vdso_update, vd, 1,
+                  RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+    rt_timer_start(&_vdso_timer);
+
+    return RT_EOK;
+}
+INIT_COMPONENT_EXPORT(lwp_vdso_init);
+
+static void *_vdso_map_page(struct rt_lwp *lwp, void *prefer, void *page, rt_bool_t fixed)
+{
+    void *va = RT_NULL;
+    rt_size_t attr;
+    struct rt_mm_va_hint hint = {.flags = fixed ? MMF_MAP_FIXED : 0,
+                                 .limit_range_size = lwp->aspace->size,
+                                 .limit_start = lwp->aspace->start,
+                                 .prefer = prefer,
+                                 .map_size = ARCH_PAGE_SIZE};
+
+    /* readable by the user only */
+    attr = rt_hw_mmu_attr_rm_perm(MMU_MAP_U_RWCB, RT_HW_MMU_PROT_USER | RT_HW_MMU_PROT_WRITE);
+    if (rt_aspace_map_phy(lwp->aspace, &hint, attr, MM_PA_TO_OFF(rt_kmem_v2p(page)), &va) != RT_EOK)
+        va = RT_NULL;
+
+    return va;
+}
+
+static struct rt_vdso_proc *_vdso_proc_alloc(struct rt_lwp *lwp)
+{
+    struct rt_vdso_proc *vp;
+
+    vp = rt_pages_alloc_ext(0, PAGE_ANY_AVAILABLE);
+    if (vp)
+    {
+        rt_memset(vp, 0, ARCH_PAGE_SIZE);
+        vp->pid = lwp->pid;
+    }
+    return vp;
+}
+
+int lwp_vdso_map(struct rt_lwp *lwp)
+{
+    struct rt_vdso_proc *vp;
+    void *data, *proc;
+
+    if (!_vdso_data)
+        return RT_EOK;
+
+    vp = _vdso_proc_alloc(lwp);
+    if (!vp)
+        return -RT_ENOMEM;
+
+    data = _vdso_map_page(lwp, VDSO_DATA_VADDR, _vdso_data, RT_FALSE);
+    proc = data ? _vdso_map_page(lwp, VDSO_PROC_VADDR, vp, RT_FALSE) : RT_NULL;
+    if (!proc)
+    {
+        if (data)
+            rt_aspace_unmap_range(lwp->aspace, data, ARCH_PAGE_SIZE);
+        rt_pages_free(vp, 0);
+        LOG_W("%s: failed to map pages", __func__);
+        return -RT_ENOMEM;
+    }
+
+    lwp->vdso_data = data;
+    lwp->vdso_proc = proc;
+    lwp->vdso_kproc = vp;
+    return RT_EOK;
+}
+
+int lwp_vdso_fork(struct rt_lwp *dst, struct rt_lwp *src)
+{
+    struct rt_vdso_proc *vp;
+
+    if (!src->vdso_kproc)
+        return RT_EOK;
+
+    vp = _vdso_proc_alloc(dst);
+    if (!vp)
+        return -RT_ENOMEM;
+
+    /* the page of parent is duplicated into child, replace it */
+    rt_aspace_unmap_range(dst->aspace, src->vdso_proc, ARCH_PAGE_SIZE);
+    if (!_vdso_map_page(dst, src->vdso_proc, vp, RT_TRUE))
+    {
+        rt_pages_free(vp, 0);
+        return -RT_ENOMEM;
+    }
+
+    dst->vdso_data = src->vdso_data;
+    dst->vdso_proc = src->vdso_proc;
+    dst->vdso_kproc = vp;
+    return RT_EOK;
+}
+
+void lwp_vdso_vfork(struct rt_lwp *lwp, rt_bool_t borrowed)
+{
+    struct rt_vdso_proc *vp = lwp->vdso_kproc;
+
+    /* a child of vfork() vforking again sees the page of the first parent */
+    if (!vp)
+        return;
+
+    if (borrowed)
+        __atomic_add_fetch(&vp->vfork, 1, __ATOMIC_RELEASE);
+    else
+        __atomic_sub_fetch(&vp->vfork, 1, __ATOMIC_RELEASE);
+}
+
+void lwp_vdso_unmap(struct rt_lwp *lwp)
+{
+    if (lwp->vdso_kproc)
+    {
+        rt_pages_free(lwp->vdso_kproc, 0);
+        lwp->vdso_kproc = RT_NULL;
+    }
+    lwp->vdso_data = RT_NULL;
+    lwp->vdso_proc = RT_NULL;
+}
+
+void lwp_vdso_proc_update(struct rt_lwp *lwp)
+{
+    if (lwp->vdso_kproc)
+        lwp->vdso_kproc->pid = lwp->pid;
+}
+
+#endif /* LWP_USING_VDSO */
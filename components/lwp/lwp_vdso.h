@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#ifndef __LWP_VDSO_H__
+#define __LWP_VDSO_H__
+
+#include <rtthread.h>
+#include "vdso/vdso_datapage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct rt_lwp;
+
+/**
+ * @brief Map the shared time data page and a page of process data into the
+ * new user space of lwp, the user addresses are passed by the aux vector
+ */
+int lwp_vdso_map(struct rt_lwp *lwp);
+
+/**
+ * @brief Give the forked child a page of process data of its own, the child
+ * inherits the mappings of src at the same addresses
+ */
+int lwp_vdso_fork(struct rt_lwp *dst, struct rt_lwp *src);
+
+/**
+ * @brief Mark the page of process data of lwp as shared with a child of
+ * vfork() while it borrows the user space, or the end of it
+ */
+void lwp_vdso_vfork(struct rt_lwp *lwp, rt_bool_t borrowed);
+
+/**
+ * @brief Release the page of process data after the user space is freed
+ */
+void lwp_vdso_unmap(struct rt_lwp *lwp);
+
+/**
+ * @brief Update the page of process data, e.g. after exec swaps in a new
+ * user space
+ */
+void lwp_vdso_proc_update(struct rt_lwp *lwp);
+
+/**
+ * @brief Resynchronize the realtime with the RTC, the RTC devices call it
+ * after the time is set
+ */
+void lwp_vdso_realtime_sync(void);
+
+/**
+ * @brief Kernel address of the time data page
+ */
+struct rt_vdso_data *lwp_vdso_data_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LWP_VDSO_H__ */
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#ifndef __SYSRING_ABI_H__
+#define __SYSRING_ABI_H__
+
+/**
+ * Layout of the system call ring shared by a process and the kernel. The
+ * process fills the submission entries and advances sq_tail, then calls
+ * sysring_enter() to have a batch of them done in one trap. A completion is
+ * posted for each submission consumed, in the order of submission.
+ *
+ * It is shared by the kernel and the user space, so only the types of C
+ * library are used here.
+ */
+
+#include <stdint.h>
+
+/* system call numbers */
+#define SYS_sysring_setup   217
+#define SYS_sysring_enter   218
+
+#define RT_SYSRING_ENTRIES_MAX  4096
+
+enum rt_sysring_op
+{
+    RT_SYSRING_OP_NOP = 0,
+    RT_SYSRING_OP_READ,     /* read(fd, addr, len) */
+    RT_SYSRING_OP_WRITE,    /* write(fd, addr, len) */
+    RT_SYSRING_OP_SEND,     /* send(fd, addr, len, op_flags) */
+    RT_SYSRING_OP_RECV,     /* recv(fd, addr, len, op_flags) */
+    RT_SYSRING_OP_POLL,     /* poll fd for events op_flags in len ms, res is revents */
+    RT_SYSRING_OP_FSYNC,    /* fsync(fd) */
+};
+
+struct rt_sysring_sqe
+{
+    uint8_t opcode;
+    uint8_t flags;
+    uint16_t reserved;
+    int32_t fd;
+    uint64_t addr;          /* user buffer */
+    uint32_t len;           /* length of buffer, or timeout of poll */
+    int32_t op_flags;
+    uint64_t user_data;     /* passed back in the completion */
+};
+
+struct rt_sysring_cqe
+{
+    uint64_t user_data;
+    int32_t res;            /* result of the call, or a negative errno */
+    uint32_t flags;
+};
+
+/**
+ * @brief Head of the ring at its start. The indexes run freely and are
+ * masked by entries - 1 on access.
+ */
+struct rt_sysring_head
+{
+    uint32_t sq_head;       /* next submission to consume, by kernel */
+    uint32_t sq_tail;       /* next submission to fill, by user */
+    uint32_t cq_head;       /* next completion to reap, by user */
+    uint32_t cq_tail;       /* next completion to post, by kernel */
+    uint32_t entries;       /* of both queues, a power of 2 */
+    uint32_t sqe_off;       /* offset of submissions from the head */
+    uint32_t cqe_off;       /* offset of completions from the head */
+    uint32_t reserved;
+};
+
+#endif /* __SYSRING_ABI_H__ */
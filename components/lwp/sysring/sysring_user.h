@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#ifndef __SYSRING_USER_H__
+#define __SYSRING_USER_H__
+
+/**
+ * Helpers of the system call ring for the user space, which is built into
+ * the C library or the application:
+ *
+ *  rt_sysring_init(&ring, 64);
+ *  sqe = rt_sysring_get_sqe(&ring);
+ *  sqe->opcode = RT_SYSRING_OP_WRITE; ...
+ *  rt_sysring_submit(&ring);
+ *  while ((cqe = rt_sysring_peek_cqe(&ring)) != NULL)
+ *      rt_sysring_cqe_seen(&ring);
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sysring_abi.h"
+
+struct rt_sysring
+{
+    struct rt_sysring_head *head;
+    struct rt_sysring_sqe *sqes;
+    struct rt_sysring_cqe *cqes;
+    uint32_t mask;
+    uint32_t sq_tail;       /* filled, but not submitted yet */
+};
+
+static inline int rt_sysring_init(struct rt_sysring *ring, unsigned int entries)
+{
+    void *addr;
+
+    if (syscall(SYS_sysring_setup, entries, &addr) != 0)
+        return -errno;
+
+    ring->head = addr;
+    ring->sqes = (struct rt_sysring_sqe *)((char *)addr + ring->head->sqe_off);
+    ring->cqes = (struct rt_sysring_cqe *)((char *)addr + ring->head->cqe_off);
+    ring->mask = ring->head->entries - 1;
+    ring->sq_tail = ring->head->sq_tail;
+    return 0;
+}
+
+/* get a cleared submission to fill, NULL if the queue is full */
+static inline struct rt_sysring_sqe *rt_sysring_get_sqe(struct rt_sysring *ring)
+{
+    uint32_t head = __atomic_load_n(&ring->head->sq_head, __ATOMIC_ACQUIRE);
+    struct rt_sysring_sqe *sqe;
+
+    if (ring->sq_tail - head > ring->mask)
+        return NULL;
+
+    sqe = &ring->sqes[ring->sq_tail++ & ring->mask];
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+/* submit the filled entries, return the number consumed or a negative errno */
+static inline int rt_sysring_submit(struct rt_sysring *ring)
+{
+    uint32_t head = __atomic_load_n(&ring->head->sq_head, __ATOMIC_ACQUIRE);
+    long rc;
+
+    __atomic_store_n(&ring->head->sq_tail, ring->sq_tail, __ATOMIC_RELEASE);
+    rc = syscall(SYS_sysring_enter, ring->sq_tail - head, 0);
+    return rc < 0 ? -errno : (int)rc;
+}
+
+static inline struct rt_sysring_cqe *rt_sysring_peek_cqe(struct rt_sysring *ring)
+{
+    uint32_t head = ring->head->cq_head;
+
+    if (head == __atomic_load_n(&ring->head->cq_tail, __ATOMIC_ACQUIRE))
+        return NULL;
+    return &ring->cqes[head & ring->mask];
+}
+
+static inline void rt_sysring_cqe_seen(struct rt_sysring *ring)
+{
+    __atomic_store_n(&ring->head->cq_head, ring->head->cq_head + 1, __ATOMIC_RELEASE);
+}
+
+#endif /* __SYSRING_USER_H__ */
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#ifndef __VDSO_DATAPAGE_H__
+#define __VDSO_DATAPAGE_H__
+
+/**
+ * Layout of the pages mapped read-only into every process by the kernel. It
+ * is shared by the kernel and the user space, so only the types of C library
+ * are used here.
+ */
+
+#include <stdint.h>
+#include <time.h>
+
+/* aux keys of the user address of pages, out of the range used by Linux */
+#define AT_RT_VDSO_DATA     0x1000
+#define AT_RT_VDSO_PROC     0x1001
+
+#define RT_VDSO_NSEC_PER_SEC 1000000000L
+
+/**
+ * @brief Time data shared by all processes
+ *
+ * The kernel updates it on every tick. The seq is odd while an update is in
+ * progress, and a reader retries when the seq is odd or changed during the
+ * read.
+ */
+struct rt_vdso_data
+{
+    volatile uint32_t seq;
+    uint32_t tick_per_second;
+    uint64_t tick;              /* system tick at the last update */
+    uint64_t res_nsec;          /* resolution of the times below */
+    int64_t boot_sec;           /* boottime at the last update */
+    int64_t boot_nsec;
+    int64_t real_sec;           /* realtime minus boottime */
+    int64_t real_nsec;
+};
+
+/**
+ * @brief Data of the process which maps it
+ */
+struct rt_vdso_proc
+{
+    int32_t pid;
+    int32_t vfork;              /* children of vfork() running in this user space */
+};
+
+static inline uint32_t rt_vdso_read_begin(const struct rt_vdso_data *vd)
+{
+    uint32_t seq;
+
+    while ((seq = __atomic_load_n(&vd->seq, __ATOMIC_ACQUIRE)) & 1)
+        ;
+    return seq;
+}
+
+static inline int rt_vdso_read_retry(const struct rt_vdso_data *vd, uint32_t seq)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&vd->seq, __ATOMIC_RELAXED) != seq;
+}
+
+/**
+ * @brief Get the boottime, or the realtime if realtime is set, at the last
+ * update of vd
+ */
+static inline void rt_vdso_time_get(const struct rt_vdso_data *vd, int realtime,
+                                    struct timespec *ts)
+{
+    int64_t sec, nsec;
+    uint32_t seq;
+
+    do
+    {
+        seq = rt_vdso_read_begin(vd);
+        sec = vd->boot_sec;
+        nsec = vd->boot_nsec;
+        if (realtime)
+        {
+            sec += vd->real_sec;
+            nsec += vd->real_nsec;
+        }
+    } while (rt_vdso_read_retry(vd, seq));
+
+    if (nsec >= RT_VDSO_NSEC_PER_SEC)
+    {
+        sec++;
+        nsec -= RT_VDSO_NSEC_PER_SEC;
+    }
+    ts->tv_sec = sec;
+    ts->tv_nsec = nsec;
+}
+
+static inline uint64_t rt_vdso_tick_get(const struct rt_vdso_data *vd)
+{
+    uint64_t tick;
+    uint32_t seq;
+
+    do
+    {
+        seq = rt_vdso_read_begin(vd);
+        tick = vd->tick;
+    } while (rt_vdso_read_retry(vd, seq));
+
+    return tick;
+}
+
+#endif /* __VDSO_DATAPAGE_H__ */
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#ifndef __VDSO_USER_H__
+#define __VDSO_USER_H__
+
+/**
+ * Fast path of clock_gettime(), gettimeofday() and getpid() for the user
+ * space, which reads the pages mapped by the kernel instead of trapping into
+ * it. It is built into the C library or the application, and falls back to
+ * the system calls on a kernel without the pages.
+ *
+ * The times are the ones at the last tick, so the clocks have a resolution of
+ * one tick. A caller in need of a finer clock should call clock_gettime() of
+ * C library directly.
+ */
+
+#include <sys/auxv.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "vdso_datapage.h"
+
+static inline const struct rt_vdso_data *rt_vdso_data(void)
+{
+    static const struct rt_vdso_data *vd;
+
+    if (!vd)
+        vd = (const struct rt_vdso_data *)getauxval(AT_RT_VDSO_DATA);
+    return vd;
+}
+
+static inline const struct rt_vdso_proc *rt_vdso_proc(void)
+{
+    static const struct rt_vdso_proc *vp;
+
+    if (!vp)
+        vp = (const struct rt_vdso_proc *)getauxval(AT_RT_VDSO_PROC);
+    return vp;
+}
+
+static inline int rt_vdso_clock_gettime(clockid_t clk, struct timespec *ts)
+{
+    const struct rt_vdso_data *vd = rt_vdso_data();
+
+    if (vd)
+    {
+        switch (clk)
+        {
+        case CLOCK_REALTIME:
+        case CLOCK_REALTIME_COARSE:
+            rt_vdso_time_get(vd, 1, ts);
+            return 0;
+        case CLOCK_MONOTONIC:
+        case CLOCK_MONOTONIC_COARSE:
+        case CLOCK_MONOTONIC_RAW:
+        case CLOCK_BOOTTIME:
+            rt_vdso_time_get(vd, 0, ts);
+            return 0;
+        default:
+            break;
+        }
+    }
+    return clock_gettime(clk, ts);
+}
+
+static inline int rt_vdso_clock_getres(clockid_t clk, struct timespec *ts)
+{
+    const struct rt_vdso_data *vd = rt_vdso_data();
+
+    if (vd && ts && (clk == CLOCK_REALTIME || clk == CLOCK_REALTIME_COARSE ||
+                     clk == CLOCK_MONOTONIC || clk == CLOCK_MONOTONIC_COARSE ||
+                     clk == CLOCK_MONOTONIC_RAW || clk == CLOCK_BOOTTIME))
+    {
+        ts->tv_sec = vd->res_nsec / RT_VDSO_NSEC_PER_SEC;
+        ts->tv_nsec = vd->res_nsec % RT_VDSO_NSEC_PER_SEC;
+        return 0;
+    }
+    return clock_getres(clk, ts);
+}
+
+/* the same as the system call, which counts from boot in ticks */
+static inline int rt_vdso_gettimeofday(struct timeval *tv, void *tz)
+{
+    const struct rt_vdso_data *vd = rt_vdso_data();
+    uint64_t tick;
+
+    if (!vd)
+        return gettimeofday(tv, tz);
+
+    if (tv)
+    {
+        tick = rt_vdso_tick_get(vd);
+        tv->tv_sec = tick / vd->tick_per_second;
+        tv->tv_usec = (tick % vd->tick_per_second) * (1000000 / vd->tick_per_second);
+    }
+    return 0;
+}
+
+/**
+ * A child of vfork() runs in the user space of parent until it calls exec or
+ * exits, and it sees the page of parent, so the pid is asked from the kernel
+ * meanwhile.
+ */
+static inline pid_t rt_vdso_getpid(void)
+{
+    const struct rt_vdso_proc *vp = rt_vdso_proc();
+
+    if (!vp || __atomic_load_n(&vp->vfork, __ATOMIC_ACQUIRE) != 0)
+        return getpid();
+    return vp->pid;
+}
+
+#endif /* __VDSO_USER_H__ */
@@ -6,6 +6,9 @@
  * Change Logs:
  * Date           Author       Notes
  * 2023-08-19     Shell        Support PRIVATE mapping and COW
+ * 2026-10-19     agent        Map the resident backup pages around a fault
+ * 2026-10-19     agent        Map the huge page provided by dummy mapper
+ * 2026-10-19     agent        Lazy fork and skip the untouched varea on teardown
  */
 
 #define DBG_TAG "mm.anon"
@@ -30,6 +33,13 @@ typedef struct rt_private_ctx {
     long readonly;
 } *rt_private_ctx_t;
 
+/**
+ * A varea which never mapped a page frame has nothing to release or share, so
+ * it's skipped without a walk of page table on fork or teardown
+ */
+#define VAREA_POPULATED(varea)      ((varea)->data != RT_NULL)
+#define VAREA_SET_POPULATED(varea)  ((varea)->data = (void *)1)
+
 rt_inline rt_aspace_t _anon_obj_get_backup(rt_mem_obj_t mobj)
 {
     rt_private_ctx_t pctx;
@@ -113,6 +123,7 @@ void rt_varea_pgmgr_insert(rt_varea_t varea, void *page_addr)
 {
     /* each mapping of page frame in the varea is binding with a reference */
     rt_page_ref_inc(page_addr, 0);
+    VAREA_SET_POPULATED(varea);
 }
 
 /**
@@ -128,6 +139,9 @@ static void _pgmgr_pop_all(rt_varea_t varea)
     RT_ASSERT(!((long)iter & ARCH_PAGE_MASK));
     RT_ASSERT(!((long)end_addr & ARCH_PAGE_MASK));
 
+    if (!VAREA_POPULATED(varea))
+        return;
+
     for (; iter != end_addr; iter += ARCH_PAGE_SIZE)
     {
         void *page_pa = rt_hw_mmu_v2p(aspace, iter);
@@ -221,12 +235,14 @@ static rt_err_t _anon_varea_split(struct rt_varea *existed, void *unmap_start, r
     _pgmgr_pop_range(existed, unmap_start, (char *)unmap_start + unmap_len);
 
     _anon_varea_open(subset);
+    subset->data = existed->data;
     return RT_EOK;
 }
 
 static rt_err_t _anon_varea_merge(struct rt_varea *merge_to, struct rt_varea *merge_from)
 {
-    /* do nothing for the varea merge */
+    if (VAREA_POPULATED(merge_from))
+        VAREA_SET_POPULATED(merge_to);
     return RT_EOK;
 }
 
@@ -238,10 +254,26 @@ rt_inline void _map_page_in_varea(rt_aspace_t asapce, rt_varea_t varea,
                                   struct rt_aspace_fault_msg *msg, char *fault_addr)
 {
     char *page_va = msg->response.vaddr;
-    if (rt_varea_map_page(varea, fault_addr, page_va) == RT_EOK)
+    rt_size_t size = msg->response.size;
+    rt_size_t off;
+    int err;
+
+    if (size > ARCH_PAGE_SIZE)
+    {
+        err = rt_varea_map_range(varea, fault_addr, page_va + PV_OFFSET, size);
+    }
+    else
+    {
+        size = ARCH_PAGE_SIZE;
+        err = rt_varea_map_page(varea, fault_addr, page_va);
+    }
+
+    if (err == RT_EOK)
     {
         msg->response.status = MM_FAULT_STATUS_OK_MAPPED;
-        rt_varea_pgmgr_insert(varea, page_va);
+        /* a huge page is split to single pages, each one is referenced */
+        for (off = 0; off < size; off += ARCH_PAGE_SIZE)
+            rt_varea_pgmgr_insert(varea, page_va + off);
     }
     else
     {
@@ -250,6 +282,16 @@ rt_inline void _map_page_in_varea(rt_aspace_t asapce, rt_varea_t varea,
     }
 }
 
+/* drop the reference from allocation of the pages provided by dummy mapper */
+rt_inline void _put_fetched_pages(struct rt_aspace_fault_msg *msg)
+{
+    char *page_va = msg->response.vaddr;
+    rt_size_t off;
+
+    for (off = 0; off < msg->response.size; off += ARCH_PAGE_SIZE)
+        rt_pages_free(page_va + off, 0);
+}
+
 /* page frame inquiry or allocation in backup address space */
 static void *_get_page_from_backup(rt_aspace_t backup, rt_base_t offset_in_mobj)
 {
@@ -280,12 +322,13 @@ static void *_get_page_from_backup(rt_aspace_t backup, rt_base_t offset_in_mobj)
             rt_mm_dummy_mapper.on_page_fault(backup_varea, &msg);
             if (msg.response.status != MM_FAULT_STATUS_UNRECOVERABLE)
             {
-                _map_page_in_varea(backup, backup_varea, &msg, backup_addr);
+                _map_page_in_varea(backup, backup_varea, &msg, msg.fault_vaddr);
                 if (msg.response.status == MM_FAULT_STATUS_OK_MAPPED)
                 {
-                    rc = msg.response.vaddr;
+                    /* the fault address is moved back if a huge page is provided */
+                    rc = (char *)msg.response.vaddr + (backup_addr - (char *)msg.fault_vaddr);
                 }
-                rt_pages_free(msg.response.vaddr, 0);
+                _put_fetched_pages(&msg);
             }
         }
         else
@@ -331,7 +374,7 @@ static void _fetch_page_for_varea(struct rt_varea *varea, struct rt_aspace_fault
                 _map_page_in_varea(backup, varea, msg, msg->fault_vaddr);
                 if (msg->response.status != MM_FAULT_STATUS_UNRECOVERABLE)
                 {
-                    rt_pages_free(msg->response.vaddr, 0);
+                    _put_fetched_pages(msg);
                 }
             }
         }
@@ -365,6 +408,35 @@ static void _anon_page_fault(struct rt_varea *varea, struct rt_aspace_fault_msg
     _fetch_page_for_varea(varea, msg, RT_TRUE);
 }
 
+/**
+ * Only the varea referencing a backup aspace can find a page not mapped in
+ * itself but resident already, the anonymous one has nothing to map ahead
+ */
+static void _anon_page_fault_around(struct rt_varea *varea, struct rt_aspace_fault_msg *msg)
+{
+    void *frame_pa;
+    char *frame_ka;
+    rt_aspace_t backup = _anon_obj_get_backup(varea->mem_obj);
+
+    if (backup == varea->aspace)
+        return;
+
+    /* the backup page is not freed while it's taken by the lock */
+    WR_LOCK(backup);
+    frame_pa = rt_hw_mmu_v2p(backup, (void *)(msg->off << MM_PAGE_SHIFT));
+    if (frame_pa != ARCH_MAP_FAILED)
+    {
+        frame_ka = rt_kmem_p2v(frame_pa);
+        if (frame_ka)
+        {
+            msg->response.vaddr = frame_ka;
+            msg->response.size = ARCH_PAGE_SIZE;
+            _map_page_in_varea(varea->aspace, varea, msg, msg->fault_vaddr);
+        }
+    }
+    WR_UNLOCK(backup);
+}
+
 static void read_by_mte(rt_aspace_t aspace, struct rt_aspace_io_msg *iomsg)
 {
     if (rt_aspace_page_get_phy(aspace, iomsg->fault_vaddr, iomsg->buffer_vaddr) == RT_EOK)
@@ -454,6 +526,7 @@ static struct rt_private_ctx _priv_obj = {
     .mem_obj.on_varea_merge = _anon_varea_merge,
     .mem_obj.page_read = _anon_page_read,
     .mem_obj.page_write = _anon_page_write,
+    .mem_obj.on_page_fault_around = _anon_page_fault_around,
 };
 
 rt_inline rt_private_ctx_t rt_private_obj_create_n_bind(rt_aspace_t aspace)
@@ -702,6 +775,10 @@ rt_err_t rt_aspace_fork(rt_aspace_t *psrc, rt_aspace_t *pdst)
     rt_aspace_t dst = *pdst;
     long base_reference;
 
+    /* source forked before may have no private object, when nothing is written */
+    if (!_get_private_obj(src))
+        return -RT_ENOMEM;
+
     pgtbl = rt_hw_mmu_pgtbl_create();
     if (pgtbl)
     {
@@ -9,6 +9,7 @@
  * 2023-08-17     Shell        Add unmap_range for MAP_PRIVATE
  *                             Support MAP_FIXED in aspace_map(), and
  *                             Add better support of permission in mmap
+ * 2026-10-19     agent        Align and prefetch the mapping with huge page
  */
 
 /**
@@ -252,9 +253,8 @@ static int _do_prefetch(rt_aspace_t aspace, rt_varea_t varea, void *start,
     char *vaddr = start;
     rt_size_t off = varea->offset + ((vaddr - (char *)varea->start) >> ARCH_PAGE_SHIFT);
 
-    while (vaddr != end)
+    while (vaddr < end)
     {
-        /* TODO try to map with huge TLB, when flag & HUGEPAGE */
         struct rt_aspace_fault_msg msg;
         _do_page_fault(&msg, off, vaddr, varea->mem_obj, varea);
 
@@ -270,8 +270,9 @@ static int _do_prefetch(rt_aspace_t aspace, rt_varea_t varea, void *start,
         if (msg.response.status == MM_FAULT_STATUS_OK_MAPPED)
             break;
 
-        vaddr += msg.response.size;
-        off += msg.response.size >> ARCH_PAGE_SHIFT;
+        /* a huge page may start ahead of the address requested */
+        vaddr = (char *)msg.fault_vaddr + msg.response.size;
+        off = msg.off + (msg.response.size >> ARCH_PAGE_SHIFT);
     }
 
     return err;
@@ -698,6 +699,17 @@ int rt_aspace_map(rt_aspace_t aspace, void **addr, rt_size_t length,
     {
         RT_ASSERT((length & ARCH_PAGE_MASK) == 0);
         RT_ASSERT(((long)*addr & ARCH_PAGE_MASK) == 0);
+
+#ifdef RT_MM_HUGE_PAGE
+        /* place the mapping on huge page boundary so it can be fully covered */
+        if ((flags & MMF_HUGEPAGE) && length >= ARCH_HUGE_PAGE_SIZE &&
+            !(flags & (MMF_MAP_FIXED | MMF_REQUEST_ALIGN)))
+        {
+            flags = MMF_SET_CNTL(flags, MMF_REQUEST_ALIGN);
+            flags = MMF_SET_ALIGN(flags, ARCH_HUGE_PAGE_SIZE);
+        }
+#endif /* RT_MM_HUGE_PAGE */
+
         err = _mm_aspace_map(aspace, &varea, addr, length, attr, flags, mem_obj, offset);
     }
 
@@ -7,6 +7,8 @@
  * Date           Author       Notes
  * 2022-11-14     WangXiaoyao  the first version
  * 2023-08-17     Shell        Add unmap_range for MAP_PRIVATE
+ * 2026-10-19     agent        Add on_page_fault_around to mem_obj
+ * 2026-10-19     agent        Add huge page size
  */
 #ifndef __MM_ASPACE_H__
 #define __MM_ASPACE_H__
@@ -25,6 +27,13 @@
 #define MM_PA_TO_OFF(pa) ((uintptr_t)(pa) >> MM_PAGE_SHIFT)
 #define PV_OFFSET        (rt_kmem_pvoff())
 
+/* block size of a section/block descriptor, an architecture can override it */
+#ifndef ARCH_HUGE_PAGE_SHIFT
+#define ARCH_HUGE_PAGE_SHIFT  21
+#endif
+#define ARCH_HUGE_PAGE_SIZE   (1ul << ARCH_HUGE_PAGE_SHIFT)
+#define ARCH_HUGE_PAGE_ORDER  (ARCH_HUGE_PAGE_SHIFT - ARCH_PAGE_SHIFT)
+
 typedef struct rt_spinlock mm_spinlock_t;
 
 #define MM_PGTBL_LOCK_INIT(aspace) (rt_spin_lock_init(&((aspace)->pgtbl_lock)))
@@ -113,6 +122,13 @@ typedef struct rt_mem_obj
     const char *(*get_name)(rt_varea_t varea);
 
     void *(*on_varea_mremap)(struct rt_varea *varea, rt_size_t new_size, int flags, void *new_address);
+
+    /**
+     * like on_page_fault(), but only map the page if it's resident in the
+     * object already, never allocate or wait for I/O. Used to map the
+     * neighbours of a read fault.
+     */
+    void (*on_page_fault_around)(struct rt_varea *varea, struct rt_aspace_fault_msg *msg);
 } *rt_mem_obj_t;
 
 extern struct rt_mem_obj rt_mm_dummy_mapper;
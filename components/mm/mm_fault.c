@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2022-12-06     WangXiaoyao  the first version
  * 2023-08-19     Shell        Support PRIVATE mapping and COW
+ * 2026-10-19     agent        Support fault-around and fault statistics
  */
 #include <rtthread.h>
 
@@ -24,6 +25,10 @@
 #include <mmu.h>
 #include <tlb.h>
 
+#ifndef RT_MM_FAULT_AROUND_PAGES
+#define RT_MM_FAULT_AROUND_PAGES 1
+#endif
+
 static int _fetch_page(rt_varea_t varea, struct rt_aspace_fault_msg *msg)
 {
     int err = MM_FAULT_FIXABLE_FALSE;
@@ -102,8 +107,69 @@ static int _exec_fault(rt_varea_t varea, void *pa, struct rt_aspace_fault_msg *m
     return err;
 }
 
+/**
+ * Map the resident pages in the aligned window around a fixed read or execute
+ * fault, so a sequential access does not trap on every page. Nothing is
+ * allocated or read in here, the pages are mapped as if read one by one.
+ */
+static rt_size_t _fault_around(rt_varea_t varea, struct rt_aspace_fault_msg *msg)
+{
+    struct rt_aspace_fault_msg around;
+    rt_ubase_t fault_pg, first_pg, last_pg, pg;
+    rt_ubase_t varea_first, varea_last;
+    rt_size_t mapped = 0;
+    char *va;
+
+    if (RT_MM_FAULT_AROUND_PAGES < 2 || (varea->flag & MMF_NO_FAULT_AROUND) ||
+        !varea->mem_obj || !varea->mem_obj->on_page_fault_around)
+        return 0;
+
+    fault_pg = (rt_ubase_t)msg->fault_vaddr >> ARCH_PAGE_SHIFT;
+    first_pg = fault_pg - fault_pg % RT_MM_FAULT_AROUND_PAGES;
+    last_pg = first_pg + RT_MM_FAULT_AROUND_PAGES - 1;
+
+    varea_first = (rt_ubase_t)varea->start >> ARCH_PAGE_SHIFT;
+    varea_last = varea_first + (varea->size >> ARCH_PAGE_SHIFT) - 1;
+    if (first_pg < varea_first)
+        first_pg = varea_first;
+    if (last_pg > varea_last)
+        last_pg = varea_last;
+
+    around.fault_op = msg->fault_op;
+    around.fault_type = MM_FAULT_TYPE_PAGE_FAULT;
+    for (pg = first_pg; pg <= last_pg; pg++)
+    {
+        va = (char *)(pg << ARCH_PAGE_SHIFT);
+        if (pg == fault_pg || rt_hw_mmu_v2p(varea->aspace, va) != ARCH_MAP_FAILED)
+            continue;
+
+        around.fault_vaddr = va;
+        around.off = varea->offset + (pg - varea_first);
+        rt_mm_fault_res_init(&around.response);
+
+        varea->mem_obj->on_page_fault_around(varea, &around);
+        if (around.response.status == MM_FAULT_STATUS_OK_MAPPED)
+            mapped++;
+    }
+
+    return mapped;
+}
+
+static void _fault_account(rt_aspace_t aspace, rt_size_t around)
+{
+    rt_lwp_t lwp = lwp_self();
+
+    if (lwp && lwp->aspace == aspace)
+    {
+        rt_atomic_add(&lwp->fault_count, 1);
+        if (around)
+            rt_atomic_add(&lwp->fault_around_count, around);
+    }
+}
+
 int rt_aspace_fault_try_fix(rt_aspace_t aspace, struct rt_aspace_fault_msg *msg)
 {
+    rt_size_t around = 0;
     int err = MM_FAULT_FIXABLE_FALSE;
     uintptr_t va = (uintptr_t)msg->fault_vaddr;
     va &= ~ARCH_PAGE_MASK;
@@ -136,14 +202,19 @@ int rt_aspace_fault_try_fix(rt_aspace_t aspace, struct rt_aspace_fault_msg *msg)
                 {
                 case MM_FAULT_OP_READ:
                     err = _read_fault(varea, pa, msg);
+                    if (err == MM_FAULT_FIXABLE_TRUE)
+                        around = _fault_around(varea, msg);
                     break;
                 case MM_FAULT_OP_WRITE:
                     err = _write_fault(varea, pa, msg);
                     break;
                 case MM_FAULT_OP_EXECUTE:
                     err = _exec_fault(varea, pa, msg);
+                    if (err == MM_FAULT_FIXABLE_TRUE)
+                        around = _fault_around(varea, msg);
                     break;
                 }
+                _fault_account(aspace, around);
             }
         }
         else
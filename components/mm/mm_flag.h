@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2022-11-23     WangXiaoyao  the first version
+ * 2026-10-19     agent        add MMF_NO_FAULT_AROUND
  */
 #ifndef __MM_FLAG_H__
 #define __MM_FLAG_H__
@@ -87,6 +88,12 @@ enum mm_flag_cntl
      */
     MMF_REQUEST_ALIGN = _DEF_FLAG(9),
 
+    /**
+     * @brief Only map the faulting page on a read fault, the resident
+     * neighbours are not mapped ahead (random access)
+     */
+    MMF_NO_FAULT_AROUND = _DEF_FLAG(10),
+
     __MMF_INVALID,
 };
 
@@ -8,6 +8,7 @@
  * 2022-11-30     WangXiaoyao  the first version
  * 2023-08-19     Shell        Support varea modification handler
  * 2023-10-13     Shell        Replace the page management algorithm of pgmgr
+ * 2026-10-19     agent        Serve the fault with huge page on MMF_HUGEPAGE
  */
 
 #define DBG_TAG "mm.object"
@@ -31,9 +32,60 @@ static const char *get_name(rt_varea_t varea)
     return "dummy-mapper";
 }
 
+#ifdef RT_MM_HUGE_PAGE
+RT_STATIC_ASSERT(huge_page_order, ARCH_HUGE_PAGE_ORDER < RT_PAGE_MAX_ORDER);
+
+/**
+ * Provide the whole huge page containing the fault address with a physically
+ * contiguous page group, if the huge page is inside the varea and none of its
+ * pages is mapped yet. The fault address and offset in message are moved back
+ * to the start of huge page, so the caller maps it all at once.
+ */
+static rt_bool_t _huge_page_fault(struct rt_varea *varea, struct rt_aspace_fault_msg *msg)
+{
+    char *huge_va;
+    char *iter;
+    void *page;
+
+    huge_va = (char *)RT_ALIGN_DOWN((rt_ubase_t)msg->fault_vaddr, ARCH_HUGE_PAGE_SIZE);
+    if (huge_va < (char *)varea->start ||
+        huge_va + ARCH_HUGE_PAGE_SIZE > (char *)varea->start + varea->size)
+        return RT_FALSE;
+
+    for (iter = huge_va; iter < huge_va + ARCH_HUGE_PAGE_SIZE; iter += ARCH_PAGE_SIZE)
+    {
+        if (rt_hw_mmu_v2p(varea->aspace, iter) != ARCH_MAP_FAILED)
+            return RT_FALSE;
+    }
+
+    page = rt_pages_alloc_ext(ARCH_HUGE_PAGE_ORDER, PAGE_ANY_AVAILABLE);
+    if (!page)
+        return RT_FALSE;
+
+    /**
+     * pages are referenced one by one as usual, so a partial unmap or shrink
+     * of the varea releases only the pages inside the range
+     */
+    rt_pages_split(page, ARCH_HUGE_PAGE_ORDER);
+
+    msg->off -= ((char *)msg->fault_vaddr - huge_va) >> ARCH_PAGE_SHIFT;
+    msg->fault_vaddr = huge_va;
+    msg->response.status = MM_FAULT_STATUS_OK;
+    msg->response.size = ARCH_HUGE_PAGE_SIZE;
+    msg->response.vaddr = page;
+    return RT_TRUE;
+}
+#endif /* RT_MM_HUGE_PAGE */
+
 static void on_page_fault(struct rt_varea *varea, struct rt_aspace_fault_msg *msg)
 {
     void *page;
+
+#ifdef RT_MM_HUGE_PAGE
+    if ((varea->flag & MMF_HUGEPAGE) && _huge_page_fault(varea, msg))
+        return;
+#endif /* RT_MM_HUGE_PAGE */
+
     page = rt_pages_alloc_ext(0, PAGE_ANY_AVAILABLE);
 
     if (!page)
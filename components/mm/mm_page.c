@@ -10,6 +10,9 @@
  *                             page management algorithm
  * 2023-02-20     WangXiaoyao  Multi-list page-management
  * 2023-11-28     Shell        Bugs fix for page_install on shadow region
+ * 2026-10-19     agent        Split a page group into single pages
+ * 2026-10-19     agent        Per-CPU cache of order-0 pages
+ * 2026-10-19     agent        Reclaim by shrinkers on memory pressure
  */
 #include <rtthread.h>
 
@@ -22,6 +25,7 @@
 #include "mm_aspace.h"
 #include "mm_flag.h"
 #include "mm_page.h"
+#include "mm_shrinker.h"
 #include <mmu.h>
 
 #define DBG_TAG "mm.page"
@@ -51,6 +55,16 @@ static rt_size_t page_nr;
 static rt_size_t _high_pages_nr;
 static rt_size_t early_offset;
 
+#ifdef RT_MM_RECLAIM
+/* pages in buddy system, maintained to check the watermark quickly */
+static rt_size_t _free_pages_nr;
+#define FREE_PAGES_ADD(size_bits) (_free_pages_nr += 1UL << (size_bits))
+#define FREE_PAGES_SUB(size_bits) (_free_pages_nr -= 1UL << (size_bits))
+#else
+#define FREE_PAGES_ADD(size_bits)
+#define FREE_PAGES_SUB(size_bits)
+#endif /* RT_MM_RECLAIM */
+
 static const char *get_name(rt_varea_t varea)
 {
     return "master-page-record";
@@ -180,7 +194,7 @@ static void _trace_free(rt_page_t page, void *caller, size_t size_bits)
             return ;
         }
 
-        if (page->ref_cnt == 0)
+        if (rt_atomic_load(&page->ref_cnt) == 0)
         {
             _alloc_cnt--;
             if (page->tl_prev)
@@ -287,6 +301,7 @@ static void _page_remove(rt_page_t page_list[], struct rt_page *p, rt_uint32_t s
     }
 
     p->size_bits = ARCH_ADDRESS_WIDTH_BITS;
+    FREE_PAGES_SUB(size_bits);
 }
 
 static void _page_insert(rt_page_t page_list[], struct rt_page *p, rt_uint32_t size_bits)
@@ -299,6 +314,7 @@ static void _page_insert(rt_page_t page_list[], struct rt_page *p, rt_uint32_t s
     p->pre = 0;
     page_list[size_bits] = p;
     p->size_bits = size_bits;
+    FREE_PAGES_ADD(size_bits);
 }
 
 static void _pages_ref_inc(struct rt_page *p, rt_uint32_t size_bits)
@@ -312,7 +328,7 @@ static void _pages_ref_inc(struct rt_page *p, rt_uint32_t size_bits)
 
     page_head = page_start + idx;
     page_head = (void *)((char *)page_head + early_offset);
-    page_head->ref_cnt++;
+    rt_atomic_add(&page_head->ref_cnt, 1);
 }
 
 static int _pages_ref_get(struct rt_page *p, rt_uint32_t size_bits)
@@ -325,7 +341,7 @@ static int _pages_ref_get(struct rt_page *p, rt_uint32_t size_bits)
     idx = idx & ~((1UL << size_bits) - 1);
 
     page_head = page_start + idx;
-    return page_head->ref_cnt;
+    return rt_atomic_load(&page_head->ref_cnt);
 }
 
 static int _pages_free(rt_page_t page_list[], struct rt_page *p, rt_uint32_t size_bits)
@@ -336,12 +352,11 @@ static int _pages_free(rt_page_t page_list[], struct rt_page *p, rt_uint32_t siz
     RT_ASSERT(p >= page_start);
     RT_ASSERT((char *)p < (char *)rt_mpr_start + rt_mpr_size);
     RT_ASSERT(rt_kmem_v2p(p));
-    RT_ASSERT(p->ref_cnt > 0);
+    RT_ASSERT(rt_atomic_load(&p->ref_cnt) > 0);
     RT_ASSERT(p->size_bits == ARCH_ADDRESS_WIDTH_BITS);
     RT_ASSERT(size_bits < RT_PAGE_MAX_ORDER);
 
-    p->ref_cnt--;
-    if (p->ref_cnt != 0)
+    if (rt_atomic_sub(&p->ref_cnt, 1) != 1)
     {
         return 0;
     }
@@ -399,7 +414,7 @@ static struct rt_page *_pages_alloc(rt_page_t page_list[], rt_uint32_t size_bits
         }
     }
     p->size_bits = ARCH_ADDRESS_WIDTH_BITS;
-    p->ref_cnt = 1;
+    rt_atomic_store(&p->ref_cnt, 1);
     return p;
 }
 
@@ -423,6 +438,7 @@ static void _early_page_remove(rt_page_t page_list[], rt_page_t page, rt_uint32_
     }
 
     page_cont->size_bits = ARCH_ADDRESS_WIDTH_BITS;
+    FREE_PAGES_SUB(size_bits);
 }
 
 static void _early_page_insert(rt_page_t page_list[], rt_page_t page, int size_bits)
@@ -440,6 +456,7 @@ static void _early_page_insert(rt_page_t page_list[], rt_page_t page, int size_b
     page_cont->pre = 0;
     page_list[size_bits] = page;
     page_cont->size_bits = size_bits;
+    FREE_PAGES_ADD(size_bits);
 }
 
 static struct rt_page *_early_pages_alloc(rt_page_t page_list[], rt_uint32_t size_bits)
@@ -478,7 +495,7 @@ static struct rt_page *_early_pages_alloc(rt_page_t page_list[], rt_uint32_t siz
     }
     rt_page_t page_cont = (rt_page_t)((char *)p + early_offset);
     page_cont->size_bits = ARCH_ADDRESS_WIDTH_BITS;
-    page_cont->ref_cnt = 1;
+    rt_atomic_store(&page_cont->ref_cnt, 1);
     return p;
 }
 
@@ -497,28 +514,21 @@ static rt_page_t *_get_page_list(void *vaddr)
     return list;
 }
 
+/* the reference count is atomic, no lock is required to update it */
 int rt_page_ref_get(void *addr, rt_uint32_t size_bits)
 {
     struct rt_page *p;
-    rt_base_t level;
-    int ref;
 
     p = rt_page_addr2page(addr);
-    level = rt_spin_lock_irqsave(&_spinlock);
-    ref = _pages_ref_get(p, size_bits);
-    rt_spin_unlock_irqrestore(&_spinlock, level);
-    return ref;
+    return _pages_ref_get(p, size_bits);
 }
 
 void rt_page_ref_inc(void *addr, rt_uint32_t size_bits)
 {
     struct rt_page *p;
-    rt_base_t level;
 
     p = rt_page_addr2page(addr);
-    level = rt_spin_lock_irqsave(&_spinlock);
     _pages_ref_inc(p, size_bits);
-    rt_spin_unlock_irqrestore(&_spinlock, level);
 }
 
 static rt_page_t (*pages_alloc_handler)(rt_page_t page_list[], rt_uint32_t size_bits);
@@ -540,32 +550,346 @@ static rt_page_t *_flag_to_page_list(size_t flags)
     return page_list;
 }
 
-rt_inline void *_do_pages_alloc(rt_uint32_t size_bits, size_t flags)
+#ifdef RT_MM_PAGE_PCP
+/**
+ * Per-CPU cache of order-0 pages, one list for each of the low and high page
+ * lists. A page is freed to the hot end and allocated from the hot end, so the
+ * page likely still in the data cache is reused first; the cache is refilled
+ * from and drained to the buddy system in batch, taking the pages of the cold
+ * end back. Pages in cache are neither free in buddy system (so they are never
+ * merged) nor referenced.
+ *
+ * The lock of cache is taken only by its own CPU except on draining all the
+ * caches for a high order allocation, so it's hardly contended.
+ */
+struct _pcp_list
 {
-    void *alloc_buf = RT_NULL;
-    struct rt_page *p;
+    rt_page_t hot;
+    rt_page_t cold;
+    rt_size_t count;
+};
+
+struct _pcp_cache
+{
+    struct rt_spinlock lock;
+    struct _pcp_list list[2];
+
+    /* statistics */
+    rt_size_t alloc_nr;
+    rt_size_t refill_nr;
+    rt_size_t free_nr;
+    rt_size_t drain_nr;
+};
+
+static struct _pcp_cache _pcp[RT_CPUS_NR];
+static rt_bool_t _pcp_ready;
+
+#define PCP_LIST_IDX(page_list) ((page_list) == page_list_high ? 1 : 0)
+#define PCP_PAGE_LIST(idx)      ((idx) ? page_list_high : page_list_low)
+
+rt_inline struct _pcp_cache *_pcp_self(void)
+{
+#ifdef RT_USING_SMP
+    return &_pcp[rt_hw_cpu_id()];
+#else
+    return &_pcp[0];
+#endif
+}
+
+static void _pcp_push_hot(struct _pcp_list *list, rt_page_t p)
+{
+    p->pre = RT_NULL;
+    p->next = list->hot;
+    if (list->hot)
+        list->hot->pre = p;
+    else
+        list->cold = p;
+    list->hot = p;
+    list->count++;
+}
+
+static rt_page_t _pcp_pop_hot(struct _pcp_list *list)
+{
+    rt_page_t p = list->hot;
+
+    if (p)
+    {
+        list->hot = p->next;
+        if (list->hot)
+            list->hot->pre = RT_NULL;
+        else
+            list->cold = RT_NULL;
+        list->count--;
+    }
+    return p;
+}
+
+static rt_page_t _pcp_pop_cold(struct _pcp_list *list)
+{
+    rt_page_t p = list->cold;
+
+    if (p)
+    {
+        list->cold = p->pre;
+        if (list->cold)
+            list->cold->next = RT_NULL;
+        else
+            list->hot = RT_NULL;
+        list->count--;
+    }
+    return p;
+}
+
+/* move the pages from buddy system to cache, with the lock of cache taken */
+static void _pcp_refill(struct _pcp_cache *cache, int idx)
+{
+    rt_page_t p;
+
+    rt_spin_lock(&_spinlock);
+    for (int i = 0; i < RT_MM_PAGE_PCP_BATCH; i++)
+    {
+        p = _pages_alloc(PCP_PAGE_LIST(idx), 0);
+        if (!p)
+            break;
+        rt_atomic_store(&p->ref_cnt, 0);
+        _pcp_push_hot(&cache->list[idx], p);
+    }
+    rt_spin_unlock(&_spinlock);
+    cache->refill_nr++;
+}
+
+/* return the cold pages to buddy system, with the lock of cache taken */
+static rt_size_t _pcp_drain(struct _pcp_cache *cache, int idx, rt_size_t count)
+{
+    rt_page_t p;
+    rt_size_t drained;
+
+    rt_spin_lock(&_spinlock);
+    for (drained = 0; drained < count; drained++)
+    {
+        p = _pcp_pop_cold(&cache->list[idx]);
+        if (!p)
+            break;
+        rt_atomic_store(&p->ref_cnt, 1);
+        _pages_free(PCP_PAGE_LIST(idx), p, 0);
+    }
+    rt_spin_unlock(&_spinlock);
+    cache->drain_nr++;
+
+    return drained;
+}
+
+static rt_page_t _pcp_alloc(rt_page_t page_list[])
+{
+    struct _pcp_cache *cache;
+    rt_page_t p;
     rt_base_t level;
-    rt_page_t *page_list = _flag_to_page_list(flags);
+    int idx = PCP_LIST_IDX(page_list);
+
+    cache = _pcp_self();
+    level = rt_spin_lock_irqsave(&cache->lock);
+    if (!cache->list[idx].count)
+        _pcp_refill(cache, idx);
+
+    p = _pcp_pop_hot(&cache->list[idx]);
+    if (p)
+    {
+        rt_atomic_store(&p->ref_cnt, 1);
+        cache->alloc_nr++;
+    }
+    rt_spin_unlock_irqrestore(&cache->lock, level);
+
+    return p;
+}
+
+static int _pcp_free(rt_page_t page_list[], rt_page_t p)
+{
+    struct _pcp_cache *cache;
+    rt_base_t level;
+    int idx = PCP_LIST_IDX(page_list);
+
+    RT_ASSERT(rt_atomic_load(&p->ref_cnt) > 0);
+    RT_ASSERT(p->size_bits == ARCH_ADDRESS_WIDTH_BITS);
+
+    if (rt_atomic_sub(&p->ref_cnt, 1) != 1)
+        return 0;
+
+#ifdef RT_DEBUGING_PAGE_LEAK
+    level = rt_spin_lock_irqsave(&_spinlock);
+    TRACE_FREE(p, 0);
+    rt_spin_unlock_irqrestore(&_spinlock, level);
+#endif /* RT_DEBUGING_PAGE_LEAK */
+
+    cache = _pcp_self();
+    level = rt_spin_lock_irqsave(&cache->lock);
+    _pcp_push_hot(&cache->list[idx], p);
+    cache->free_nr++;
+    if (cache->list[idx].count > RT_MM_PAGE_PCP_HIGH)
+        _pcp_drain(cache, idx, RT_MM_PAGE_PCP_BATCH);
+    rt_spin_unlock_irqrestore(&cache->lock, level);
+
+    return 1;
+}
+
+/* return up to nr_pages cached pages from the cold ends, so they can be merged */
+static rt_size_t _pcp_drain_caches(rt_size_t nr_pages)
+{
+    struct _pcp_cache *cache;
+    rt_base_t level;
+    rt_size_t drained = 0, count;
+
+    for (int cpu = 0; cpu < RT_CPUS_NR && drained < nr_pages; cpu++)
+    {
+        cache = &_pcp[cpu];
+        level = rt_spin_lock_irqsave(&cache->lock);
+        for (int idx = 0; idx < 2 && drained < nr_pages; idx++)
+        {
+            count = cache->list[idx].count;
+            if (count > nr_pages - drained)
+                count = nr_pages - drained;
+            if (count)
+                drained += _pcp_drain(cache, idx, count);
+        }
+        rt_spin_unlock_irqrestore(&cache->lock, level);
+    }
+    return drained;
+}
+
+/* return all the cached pages for high order request */
+rt_inline rt_size_t _pcp_drain_all(void)
+{
+    return _pcp_drain_caches((rt_size_t)-1);
+}
+
+static rt_size_t _pcp_count(int idx)
+{
+    rt_size_t count = 0;
+
+    for (int cpu = 0; cpu < RT_CPUS_NR; cpu++)
+        count += _pcp[cpu].list[idx].count;
+    return count;
+}
+
+static void _pcp_init(void)
+{
+    for (int cpu = 0; cpu < RT_CPUS_NR; cpu++)
+        rt_spin_lock_init(&_pcp[cpu].lock);
+    _pcp_ready = RT_TRUE;
+}
+
+#ifdef RT_MM_RECLAIM
+static rt_size_t _pcp_shrink_count(struct rt_shrinker *shrinker)
+{
+    return _pcp_count(0) + _pcp_count(1);
+}
+
+static rt_size_t _pcp_shrink_scan(struct rt_shrinker *shrinker, rt_size_t nr_to_scan)
+{
+    return _pcp_drain_caches(nr_to_scan);
+}
+
+static struct rt_shrinker _pcp_shrinker = {
+    .name = "page-pcp",
+    .priority = RT_SHRINKER_PRIO_PAGE,
+    .count = _pcp_shrink_count,
+    .scan = _pcp_shrink_scan,
+};
+
+static int _pcp_shrinker_init(void)
+{
+    rt_shrinker_register(&_pcp_shrinker);
+    return 0;
+}
+INIT_COMPONENT_EXPORT(_pcp_shrinker_init);
+#endif /* RT_MM_RECLAIM */
+#endif /* RT_MM_PAGE_PCP */
+
+static rt_page_t _alloc_from(rt_page_t page_list[], rt_uint32_t size_bits)
+{
+    rt_page_t p;
+    rt_base_t level;
+
+#ifdef RT_MM_PAGE_PCP
+    if (size_bits == 0 && _pcp_ready)
+    {
+        p = _pcp_alloc(page_list);
+        /* the free pages may be parked in the caches of other CPUs */
+        if (!p && _pcp_drain_all())
+            p = _pcp_alloc(page_list);
+        return p;
+    }
+#endif /* RT_MM_PAGE_PCP */
 
     level = rt_spin_lock_irqsave(&_spinlock);
     p = pages_alloc_handler(page_list, size_bits);
     rt_spin_unlock_irqrestore(&_spinlock, level);
 
+#ifdef RT_MM_PAGE_PCP
+    /* the missing buddies may be parked in the per-CPU caches */
+    if (!p && _pcp_ready && _pcp_drain_all())
+    {
+        level = rt_spin_lock_irqsave(&_spinlock);
+        p = pages_alloc_handler(page_list, size_bits);
+        rt_spin_unlock_irqrestore(&_spinlock, level);
+    }
+#endif /* RT_MM_PAGE_PCP */
+
+    return p;
+}
+
+#ifdef RT_MM_RECLAIM
+static rt_size_t _free_pages_fast(void)
+{
+#ifdef RT_MM_PAGE_PCP
+    return _free_pages_nr + _pcp_count(0) + _pcp_count(1);
+#else
+    return _free_pages_nr;
+#endif /* RT_MM_PAGE_PCP */
+}
+#endif /* RT_MM_RECLAIM */
+
+static rt_page_t _alloc_fallback(rt_page_t page_list[], rt_uint32_t size_bits)
+{
+    rt_page_t p;
+
+    p = _alloc_from(page_list, size_bits);
+
     if (!p && page_list != page_list_low)
     {
         /* fall back */
         page_list = page_list_low;
+        p = _alloc_from(page_list, size_bits);
+    }
+    return p;
+}
 
-        level = rt_spin_lock_irqsave(&_spinlock);
-        p = pages_alloc_handler(page_list, size_bits);
-        rt_spin_unlock_irqrestore(&_spinlock, level);
+rt_inline void *_do_pages_alloc(rt_uint32_t size_bits, size_t flags)
+{
+    void *alloc_buf = RT_NULL;
+    struct rt_page *p;
+    rt_page_t *page_list = _flag_to_page_list(flags);
+
+    p = _alloc_fallback(page_list, size_bits);
+
+#ifdef RT_MM_RECLAIM
+    if (!p)
+    {
+        /* retry once if the shrinkers gave something back */
+        if (rt_mm_reclaim_on_failure(1UL << size_bits))
+            p = _alloc_fallback(page_list, size_bits);
+    }
+    else if (rt_mm_reclaim_below_low(_free_pages_fast()))
+    {
+        rt_mm_reclaim_wakeup();
     }
+#endif /* RT_MM_RECLAIM */
 
     if (p)
     {
         alloc_buf = page_to_addr(p);
 
         #ifdef RT_DEBUGING_PAGE_LEAK
+            rt_base_t level;
             level = rt_spin_lock_irqsave(&_spinlock);
             TRACE_ALLOC(p, size_bits);
             rt_spin_unlock_irqrestore(&_spinlock, level);
@@ -594,6 +918,12 @@ int rt_pages_free(void *addr, rt_uint32_t size_bits)
     if (p)
     {
         rt_base_t level;
+
+#ifdef RT_MM_PAGE_PCP
+        if (size_bits == 0 && _pcp_ready)
+            return _pcp_free(page_list, p);
+#endif /* RT_MM_PAGE_PCP */
+
         level = rt_spin_lock_irqsave(&_spinlock);
         real_free = _pages_free(page_list, p, size_bits);
         if (real_free)
@@ -604,6 +934,35 @@ int rt_pages_free(void *addr, rt_uint32_t size_bits)
     return real_free;
 }
 
+void rt_pages_split(void *addr, rt_uint32_t size_bits)
+{
+    struct rt_page *p;
+    rt_base_t level;
+    rt_size_t i;
+
+    p = rt_page_addr2page(addr);
+    if (p)
+    {
+        level = rt_spin_lock_irqsave(&_spinlock);
+        RT_ASSERT(p->size_bits == ARCH_ADDRESS_WIDTH_BITS);
+        RT_ASSERT(rt_atomic_load(&p->ref_cnt) == 1);
+
+#ifdef RT_DEBUGING_PAGE_LEAK
+        rt_atomic_store(&p->ref_cnt, 0);
+        TRACE_FREE(p, size_bits);
+#endif /* RT_DEBUGING_PAGE_LEAK */
+
+        /* every page of the group is an allocated group of order 0 now */
+        for (i = 0; i < (1ul << size_bits); i++)
+        {
+            p[i].size_bits = ARCH_ADDRESS_WIDTH_BITS;
+            rt_atomic_store(&p[i].ref_cnt, 1);
+            TRACE_ALLOC(&p[i], 0);
+        }
+        rt_spin_unlock_irqrestore(&_spinlock, level);
+    }
+}
+
 void rt_page_list(void) __attribute__((alias("list_page")));
 
 #define PGNR2SIZE(nr) ((nr) * ARCH_PAGE_SIZE / 1024)
@@ -640,6 +999,21 @@ void list_page(void)
     }
 
     rt_spin_unlock_irqrestore(&_spinlock, level);
+
+#ifdef RT_MM_PAGE_PCP
+    rt_kprintf("-------------------------------\n");
+    rt_kprintf("Per-CPU cache (batch %d, high %d):\n", RT_MM_PAGE_PCP_BATCH, RT_MM_PAGE_PCP_HIGH);
+    for (i = 0; i < RT_CPUS_NR; i++)
+    {
+        struct _pcp_cache *cache = &_pcp[i];
+
+        rt_kprintf(" cpu %d: cached %ld/%ld alloc %ld (refill %ld) free %ld (drain %ld)\n", i,
+                   cache->list[0].count, cache->list[1].count, cache->alloc_nr,
+                   cache->refill_nr, cache->free_nr, cache->drain_nr);
+        free += cache->list[0].count + cache->list[1].count;
+    }
+#endif /* RT_MM_PAGE_PCP */
+
     rt_kprintf("-------------------------------\n");
     rt_kprintf("Page Summary:\n => free/installed: 0x%lx/0x%lx (%ld/%ld KB)\n", free, installed, PGNR2SIZE(free), PGNR2SIZE(installed));
     rt_kprintf("-------------------------------\n");
@@ -674,6 +1048,11 @@ void rt_page_get_info(rt_size_t *total_nr, rt_size_t *free_nr)
         }
     }
     rt_spin_unlock_irqrestore(&_spinlock, level);
+
+#ifdef RT_MM_PAGE_PCP
+    total_free += _pcp_count(0) + _pcp_count(1);
+#endif /* RT_MM_PAGE_PCP */
+
     *total_nr = page_nr;
     *free_nr = total_free;
 }
@@ -696,6 +1075,11 @@ void rt_page_high_get_info(rt_size_t *total_nr, rt_size_t *free_nr)
         }
     }
     rt_spin_unlock_irqrestore(&_spinlock, level);
+
+#ifdef RT_MM_PAGE_PCP
+    total_free += _pcp_count(1);
+#endif /* RT_MM_PAGE_PCP */
+
     *total_nr = _high_pages_nr;
     *free_nr = total_free;
 }
@@ -747,7 +1131,7 @@ static void _install_page(rt_page_t mpr_head, rt_region_t region, void *insert_h
 
         p = addr_to_page(mpr_head, (void *)region.start);
         p->size_bits = ARCH_ADDRESS_WIDTH_BITS;
-        p->ref_cnt = 0;
+        rt_atomic_store(&p->ref_cnt, 0);
 
         /* insert to list */
         rt_page_t *page_list = _get_page_list((void *)region.start);
@@ -890,4 +1274,8 @@ void rt_page_cleanup(void)
 {
     early_offset = 0;
     pages_alloc_handler = _pages_alloc;
+
+#ifdef RT_MM_PAGE_PCP
+    _pcp_init();
+#endif /* RT_MM_PAGE_PCP */
 }
@@ -8,6 +8,8 @@
  * 2019-11-01     Jesven       The first version
  * 2022-12-13     WangXiaoyao  Hot-pluggable, extensible
  *                             page management algorithm
+ * 2026-10-19     agent        Split a page group into single pages
+ * 2026-10-19     agent        Atomic page reference count
  */
 #ifndef __MM_PAGE_H__
 #define __MM_PAGE_H__
@@ -52,7 +54,7 @@ DEF_PAGE_T(
     DEBUG_FIELD;
 
     rt_uint32_t size_bits;     /* if is ARCH_ADDRESS_WIDTH_BITS, means not free */
-    rt_uint32_t ref_cnt;       /* page group ref count */
+    rt_atomic_t ref_cnt;       /* page group ref count */
 );
 
 #undef GET_FLOOR
@@ -83,6 +85,16 @@ int rt_page_ref_get(void *addr, rt_uint32_t size_bits);
 
 int rt_pages_free(void *addr, rt_uint32_t size_bits);
 
+/**
+ * @brief Split an allocated page group of 2^size_bits pages into single
+ * pages, each one holding a reference. The pages are then freed one by one
+ * with rt_pages_free(addr, 0), which merges them back to the group.
+ *
+ * @param addr start of the page group, whose reference count must be 1
+ * @param size_bits order of the page group
+ */
+void rt_pages_split(void *addr, rt_uint32_t size_bits);
+
 void rt_page_list(void);
 
 rt_size_t rt_page_bits(rt_size_t size);
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#define DBG_TAG "mm.shrinker"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include "mm_page.h"
+#include "mm_shrinker.h"
+
+#ifdef RT_MM_RECLAIM
+
+#ifndef RT_MM_RECLAIM_LOW_PAGES
+#define RT_MM_RECLAIM_LOW_PAGES     128
+#endif
+
+#ifndef RT_MM_RECLAIM_HIGH_PAGES
+#define RT_MM_RECLAIM_HIGH_PAGES    256
+#endif
+
+#if RT_MM_RECLAIM_HIGH_PAGES <= RT_MM_RECLAIM_LOW_PAGES
+#error "RT_MM_RECLAIM_HIGH_PAGES must be above RT_MM_RECLAIM_LOW_PAGES"
+#endif
+
+#ifndef RT_MM_RECLAIM_WAIT_MS
+#define RT_MM_RECLAIM_WAIT_MS       100
+#endif
+
+#define RECLAIM_THREAD_STACK_SIZE   4096
+#define RECLAIM_THREAD_PRIORITY     (RT_THREAD_PRIORITY_MAX / 4)
+
+static rt_list_t _shrinkers = RT_LIST_OBJECT_INIT(_shrinkers);
+static struct rt_mutex _shrinker_lock;
+
+static struct rt_semaphore _reclaim_sem;
+static rt_thread_t _reclaim_thread;
+static rt_bool_t _reclaim_ready;
+
+/* pages requested by the failed allocations */
+static rt_atomic_t _reclaim_request;
+static rt_atomic_t _reclaim_pending;
+
+/* rounds of the reclaim thread, a waiter waits a round started after it */
+static rt_atomic_t _reclaim_started;
+static rt_atomic_t _reclaim_done;
+
+/* the waiters of the reclaim thread, each is signalled at the end of a round */
+static struct rt_semaphore _reclaim_done_sem;
+static rt_atomic_t _reclaim_waiters;
+
+/* statistics */
+static rt_atomic_t _stat_wakeup;
+static rt_atomic_t _stat_failure;
+static rt_atomic_t _stat_reclaimed;
+
+void rt_shrinker_register(rt_shrinker_t shrinker)
+{
+    rt_list_t *node;
+
+    RT_ASSERT(shrinker && shrinker->count && shrinker->scan);
+    shrinker->calls = 0;
+    shrinker->reclaimed = 0;
+
+    rt_mutex_take(&_shrinker_lock, RT_WAITING_FOREVER);
+    rt_list_for_each(node, &_shrinkers)
+    {
+        if (rt_list_entry(node, struct rt_shrinker, node)->priority > shrinker->priority)
+            break;
+    }
+    rt_list_insert_before(node, &shrinker->node);
+    rt_mutex_release(&_shrinker_lock);
+}
+
+void rt_shrinker_unregister(rt_shrinker_t shrinker)
+{
+    RT_ASSERT(shrinker);
+
+    /* a shrinker is never removed in the middle of a reclaim */
+    rt_mutex_take(&_shrinker_lock, RT_WAITING_FOREVER);
+    rt_list_remove(&shrinker->node);
+    rt_mutex_release(&_shrinker_lock);
+}
+
+rt_size_t rt_mm_shrink(rt_size_t nr_pages)
+{
+    rt_shrinker_t shrinker;
+    rt_size_t freed = 0;
+    rt_size_t count, once;
+
+    RT_DEBUG_SCHEDULER_AVAILABLE(1);
+
+    rt_mutex_take(&_shrinker_lock, RT_WAITING_FOREVER);
+    rt_list_for_each_entry(shrinker, &_shrinkers, node)
+    {
+        if (freed >= nr_pages)
+            break;
+
+        count = shrinker->count(shrinker);
+        if (!count)
+            continue;
+
+        once = shrinker->scan(shrinker, count < nr_pages - freed ? count : nr_pages - freed);
+        shrinker->calls++;
+        shrinker->reclaimed += once;
+        freed += once;
+        LOG_D("%s: %s freed %ld/%ld pages", __func__, shrinker->name, once, count);
+    }
+    rt_mutex_release(&_shrinker_lock);
+
+    rt_atomic_add(&_stat_reclaimed, freed);
+    return freed;
+}
+
+void rt_mm_reclaim_wakeup(void)
+{
+    if (_reclaim_ready && rt_atomic_exchange(&_reclaim_pending, 1) == 0)
+    {
+        rt_atomic_add(&_stat_wakeup, 1);
+        rt_sem_release(&_reclaim_sem);
+    }
+}
+
+rt_bool_t rt_mm_reclaim_on_failure(rt_size_t nr_pages)
+{
+    rt_atomic_t started;
+    rt_atomic_t reclaimed;
+    rt_tick_t deadline;
+    rt_int32_t timeout;
+
+    if (!_reclaim_ready)
+        return RT_FALSE;
+
+    rt_atomic_add(&_stat_failure, 1);
+    rt_atomic_add(&_reclaim_request, nr_pages);
+    started = rt_atomic_load(&_reclaim_started);
+    reclaimed = rt_atomic_load(&_stat_reclaimed);
+    rt_mm_reclaim_wakeup();
+
+    /**
+     * never reclaim in the caller which may hold the locks a shrinker takes,
+     * but wait for the reclaim thread in a bounded time if it can sleep
+     */
+    if (rt_thread_self() == _reclaim_thread || !rt_scheduler_is_available())
+        return RT_FALSE;
+
+    /**
+     * a round already running may have read the requests before ours, the
+     * rounds run in order, so wait until the next round started is done
+     */
+    deadline = rt_tick_get() + rt_tick_from_millisecond(RT_MM_RECLAIM_WAIT_MS);
+    rt_atomic_add(&_reclaim_waiters, 1);
+    while (rt_atomic_load(&_reclaim_done) <= started)
+    {
+        timeout = (rt_int32_t)(deadline - rt_tick_get());
+        if (timeout <= 0 || rt_sem_take(&_reclaim_done_sem, timeout) != RT_EOK)
+            break;
+    }
+    rt_atomic_sub(&_reclaim_waiters, 1);
+
+    return rt_atomic_load(&_stat_reclaimed) != reclaimed;
+}
+
+static void _reclaim_entry(void *param)
+{
+    rt_size_t total, free;
+    rt_size_t target, request;
+
+    while (1)
+    {
+        rt_sem_take(&_reclaim_sem, RT_WAITING_FOREVER);
+        rt_atomic_store(&_reclaim_pending, 0);
+        rt_atomic_add(&_reclaim_started, 1);
+
+        /* refill to high watermark, or at least what the failures asked */
+        rt_page_get_info(&total, &free);
+        target = free < RT_MM_RECLAIM_HIGH_PAGES ? RT_MM_RECLAIM_HIGH_PAGES - free : 0;
+        request = rt_atomic_exchange(&_reclaim_request, 0);
+        if (target < request)
+            target = request;
+
+        if (target)
+            rt_mm_shrink(target);
+
+        /* a waiter counted after this sees the round done by itself */
+        rt_atomic_add(&_reclaim_done, 1);
+        for (rt_atomic_t waiters = rt_atomic_load(&_reclaim_waiters); waiters > 0; waiters--)
+            rt_sem_release(&_reclaim_done_sem);
+    }
+}
+
+rt_bool_t rt_mm_reclaim_below_low(rt_size_t free_pages)
+{
+    return free_pages < RT_MM_RECLAIM_LOW_PAGES;
+}
+
+static int rt_mm_reclaim_init(void)
+{
+    rt_mutex_init(&_shrinker_lock, "shrinker", RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_reclaim_sem, "reclaim", 0, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_reclaim_done_sem, "rcldone", 0, RT_IPC_FLAG_PRIO);
+
+    _reclaim_thread = rt_thread_create("mmreclaim", _reclaim_entry, RT_NULL,
+                                       RECLAIM_THREAD_STACK_SIZE, RECLAIM_THREAD_PRIORITY, 10);
+    if (!_reclaim_thread)
+    {
+        LOG_E("%s: failed to create reclaim thread", __func__);
+        return -RT_ENOMEM;
+    }
+    rt_thread_startup(_reclaim_thread);
+    _reclaim_ready = RT_TRUE;
+
+    return RT_EOK;
+}
+INIT_PREV_EXPORT(rt_mm_reclaim_init);
+
+#if defined(RT_USING_FINSH) && defined(FINSH_USING_MSH)
+static int list_shrinker(void)
+{
+    rt_shrinker_t shrinker;
+    rt_size_t total, free;
+
+    rt_page_get_info(&total, &free);
+    rt_kprintf("free pages %ld, watermark low %d high %d\n", free,
+               RT_MM_RECLAIM_LOW_PAGES, RT_MM_RECLAIM_HIGH_PAGES);
+    rt_kprintf("wakeup %ld, allocation failure %ld, reclaimed %ld pages\n",
+               (long)rt_atomic_load(&_stat_wakeup), (long)rt_atomic_load(&_stat_failure),
+               (long)rt_atomic_load(&_stat_reclaimed));
+
+    rt_kprintf("%-16s %4s %8s %8s %10s\n", "shrinker", "prio", "count", "calls", "reclaimed");
+    rt_mutex_take(&_shrinker_lock, RT_WAITING_FOREVER);
+    rt_list_for_each_entry(shrinker, &_shrinkers, node)
+    {
+        rt_kprintf("%-16s %4d %8ld %8ld %10ld\n", shrinker->name, shrinker->priority,
+                   shrinker->count(shrinker), shrinker->calls, shrinker->reclaimed);
+    }
+    rt_mutex_release(&_shrinker_lock);
+
+    return 0;
+}
+MSH_CMD_EXPORT(list_shrinker, show the shrinkers and reclaim statistics);
+#endif /* RT_USING_FINSH && FINSH_USING_MSH */
+
+#endif /* RT_MM_RECLAIM */
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+#ifndef __MM_SHRINKER_H__
+#define __MM_SHRINKER_H__
+
+#include <rtthread.h>
+
+/**
+ * @brief A cache which can give memory back on memory pressure
+ *
+ * The shrinkers are called in order of priority (lower value first) by the
+ * reclaim thread, when an allocation of page frames fails or the free pages
+ * drop under the low watermark. They are always called in the context of a
+ * thread which holds none of the locks of the caller of page allocator, so a
+ * shrinker can sleep, but it should not wait for the memory to be allocated.
+ */
+struct rt_shrinker
+{
+    rt_list_t node;
+    const char *name;
+    int priority;
+
+    /**
+     * @brief Number of pages could be freed by the shrinker now
+     */
+    rt_size_t (*count)(struct rt_shrinker *shrinker);
+
+    /**
+     * @brief Try to free up to nr_to_scan pages
+     *
+     * @return rt_size_t number of pages freed, memory freed to the heap is
+     *         counted in pages rounded down
+     */
+    rt_size_t (*scan)(struct rt_shrinker *shrinker, rt_size_t nr_to_scan);
+
+    void *data;
+
+    /* statistics */
+    rt_size_t calls;
+    rt_size_t reclaimed;
+};
+typedef struct rt_shrinker *rt_shrinker_t;
+
+#define RT_SHRINKER_PRIO_PAGE   0   /* pages in the page allocator already */
+#define RT_SHRINKER_PRIO_CACHE  10  /* clean cache which is cheap to rebuild */
+#define RT_SHRINKER_PRIO_META   20  /* metadata cache of file system */
+
+void rt_shrinker_register(rt_shrinker_t shrinker);
+
+void rt_shrinker_unregister(rt_shrinker_t shrinker);
+
+/**
+ * @brief Call the shrinkers until nr_pages are freed or nothing more is
+ * freed. It may sleep.
+ *
+ * @return rt_size_t number of pages freed
+ */
+rt_size_t rt_mm_shrink(rt_size_t nr_pages);
+
+/**
+ * @brief Wake up the reclaim thread, which can be called in any context
+ */
+void rt_mm_reclaim_wakeup(void);
+
+/**
+ * @brief Reclaim on a failure of page allocation. In a context which can
+ * sleep, it waits the reclaim thread for a round of reclaim.
+ *
+ * @return rt_bool_t RT_TRUE if something is freed and allocation worth a retry
+ */
+rt_bool_t rt_mm_reclaim_on_failure(rt_size_t nr_pages);
+
+/**
+ * @brief Check the free pages against the low watermark of reclaim
+ */
+rt_bool_t rt_mm_reclaim_below_low(rt_size_t free_pages);
+
+#endif /* __MM_SHRINKER_H__ */
@@ -46,6 +46,9 @@
 #define AT_SOCKETS_NUM       AT_DEVICE_SOCKETS_NUM
 #endif
 
+/* the magic of a socket being freed, the entry is not reused until it is cleared */
+#define AT_SOCKET_FREE_MAGIC 0xA1FF
+
 typedef enum {
     AT_EVENT_SEND,
     AT_EVENT_RECV,
@@ -236,6 +239,172 @@ static size_t at_recvpkt_get(rt_slist_t *rlist, char *mem, size_t len)
     return content_pos;
 }
 
+#ifdef AT_SOCKET_USING_RECV_RING
+/* get the contiguous free space at the write position of receive ring */
+static rt_size_t at_recv_ring_reserve(struct rt_ringbuffer *rb, rt_uint8_t **ptr)
+{
+    rt_size_t space, tail;
+
+    space = rt_ringbuffer_space_len(rb);
+    tail = rb->buffer_size - rb->write_index;
+    *ptr = &rb->buffer_ptr[rb->write_index];
+
+    return space < tail ? space : tail;
+}
+
+/* commit the data which is written in place after at_recv_ring_reserve() */
+static void at_recv_ring_commit(struct rt_ringbuffer *rb, rt_size_t length)
+{
+    if (rb->buffer_size - rb->write_index > length)
+    {
+        rb->write_index += length;
+    }
+    else
+    {
+        rb->write_mirror = ~rb->write_mirror;
+        rb->write_index = length - (rb->buffer_size - rb->write_index);
+    }
+}
+
+/**
+ * The ring is full, pause the modem. The data on the way is kept in packet
+ * list once, and the one after that is dropped until the ring is drained.
+ *
+ * @return RT_TRUE if the rest of payload can be kept in packet list
+ */
+static rt_bool_t at_recv_ring_throttle(struct at_socket *sock)
+{
+    rt_bool_t keep = RT_FALSE;
+
+    if (rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER) != RT_EOK)
+    {
+        return RT_FALSE;
+    }
+    if (!sock->recv_throttled)
+    {
+        sock->recv_throttled = RT_TRUE;
+        keep = RT_TRUE;
+    }
+    rt_mutex_release(sock->recv_lock);
+
+    if (keep && sock->ops->at_recv_flowctrl)
+    {
+        sock->ops->at_recv_flowctrl(sock, RT_FALSE);
+    }
+
+    return keep;
+}
+#endif /* AT_SOCKET_USING_RECV_RING */
+
+/* get received data from AT socket, the receive ring is always older than packet list */
+static size_t at_recv_get(struct at_socket *sock, char *mem, size_t len)
+{
+    size_t recv_len = 0;
+#ifdef AT_SOCKET_USING_RECV_RING
+    rt_bool_t resume = RT_FALSE;
+#endif
+
+    rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER);
+#ifdef AT_SOCKET_USING_RECV_RING
+    if (sock->recv_ring)
+    {
+        recv_len = rt_ringbuffer_get(sock->recv_ring, (rt_uint8_t *)mem, len);
+    }
+#endif
+    if (recv_len < len)
+    {
+        recv_len += at_recvpkt_get(&(sock->recvpkt_list), mem + recv_len, len - recv_len);
+    }
+#ifdef AT_SOCKET_USING_RECV_RING
+    /* resume the modem when the data kept on the way is read and the ring is half empty */
+    if (sock->recv_ring && sock->recv_throttled && rt_slist_isempty(&sock->recvpkt_list)
+            && rt_ringbuffer_space_len(sock->recv_ring) >= rt_ringbuffer_get_size(sock->recv_ring) / 2)
+    {
+        sock->recv_throttled = RT_FALSE;
+        resume = RT_TRUE;
+    }
+#endif
+    rt_mutex_release(sock->recv_lock);
+
+#ifdef AT_SOCKET_USING_RECV_RING
+    if (resume && sock->ops->at_recv_flowctrl)
+    {
+        sock->ops->at_recv_flowctrl(sock, RT_TRUE);
+    }
+#endif
+
+    return recv_len;
+}
+
+/* enter the socket from AT client parser, it fails if the socket is closed or being freed */
+static rt_bool_t at_recv_enter(struct at_socket *sock)
+{
+    rt_bool_t entered = RT_FALSE;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (sock->magic == AT_SOCKET_MAGIC)
+    {
+        sock->recv_users++;
+        entered = RT_TRUE;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return entered;
+}
+
+static void at_recv_leave(struct at_socket *sock)
+{
+    rt_sem_t exit_sem = RT_NULL;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (--sock->recv_users == 0)
+    {
+        exit_sem = sock->recv_exit;
+    }
+    rt_hw_interrupt_enable(level);
+
+    /* free_socket() is waiting for the last one */
+    if (exit_sem)
+    {
+        rt_sem_release(exit_sem);
+    }
+}
+
+/* read the payload out of AT client and drop it, to keep the parser in step */
+static rt_size_t at_recv_discard(struct at_client *client, rt_size_t size, rt_int32_t timeout)
+{
+    char discard[32];
+    rt_size_t len = 0, read_len;
+
+    while (len < size)
+    {
+        read_len = at_client_obj_recv(client, discard,
+                                      size - len > sizeof(discard) ? sizeof(discard) : size - len, timeout);
+        if (read_len == 0)
+        {
+            break;
+        }
+        len += read_len;
+    }
+
+    return len;
+}
+
+/* check is there any received data in AT socket */
+static rt_bool_t at_recv_is_empty(struct at_socket *sock)
+{
+#ifdef AT_SOCKET_USING_RECV_RING
+    if (sock->recv_ring && rt_ringbuffer_data_len(sock->recv_ring) > 0)
+    {
+        return RT_FALSE;
+    }
+#endif
+
+    return rt_slist_isempty(&sock->recvpkt_list);
+}
+
 static void at_do_event_changes(struct at_socket *sock, at_event_t event, rt_bool_t is_plus)
 {
     switch (event)
@@ -394,6 +563,8 @@ static struct at_socket *alloc_socket_by_device(struct at_device *device, enum a
     sock->rcvevent = RT_NULL;
     sock->sendevent = RT_NULL;
     sock->errevent = RT_NULL;
+    sock->recv_users = 0;
+    sock->recv_exit = RT_NULL;
     rt_slist_init(&sock->recvpkt_list);
 #ifdef SAL_USING_POSIX
     rt_wqueue_init(&sock->wait_head);
@@ -416,6 +587,20 @@ static struct at_socket *alloc_socket_by_device(struct at_device *device, enum a
         goto __err;
     }
 
+#ifdef AT_SOCKET_USING_RECV_RING
+    /* the byte stream of TCP socket lands in receive ring, the datagram of UDP keeps packet list */
+    sock->recv_ring = RT_NULL;
+    sock->recv_throttled = RT_FALSE;
+    sock->recv_dropped = 0;
+    if (type == AT_SOCKET_TCP && (sock->recv_ring = rt_ringbuffer_create(AT_SOCKET_RECV_RING_SIZE)) == RT_NULL)
+    {
+        LOG_E("No memory for socket receive ring create.");
+        rt_sem_delete(sock->recv_notice);
+        rt_mutex_delete(sock->recv_lock);
+        goto __err;
+    }
+#endif
+
     rt_mutex_release(at_slock);
     return sock;
 
@@ -503,14 +688,33 @@ int at_socket(int domain, int type, int protocol)
 
 static int free_socket(struct at_socket *sock)
 {
-    if (sock->recv_notice)
+    struct rt_semaphore exit_sem;
+    rt_bool_t wait = RT_FALSE;
+    rt_base_t level;
+
+    /**
+     * no AT client parser enters the socket from now on, wait for the ones
+     * inside before the objects they use are torn down
+     */
+    rt_sem_init(&exit_sem, "at_free", 0, RT_IPC_FLAG_FIFO);
+    level = rt_hw_interrupt_disable();
+    sock->magic = AT_SOCKET_FREE_MAGIC;
+    if (sock->recv_users > 0)
     {
-        rt_sem_delete(sock->recv_notice);
+        sock->recv_exit = &exit_sem;
+        wait = RT_TRUE;
     }
+    rt_hw_interrupt_enable(level);
 
-    if (sock->recv_lock)
+    if (wait)
     {
-        rt_mutex_delete(sock->recv_lock);
+        rt_sem_take(&exit_sem, RT_WAITING_FOREVER);
+    }
+    rt_sem_detach(&exit_sem);
+
+    if (sock->recv_notice)
+    {
+        rt_sem_delete(sock->recv_notice);
     }
 
     if (!rt_slist_isempty(&sock->recvpkt_list))
@@ -518,6 +722,19 @@ static int free_socket(struct at_socket *sock)
         at_recvpkt_all_delete(&sock->recvpkt_list);
     }
 
+#ifdef AT_SOCKET_USING_RECV_RING
+    if (sock->recv_ring)
+    {
+        rt_ringbuffer_destroy(sock->recv_ring);
+        sock->recv_ring = RT_NULL;
+    }
+#endif
+
+    if (sock->recv_lock)
+    {
+        rt_mutex_delete(sock->recv_lock);
+    }
+
     /* delect socket from socket list */
     {
         rt_base_t level;
@@ -529,13 +746,10 @@ static int free_socket(struct at_socket *sock)
         rt_slist_for_each(node, &_socket_list)
         {
             at_sock = rt_slist_entry(node, struct at_socket, list);
-            if (at_sock && sock->socket == at_sock->socket)
+            if (at_sock == sock)
             {
-                if (at_sock->magic == AT_SOCKET_MAGIC)
-                {
-                    rt_slist_remove(&_socket_list, &at_sock->list);
-                    break;
-                }
+                rt_slist_remove(&_socket_list, &at_sock->list);
+                break;
             }
         }
 
@@ -789,18 +1003,34 @@ static void at_recv_notice_cb(struct at_socket *sock, at_socket_evt_t event, con
     RT_ASSERT(event == AT_SOCKET_EVT_RECV);
 
     /* check the socket object status */
-    if (sock->magic != AT_SOCKET_MAGIC || sock->state == AT_SOCKET_CLOSED)
+    if (sock->state == AT_SOCKET_CLOSED || !at_recv_enter(sock))
     {
         rt_free((void *)buff);
         return;
     }
 
     /* put receive buffer to receiver packet list */
-    rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER);
+    if (rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER) != RT_EOK)
+    {
+        rt_free((void *)buff);
+        at_recv_leave(sock);
+        return;
+    }
+#ifdef AT_SOCKET_USING_RECV_RING
+    /* keep the order, the ring is used only when there is no older data in packet list */
+    if (sock->recv_ring && rt_slist_isempty(&sock->recvpkt_list)
+            && rt_ringbuffer_space_len(sock->recv_ring) >= bfsz)
+    {
+        rt_ringbuffer_put(sock->recv_ring, (const rt_uint8_t *)buff, bfsz);
+        rt_free((void *)buff);
+    }
+    else
+#endif
     if (at_recvpkt_put(&(sock->recvpkt_list), buff, bfsz) != RT_EOK)
     {
         rt_free((void *)buff);
         rt_mutex_release(sock->recv_lock);
+        at_recv_leave(sock);
         return;
     }
     rt_mutex_release(sock->recv_lock);
@@ -808,6 +1038,7 @@ static void at_recv_notice_cb(struct at_socket *sock, at_socket_evt_t event, con
     rt_sem_release(sock->recv_notice);
 
     at_do_event_changes(sock, AT_EVENT_RECV, RT_TRUE);
+    at_recv_leave(sock);
 }
 
 static void at_closed_notice_cb(struct at_socket *sock, at_socket_evt_t event, const char *buff, size_t bfsz)
@@ -815,7 +1046,7 @@ static void at_closed_notice_cb(struct at_socket *sock, at_socket_evt_t event, c
     RT_ASSERT(event == AT_SOCKET_EVT_CLOSED);
 
     /* check the socket object status */
-    if (sock->magic != AT_SOCKET_MAGIC)
+    if (!at_recv_enter(sock))
     {
         return;
     }
@@ -825,6 +1056,126 @@ static void at_closed_notice_cb(struct at_socket *sock, at_socket_evt_t event, c
 
     sock->state = AT_SOCKET_CLOSED;
     rt_sem_release(sock->recv_notice);
+    at_recv_leave(sock);
+}
+
+/**
+ * Receive the socket payload from AT client into the socket receive buffer.
+ * It should be called by AT device driver in the URC function of receiving
+ * data (eg: "+IPD"), instead of allocating a buffer for the AT_SOCKET_EVT_RECV
+ * callback. The payload lands in the socket receive ring in place when it is
+ * enabled, so recv() copies it only once.
+ *
+ * @param sock AT socket object
+ * @param client AT client object which the payload is received from
+ * @param size payload size
+ * @param timeout receive data timeout (ms)
+ *
+ * @return the size of payload consumed from AT client
+ */
+rt_size_t at_socket_recv_from_client(struct at_socket *sock, struct at_client *client, rt_size_t size, rt_int32_t timeout)
+{
+    rt_size_t recv_len = 0, len;
+    char *buff = RT_NULL;
+
+    RT_ASSERT(sock);
+    RT_ASSERT(client);
+
+    /* the payload of a socket closed is read out and dropped */
+    if (!at_recv_enter(sock))
+    {
+        return at_recv_discard(client, size, timeout);
+    }
+
+#ifdef AT_SOCKET_USING_RECV_RING
+    while (sock->recv_ring && recv_len < size)
+    {
+        rt_uint8_t *ptr = RT_NULL;
+        rt_size_t read_len;
+
+        if (rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER) != RT_EOK)
+        {
+            break;
+        }
+        len = rt_slist_isempty(&sock->recvpkt_list) ? at_recv_ring_reserve(sock->recv_ring, &ptr) : 0;
+        rt_mutex_release(sock->recv_lock);
+
+        if (len == 0)
+        {
+            break;
+        }
+        if (len > size - recv_len)
+        {
+            len = size - recv_len;
+        }
+
+        /**
+         * the reserved space is written by the parser only, and the ring is
+         * kept until it leaves, so the lock is not held on the UART
+         */
+        read_len = at_client_obj_recv(client, (char *)ptr, len, timeout);
+        if (read_len > 0 && rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER) == RT_EOK)
+        {
+            at_recv_ring_commit(sock->recv_ring, read_len);
+            rt_mutex_release(sock->recv_lock);
+        }
+
+        recv_len += read_len;
+        if (read_len < len)
+        {
+            LOG_W("AT socket (%d) receive payload timeout (%d/%d)!", sock->socket, recv_len, size);
+            goto __notice;
+        }
+    }
+
+    /* the ring is full, drop what the modem sends after it is paused */
+    if (sock->recv_ring && recv_len < size && !at_recv_ring_throttle(sock))
+    {
+        len = at_recv_discard(client, size - recv_len, timeout);
+        recv_len += len;
+        sock->recv_dropped += len;
+        LOG_W("AT socket (%d) receive ring is full, drop %d bytes!", sock->socket, len);
+        goto __notice;
+    }
+#endif /* AT_SOCKET_USING_RECV_RING */
+
+    if (recv_len < size)
+    {
+        len = size - recv_len;
+        buff = (char *) rt_malloc(len);
+        if (buff == RT_NULL)
+        {
+            LOG_E("No memory for socket (%d) receive buffer, drop %d bytes!", sock->socket, len);
+            /* the payload must be consumed to keep AT client in step */
+            recv_len += at_recv_discard(client, len, timeout);
+            goto __notice;
+        }
+
+        len = at_client_obj_recv(client, buff, len, timeout);
+        if (len == 0)
+        {
+            rt_free(buff);
+            goto __notice;
+        }
+        recv_len += len;
+
+        /* the buffer is released by callback */
+        at_recv_notice_cb(sock, AT_SOCKET_EVT_RECV, buff, len);
+        at_recv_leave(sock);
+        return recv_len;
+    }
+
+__notice:
+#ifdef AT_SOCKET_USING_RECV_RING
+    if (sock->recv_ring && recv_len > 0)
+    {
+        rt_sem_release(sock->recv_notice);
+        at_do_event_changes(sock, AT_EVENT_RECV, RT_TRUE);
+    }
+#endif
+    at_recv_leave(sock);
+
+    return recv_len;
 }
 
 #ifdef AT_USING_SOCKET_SERVER
@@ -1017,12 +1368,10 @@ int at_recvfrom(int socket, void *mem, size_t len, int flags, struct sockaddr *f
 
         rt_sem_control(sock->recv_notice, RT_IPC_CMD_RESET, RT_NULL);
         /* receive packet list last transmission of remaining data */
-        rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER);
-        recv_len = at_recvpkt_get(&(sock->recvpkt_list), (char *)mem, len);
-        rt_mutex_release(sock->recv_lock);
+        recv_len = at_recv_get(sock, (char *)mem, len);
         if (recv_len > 0)
         {
-            if (rt_slist_isempty(&sock->recvpkt_list))
+            if (at_recv_is_empty(sock))
             {
                 at_do_event_clean(sock, AT_EVENT_RECV);
             }
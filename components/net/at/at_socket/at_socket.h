@@ -27,6 +27,12 @@ extern "C" {
 #define AT_SOCKET_RECV_BFSZ            512
 #endif
 
+#ifdef AT_SOCKET_USING_RECV_RING
+#ifndef AT_SOCKET_RECV_RING_SIZE
+#define AT_SOCKET_RECV_RING_SIZE       4096
+#endif
+#endif /* AT_SOCKET_USING_RECV_RING */
+
 #define AT_DEFAULT_RECVMBOX_SIZE       10
 #define AT_DEFAULT_ACCEPTMBOX_SIZE     10
 
@@ -65,6 +71,7 @@ typedef enum
 
 struct at_socket;
 struct at_device;
+struct at_client;
 
 typedef void (*at_evt_cb_t)(struct at_socket *socket, at_socket_evt_t event, const char *buff, size_t bfsz);
 
@@ -83,6 +90,10 @@ struct at_socket_ops
 #ifdef AT_USING_SOCKET_SERVER
     int (*at_listen)(struct at_socket *socket, int backlog);
 #endif
+    /* optional, pause (enable is RT_FALSE) or resume the data delivery of the socket,
+     * the pause request is issued from the AT client parser thread, so it must not
+     * wait for an AT response there */
+    int (*at_recv_flowctrl)(struct at_socket *socket, rt_bool_t enable);
 };
 
 /* AT receive package list structure */
@@ -125,6 +136,17 @@ struct at_socket
     rt_sem_t recv_notice;
     rt_mutex_t recv_lock;
     rt_slist_t recvpkt_list;
+    /* AT client parser threads working on the socket, free_socket() waits for them */
+    uint16_t recv_users;
+    rt_sem_t recv_exit;
+#ifdef AT_SOCKET_USING_RECV_RING
+    /* TCP payload ring, filled in place by at_socket_recv_from_client() */
+    struct rt_ringbuffer *recv_ring;
+    /* the data delivery of modem is paused as the ring is full */
+    rt_bool_t recv_throttled;
+    /* bytes dropped as the modem kept sending after the pause */
+    rt_size_t recv_dropped;
+#endif
 
     /* timeout to wait for send or received data in milliseconds */
     int32_t recv_timeout;
@@ -170,6 +192,7 @@ int at_getaddrinfo(const char *nodename, const char *servname, const struct addr
 void at_freeaddrinfo(struct addrinfo *ai);
 
 struct at_socket *at_get_socket(int socket);
+rt_size_t at_socket_recv_from_client(struct at_socket *sock, struct at_client *client, rt_size_t size, rt_int32_t timeout);
 #ifdef AT_USING_SOCKET_SERVER
 struct at_socket *at_get_base_socket(int base_socket);
 #endif
@@ -36,6 +36,19 @@ extern "C" {
 #define AT_CLIENT_NUM_MAX              1
 #endif
 
+/* the size of AT client bulk receive buffer, data is read from device in this granularity */
+#ifndef AT_CLIENT_RECV_BULK_SIZE
+#define AT_CLIENT_RECV_BULK_SIZE       64
+#endif
+
+/* the number of URC lookup buckets, must be power of 2 */
+#ifndef AT_CLIENT_URC_HASH_SIZE
+#define AT_CLIENT_URC_HASH_SIZE        16
+#endif
+#if (AT_CLIENT_URC_HASH_SIZE & (AT_CLIENT_URC_HASH_SIZE - 1)) != 0
+#error "AT_CLIENT_URC_HASH_SIZE must be power of 2"
+#endif
+
 #define AT_CMD_EXPORT(_name_, _args_expr_, _test_, _query_, _setup_, _exec_)   \
     rt_used static const struct at_cmd __at_cmd_##_test_##_query_##_setup_##_exec_ rt_section("RtAtCmdTab") = \
     {                                                                          \
@@ -145,6 +158,29 @@ struct at_urc_table
 };
 typedef struct at_urc *at_urc_table_t;
 
+/* precomputed URC lookup entry, built when the URC table is set */
+struct at_urc_entry
+{
+    const struct at_urc *urc;
+    rt_uint16_t prefix_len;
+    rt_uint16_t suffix_len;
+    /* the first (up to 4) bytes of prefix and its mask, for fast rejection */
+    rt_uint32_t prefix_key;
+    rt_uint32_t prefix_mask;
+    /* next entry index in the same bucket, -1 is the end */
+    rt_int32_t next;
+};
+
+/* URC lookup index, hashed by the first 4 bytes of prefix */
+struct at_urc_index
+{
+    struct at_urc_entry *entry;
+    rt_size_t entry_num;
+    rt_int32_t hash[AT_CLIENT_URC_HASH_SIZE];
+    /* the entries with a prefix shorter than 4 bytes, they are checked on every line */
+    rt_int32_t short_prefix;
+};
+
 struct at_client
 {
     rt_device_t device;
@@ -164,6 +200,10 @@ struct at_client
     rt_size_t recv_line_len;
     /* The maximum supported receive data length */
     rt_size_t recv_bufsz;
+    /* bulk receive buffer, the device data is read in chunks into here */
+    char recv_bulk_buf[AT_CLIENT_RECV_BULK_SIZE];
+    rt_size_t recv_bulk_len;
+    rt_size_t recv_bulk_pos;
     rt_sem_t rx_notice;
     rt_mutex_t lock;
 
@@ -175,6 +215,10 @@ struct at_client
     rt_size_t urc_table_size;
     const struct at_urc *urc;
 
+    /* URC lookup index, replaced as a whole under urc_lock */
+    struct at_urc_index *urc_index;
+    struct rt_spinlock urc_lock;
+
     rt_thread_t parser;
 };
 typedef struct at_client *at_client_t;
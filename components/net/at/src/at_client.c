@@ -27,6 +27,10 @@
 #define AT_RESP_END_FAIL               "FAIL"
 #define AT_END_CR_LF                   "\r\n"
 
+/* the URC prefixes are hashed by their first bytes, which are packed into a key */
+#define AT_URC_KEY_LEN                 sizeof(rt_uint32_t)
+#define AT_URC_HASH(key)               ((((rt_uint32_t)(key) * 2654435761u) >> 24) & (AT_CLIENT_URC_HASH_SIZE - 1))
+
 static struct at_client at_client_table[AT_CLIENT_NUM_MAX] = { 0 };
 
 extern rt_size_t at_utils_send(rt_device_t dev,
@@ -444,17 +448,25 @@ static rt_err_t at_client_getchar(at_client_t client, char *ch, rt_int32_t timeo
 {
     rt_err_t result = RT_EOK;
 
-    while (rt_device_read(client->device, 0, ch, 1) == 0)
+    if (client->recv_bulk_pos >= client->recv_bulk_len)
     {
-        result = rt_sem_take(client->rx_notice, rt_tick_from_millisecond(timeout));
-        if (result != RT_EOK)
+        /* the bulk buffer is drained, read as much as possible from device */
+        client->recv_bulk_pos = 0;
+        while ((client->recv_bulk_len = rt_device_read(client->device, 0,
+                client->recv_bulk_buf, sizeof(client->recv_bulk_buf))) == 0)
         {
-            return result;
-        }
+            result = rt_sem_take(client->rx_notice, rt_tick_from_millisecond(timeout));
+            if (result != RT_EOK)
+            {
+                return result;
+            }
 
-        rt_sem_control(client->rx_notice, RT_IPC_CMD_RESET, RT_NULL);
+            rt_sem_control(client->rx_notice, RT_IPC_CMD_RESET, RT_NULL);
+        }
     }
 
+    *ch = client->recv_bulk_buf[client->recv_bulk_pos++];
+
     return RT_EOK;
 }
 
@@ -483,6 +495,20 @@ rt_size_t at_client_obj_recv(at_client_t client, char *buf, rt_size_t size, rt_i
         return 0;
     }
 
+    /* the data already in bulk buffer belongs to the caller first */
+    if (client->recv_bulk_pos < client->recv_bulk_len)
+    {
+        len = client->recv_bulk_len - client->recv_bulk_pos;
+        if (len > size)
+        {
+            len = size;
+        }
+
+        rt_memcpy(buf, client->recv_bulk_buf + client->recv_bulk_pos, len);
+        client->recv_bulk_pos += len;
+        size -= len;
+    }
+
     while (size)
     {
         rt_size_t read_len;
@@ -526,6 +552,103 @@ void at_obj_set_end_sign(at_client_t client, char ch)
     client->end_sign = ch;
 }
 
+static rt_uint32_t at_urc_key(const char *str, rt_size_t len)
+{
+    rt_size_t i;
+    rt_uint32_t key = 0;
+
+    for (i = 0; i < len && i < sizeof(key); i++)
+    {
+        key |= (rt_uint32_t)(rt_uint8_t)str[i] << (i * 8);
+    }
+
+    return key;
+}
+
+/*
+ * rebuild the URC lookup index from all URC tables, table order is kept in each bucket.
+ * The new index is built aside and replaces the old one as a whole, the parser may be
+ * looking up URC at the same time.
+ */
+static int at_urc_index_build(at_client_t client)
+{
+    rt_size_t i, j, num = 0;
+    rt_int32_t *tail, idx;
+    struct at_urc_index *index, *old_index;
+    struct at_urc_entry *entry;
+    rt_int32_t hash_tail[AT_CLIENT_URC_HASH_SIZE];
+    rt_int32_t short_tail = -1;
+
+    for (i = 0; i < client->urc_table_size; i++)
+    {
+        num += client->urc_table[i].urc_size;
+    }
+
+    index = (struct at_urc_index *) rt_calloc(1, sizeof(struct at_urc_index) + num * sizeof(struct at_urc_entry));
+    if (index == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+    index->entry = (struct at_urc_entry *) (index + 1);
+    index->entry_num = num;
+
+    index->short_prefix = -1;
+    for (i = 0; i < AT_CLIENT_URC_HASH_SIZE; i++)
+    {
+        index->hash[i] = -1;
+        hash_tail[i] = -1;
+    }
+
+    idx = 0;
+    for (i = 0; i < client->urc_table_size; i++)
+    {
+        for (j = 0; j < client->urc_table[i].urc_size; j++, idx++)
+        {
+            entry = &index->entry[idx];
+            entry->urc = client->urc_table[i].urc + j;
+            entry->prefix_len = rt_strlen(entry->urc->cmd_prefix);
+            entry->suffix_len = rt_strlen(entry->urc->cmd_suffix);
+            entry->prefix_key = at_urc_key(entry->urc->cmd_prefix, entry->prefix_len);
+            entry->prefix_mask = at_urc_key("\xff\xff\xff\xff", entry->prefix_len);
+            entry->next = -1;
+
+            if (entry->prefix_len < AT_URC_KEY_LEN)
+            {
+                tail = &short_tail;
+                if (*tail < 0)
+                    index->short_prefix = idx;
+            }
+            else
+            {
+                rt_uint32_t h = AT_URC_HASH(entry->prefix_key);
+
+                tail = &hash_tail[h];
+                if (*tail < 0)
+                    index->hash[h] = idx;
+            }
+
+            if (*tail >= 0)
+            {
+                index->entry[*tail].next = idx;
+            }
+            *tail = idx;
+        }
+    }
+
+    rt_spin_lock(&client->urc_lock);
+    old_index = client->urc_index;
+    client->urc_index = index;
+    rt_spin_unlock(&client->urc_lock);
+
+    /* the parser looks up under urc_lock, it is done with the old index here */
+    if (old_index)
+    {
+        rt_free(old_index);
+    }
+
+    return RT_EOK;
+}
+
 /**
  * set URC(Unsolicited Result Code) table
  *
@@ -578,7 +701,7 @@ int at_obj_set_urc_table(at_client_t client, const struct at_urc *urc_table, rt_
 
     }
 
-    return RT_EOK;
+    return at_urc_index_build(client);
 }
 
 /**
@@ -621,44 +744,90 @@ at_client_t at_client_get_first(void)
     return &at_client_table[0];
 }
 
+static rt_bool_t urc_entry_match(at_client_t client, const struct at_urc_entry *entry, rt_uint32_t line_key)
+{
+    const char *buffer = client->recv_line_buf;
+    rt_size_t bufsz = client->recv_line_len;
+
+    if (bufsz < (rt_size_t)entry->prefix_len + entry->suffix_len)
+    {
+        return RT_FALSE;
+    }
+
+    if ((line_key & entry->prefix_mask) != entry->prefix_key)
+    {
+        return RT_FALSE;
+    }
+
+    if (entry->prefix_len > sizeof(line_key)
+            && rt_memcmp(buffer, entry->urc->cmd_prefix, entry->prefix_len) != 0)
+    {
+        return RT_FALSE;
+    }
+
+    if (entry->suffix_len
+            && rt_memcmp(buffer + bufsz - entry->suffix_len, entry->urc->cmd_suffix, entry->suffix_len) != 0)
+    {
+        return RT_FALSE;
+    }
+
+    return RT_TRUE;
+}
+
 static const struct at_urc *get_urc_obj(at_client_t client)
 {
-    rt_size_t i, j, prefix_len, suffix_len;
-    rt_size_t bufsz;
-    char *buffer = RT_NULL;
+    rt_int32_t hash_idx, short_idx;
+    rt_uint32_t line_key;
+    const struct at_urc_index *index;
+    const struct at_urc_entry *entry;
     const struct at_urc *urc = RT_NULL;
-    struct at_urc_table *urc_table = RT_NULL;
 
-    if (client->urc_table == RT_NULL)
+    if (client->recv_line_len == 0)
     {
         return RT_NULL;
     }
 
-    buffer = client->recv_line_buf;
-    bufsz = client->recv_line_len;
+    /* only the entries which prefix starts with the first received bytes can match */
+    line_key = at_urc_key(client->recv_line_buf, client->recv_line_len);
 
-    for (i = 0; i < client->urc_table_size; i++)
+    rt_spin_lock(&client->urc_lock);
+    index = client->urc_index;
+    if (index == RT_NULL)
+    {
+        rt_spin_unlock(&client->urc_lock);
+        return RT_NULL;
+    }
+
+    hash_idx = -1;
+    if (client->recv_line_len >= AT_URC_KEY_LEN)
+    {
+        hash_idx = index->hash[AT_URC_HASH(line_key)];
+    }
+    short_idx = index->short_prefix;
+
+    /* merge the two sorted lists, the first matched entry in table order wins */
+    while (hash_idx >= 0 || short_idx >= 0)
     {
-        for (j = 0; j < client->urc_table[i].urc_size; j++)
+        if (short_idx < 0 || (hash_idx >= 0 && hash_idx < short_idx))
         {
-            urc_table = client->urc_table + i;
-            urc = urc_table->urc + j;
+            entry = &index->entry[hash_idx];
+            hash_idx = entry->next;
+        }
+        else
+        {
+            entry = &index->entry[short_idx];
+            short_idx = entry->next;
+        }
 
-            prefix_len = rt_strlen(urc->cmd_prefix);
-            suffix_len = rt_strlen(urc->cmd_suffix);
-            if (bufsz < prefix_len + suffix_len)
-            {
-                continue;
-            }
-            if ((prefix_len ? !rt_strncmp(buffer, urc->cmd_prefix, prefix_len) : 1)
-                    && (suffix_len ? !rt_strncmp(buffer + bufsz - suffix_len, urc->cmd_suffix, suffix_len) : 1))
-            {
-                return urc;
-            }
+        if (urc_entry_match(client, entry, line_key))
+        {
+            urc = entry->urc;
+            break;
         }
     }
+    rt_spin_unlock(&client->urc_lock);
 
-    return RT_NULL;
+    return urc;
 }
 
 static int at_recv_readline(at_client_t client)
@@ -856,6 +1025,10 @@ static int at_client_para_init(at_client_t client)
 
     client->urc_table = RT_NULL;
     client->urc_table_size = 0;
+    client->urc_index = RT_NULL;
+    rt_spin_lock_init(&client->urc_lock);
+    client->recv_bulk_len = 0;
+    client->recv_bulk_pos = 0;
 
     rt_snprintf(name, RT_NAME_MAX, "%s%d", AT_CLIENT_THREAD_NAME, at_client_num);
     client->parser = rt_thread_create(name,
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2019-03-18     ChenYong     First version
+ * 2026-10-19     agent        look up the netdev list under RCU
  */
 
 #include <stdio.h>
@@ -42,6 +43,37 @@ static netdev_callback_fn g_netdev_register_callback = RT_NULL;
 static netdev_callback_fn g_netdev_default_change_callback = RT_NULL;
 static RT_DEFINE_SPINLOCK(_spinlock);
 
+#ifdef RT_USING_RCU
+/* the lookups walk the list under RCU, only the writers take the spinlock */
+rt_inline rt_base_t _netdev_read_lock(void)
+{
+    rt_rcu_read_lock();
+    return 0;
+}
+
+rt_inline void _netdev_read_unlock(rt_base_t level)
+{
+    RT_UNUSED(level);
+    rt_rcu_read_unlock();
+}
+
+#define _netdev_list_head()             ((struct netdev *)rt_rcu_dereference(netdev_list))
+#define _netdev_list_publish(ptr, val)  rt_rcu_assign_pointer(ptr, val)
+#else
+rt_inline rt_base_t _netdev_read_lock(void)
+{
+    return rt_spin_lock_irqsave(&_spinlock);
+}
+
+rt_inline void _netdev_read_unlock(rt_base_t level)
+{
+    rt_spin_unlock_irqrestore(&_spinlock, level);
+}
+
+#define _netdev_list_head()             (netdev_list)
+#define _netdev_list_publish(ptr, val)  ((ptr) = (val))
+#endif /* RT_USING_RCU */
+
 /**
  * This function will register network interface device and
  * add it to network interface device list.
@@ -107,12 +139,12 @@ int netdev_register(struct netdev *netdev, const char *name, void *user_data)
 
     if (netdev_list == RT_NULL)
     {
-        netdev_list = netdev;
+        _netdev_list_publish(netdev_list, netdev);
     }
     else
     {
-        /* tail insertion */
-        rt_slist_append(&(netdev_list->list), &(netdev->list));
+        /* tail insertion, the netdev is published after it is filled */
+        _netdev_list_publish(rt_slist_tail(&(netdev_list->list))->next, &(netdev->list));
     }
 
     rt_spin_unlock_irqrestore(&_spinlock, level);
@@ -170,11 +202,11 @@ int netdev_unregister(struct netdev *netdev)
                 rt_slist_t *next = rt_slist_next(node);
                 if (next)
                 {
-                    netdev_list = rt_slist_entry(next, struct netdev, list);
+                    _netdev_list_publish(netdev_list, rt_slist_entry(next, struct netdev, list));
                 }
                 else
                 {
-                    netdev_list = RT_NULL;
+                    _netdev_list_publish(netdev_list, RT_NULL);
                 }
             }
             else
@@ -201,6 +233,10 @@ int netdev_unregister(struct netdev *netdev)
 
     if (cur_netdev == netdev)
     {
+#ifdef RT_USING_RCU
+        /* wait for the lookups still walking through it */
+        rt_rcu_synchronize();
+#endif /* RT_USING_RCU */
 #ifdef RT_USING_SAL
         extern int sal_netdev_cleanup(struct netdev *netdev);
         sal_netdev_cleanup(netdev);
@@ -236,25 +272,28 @@ struct netdev *netdev_get_first_by_flags(uint16_t flags)
     rt_base_t level;
     rt_slist_t *node = RT_NULL;
     struct netdev *netdev = RT_NULL;
+    struct netdev *head;
 
-    if (netdev_list == RT_NULL)
+    level = _netdev_read_lock();
+
+    head = _netdev_list_head();
+    if (head == RT_NULL)
     {
+        _netdev_read_unlock(level);
         return RT_NULL;
     }
 
-    level = rt_spin_lock_irqsave(&_spinlock);
-
-    for (node = &(netdev_list->list); node; node = rt_slist_next(node))
+    for (node = &(head->list); node; node = rt_slist_next(node))
     {
         netdev = rt_slist_entry(node, struct netdev, list);
         if (netdev && (netdev->flags & flags) != 0)
         {
-            rt_spin_unlock_irqrestore(&_spinlock, level);
+            _netdev_read_unlock(level);
             return netdev;
         }
     }
 
-    rt_spin_unlock_irqrestore(&_spinlock, level);
+    _netdev_read_unlock(level);
 
     return RT_NULL;
 }
@@ -273,25 +312,28 @@ struct netdev *netdev_get_by_ipaddr(ip_addr_t *ip_addr)
     rt_base_t level;
     rt_slist_t *node = RT_NULL;
     struct netdev *netdev = RT_NULL;
+    struct netdev *head;
 
-    if (netdev_list == RT_NULL)
+    level = _netdev_read_lock();
+
+    head = _netdev_list_head();
+    if (head == RT_NULL)
     {
+        _netdev_read_unlock(level);
         return RT_NULL;
     }
 
-    level = rt_spin_lock_irqsave(&_spinlock);
-
-    for (node = &(netdev_list->list); node; node = rt_slist_next(node))
+    for (node = &(head->list); node; node = rt_slist_next(node))
     {
         netdev = rt_slist_entry(node, struct netdev, list);
         if (netdev && ip_addr_cmp(&(netdev->ip_addr), ip_addr))
         {
-            rt_spin_unlock_irqrestore(&_spinlock, level);
+            _netdev_read_unlock(level);
             return netdev;
         }
     }
 
-    rt_spin_unlock_irqrestore(&_spinlock, level);
+    _netdev_read_unlock(level);
 
     return RT_NULL;
 }
@@ -310,25 +352,28 @@ struct netdev *netdev_get_by_name(const char *name)
     rt_base_t level;
     rt_slist_t *node = RT_NULL;
     struct netdev *netdev = RT_NULL;
+    struct netdev *head;
 
-    if (netdev_list == RT_NULL)
+    level = _netdev_read_lock();
+
+    head = _netdev_list_head();
+    if (head == RT_NULL)
     {
+        _netdev_read_unlock(level);
         return RT_NULL;
     }
 
-    level = rt_spin_lock_irqsave(&_spinlock);
-
-    for (node = &(netdev_list->list); node; node = rt_slist_next(node))
+    for (node = &(head->list); node; node = rt_slist_next(node))
     {
         netdev = rt_slist_entry(node, struct netdev, list);
         if (netdev && (rt_strncmp(netdev->name, name, rt_strlen(name) < RT_NAME_MAX ? rt_strlen(name) : RT_NAME_MAX) == 0))
         {
-            rt_spin_unlock_irqrestore(&_spinlock, level);
+            _netdev_read_unlock(level);
             return netdev;
         }
     }
 
-    rt_spin_unlock_irqrestore(&_spinlock, level);
+    _netdev_read_unlock(level);
 
     return RT_NULL;
 }
@@ -348,38 +393,41 @@ struct netdev *netdev_get_by_family(int family)
     rt_base_t level;
     rt_slist_t *node = RT_NULL;
     struct netdev *netdev = RT_NULL;
+    struct netdev *head;
     struct sal_proto_family *pf = RT_NULL;
 
-    if (netdev_list == RT_NULL)
+    level = _netdev_read_lock();
+
+    head = _netdev_list_head();
+    if (head == RT_NULL)
     {
+        _netdev_read_unlock(level);
         return RT_NULL;
     }
 
-    level = rt_spin_lock_irqsave(&_spinlock);
-
-    for (node = &(netdev_list->list); node; node = rt_slist_next(node))
+    for (node = &(head->list); node; node = rt_slist_next(node))
     {
         netdev = rt_slist_entry(node, struct netdev, list);
         pf = (struct sal_proto_family *) netdev->sal_user_data;
         if (pf && pf->skt_ops && pf->family == family && netdev_is_up(netdev))
         {
-            rt_spin_unlock_irqrestore(&_spinlock, level);
+            _netdev_read_unlock(level);
             return netdev;
         }
     }
 
-    for (node = &(netdev_list->list); node; node = rt_slist_next(node))
+    for (node = &(head->list); node; node = rt_slist_next(node))
     {
         netdev = rt_slist_entry(node, struct netdev, list);
         pf = (struct sal_proto_family *) netdev->sal_user_data;
         if (pf && pf->skt_ops && pf->sec_family == family && netdev_is_up(netdev))
         {
-            rt_spin_unlock_irqrestore(&_spinlock, level);
+            _netdev_read_unlock(level);
             return netdev;
         }
     }
 
-    rt_spin_unlock_irqrestore(&_spinlock, level);
+    _netdev_read_unlock(level);
 
     return RT_NULL;
 }
@@ -9,6 +9,7 @@
  */
 
 #include <rtthread.h>
+#include <sys/time.h>
 
 #include <lwip/sockets.h>
 #include <lwip/netdb.h>
@@ -244,6 +245,83 @@ int inet_ioctlsocket(int socket, long cmd, void *arg)
     }
 }
 
+#if LWIP_VERSION >= 0x20102ff
+/* the same layout as struct mmsghdr of SAL, based on the lwIP struct msghdr */
+struct inet_mmsghdr
+{
+    struct msghdr msg_hdr;
+    unsigned int  msg_len;
+};
+
+#ifndef MSG_WAITFORONE
+#define MSG_WAITFORONE  0x10000
+#endif
+
+static int inet_sendmmsg(int socket, struct mmsghdr *mmsgvec, unsigned int vlen, int flags)
+{
+    int ret;
+    unsigned int i;
+    struct inet_mmsghdr *msgvec = (struct inet_mmsghdr *)mmsgvec;
+
+    for (i = 0; i < vlen; i++)
+    {
+        ret = lwip_sendmsg(socket, &msgvec[i].msg_hdr, flags);
+        if (ret < 0)
+        {
+            break;
+        }
+        msgvec[i].msg_len = ret;
+    }
+
+    return (i > 0) ? (int)i : -1;
+}
+
+/*
+ * Drain the received datagrams of the socket in one call, every lwip_recvmsg()
+ * consumes one pbuf chain from the netconn receive mailbox. With MSG_WAITFORONE
+ * only the first datagram may block, the remaining ones are taken while they
+ * are already queued.
+ */
+static int inet_recvmmsg(int socket, struct mmsghdr *mmsgvec, unsigned int vlen, int flags,
+        struct timespec *timeout)
+{
+    int ret;
+    unsigned int i;
+    rt_tick_t start, wait = 0;
+    struct inet_mmsghdr *msgvec = (struct inet_mmsghdr *)mmsgvec;
+
+    if (timeout)
+    {
+        wait = rt_tick_from_millisecond(timeout->tv_sec * 1000 + timeout->tv_nsec / 1000000);
+    }
+    start = rt_tick_get();
+
+    for (i = 0; i < vlen; i++)
+    {
+        /* lwIP rejects the flags it does not know */
+        ret = lwip_recvmsg(socket, &msgvec[i].msg_hdr, flags & ~MSG_WAITFORONE);
+        if (ret < 0)
+        {
+            break;
+        }
+        msgvec[i].msg_len = ret;
+
+        if (flags & MSG_WAITFORONE)
+        {
+            flags |= MSG_DONTWAIT;
+        }
+        /* the timeout is only checked after a datagram is received, the same as Linux */
+        if (timeout && rt_tick_get() - start >= wait)
+        {
+            i++;
+            break;
+        }
+    }
+
+    return (i > 0) ? (int)i : -1;
+}
+#endif /* LWIP_VERSION >= 0x20102ff */
+
 #ifdef SAL_USING_POSIX
 static int inet_poll(struct dfs_file *file, struct rt_pollreq *req)
 {
@@ -313,6 +391,10 @@ static const struct sal_socket_ops lwip_socket_ops =
     .getsockname = inet_getsockname,
     .ioctlsocket = inet_ioctlsocket,
     .socketpair  = RT_NULL,
+#if LWIP_VERSION >= 0x20102ff
+    .sendmmsg    = inet_sendmmsg,
+    .recvmmsg    = inet_recvmmsg,
+#endif
 #ifdef SAL_USING_POSIX
     .poll        = inet_poll,
 #endif
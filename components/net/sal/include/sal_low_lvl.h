@@ -47,10 +47,13 @@ typedef uint32_t socklen_t;
 
 struct sockaddr;
 struct msghdr;
+struct mmsghdr;
+struct timespec;
 struct addrinfo;
 struct sal_socket
 {
     uint32_t magic;                    /* SAL socket magic word */
+    rt_atomic_t ref_count;             /* the socket table and the SAL calls in progress */
 
     int socket;                        /* SAL socket descriptor */
     int domain;
@@ -85,6 +88,8 @@ struct sal_socket_ops
     int (*getsockname)(int s, struct sockaddr *name, socklen_t *namelen);
     int (*ioctlsocket)(int s, long cmd, void *arg);
     int (*socketpair) (int s, int type, int protocol, int *fds);
+    int (*sendmmsg)   (int s, struct mmsghdr *msgvec, unsigned int vlen, int flags);
+    int (*recvmmsg)   (int s, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout);
 #ifdef SAL_USING_POSIX
     int (*poll)       (struct dfs_file *file, struct rt_pollreq *req);
 #endif
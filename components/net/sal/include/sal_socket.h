@@ -118,6 +118,7 @@ typedef uint16_t in_port_t;
 #define MSG_OOB         0x04    /* Unimplemented: Requests out-of-band data. The significance and semantics of out-of-band data are protocol-specific */
 #define MSG_DONTWAIT    0x08    /* Nonblocking i/o for this operation only */
 #define MSG_MORE        0x10    /* Sender will send more */
+#define MSG_WAITFORONE  0x10000 /* recvmmsg: nonblocking i/o after the first message */
 
 #define MSG_ERRQUEUE    0x2000  /* Fetch message from error queue */
 #define MSG_CONFIRM     0x0800  /* Confirm path validity */
@@ -250,6 +251,13 @@ struct msghdr
     int              msg_flags;
 };
 
+/* one entry of the recvmmsg/sendmmsg vector */
+struct mmsghdr
+{
+    struct msghdr    msg_hdr;
+    unsigned int     msg_len;   /* number of bytes transmitted */
+};
+
 /* RFC 3542, Section 20: Ancillary Data */
 struct cmsghdr
 {
@@ -330,6 +338,8 @@ struct sal_ifreq
     } ifr_ifru;
 };
 
+struct timespec;
+
 int sal_accept(int socket, struct sockaddr *addr, socklen_t *addrlen);
 int sal_bind(int socket, const struct sockaddr *name, socklen_t namelen);
 int sal_shutdown(int socket, int how);
@@ -341,6 +351,9 @@ int sal_connect(int socket, const struct sockaddr *name, socklen_t namelen);
 int sal_listen(int socket, int backlog);
 int sal_sendmsg(int socket, const struct msghdr *message, int flags);
 int sal_recvmsg(int socket, struct msghdr *message, int flags);
+int sal_sendmmsg(int socket, struct mmsghdr *msgvec, unsigned int vlen, int flags);
+int sal_recvmmsg(int socket, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+      struct timespec *timeout);
 int sal_recvfrom(int socket, void *mem, size_t len, int flags,
       struct sockaddr *from, socklen_t *fromlen);
 int sal_sendto(int socket, const void *dataptr, size_t size, int flags,
@@ -37,6 +37,9 @@ int recvfrom(int s, void *mem, size_t len, int flags,
       struct sockaddr *from, socklen_t *fromlen);
 int recvmsg(int s, struct msghdr *message, int flags);
 int sendmsg(int s, const struct msghdr *message, int flags);
+int recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+      struct timespec *timeout);
+int sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags);
 int send(int s, const void *dataptr, size_t size, int flags);
 int sendto(int s, const void *dataptr, size_t size, int flags,
     const struct sockaddr *to, socklen_t tolen);
@@ -60,6 +63,8 @@ int socketpair(int domain, int type, int protocol, int *fds);
 #define send(s, dataptr, size, flags)                      sal_sendto(s, dataptr, size, flags, NULL, NULL)
 #define sendto(s, dataptr, size, flags, to, tolen)         sal_sendto(s, dataptr, size, flags, to, tolen)
 #define sendmsg(s, message, flags)                         sal_sendmsg(s, message, flags)
+#define recvmmsg(s, msgvec, vlen, flags, timeout)          sal_recvmmsg(s, msgvec, vlen, flags, timeout)
+#define sendmmsg(s, msgvec, vlen, flags)                   sal_sendmmsg(s, msgvec, vlen, flags)
 #define socket(domain, type, protocol)                     sal_socket(domain, type, protocol)
 #define socketpair(domain, type, protocol, fds)            sal_socketpair(domain, type, protocol, fds)
 #define closesocket(s)                                     sal_closesocket(s)
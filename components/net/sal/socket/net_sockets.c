@@ -184,6 +184,23 @@ int recvmsg(int s, struct msghdr *message, int flags)
 }
 RTM_EXPORT(recvmsg);
 
+int sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+    int socket = dfs_net_getsocket(s);
+
+    return sal_sendmmsg(socket, msgvec, vlen, flags);
+}
+RTM_EXPORT(sendmmsg);
+
+int recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+             struct timespec *timeout)
+{
+    int socket = dfs_net_getsocket(s);
+
+    return sal_recvmmsg(socket, msgvec, vlen, flags, timeout);
+}
+RTM_EXPORT(recvmmsg);
+
 int recvfrom(int s, void *mem, size_t len, int flags,
              struct sockaddr *from, socklen_t *fromlen)
 {
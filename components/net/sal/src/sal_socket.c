@@ -25,6 +25,7 @@
 #endif
 #include <sal_low_lvl.h>
 #include <netdev.h>
+#include <rid_bitmap.h>
 
 #ifdef SAL_INTERNET_CHECK
 #include <ipc/workqueue.h>
@@ -43,13 +44,15 @@
 #define DBG_LVL                        DBG_INFO
 #include <rtdbg.h>
 
-#define SOCKET_TABLE_STEP_LEN          4
-
 /* the socket table used to dynamic allocate sockets */
 struct sal_socket_table
 {
     uint32_t max_socket;
-    struct sal_socket **sockets;
+    /* the slots never move and are accessed atomically, so they can be read without lock */
+    rt_atomic_t *sockets;
+    /* the free socket index allocator */
+    struct rid_bitmap ids;
+    RT_BITMAP_DECLARE(ids_set, SAL_SOCKETS_NUM);
 };
 
 /* record the netdev and res table*/
@@ -93,7 +96,7 @@ do {
 
 #define SAL_SOCKET_OBJ_GET(sock, socket)                                          \
 do {                                                                              \
-    (sock) = sal_get_socket(socket);                                              \
+    (sock) = socket_get(socket);                                                  \
     if ((sock) == RT_NULL) {                                                      \
         return -1;                                                                \
     }                                                                             \
@@ -132,18 +135,15 @@ do {
  */
 int sal_init(void)
 {
-    int cn;
-
     if (init_ok)
     {
         LOG_D("Socket Abstraction Layer is already initialized.");
         return 0;
     }
 
-    /* init sal socket table */
-    cn = SOCKET_TABLE_STEP_LEN < SAL_SOCKETS_NUM ? SOCKET_TABLE_STEP_LEN : SAL_SOCKETS_NUM;
-    socket_table.max_socket = cn;
-    socket_table.sockets = rt_calloc(1, cn * sizeof(struct sal_socket *));
+    /* init sal socket table, it is allocated in full to avoid moving the slots */
+    socket_table.max_socket = SAL_SOCKETS_NUM;
+    socket_table.sockets = rt_calloc(1, SAL_SOCKETS_NUM * sizeof(rt_atomic_t));
     if (socket_table.sockets == RT_NULL)
     {
         LOG_E("No memory for socket table.\n");
@@ -153,8 +153,9 @@ int sal_init(void)
     /*init the dev_res table */
     rt_memset(sal_dev_res_tbl,  0, sizeof(sal_dev_res_tbl));
 
-    /* create sal socket lock */
+    /* create sal socket lock, it only protects the socket index allocator */
     rt_mutex_init(&sal_core_lock, "sal_lock", RT_IPC_FLAG_PRIO);
+    rid_bitmap_init(&socket_table.ids, 0, SAL_SOCKETS_NUM, socket_table.ids_set, &sal_core_lock);
 
     LOG_I("Socket Abstraction Layer initialize success.");
     init_ok = RT_TRUE;
@@ -339,16 +340,74 @@ int sal_proto_tls_register(const struct sal_proto_tls *pt)
 }
 #endif
 
+#ifdef RT_USING_RCU
+/* the lookups read the slots under RCU, a deleted socket is freed after a grace period */
+rt_inline rt_base_t socket_read_lock(void)
+{
+    rt_rcu_read_lock();
+    return 0;
+}
+
+rt_inline void socket_read_unlock(rt_base_t level)
+{
+    RT_UNUSED(level);
+    rt_rcu_read_unlock();
+}
+
+#define socket_read_sync()      rt_rcu_synchronize()
+#else
+/* the lookups in flight, they never block, a deleted socket is released after them */
+static rt_atomic_t sal_slot_readers;
+
+rt_inline rt_base_t socket_read_lock(void)
+{
+    rt_atomic_add(&sal_slot_readers, 1);
+    return 0;
+}
+
+rt_inline void socket_read_unlock(rt_base_t level)
+{
+    RT_UNUSED(level);
+    rt_atomic_sub(&sal_slot_readers, 1);
+}
+
+/* the lookups which may have read a cleared slot are done once none is in flight */
+rt_inline void socket_read_sync(void)
+{
+    while (rt_atomic_load(&sal_slot_readers) != 0)
+    {
+        rt_thread_delay(1);
+    }
+}
+#endif /* RT_USING_RCU */
+
+rt_inline struct sal_socket *socket_slot_get(struct sal_socket_table *st, int idx)
+{
+    return (struct sal_socket *) rt_atomic_load(&st->sockets[idx]);
+}
+
+rt_inline void socket_slot_set(struct sal_socket_table *st, int idx, struct sal_socket *sock)
+{
+    rt_atomic_store(&st->sockets[idx], (rt_atomic_t) sock);
+}
+
 /**
  * This function will get sal socket object by sal socket descriptor.
  *
  * @param socket sal socket index
  *
  * @return sal socket object of the current sal socket index
+ *
+ * @note the socket table slots never move and a slot is published atomically
+ * after the socket object is initialized. The object returned is not referenced,
+ * it is valid only while the caller keeps the socket open, e.g. by the file
+ * descriptor it holds. The SAL calls reference it by socket_get() instead.
  */
 struct sal_socket *sal_get_socket(int socket)
 {
     struct sal_socket_table *st = &socket_table;
+    struct sal_socket *sock;
+    rt_base_t level;
 
     socket = socket - SAL_SOCKET_OFFSET;
 
@@ -357,36 +416,57 @@ struct sal_socket *sal_get_socket(int socket)
         return RT_NULL;
     }
 
-    /* check socket structure valid or not */
-    RT_ASSERT(st->sockets[socket]->magic == SAL_SOCKET_MAGIC);
+    level = socket_read_lock();
+    sock = socket_slot_get(st, socket);
+    if (sock != RT_NULL)
+    {
+        /* check socket structure valid or not */
+        RT_ASSERT(sock->magic == SAL_SOCKET_MAGIC);
+    }
+    socket_read_unlock(level);
 
-    return st->sockets[socket];
+    return sock;
 }
 
-/**
- * This function will lock sal socket.
- *
- * @note please don't invoke it on ISR.
- */
-static void sal_lock(void)
+/* get the socket object with a reference, it is not freed before socket_put() */
+static struct sal_socket *socket_get(int socket)
 {
-    rt_err_t result;
+    struct sal_socket_table *st = &socket_table;
+    struct sal_socket *sock;
+    rt_base_t level;
+
+    socket = socket - SAL_SOCKET_OFFSET;
+
+    if (socket < 0 || socket >= (int) st->max_socket)
+    {
+        return RT_NULL;
+    }
 
-    result = rt_mutex_take(&sal_core_lock, RT_WAITING_FOREVER);
-    if (result != RT_EOK)
+    /**
+     * the table holds a reference of the socket in slot, it is dropped after
+     * the slot is cleared and the lookups in read side section are done
+     */
+    level = socket_read_lock();
+    sock = socket_slot_get(st, socket);
+    if (sock != RT_NULL)
     {
-        RT_ASSERT(0);
+        RT_ASSERT(sock->magic == SAL_SOCKET_MAGIC);
+        rt_atomic_add(&sock->ref_count, 1);
     }
+    socket_read_unlock(level);
+
+    return sock;
 }
 
-/**
- * This function will lock sal socket.
- *
- * @note please don't invoke it on ISR.
- */
-static void sal_unlock(void)
+static void socket_put(struct sal_socket *sock)
 {
-    rt_mutex_release(&sal_core_lock);
+    /* the last reference is gone, the socket is closed and not in use */
+    if (rt_atomic_sub(&sock->ref_count, 1) == 1)
+    {
+        sock->magic = 0;
+        sock->netdev = RT_NULL;
+        rt_free(sock);
+    }
 }
 
 /**
@@ -398,20 +478,23 @@ int sal_netdev_cleanup(struct netdev *netdev)
 {
     uint32_t idx = 0;
     int find_dev;
+    struct sal_socket *sock;
+    rt_base_t level;
 
     do
     {
         find_dev = 0;
-        sal_lock();
+        level = socket_read_lock();
         for (idx = 0; idx < socket_table.max_socket; idx++)
         {
-            if (socket_table.sockets[idx] && socket_table.sockets[idx]->netdev == netdev)
+            sock = socket_slot_get(&socket_table, idx);
+            if (sock && sock->netdev == netdev)
             {
                 find_dev = 1;
                 break;
             }
         }
-        sal_unlock();
+        socket_read_unlock(level);
         if (find_dev)
         {
             rt_thread_mdelay(100);
@@ -491,127 +574,71 @@ static int socket_init(int family, int type, int protocol, struct sal_socket **r
     return 0;
 }
 
-static int socket_alloc(struct sal_socket_table *st, int f_socket)
-{
-    int idx;
-
-    /* find an empty socket entry */
-    for (idx = f_socket; idx < (int) st->max_socket; idx++)
-    {
-        if (st->sockets[idx] == RT_NULL)
-        {
-            break;
-        }
-    }
-
-    /* allocate a larger sockte container */
-    if (idx == (int) st->max_socket &&  st->max_socket < SAL_SOCKETS_NUM)
-    {
-        int cnt, index;
-        struct sal_socket **sockets;
-
-        /* increase the number of socket with 4 step length */
-        cnt = st->max_socket + SOCKET_TABLE_STEP_LEN;
-        cnt = cnt > SAL_SOCKETS_NUM ? SAL_SOCKETS_NUM : cnt;
-
-        sockets = rt_realloc(st->sockets, cnt * sizeof(struct sal_socket *));
-        if (sockets == RT_NULL)
-            goto __result; /* return st->max_socket */
-
-        /* clean the new allocated fds */
-        for (index = st->max_socket; index < cnt; index++)
-        {
-            sockets[index] = RT_NULL;
-        }
-
-        st->sockets = sockets;
-        st->max_socket = cnt;
-    }
-
-    /* allocate  'struct sal_socket' */
-    if (idx < (int) st->max_socket && st->sockets[idx] == RT_NULL)
-    {
-        st->sockets[idx] = rt_calloc(1, sizeof(struct sal_socket));
-        if (st->sockets[idx] == RT_NULL)
-        {
-            idx = st->max_socket;
-        }
-    }
-
-__result:
-    return idx;
-}
-
-static void socket_free(struct sal_socket_table *st, int idx)
-{
-    struct sal_socket *sock;
-
-    sock = st->sockets[idx];
-    st->sockets[idx] = RT_NULL;
-    rt_free(sock);
-}
-
 static int socket_new(void)
 {
     struct sal_socket *sock;
     struct sal_socket_table *st = &socket_table;
-    int idx;
-
-    sal_lock();
+    long idx;
 
-    /* find an empty sal socket entry */
-    idx = socket_alloc(st, 0);
+    /* get a free socket index from bitmap, the socket table is not scanned */
+    idx = rid_bitmap_get(&st->ids);
+    if (idx < 0)
+    {
+        return -1;
+    }
 
-    /* can't find an empty sal socket entry */
-    if (idx == (int) st->max_socket)
+    sock = rt_calloc(1, sizeof(struct sal_socket));
+    if (sock == RT_NULL)
     {
-        idx = -(1 + SAL_SOCKET_OFFSET);
-        goto __result;
+        rid_bitmap_put(&st->ids, idx);
+        return -1;
     }
 
-    sock = st->sockets[idx];
     sock->socket = idx + SAL_SOCKET_OFFSET;
     sock->magic = SAL_SOCKET_MAGIC;
+    /* the reference of socket table */
+    rt_atomic_store(&sock->ref_count, 1);
     sock->netdev = RT_NULL;
     sock->user_data = RT_NULL;
 #ifdef SAL_USING_TLS
     sock->user_data_tls = RT_NULL;
 #endif
 
-__result:
-    sal_unlock();
+    /* publish the socket object after it is initialized */
+    socket_slot_set(st, idx, sock);
+
     return idx + SAL_SOCKET_OFFSET;
 }
 
-static void socket_delete(int socket)
+static void socket_delete(struct sal_socket *sock)
 {
-    struct sal_socket *sock;
     struct sal_socket_table *st = &socket_table;
+    rt_atomic_t expected = (rt_atomic_t) sock;
     int idx;
 
-    idx = socket - SAL_SOCKET_OFFSET;
-    if (idx < 0 || idx >= (int) st->max_socket)
+    idx = sock->socket - SAL_SOCKET_OFFSET;
+    RT_ASSERT(idx >= 0 && idx < (int) st->max_socket);
+
+    /* the socket closed by others at the same time is deleted once */
+    if (!rt_atomic_compare_exchange_strong(&st->sockets[idx], &expected, (rt_atomic_t) RT_NULL))
     {
         return;
     }
-    sal_lock();
-    sock = sal_get_socket(socket);
-    RT_ASSERT(sock != RT_NULL);
-    sock->magic = 0;
-    sock->netdev = RT_NULL;
-    socket_free(st, idx);
-    sal_unlock();
+    /* wait for the lookups which may be taking a reference of the socket object */
+    socket_read_sync();
+
+    /* the index can be reused only after the slot is cleared */
+    rid_bitmap_put(&st->ids, idx);
+
+    /* the socket object is freed by the last user */
+    socket_put(sock);
 }
 
-int sal_accept(int socket, struct sockaddr *addr, socklen_t *addrlen)
+static int sal_sock_accept(struct sal_socket *sock, struct sockaddr *addr, socklen_t *addrlen)
 {
     int new_socket;
-    struct sal_socket *sock;
     struct sal_proto_family *pf;
 
-    /* get the socket object by socket descriptor */
-    SAL_SOCKET_OBJ_GET(sock, socket);
-
     /* check the network interface is up status */
     SAL_NETDEV_IS_UP(sock->netdev);
 
@@ -638,9 +665,8 @@ int sal_accept(int socket, struct sockaddr *addr, socklen_t *addrlen)
         if (retval < 0)
         {
             pf->skt_ops->closesocket(new_socket);
-            rt_memset(new_sock, 0x00, sizeof(struct sal_socket));
             /* socket init failed, delete socket */
-            socket_delete(new_sal_socket);
+            socket_delete(new_sock);
             LOG_E("New socket registered failed, return error %d.", retval);
             return -1;
         }
@@ -656,6 +682,19 @@ int sal_accept(int socket, struct sockaddr *addr, socklen_t *addrlen)
     return -1;
 }
 
+int sal_accept(int socket, struct sockaddr *addr, socklen_t *addrlen)
+{
+    struct sal_socket *sock;
+    int ret;
+
+    /* get the socket object by socket descriptor */
+    SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_accept(sock, addr, addrlen);
+    socket_put(sock);
+
+    return ret;
+}
+
 static void sal_sockaddr_to_ipaddr(const struct sockaddr *name, ip_addr_t *local_ipaddr)
 {
     const struct sockaddr_in *svr_addr = (const struct sockaddr_in *) name;
@@ -670,18 +709,14 @@ static void sal_sockaddr_to_ipaddr(const struct sockaddr *name, ip_addr_t *local
 #endif /* NETDEV_IPV4 && NETDEV_IPV6*/
 }
 
-int sal_bind(int socket, const struct sockaddr *name, socklen_t namelen)
+static int sal_sock_bind(struct sal_socket *sock, const struct sockaddr *name, socklen_t namelen)
 {
-    struct sal_socket *sock;
     struct sal_proto_family *pf;
     struct sockaddr_un *addr_un = RT_NULL;
     ip_addr_t input_ipaddr;
 
     RT_ASSERT(name);
 
-    /* get the socket object by socket descriptor */
-    SAL_SOCKET_OBJ_GET(sock, socket);
-
     addr_un = (struct sockaddr_un *)name;
 
     if ((addr_un->sa_family != AF_UNIX) && (addr_un->sa_family != AF_NETLINK))
@@ -711,7 +746,7 @@ int sal_bind(int socket, const struct sockaddr *name, socklen_t namelen)
                 int new_socket = -1;
 
                 /* protocol family is different, close old socket and create new socket by input ip address */
-                local_pf->skt_ops->closesocket(socket);
+                local_pf->skt_ops->closesocket(sock->socket);
 
                 new_socket = input_pf->skt_ops->socket(input_pf->family, sock->type, sock->protocol);
                 if (new_socket < 0)
@@ -728,14 +763,23 @@ int sal_bind(int socket, const struct sockaddr *name, socklen_t namelen)
     return pf->skt_ops->bind((int)(size_t)sock->user_data, name, namelen);
 }
 
-int sal_shutdown(int socket, int how)
+int sal_bind(int socket, const struct sockaddr *name, socklen_t namelen)
 {
     struct sal_socket *sock;
-    struct sal_proto_family *pf;
-    int error = 0;
+    int ret;
 
     /* get the socket object by socket descriptor */
     SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_bind(sock, name, namelen);
+    socket_put(sock);
+
+    return ret;
+}
+
+static int sal_sock_shutdown(struct sal_socket *sock, int how)
+{
+    struct sal_proto_family *pf;
+    int error = 0;
 
     /* shutdown operation not need to check network interface status */
     /* check the network interface socket opreation */
@@ -763,13 +807,22 @@ int sal_shutdown(int socket, int how)
     return error;
 }
 
-int sal_getpeername(int socket, struct sockaddr *name, socklen_t *namelen)
+int sal_shutdown(int socket, int how)
 {
     struct sal_socket *sock;
-    struct sal_proto_family *pf;
+    int ret;
 
     /* get the socket object by socket descriptor */
     SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_shutdown(sock, how);
+    socket_put(sock);
+
+    return ret;
+}
+
+static int sal_sock_getpeername(struct sal_socket *sock, struct sockaddr *name, socklen_t *namelen)
+{
+    struct sal_proto_family *pf;
 
     /* check the network interface socket opreation */
     SAL_NETDEV_SOCKETOPS_VALID(sock->netdev, pf, getpeername);
@@ -777,13 +830,22 @@ int sal_getpeername(int socket, struct sockaddr *name, socklen_t *namelen)
     return pf->skt_ops->getpeername((int)(size_t)sock->user_data, name, namelen);
 }
 
-int sal_getsockname(int socket, struct sockaddr *name, socklen_t *namelen)
+int sal_getpeername(int socket, struct sockaddr *name, socklen_t *namelen)
 {
     struct sal_socket *sock;
-    struct sal_proto_family *pf;
+    int ret;
 
-    /* get socket object by socket descriptor */
+    /* get the socket object by socket descriptor */
     SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_getpeername(sock, name, namelen);
+    socket_put(sock);
+
+    return ret;
+}
+
+static int sal_sock_getsockname(struct sal_socket *sock, struct sockaddr *name, socklen_t *namelen)
+{
+    struct sal_proto_family *pf;
 
     /* check the network interface socket opreation */
     SAL_NETDEV_SOCKETOPS_VALID(sock->netdev, pf, getsockname);
@@ -791,13 +853,22 @@ int sal_getsockname(int socket, struct sockaddr *name, socklen_t *namelen)
     return pf->skt_ops->getsockname((int)(size_t)sock->user_data, name, namelen);
 }
 
-int sal_getsockopt(int socket, int level, int optname, void *optval, socklen_t *optlen)
+int sal_getsockname(int socket, struct sockaddr *name, socklen_t *namelen)
 {
     struct sal_socket *sock;
-    struct sal_proto_family *pf;
+    int ret;
 
     /* get the socket object by socket descriptor */
     SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_getsockname(sock, name, namelen);
+    socket_put(sock);
+
+    return ret;
+}
+
+static int sal_sock_getsockopt(struct sal_socket *sock, int level, int optname, void *optval, socklen_t *optlen)
+{
+    struct sal_proto_family *pf;
 
     /* check the network interface socket opreation */
     SAL_NETDEV_SOCKETOPS_VALID(sock->netdev, pf, getsockopt);
@@ -805,13 +876,22 @@ int sal_getsockopt(int socket, int level, int optname, void *optval, socklen_t *
     return pf->skt_ops->getsockopt((int)(size_t)sock->user_data, level, optname, optval, optlen);
 }
 
-int sal_setsockopt(int socket, int level, int optname, const void *optval, socklen_t optlen)
+int sal_getsockopt(int socket, int level, int optname, void *optval, socklen_t *optlen)
 {
     struct sal_socket *sock;
-    struct sal_proto_family *pf;
+    int ret;
 
     /* get the socket object by socket descriptor */
     SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_getsockopt(sock, level, optname, optval, optlen);
+    socket_put(sock);
+
+    return ret;
+}
+
+static int sal_sock_setsockopt(struct sal_socket *sock, int level, int optname, const void *optval, socklen_t optlen)
+{
+    struct sal_proto_family *pf;
 
     /* check the network interface socket opreation */
     SAL_NETDEV_SOCKETOPS_VALID(sock->netdev, pf, setsockopt);
@@ -852,14 +932,23 @@ int sal_setsockopt(int socket, int level, int optname, const void *optval, sockl
 #endif /* SAL_USING_TLS */
 }
 
-int sal_connect(int socket, const struct sockaddr *name, socklen_t namelen)
+int sal_setsockopt(int socket, int level, int optname, const void *optval, socklen_t optlen)
 {
     struct sal_socket *sock;
-    struct sal_proto_family *pf;
     int ret;
 
     /* get the socket object by socket descriptor */
     SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_setsockopt(sock, level, optname, optval, optlen);
+    socket_put(sock);
+
+    return ret;
+}
+
+static int sal_sock_connect(struct sal_socket *sock, const struct sockaddr *name, socklen_t namelen)
+{
+    struct sal_proto_family *pf;
+    int ret;
 
     /* check the network interface is up status */
     SAL_NETDEV_IS_UP(sock->netdev);
@@ -882,13 +971,22 @@ int sal_connect(int socket, const struct sockaddr *name, socklen_t namelen)
     return ret;
 }
 
-int sal_listen(int socket, int backlog)
+int sal_connect(int socket, const struct sockaddr *name, socklen_t namelen)
 {
     struct sal_socket *sock;
-    struct sal_proto_family *pf;
+    int ret;
 
     /* get the socket object by socket descriptor */
     SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_connect(sock, name, namelen);
+    socket_put(sock);
+
+    return ret;
+}
+
+static int sal_sock_listen(struct sal_socket *sock, int backlog)
+{
+    struct sal_proto_family *pf;
 
     /* check the network interface socket opreation */
     SAL_NETDEV_SOCKETOPS_VALID(sock->netdev, pf, listen);
@@ -896,13 +994,22 @@ int sal_listen(int socket, int backlog)
     return pf->skt_ops->listen((int)(size_t)sock->user_data, backlog);
 }
 
-int sal_sendmsg(int socket, const struct msghdr *message, int flags)
+int sal_listen(int socket, int backlog)
 {
     struct sal_socket *sock;
-    struct sal_proto_family *pf;
+    int ret;
 
     /* get the socket object by socket descriptor */
     SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_listen(sock, backlog);
+    socket_put(sock);
+
+    return ret;
+}
+
+static int sal_sock_sendmsg(struct sal_socket *sock, const struct msghdr *message, int flags)
+{
+    struct sal_proto_family *pf;
 
     /* check the network interface is up status  */
     SAL_NETDEV_IS_UP(sock->netdev);
@@ -929,13 +1036,22 @@ int sal_sendmsg(int socket, const struct msghdr *message, int flags)
 #endif
 }
 
-int sal_recvmsg(int socket, struct msghdr *message, int flags)
+int sal_sendmsg(int socket, const struct msghdr *message, int flags)
 {
     struct sal_socket *sock;
-    struct sal_proto_family *pf;
+    int ret;
 
     /* get the socket object by socket descriptor */
     SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_sendmsg(sock, message, flags);
+    socket_put(sock);
+
+    return ret;
+}
+
+static int sal_sock_recvmsg(struct sal_socket *sock, struct msghdr *message, int flags)
+{
+    struct sal_proto_family *pf;
 
     /* check the network interface is up status  */
     SAL_NETDEV_IS_UP(sock->netdev);
@@ -962,14 +1078,135 @@ int sal_recvmsg(int socket, struct msghdr *message, int flags)
 #endif
 }
 
-int sal_recvfrom(int socket, void *mem, size_t len, int flags,
-                 struct sockaddr *from, socklen_t *fromlen)
+int sal_recvmsg(int socket, struct msghdr *message, int flags)
 {
     struct sal_socket *sock;
+    int ret;
+
+    /* get the socket object by socket descriptor */
+    SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_recvmsg(sock, message, flags);
+    socket_put(sock);
+
+    return ret;
+}
+
+static int sal_sock_sendmmsg(struct sal_socket *sock, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+    int ret;
+    unsigned int i;
     struct sal_proto_family *pf;
 
+    /* check the network interface is up status  */
+    SAL_NETDEV_IS_UP(sock->netdev);
+    pf = (struct sal_proto_family *)sock->netdev->sal_user_data;
+
+#ifdef SAL_USING_TLS
+    if (!IS_SOCKET_PROTO_TLS(sock))
+#endif
+    {
+        if (pf->skt_ops->sendmmsg)
+        {
+            return pf->skt_ops->sendmmsg((int)(size_t)sock->user_data, msgvec, vlen, flags);
+        }
+    }
+
+    /* no batch operation for this socket, send the messages one by one */
+    for (i = 0; i < vlen; i++)
+    {
+        if ((ret = sal_sendmsg(sock->socket, &msgvec[i].msg_hdr, flags)) < 0)
+        {
+            break;
+        }
+        msgvec[i].msg_len = ret;
+    }
+
+    return (i > 0) ? (int)i : -1;
+}
+
+int sal_sendmmsg(int socket, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+    struct sal_socket *sock;
+    int ret;
+
+    /* get the socket object by socket descriptor */
+    SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_sendmmsg(sock, msgvec, vlen, flags);
+    socket_put(sock);
+
+    return ret;
+}
+
+static int sal_sock_recvmmsg(struct sal_socket *sock, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+                             struct timespec *timeout)
+{
+    int ret;
+    unsigned int i;
+    rt_tick_t start, wait = 0;
+    struct sal_proto_family *pf;
+
+    /* check the network interface is up status  */
+    SAL_NETDEV_IS_UP(sock->netdev);
+    pf = (struct sal_proto_family *)sock->netdev->sal_user_data;
+
+#ifdef SAL_USING_TLS
+    if (!IS_SOCKET_PROTO_TLS(sock))
+#endif
+    {
+        if (pf->skt_ops->recvmmsg)
+        {
+            return pf->skt_ops->recvmmsg((int)(size_t)sock->user_data, msgvec, vlen, flags, timeout);
+        }
+    }
+
+    /* no batch operation for this socket, receive the messages one by one */
+    if (timeout)
+    {
+        wait = rt_tick_from_millisecond(timeout->tv_sec * 1000 + timeout->tv_nsec / 1000000);
+    }
+    start = rt_tick_get();
+
+    for (i = 0; i < vlen; i++)
+    {
+        if ((ret = sal_recvmsg(sock->socket, &msgvec[i].msg_hdr, flags & ~MSG_WAITFORONE)) < 0)
+        {
+            break;
+        }
+        msgvec[i].msg_len = ret;
+
+        if (flags & MSG_WAITFORONE)
+        {
+            flags |= MSG_DONTWAIT;
+        }
+        /* the timeout is only checked after a message is received */
+        if (timeout && rt_tick_get() - start >= wait)
+        {
+            i++;
+            break;
+        }
+    }
+
+    return (i > 0) ? (int)i : -1;
+}
+
+int sal_recvmmsg(int socket, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+      struct timespec *timeout)
+{
+    struct sal_socket *sock;
+    int ret;
+
     /* get the socket object by socket descriptor */
     SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_recvmmsg(sock, msgvec, vlen, flags, timeout);
+    socket_put(sock);
+
+    return ret;
+}
+
+static int sal_sock_recvfrom(struct sal_socket *sock, void *mem, size_t len, int flags,
+                             struct sockaddr *from, socklen_t *fromlen)
+{
+    struct sal_proto_family *pf;
 
     /* check the network interface is up status  */
     SAL_NETDEV_IS_UP(sock->netdev);
@@ -996,14 +1233,24 @@ int sal_recvfrom(int socket, void *mem, size_t len, int flags,
 #endif
 }
 
-int sal_sendto(int socket, const void *dataptr, size_t size, int flags,
-               const struct sockaddr *to, socklen_t tolen)
+int sal_recvfrom(int socket, void *mem, size_t len, int flags,
+                 struct sockaddr *from, socklen_t *fromlen)
 {
     struct sal_socket *sock;
-    struct sal_proto_family *pf;
+    int ret;
 
     /* get the socket object by socket descriptor */
     SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_recvfrom(sock, mem, len, flags, from, fromlen);
+    socket_put(sock);
+
+    return ret;
+}
+
+static int sal_sock_sendto(struct sal_socket *sock, const void *dataptr, size_t size, int flags,
+                           const struct sockaddr *to, socklen_t tolen)
+{
+    struct sal_proto_family *pf;
 
     /* check the network interface is up status  */
     SAL_NETDEV_IS_UP(sock->netdev);
@@ -1030,6 +1277,20 @@ int sal_sendto(int socket, const void *dataptr, size_t size, int flags,
 #endif
 }
 
+int sal_sendto(int socket, const void *dataptr, size_t size, int flags,
+               const struct sockaddr *to, socklen_t tolen)
+{
+    struct sal_socket *sock;
+    int ret;
+
+    /* get the socket object by socket descriptor */
+    SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_sendto(sock, dataptr, size, flags, to, tolen);
+    socket_put(sock);
+
+    return ret;
+}
+
 int sal_socket(int domain, int type, int protocol)
 {
     int retval;
@@ -1048,7 +1309,6 @@ int sal_socket(int domain, int type, int protocol)
     sock = sal_get_socket(socket);
     if (sock == RT_NULL)
     {
-        socket_delete(socket);
         return -1;
     }
 
@@ -1057,7 +1317,7 @@ int sal_socket(int domain, int type, int protocol)
     if (retval < 0)
     {
         LOG_E("SAL socket protocol family input failed, return error %d.", retval);
-        socket_delete(socket);
+        socket_delete(sock);
         return -1;
     }
 
@@ -1073,7 +1333,7 @@ int sal_socket(int domain, int type, int protocol)
             sock->user_data_tls = proto_tls->ops->socket(socket);
             if (sock->user_data_tls == RT_NULL)
             {
-                socket_delete(socket);
+                socket_delete(sock);
                 return -1;
             }
         }
@@ -1081,7 +1341,7 @@ int sal_socket(int domain, int type, int protocol)
         sock->user_data = (void *)(size_t)proto_socket;
         return sock->socket;
     }
-    socket_delete(socket);
+    socket_delete(sock);
     return -1;
 }
 
@@ -1096,14 +1356,27 @@ int sal_socketpair(int domain, int type, int protocol, int *fds)
     {
         /* get the socket object by socket descriptor */
         SAL_SOCKET_OBJ_GET(socka, fds[0]);
-        SAL_SOCKET_OBJ_GET(sockb, fds[1]);
+        sockb = socket_get(fds[1]);
+        if (sockb == RT_NULL)
+        {
+            socket_put(socka);
+            return -1;
+        }
 
         /* valid the network interface socket opreation */
-        SAL_NETDEV_SOCKETOPS_VALID(socka->netdev, pf, socket);
+        pf = (struct sal_proto_family *) socka->netdev->sal_user_data;
 
         unix_fd[0] = (int)(size_t)socka->user_data;
         unix_fd[1] = (int)(size_t)sockb->user_data;
 
+        socket_put(sockb);
+        socket_put(socka);
+
+        if (pf->skt_ops->socket == RT_NULL)
+        {
+            return -1;
+        }
+
         if (pf->skt_ops->socketpair)
         {
             return pf->skt_ops->socketpair(domain, type, protocol, unix_fd);
@@ -1115,15 +1388,11 @@ int sal_socketpair(int domain, int type, int protocol, int *fds)
     return -1;
 }
 
-int sal_closesocket(int socket)
+static int sal_sock_closesocket(struct sal_socket *sock)
 {
-    struct sal_socket *sock;
     struct sal_proto_family *pf;
     int error = 0;
 
-    /* get the socket object by socket descriptor */
-    SAL_SOCKET_OBJ_GET(sock, socket);
-
     /* clsoesocket operation not need to vaild network interface status */
     /* valid the network interface socket opreation */
     SAL_NETDEV_SOCKETOPS_VALID(sock->netdev, pf, closesocket);
@@ -1147,30 +1416,39 @@ int sal_closesocket(int socket)
     }
 
     /* delete socket */
-    socket_delete(socket);
+    socket_delete(sock);
 
     return error;
 }
 
+int sal_closesocket(int socket)
+{
+    struct sal_socket *sock;
+    int ret;
+
+    /* get the socket object by socket descriptor */
+    SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_closesocket(sock);
+    socket_put(sock);
+
+    return ret;
+}
+
 #define ARPHRD_ETHER    1      /* Ethernet 10/100Mbps. */
 #define ARPHRD_LOOPBACK 772    /* Loopback device.  */
 #define IFF_UP  0x1
 #define IFF_RUNNING 0x40
 #define IFF_NOARP 0x80
 
-int sal_ioctlsocket(int socket, long cmd, void *arg)
+static int sal_sock_ioctlsocket(struct sal_socket *sock, long cmd, void *arg)
 {
     rt_slist_t *node  = RT_NULL;
     struct netdev *netdev = RT_NULL;
     struct netdev *cur_netdev_list = netdev_list;
-    struct sal_socket *sock;
     struct sal_proto_family *pf;
     struct sockaddr_in *addr_in = RT_NULL;
     struct sockaddr *addr = RT_NULL;
     ip_addr_t input_ipaddr;
-    /* get the socket object by socket descriptor */
-    SAL_SOCKET_OBJ_GET(sock, socket);
-
     /* check the network interface socket opreation */
     SAL_NETDEV_SOCKETOPS_VALID(sock->netdev, pf, ioctlsocket);
 
@@ -1481,6 +1759,19 @@ int sal_ioctlsocket(int socket, long cmd, void *arg)
     return pf->skt_ops->ioctlsocket((int)(size_t)sock->user_data, cmd, arg);
 }
 
+int sal_ioctlsocket(int socket, long cmd, void *arg)
+{
+    struct sal_socket *sock;
+    int ret;
+
+    /* get the socket object by socket descriptor */
+    SAL_SOCKET_OBJ_GET(sock, socket);
+    ret = sal_sock_ioctlsocket(sock, cmd, arg);
+    socket_put(sock);
+
+    return ret;
+}
+
 #ifdef SAL_USING_POSIX
 int sal_poll(struct dfs_file *file, struct rt_pollreq *req)
 {
@@ -1488,8 +1779,12 @@ int sal_poll(struct dfs_file *file, struct rt_pollreq *req)
     struct sal_proto_family *pf;
     int socket = (int)(size_t)file->vnode->data;
 
-    /* get the socket object by socket descriptor */
-    SAL_SOCKET_OBJ_GET(sock, socket);
+    /* the file holds the socket open, the socket object is not referenced */
+    sock = sal_get_socket(socket);
+    if (sock == RT_NULL)
+    {
+        return -1;
+    }
 
     /* check the network interface is up status  */
     SAL_NETDEV_IS_UP(sock->netdev);
@@ -41,9 +41,14 @@ rt_inline rt_size_t rt_bitmap_next_set_bit(rt_bitmap_t *bitmap, rt_size_t start,
 
     for (bit = start; bit < limit && !rt_bitmap_test_bit(bitmap, bit); ++bit)
     {
+        /* skip the whole empty word */
+        if (!(bit & (RT_BITMAP_BITS_MIN - 1)) && bitmap[bit / RT_BITMAP_BITS_MIN] == 0)
+        {
+            bit += RT_BITMAP_BITS_MIN - 1;
+        }
     }
 
-    return bit;
+    return bit < limit ? bit : limit;
 }
 
 rt_inline rt_size_t rt_bitmap_next_clear_bit(rt_bitmap_t *bitmap, rt_size_t start, rt_size_t limit)
@@ -52,9 +57,14 @@ rt_inline rt_size_t rt_bitmap_next_clear_bit(rt_bitmap_t *bitmap, rt_size_t star
 
     for (bit = start; bit < limit && rt_bitmap_test_bit(bitmap, bit); ++bit)
     {
+        /* skip the whole full word */
+        if (!(bit & (RT_BITMAP_BITS_MIN - 1)) && bitmap[bit / RT_BITMAP_BITS_MIN] == (rt_bitmap_t)~0UL)
+        {
+            bit += RT_BITMAP_BITS_MIN - 1;
+        }
     }
 
-    return bit;
+    return bit < limit ? bit : limit;
 }
 
 #define rt_bitmap_for_each_bit_from(state, bitmap, from, bit, limit)        \
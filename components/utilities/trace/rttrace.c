@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include "rttrace.h"
+
+#ifdef RT_USING_CPUTIME
+#include <drivers/cputime.h>
+#endif
+
+#define DBG_TAG    "utils.trace"
+#define DBG_LVL    DBG_INFO
+#include <rtdbg.h>
+
+#define TRACE_BUF_MASK          (RT_TRACE_BUF_EVENTS - 1)
+#define TRACE_READ_BATCH        16
+#define TRACE_NAME_BATCH        8
+
+/* the commit word of the record at an index, never 0 */
+#define TRACE_SEQ(index)        ((rt_uint16_t)(((index) & 0x7fff) | 0x8000))
+
+#if (RT_TRACE_BUF_EVENTS & TRACE_BUF_MASK) != 0
+#error "RT_TRACE_BUF_EVENTS must be a power of 2"
+#endif
+
+/*
+ * Every core writes to its own buffer with the local interrupt disabled, so a
+ * writer never races with another one. A reader may be overrun by the writer,
+ * which is detected by the head afterwards and the events are dropped.
+ */
+struct trace_buffer
+{
+    rt_atomic_t head;                       /* events ever written */
+    rt_uint32_t tail;                       /* events ever streamed out */
+    struct rt_trace_event events[RT_TRACE_BUF_EVENTS];
+};
+
+static struct trace_buffer _buffers[RT_CPUS_NR];
+static volatile rt_bool_t _enabled;
+static rt_bool_t _hooked;
+static rt_bool_t _use_cputime;
+
+rt_inline rt_uint64_t _trace_clock(void)
+{
+#ifdef RT_USING_CPUTIME
+    if (_use_cputime)
+        return clock_cpu_gettime();
+#endif
+    return rt_tick_get();
+}
+
+static rt_uint64_t _trace_clock_res(void)
+{
+#ifdef RT_USING_CPUTIME
+    if (_use_cputime)
+        return clock_cpu_getres();
+#endif
+    return (1000000000ULL / RT_TICK_PER_SECOND) * 1000000ULL;
+}
+
+void rt_trace_record(rt_uint8_t type, rt_ubase_t arg0, rt_ubase_t arg1, rt_uint32_t data)
+{
+    struct trace_buffer *buf;
+    struct rt_trace_event *event;
+    rt_uint32_t head;
+    rt_base_t level;
+    int cpu;
+
+    if (!_enabled)
+        return;
+
+    level = rt_hw_local_irq_disable();
+
+#ifdef RT_USING_SMP
+    cpu = rt_hw_cpu_id();
+#else
+    cpu = 0;
+#endif
+    buf = &_buffers[cpu];
+    head = (rt_uint32_t)rt_atomic_load(&buf->head);
+
+    /* the slot is not committed until it's filled, a reader on another cpu skips it */
+    event = &buf->events[head & TRACE_BUF_MASK];
+    __atomic_store_n(&event->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    event->timestamp = _trace_clock();
+    event->arg0 = arg0;
+    event->arg1 = arg1;
+    event->data = data;
+    event->type = type;
+    event->cpu = cpu;
+    __atomic_store_n(&event->seq, TRACE_SEQ(head), __ATOMIC_RELEASE);
+
+    /* publish the event after it's filled */
+    rt_atomic_store(&buf->head, head + 1);
+
+    rt_hw_local_irq_enable(level);
+}
+
+void rt_trace_mark(rt_ubase_t id, rt_ubase_t value)
+{
+    rt_trace_record(RT_TRACE_EVENT_MARK, id, value, 0);
+}
+
+static void _trace_switch(struct rt_thread *from, struct rt_thread *to)
+{
+    rt_trace_record(RT_TRACE_EVENT_SWITCH, (rt_ubase_t)from, (rt_ubase_t)to,
+                    RT_SCHED_PRIV(to).current_priority);
+}
+
+static void _trace_irq_enter(void)
+{
+    rt_trace_record(RT_TRACE_EVENT_IRQ_ENTER, 0, 0, rt_interrupt_get_nest());
+}
+
+static void _trace_irq_leave(void)
+{
+    rt_trace_record(RT_TRACE_EVENT_IRQ_LEAVE, 0, 0, rt_interrupt_get_nest());
+}
+
+static void _trace_timer_enter(struct rt_timer *timer)
+{
+    rt_trace_record(RT_TRACE_EVENT_TIMER_ENTER, (rt_ubase_t)timer, 0, 0);
+}
+
+static void _trace_timer_exit(struct rt_timer *timer)
+{
+    rt_trace_record(RT_TRACE_EVENT_TIMER_EXIT, (rt_ubase_t)timer, 0, 0);
+}
+
+static void _trace_ipc_trytake(struct rt_object *object)
+{
+    rt_trace_record(RT_TRACE_EVENT_IPC_TRYTAKE, (rt_ubase_t)object, (rt_ubase_t)rt_thread_self(), 0);
+}
+
+static void _trace_ipc_take(struct rt_object *object)
+{
+    rt_trace_record(RT_TRACE_EVENT_IPC_TAKE, (rt_ubase_t)object, (rt_ubase_t)rt_thread_self(), 0);
+}
+
+static void _trace_ipc_put(struct rt_object *object)
+{
+    rt_trace_record(RT_TRACE_EVENT_IPC_PUT, (rt_ubase_t)object, (rt_ubase_t)rt_thread_self(), 0);
+}
+
+static void _trace_wakeup(struct rt_thread *thread)
+{
+    rt_trace_record(RT_TRACE_EVENT_WAKEUP, (rt_ubase_t)thread, (rt_ubase_t)rt_thread_self(), 0);
+}
+
+/**
+ * @brief Start recording. The system hooks are taken over by the trace at the
+ *        first start, and they stay installed with a check of the switch.
+ */
+rt_err_t rt_trace_start(void)
+{
+    if (!_hooked)
+    {
+#ifdef RT_USING_CPUTIME
+        _use_cputime = clock_cpu_getres() != 0;
+#endif
+        if (!_use_cputime)
+        {
+            LOG_W("no cputime clock, the events are stamped in os tick");
+        }
+
+        rt_scheduler_sethook(_trace_switch);
+        rt_interrupt_enter_sethook(_trace_irq_enter);
+        rt_interrupt_leave_sethook(_trace_irq_leave);
+        rt_timer_enter_sethook(_trace_timer_enter);
+        rt_timer_exit_sethook(_trace_timer_exit);
+        rt_object_trytake_sethook(_trace_ipc_trytake);
+        rt_object_take_sethook(_trace_ipc_take);
+        rt_object_put_sethook(_trace_ipc_put);
+        rt_thread_resume_sethook(_trace_wakeup);
+        _hooked = RT_TRUE;
+    }
+
+    _enabled = RT_TRUE;
+
+    return RT_EOK;
+}
+
+void rt_trace_stop(void)
+{
+    _enabled = RT_FALSE;
+}
+
+rt_bool_t rt_trace_is_running(void)
+{
+    return _enabled;
+}
+
+/**
+ * @brief Drop all the recorded events, the trace shall be stopped.
+ */
+void rt_trace_clear(void)
+{
+    for (int i = 0; i < RT_CPUS_NR; i++)
+    {
+        rt_atomic_store(&_buffers[i].head, 0);
+        _buffers[i].tail = 0;
+    }
+}
+
+static rt_err_t _trace_write(rt_trace_write_t write, void *ctx, const void *buf, rt_size_t size)
+{
+    return write(ctx, buf, size) == (rt_ssize_t)size ? RT_EOK : -RT_EIO;
+}
+
+static rt_err_t _trace_write_header(rt_trace_write_t write, void *ctx)
+{
+    struct rt_trace_header header;
+
+    rt_memset(&header, 0, sizeof(header));
+    header.magic = RT_TRACE_MAGIC;
+    header.version = RT_TRACE_VERSION;
+    header.cpus = RT_CPUS_NR;
+    header.event_size = sizeof(struct rt_trace_event);
+    header.name_size = sizeof(struct rt_trace_name);
+    header.clock_res = _trace_clock_res();
+
+    return _trace_write(write, ctx, &header, sizeof(header));
+}
+
+/* names of the kernel objects, copied out in batches to not hold the lock long */
+static rt_err_t _trace_write_names(rt_trace_write_t write, void *ctx)
+{
+    struct rt_object_information *info;
+    struct rt_trace_name names[TRACE_NAME_BATCH];
+    struct rt_trace_chunk chunk;
+    struct rt_object *object;
+    struct rt_list_node *node;
+    rt_base_t level;
+    int type, skip, index, count;
+    rt_err_t error = RT_EOK;
+
+    for (type = RT_Object_Class_Thread; type < RT_Object_Class_Unknown && error == RT_EOK; type++)
+    {
+        info = rt_object_get_information((enum rt_object_class_type)type);
+        if (info == RT_NULL)
+            continue;
+
+        skip = 0;
+        do
+        {
+            index = 0;
+            count = 0;
+            rt_memset(names, 0, sizeof(names));
+
+            level = rt_spin_lock_irqsave(&info->spinlock);
+            rt_list_for_each(node, &info->object_list)
+            {
+                if (index++ < skip)
+                    continue;
+                if (count == TRACE_NAME_BATCH)
+                    break;
+
+                object = rt_list_entry(node, struct rt_object, list);
+                names[count].object = (rt_ubase_t)object;
+                names[count].type = type;
+                rt_strncpy(names[count].name, object->name, sizeof(names[count].name) - 1);
+                count++;
+            }
+            rt_spin_unlock_irqrestore(&info->spinlock, level);
+            skip += count;
+
+            if (count == 0)
+                break;
+
+            rt_memset(&chunk, 0, sizeof(chunk));
+            chunk.magic = RT_TRACE_NAME_MAGIC;
+            chunk.count = count;
+            error = _trace_write(write, ctx, &chunk, sizeof(chunk));
+            if (error == RT_EOK)
+                error = _trace_write(write, ctx, names, count * sizeof(names[0]));
+        } while (count == TRACE_NAME_BATCH && error == RT_EOK);
+    }
+
+    return error;
+}
+
+/* read the events of a core after *tail out, the overwritten ones are dropped */
+static rt_err_t _trace_write_events(int cpu, rt_uint32_t *tail, rt_trace_write_t write, void *ctx)
+{
+    struct trace_buffer *buf = &_buffers[cpu];
+    struct rt_trace_event events[TRACE_READ_BATCH];
+    struct rt_trace_event *event;
+    struct rt_trace_chunk chunk;
+    rt_uint32_t head, count, lost, valid, dropped = 0;
+    rt_uint16_t seq;
+    rt_err_t error = RT_EOK;
+
+    head = (rt_uint32_t)rt_atomic_load(&buf->head);
+    if (head - *tail > RT_TRACE_BUF_EVENTS)
+    {
+        dropped = head - *tail - RT_TRACE_BUF_EVENTS;
+        *tail = head - RT_TRACE_BUF_EVENTS;
+    }
+
+    while (*tail != head && error == RT_EOK)
+    {
+        count = head - *tail;
+        if (count > TRACE_READ_BATCH)
+            count = TRACE_READ_BATCH;
+
+        /* a record that is being rewritten by its cpu is marked out by seq 0 */
+        for (rt_uint32_t i = 0; i < count; i++)
+        {
+            event = &buf->events[(*tail + i) & TRACE_BUF_MASK];
+            seq = __atomic_load_n(&event->seq, __ATOMIC_ACQUIRE);
+            events[i] = *event;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (seq != TRACE_SEQ(*tail + i) || __atomic_load_n(&event->seq, __ATOMIC_RELAXED) != seq)
+                events[i].seq = 0;
+        }
+
+        /* the oldest ones may be overwritten while copying */
+        lost = (rt_uint32_t)rt_atomic_load(&buf->head) - *tail;
+        lost = lost > RT_TRACE_BUF_EVENTS ? lost - RT_TRACE_BUF_EVENTS : 0;
+        if (lost > count)
+            lost = count;
+
+        valid = 0;
+        for (rt_uint32_t i = lost; i < count; i++)
+        {
+            if (events[i].seq != 0)
+                events[valid++] = events[i];
+        }
+
+        rt_memset(&chunk, 0, sizeof(chunk));
+        chunk.magic = RT_TRACE_EVENT_MAGIC;
+        chunk.cpu = cpu;
+        chunk.count = valid;
+        chunk.dropped = dropped + count - valid;
+        dropped = 0;
+
+        error = _trace_write(write, ctx, &chunk, sizeof(chunk));
+        if (error == RT_EOK && chunk.count > 0)
+            error = _trace_write(write, ctx, events, chunk.count * sizeof(events[0]));
+
+        *tail += count;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Write all the events in the buffers out, with the header and the names
+ *        of kernel objects. The buffers are kept, the recording is paused meanwhile.
+ *
+ * @param write is the output function.
+ *
+ * @param ctx is the context of output function.
+ */
+rt_err_t rt_trace_dump(rt_trace_write_t write, void *ctx)
+{
+    rt_bool_t enabled = _enabled;
+    rt_uint32_t tail;
+    rt_err_t error;
+
+    _enabled = RT_FALSE;
+
+    error = _trace_write_header(write, ctx);
+    if (error == RT_EOK)
+        error = _trace_write_names(write, ctx);
+
+    for (int i = 0; i < RT_CPUS_NR && error == RT_EOK; i++)
+    {
+        tail = (rt_uint32_t)rt_atomic_load(&_buffers[i].head);
+        tail = tail > RT_TRACE_BUF_EVENTS ? tail - RT_TRACE_BUF_EVENTS : 0;
+        error = _trace_write_events(i, &tail, write, ctx);
+    }
+
+    _enabled = enabled;
+
+    return error;
+}
+
+static rt_thread_t _stream_thread;
+static volatile rt_bool_t _stream_stop;
+static struct rt_semaphore _stream_exit_sem;
+
+static rt_ssize_t _device_write(void *ctx, const void *buf, rt_size_t size)
+{
+    return rt_device_write((rt_device_t)ctx, 0, buf, size);
+}
+
+static void _stream_entry(void *param)
+{
+    rt_device_t device = (rt_device_t)param;
+    rt_err_t error;
+
+    error = _trace_write_header(_device_write, device);
+    if (error == RT_EOK)
+        error = _trace_write_names(_device_write, device);
+
+    while (!_stream_stop && error == RT_EOK)
+    {
+        for (int i = 0; i < RT_CPUS_NR && error == RT_EOK; i++)
+        {
+            error = _trace_write_events(i, &_buffers[i].tail, _device_write, device);
+        }
+        rt_thread_mdelay(RT_TRACE_STREAM_PERIOD);
+    }
+
+    /* the threads created after start are known now */
+    if (error == RT_EOK)
+        error = _trace_write_names(_device_write, device);
+    if (error != RT_EOK)
+        LOG_E("stream to %s failed", device->parent.name);
+
+    rt_device_close(device);
+    rt_sem_release(&_stream_exit_sem);
+}
+
+/**
+ * @brief Start recording and stream the events to a device periodically.
+ */
+rt_err_t rt_trace_stream_start(const char *device_name)
+{
+    rt_device_t device;
+    rt_err_t error;
+
+    if (_stream_thread != RT_NULL)
+        return -RT_EBUSY;
+
+    device = rt_device_find(device_name);
+    if (device == RT_NULL)
+        return -RT_ENOSYS;
+
+    error = rt_device_open(device, RT_DEVICE_OFLAG_WRONLY);
+    if (error != RT_EOK)
+        return error;
+
+    for (int i = 0; i < RT_CPUS_NR; i++)
+    {
+        _buffers[i].tail = (rt_uint32_t)rt_atomic_load(&_buffers[i].head);
+    }
+
+    _stream_stop = RT_FALSE;
+    rt_sem_init(&_stream_exit_sem, "trace", 0, RT_IPC_FLAG_PRIO);
+    _stream_thread = rt_thread_create("trace", _stream_entry, device, RT_TRACE_STREAM_STACK_SIZE,
+                                      RT_THREAD_PRIORITY_MAX - 2, 10);
+    if (_stream_thread == RT_NULL)
+    {
+        rt_sem_detach(&_stream_exit_sem);
+        rt_device_close(device);
+        return -RT_ENOMEM;
+    }
+
+    rt_trace_start();
+    rt_thread_startup(_stream_thread);
+
+    return RT_EOK;
+}
+
+void rt_trace_stream_stop(void)
+{
+    if (_stream_thread == RT_NULL)
+        return;
+
+    rt_trace_stop();
+    _stream_stop = RT_TRUE;
+    rt_sem_take(&_stream_exit_sem, RT_WAITING_FOREVER);
+    rt_sem_detach(&_stream_exit_sem);
+    _stream_thread = RT_NULL;
+}
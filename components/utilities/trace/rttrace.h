@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#ifndef __RT_TRACE_H__
+#define __RT_TRACE_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* event types */
+#define RT_TRACE_EVENT_SWITCH       0x01    /* arg0: from thread, arg1: to thread, data: priority of to thread */
+#define RT_TRACE_EVENT_IRQ_ENTER    0x02    /* data: interrupt nest */
+#define RT_TRACE_EVENT_IRQ_LEAVE    0x03    /* data: interrupt nest */
+#define RT_TRACE_EVENT_TIMER_ENTER  0x04    /* arg0: timer */
+#define RT_TRACE_EVENT_TIMER_EXIT   0x05    /* arg0: timer */
+#define RT_TRACE_EVENT_IPC_TRYTAKE  0x06    /* arg0: object, arg1: current thread */
+#define RT_TRACE_EVENT_IPC_TAKE     0x07    /* arg0: object, arg1: current thread */
+#define RT_TRACE_EVENT_IPC_PUT      0x08    /* arg0: object, arg1: current thread */
+#define RT_TRACE_EVENT_WAKEUP       0x09    /* arg0: woken thread, arg1: current thread */
+#define RT_TRACE_EVENT_MARK         0x0a    /* arg0: user id, arg1: user value */
+
+/*
+ * One record in the ring buffer, the layout is fixed on every architecture so
+ * the host tool can parse it. Objects are identified by their addresses.
+ */
+struct rt_trace_event
+{
+    rt_uint64_t timestamp;                  /* cputime counter, or os tick without cputime */
+    rt_uint64_t arg0;
+    rt_uint64_t arg1;
+    rt_uint32_t data;
+    rt_uint8_t  type;
+    rt_uint8_t  cpu;
+    rt_uint16_t seq;                        /* commit word of the slot, 0 while it's written */
+};
+
+/*
+ * The dumped stream starts with a header, followed by chunks of object names
+ * and chunks of events. All the fields are in the byte order of target.
+ */
+#define RT_TRACE_MAGIC              0x52545452  /* "RTTR" */
+#define RT_TRACE_NAME_MAGIC         0x4e545452  /* "RTTN" */
+#define RT_TRACE_EVENT_MAGIC        0x45545452  /* "RTTE" */
+#define RT_TRACE_VERSION            1
+
+struct rt_trace_header
+{
+    rt_uint32_t magic;
+    rt_uint16_t version;
+    rt_uint16_t cpus;
+    rt_uint16_t event_size;
+    rt_uint16_t name_size;
+    rt_uint32_t reserved;
+    rt_uint64_t clock_res;                  /* nanoseconds per clock count x 1000000 */
+};
+
+struct rt_trace_chunk
+{
+    rt_uint32_t magic;
+    rt_uint16_t cpu;
+    rt_uint16_t reserved;
+    rt_uint32_t count;                      /* records follow */
+    rt_uint32_t dropped;                    /* events overwritten before read out */
+};
+
+#if RT_NAME_MAX > 0
+#define RT_TRACE_NAME_MAX           RT_NAME_MAX
+#else
+#define RT_TRACE_NAME_MAX           16
+#endif
+
+struct rt_trace_name
+{
+    rt_uint64_t object;
+    rt_uint8_t  type;                       /* object class */
+    rt_uint8_t  reserved[7];
+    char        name[RT_TRACE_NAME_MAX];
+};
+
+typedef rt_ssize_t (*rt_trace_write_t)(void *ctx, const void *buf, rt_size_t size);
+
+rt_err_t rt_trace_start(void);
+void rt_trace_stop(void);
+void rt_trace_clear(void);
+rt_bool_t rt_trace_is_running(void);
+void rt_trace_record(rt_uint8_t type, rt_ubase_t arg0, rt_ubase_t arg1, rt_uint32_t data);
+void rt_trace_mark(rt_ubase_t id, rt_ubase_t value);
+
+rt_err_t rt_trace_dump(rt_trace_write_t write, void *ctx);
+rt_err_t rt_trace_stream_start(const char *device_name);
+void rt_trace_stream_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RT_TRACE_H__ */
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include "rttrace.h"
+
+#ifdef DFS_USING_POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define TRACE_HEX_BYTES         32
+
+#if defined(RT_USING_FINSH) && defined(FINSH_USING_MSH)
+
+/* the binary stream in hex lines, trace2json.py picks them out of a console log */
+static rt_ssize_t _console_write(void *ctx, const void *buf, rt_size_t size)
+{
+    static const char hex[] = "0123456789abcdef";
+    const rt_uint8_t *data = buf;
+    char line[TRACE_HEX_BYTES * 2 + 1];
+    rt_size_t offset, i, len;
+
+    for (offset = 0; offset < size; offset += len)
+    {
+        len = size - offset > TRACE_HEX_BYTES ? TRACE_HEX_BYTES : size - offset;
+        for (i = 0; i < len; i++)
+        {
+            line[i * 2] = hex[data[offset + i] >> 4];
+            line[i * 2 + 1] = hex[data[offset + i] & 0x0f];
+        }
+        line[len * 2] = '\0';
+        rt_kprintf("RTTRACE:%s\n", line);
+    }
+
+    return size;
+}
+
+static rt_ssize_t _device_write(void *ctx, const void *buf, rt_size_t size)
+{
+    return rt_device_write((rt_device_t)ctx, 0, buf, size);
+}
+
+#ifdef DFS_USING_POSIX
+static rt_ssize_t _file_write(void *ctx, const void *buf, rt_size_t size)
+{
+    return write((int)(rt_ubase_t)ctx, buf, size);
+}
+#endif
+
+static rt_err_t _trace_dump_to(const char *target)
+{
+    rt_device_t device;
+    rt_err_t error;
+
+    if (target == RT_NULL)
+        return rt_trace_dump(_console_write, RT_NULL);
+
+#ifdef DFS_USING_POSIX
+    if (target[0] == '/')
+    {
+        int fd = open(target, O_WRONLY | O_CREAT | O_TRUNC, 0);
+
+        if (fd < 0)
+            return -RT_EIO;
+
+        error = rt_trace_dump(_file_write, (void *)(rt_ubase_t)fd);
+        close(fd);
+        return error;
+    }
+#endif
+
+    device = rt_device_find(target);
+    if (device == RT_NULL)
+        return -RT_ENOSYS;
+
+    error = rt_device_open(device, RT_DEVICE_OFLAG_WRONLY);
+    if (error == RT_EOK)
+    {
+        error = rt_trace_dump(_device_write, device);
+        rt_device_close(device);
+    }
+
+    return error;
+}
+
+static void _trace_usage(void)
+{
+    rt_kprintf("Usage:\n");
+    rt_kprintf("trace start                 - start recording\n");
+    rt_kprintf("trace stop                  - stop recording and streaming\n");
+    rt_kprintf("trace clear                 - drop the recorded events\n");
+    rt_kprintf("trace dump [device|path]    - dump the events, in hex lines to console by default\n");
+    rt_kprintf("trace stream <device>       - record and stream the events to a device\n");
+}
+
+static int trace(int argc, char **argv)
+{
+    rt_err_t error = RT_EOK;
+
+    if (argc < 2)
+    {
+        _trace_usage();
+        return 0;
+    }
+
+    if (!rt_strcmp(argv[1], "start"))
+    {
+        error = rt_trace_start();
+    }
+    else if (!rt_strcmp(argv[1], "stop"))
+    {
+        rt_trace_stream_stop();
+        rt_trace_stop();
+    }
+    else if (!rt_strcmp(argv[1], "clear"))
+    {
+        if (rt_trace_is_running())
+        {
+            rt_kprintf("stop the trace first\n");
+            return -1;
+        }
+        rt_trace_clear();
+    }
+    else if (!rt_strcmp(argv[1], "dump"))
+    {
+        error = _trace_dump_to(argc > 2 ? argv[2] : RT_NULL);
+    }
+    else if (!rt_strcmp(argv[1], "stream") && argc > 2)
+    {
+        error = rt_trace_stream_start(argv[2]);
+    }
+    else
+    {
+        _trace_usage();
+        return 0;
+    }
+
+    if (error != RT_EOK)
+    {
+        rt_kprintf("trace %s failed: %d\n", argv[1], error);
+        return -1;
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(trace, context switch and interrupt tracing);
+
+#endif /* RT_USING_FINSH && FINSH_USING_MSH */
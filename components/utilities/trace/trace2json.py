@@ -0,0 +1,260 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2006-2026, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-19     agent        the first version
+#
+
+"""
+Convert the output of msh command `trace dump` or `trace stream` to the
+Chrome trace event format, which is opened by chrome://tracing or
+https://ui.perfetto.dev.
+
+The input is either the binary stream written to a device or file, or a
+console log with the `RTTRACE:` hex lines in it.
+
+    python trace2json.py console.log -o trace.json --summary
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+TRACE_MAGIC = 0x52545452
+NAME_MAGIC = 0x4e545452
+EVENT_MAGIC = 0x45545452
+
+EVENT_SWITCH = 0x01
+EVENT_IRQ_ENTER = 0x02
+EVENT_IRQ_LEAVE = 0x03
+EVENT_TIMER_ENTER = 0x04
+EVENT_TIMER_EXIT = 0x05
+EVENT_IPC_TRYTAKE = 0x06
+EVENT_IPC_TAKE = 0x07
+EVENT_IPC_PUT = 0x08
+EVENT_WAKEUP = 0x09
+EVENT_MARK = 0x0a
+
+OBJECT_CLASSES = {
+    0x01: 'thread', 0x02: 'sem', 0x03: 'mutex', 0x04: 'event',
+    0x05: 'mailbox', 0x06: 'mq', 0x07: 'memheap', 0x08: 'mempool',
+    0x09: 'device', 0x0a: 'timer', 0x0b: 'module', 0x0c: 'memory',
+    0x0d: 'channel', 0x0e: 'pgroup', 0x0f: 'session', 0x10: 'custom',
+}
+
+PID = 1
+IRQ_TID_BASE = 1000
+TIMER_TID_BASE = 2000
+
+
+def load_stream(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if data[:4] in (struct.pack('<I', TRACE_MAGIC), struct.pack('>I', TRACE_MAGIC)):
+        return data
+
+    # a console log, the hex lines may be interleaved with other output
+    hexdata = ''.join(re.findall(r'RTTRACE:([0-9a-fA-F]+)', data.decode('latin-1')))
+    if not hexdata:
+        sys.exit('%s: no trace found' % path)
+    return bytes.fromhex(hexdata)
+
+
+class Trace:
+    def __init__(self):
+        self.names = {}
+        self.events = []
+        self.dropped = {}
+        self.cpus = 1
+        self.clock_res = 0
+
+    def parse(self, data):
+        endian = '<' if struct.unpack_from('<I', data)[0] == TRACE_MAGIC else '>'
+        offset = 0
+        event_size = name_size = 0
+
+        while offset + 4 <= len(data):
+            magic = struct.unpack_from(endian + 'I', data, offset)[0]
+            if magic == TRACE_MAGIC:
+                (_, version, self.cpus, event_size, name_size, _,
+                 self.clock_res) = struct.unpack_from(endian + 'IHHHHIQ', data, offset)
+                if version != 1:
+                    sys.exit('unsupported trace version %d' % version)
+                offset += 24
+                continue
+
+            if magic not in (NAME_MAGIC, EVENT_MAGIC) or event_size == 0:
+                sys.exit('bad trace data at offset %d' % offset)
+
+            _, cpu, _, count, dropped = struct.unpack_from(endian + 'IHHII', data, offset)
+            offset += 16
+
+            if magic == NAME_MAGIC:
+                for _ in range(count):
+                    obj, cls = struct.unpack_from(endian + 'QB', data, offset)
+                    raw = data[offset + 16:offset + name_size]
+                    name = raw.split(b'\0', 1)[0].decode('latin-1')
+                    self.names[obj] = (OBJECT_CLASSES.get(cls, 'object'), name)
+                    offset += name_size
+            else:
+                self.dropped[cpu] = self.dropped.get(cpu, 0) + dropped
+                for _ in range(count):
+                    ts, arg0, arg1, value, etype, ecpu = struct.unpack_from(
+                        endian + 'QQQIBB', data, offset)
+                    self.events.append((ts, ecpu, etype, arg0, arg1, value))
+                    offset += event_size
+
+        # the per-cpu chunks are merged by time, a stable sort keeps the order on a cpu
+        self.events.sort(key=lambda e: e[0])
+
+    def us(self, ts):
+        return ts * self.clock_res / 1e9
+
+    def name(self, obj):
+        if obj in self.names:
+            return self.names[obj][1]
+        return '0x%x' % obj
+
+    def object_desc(self, obj):
+        if obj in self.names:
+            return '%s %s' % self.names[obj]
+        return '0x%x' % obj
+
+
+def convert(trace):
+    out = []
+    stats = {'irq': [], 'wakeup': [], 'block': [], 'runtime': {}}
+
+    out.append({'ph': 'M', 'pid': PID, 'name': 'process_name', 'args': {'name': 'RT-Thread'}})
+    for cpu in range(trace.cpus):
+        for tid, label in ((cpu, 'CPU %d' % cpu),
+                           (IRQ_TID_BASE + cpu, 'CPU %d irq' % cpu),
+                           (TIMER_TID_BASE + cpu, 'CPU %d timer' % cpu)):
+            out.append({'ph': 'M', 'pid': PID, 'tid': tid, 'name': 'thread_name',
+                        'args': {'name': label}})
+            out.append({'ph': 'M', 'pid': PID, 'tid': tid, 'name': 'thread_sort_index',
+                        'args': {'sort_index': tid}})
+
+    running = {}        # cpu -> (thread, start, prio)
+    irq_stack = {}      # cpu -> [start]
+    timer_stack = {}    # cpu -> [(timer, start)]
+    woken = {}          # thread -> wakeup time
+    trying = {}         # (thread, object) -> trytake time
+    last_ts = 0
+
+    def slice_(tid, name, start, end, args=None):
+        event = {'ph': 'X', 'pid': PID, 'tid': tid, 'name': name,
+                 'ts': trace.us(start), 'dur': trace.us(end - start)}
+        if args:
+            event['args'] = args
+        out.append(event)
+
+    def instant(tid, name, ts, args=None):
+        event = {'ph': 'i', 's': 't', 'pid': PID, 'tid': tid, 'name': name, 'ts': trace.us(ts)}
+        if args:
+            event['args'] = args
+        out.append(event)
+
+    def close_thread(cpu, ts):
+        if cpu in running:
+            thread, start, prio = running.pop(cpu)
+            slice_(cpu, trace.name(thread), start, ts, {'priority': prio})
+            stats['runtime'][thread] = stats['runtime'].get(thread, 0) + ts - start
+
+    for ts, cpu, etype, arg0, arg1, value in trace.events:
+        last_ts = ts
+        if etype == EVENT_SWITCH:
+            close_thread(cpu, ts)
+            running[cpu] = (arg1, ts, value)
+            if arg1 in woken:
+                stats['wakeup'].append((ts - woken.pop(arg1), arg1, ts))
+        elif etype == EVENT_IRQ_ENTER:
+            irq_stack.setdefault(cpu, []).append(ts)
+        elif etype == EVENT_IRQ_LEAVE:
+            if irq_stack.get(cpu):
+                start = irq_stack[cpu].pop()
+                slice_(IRQ_TID_BASE + cpu, 'irq', start, ts, {'nest': value})
+                stats['irq'].append((ts - start, cpu, start))
+        elif etype == EVENT_TIMER_ENTER:
+            timer_stack.setdefault(cpu, []).append((arg0, ts))
+        elif etype == EVENT_TIMER_EXIT:
+            if timer_stack.get(cpu):
+                timer, start = timer_stack[cpu].pop()
+                slice_(TIMER_TID_BASE + cpu, trace.name(timer), start, ts)
+        elif etype == EVENT_IPC_TRYTAKE:
+            trying[(arg1, arg0)] = ts
+            instant(cpu, 'trytake ' + trace.object_desc(arg0), ts, {'thread': trace.name(arg1)})
+        elif etype == EVENT_IPC_TAKE:
+            start = trying.pop((arg1, arg0), None)
+            if start is not None:
+                stats['block'].append((ts - start, arg1, arg0, start))
+            instant(cpu, 'take ' + trace.object_desc(arg0), ts, {'thread': trace.name(arg1)})
+        elif etype == EVENT_IPC_PUT:
+            instant(cpu, 'put ' + trace.object_desc(arg0), ts, {'thread': trace.name(arg1)})
+        elif etype == EVENT_WAKEUP:
+            woken.setdefault(arg0, ts)
+            instant(cpu, 'wakeup ' + trace.name(arg0), ts, {'by': trace.name(arg1)})
+        elif etype == EVENT_MARK:
+            instant(cpu, 'mark %d' % arg0, ts, {'value': arg1})
+
+    for cpu in list(running):
+        close_thread(cpu, last_ts)
+
+    for cpu, count in trace.dropped.items():
+        if count:
+            out.append({'ph': 'i', 's': 'g', 'pid': PID, 'tid': cpu, 'ts': 0,
+                        'name': 'CPU %d dropped %d events' % (cpu, count)})
+
+    return out, stats
+
+
+def print_summary(trace, stats, top):
+    def show(title, items, fmt):
+        print(title)
+        for item in sorted(items, key=lambda i: i[0], reverse=True)[:top]:
+            print('  %10.3f us  %s' % (trace.us(item[0]), fmt(item)))
+
+    show('longest interrupts:', stats['irq'],
+         lambda i: 'cpu %d at %.3f us' % (i[1], trace.us(i[2])))
+    show('longest wakeup latencies:', stats['wakeup'],
+         lambda i: '%s at %.3f us' % (trace.name(i[1]), trace.us(i[2])))
+    show('longest blocking on IPC:', stats['block'],
+         lambda i: '%s on %s at %.3f us' % (trace.name(i[1]), trace.object_desc(i[2]), trace.us(i[3])))
+    show('running time:', [(t, thread) for thread, t in stats['runtime'].items()],
+         lambda i: trace.name(i[1]))
+    dropped = sum(trace.dropped.values())
+    if dropped:
+        print('%d events dropped, enlarge RT_TRACE_BUF_EVENTS or stream more often' % dropped)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert RT-Thread trace to Chrome trace json')
+    parser.add_argument('input', help='binary trace, or console log with RTTRACE lines')
+    parser.add_argument('-o', '--output', default='trace.json', help='output json file')
+    parser.add_argument('-s', '--summary', action='store_true', help='print the latency outliers')
+    parser.add_argument('-n', '--top', type=int, default=10, help='number of outliers to print')
+    args = parser.parse_args()
+
+    trace = Trace()
+    trace.parse(load_stream(args.input))
+    if trace.clock_res == 0:
+        sys.exit('no trace header found')
+
+    events, stats = convert(trace)
+    with open(args.output, 'w') as f:
+        json.dump({'traceEvents': events, 'displayTimeUnit': 'ns'}, f)
+    print('%d events converted to %s' % (len(trace.events), args.output))
+
+    if args.summary:
+        print_summary(trace, stats, args.top)
+
+
+if __name__ == '__main__':
+    main()
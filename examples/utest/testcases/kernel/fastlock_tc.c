@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+#ifdef RT_USING_CPUTIME
+#include <drivers/cputime.h>
+#endif
+
+#define KERN_TEST_UNCONTENDED_LOOPS     100000
+#define KERN_TEST_CONTENDED_TICKS       (RT_TICK_PER_SECOND)
+#define KERN_TEST_CRITICAL_LOOPS        64
+#define KERN_TEST_THREADS               (RT_CPUS_NR + 1)
+#define KERN_TEST_THREAD_PRIO           (RT_THREAD_PRIORITY_MAX / 3)
+
+static struct rt_fastlock _lock;
+static struct rt_mutex _mutex;
+static struct rt_semaphore _thr_exit_sem;
+static volatile rt_bool_t _stop;
+static rt_ubase_t _acquired[KERN_TEST_THREADS];
+static volatile rt_ubase_t _shared_counter;
+
+/* cpu cycles if there is a cputime device, otherwise os ticks */
+static rt_uint64_t _now(void)
+{
+#ifdef RT_USING_CPUTIME
+    return clock_cpu_gettime();
+#else
+    return rt_tick_get();
+#endif
+}
+
+static void test_fastlock_basic(void)
+{
+    uassert_int_equal(rt_fastlock_take(&_lock, RT_WAITING_FOREVER), RT_EOK);
+    uassert_int_equal(_lock.owner, rt_thread_self());
+
+    /* not recursive */
+    uassert_int_equal(rt_fastlock_trytake(&_lock), -RT_ERROR);
+
+    uassert_int_equal(rt_fastlock_release(&_lock), RT_EOK);
+    uassert_int_equal(rt_fastlock_release(&_lock), -RT_ERROR);
+    uassert_int_equal(rt_atomic_load(&_lock.state), RT_FASTLOCK_UNLOCKED);
+}
+
+#ifdef RT_USING_HEAP
+static void test_fastlock_create(void)
+{
+    rt_fastlock_t lock;
+
+    lock = rt_fastlock_create("fldyn", RT_IPC_FLAG_FIFO);
+    uassert_not_null(lock);
+    if (lock == RT_NULL)
+        return;
+
+    uassert_true(rt_object_find("fldyn", RT_Object_Class_FastLock) == &lock->parent);
+    uassert_int_equal(rt_fastlock_take(lock, RT_WAITING_NO), RT_EOK);
+    uassert_int_equal(rt_fastlock_release(lock), RT_EOK);
+    uassert_int_equal(rt_fastlock_delete(lock), RT_EOK);
+}
+#endif /* RT_USING_HEAP */
+
+static void _holder_entry(void *param)
+{
+    rt_fastlock_take(&_lock, RT_WAITING_FOREVER);
+    rt_sem_release(&_thr_exit_sem);
+    rt_thread_delay(5);
+    rt_fastlock_release(&_lock);
+    rt_sem_release(&_thr_exit_sem);
+}
+
+static void test_fastlock_wait(void)
+{
+    rt_thread_t tid;
+
+    tid = rt_thread_create("flhold", _holder_entry, RT_NULL, UTEST_THR_STACK_SIZE,
+                           KERN_TEST_THREAD_PRIO - 1, 10);
+    uassert_not_null(tid);
+    if (tid == RT_NULL)
+        return;
+    rt_thread_startup(tid);
+    rt_sem_take(&_thr_exit_sem, RT_WAITING_FOREVER);
+
+    uassert_int_equal(rt_fastlock_trytake(&_lock), -RT_ETIMEOUT);
+    uassert_int_equal(rt_fastlock_take(&_lock, 1), -RT_ETIMEOUT);
+
+    /* sleeps until the holder releases it */
+    uassert_int_equal(rt_fastlock_take(&_lock, RT_WAITING_FOREVER), RT_EOK);
+    uassert_int_equal(rt_fastlock_release(&_lock), RT_EOK);
+    rt_sem_take(&_thr_exit_sem, RT_WAITING_FOREVER);
+}
+
+static void test_fastlock_uncontended(void)
+{
+    rt_uint64_t start, fastlock_cost, mutex_cost;
+
+    start = _now();
+    for (int i = 0; i < KERN_TEST_UNCONTENDED_LOOPS; i++)
+    {
+        rt_fastlock_take(&_lock, RT_WAITING_FOREVER);
+        rt_fastlock_release(&_lock);
+    }
+    fastlock_cost = _now() - start;
+
+    start = _now();
+    for (int i = 0; i < KERN_TEST_UNCONTENDED_LOOPS; i++)
+    {
+        rt_mutex_take(&_mutex, RT_WAITING_FOREVER);
+        rt_mutex_release(&_mutex);
+    }
+    mutex_cost = _now() - start;
+
+    rt_kprintf("uncontended take/release x %d: fastlock %lu, mutex %lu %s\n",
+               KERN_TEST_UNCONTENDED_LOOPS, (rt_ubase_t)fastlock_cost, (rt_ubase_t)mutex_cost,
+#ifdef RT_USING_CPUTIME
+               "cycles"
+#else
+               "ticks"
+#endif
+               );
+    uassert_true(1);
+}
+
+static void _fastlock_worker_entry(void *param)
+{
+    int id = (rt_ubase_t)param;
+
+    while (!_stop)
+    {
+        rt_fastlock_take(&_lock, RT_WAITING_FOREVER);
+        for (int i = 0; i < KERN_TEST_CRITICAL_LOOPS; i++)
+        {
+            _shared_counter++;
+        }
+        rt_fastlock_release(&_lock);
+
+        _acquired[id]++;
+    }
+
+    rt_sem_release(&_thr_exit_sem);
+}
+
+static void _mutex_worker_entry(void *param)
+{
+    int id = (rt_ubase_t)param;
+
+    while (!_stop)
+    {
+        rt_mutex_take(&_mutex, RT_WAITING_FOREVER);
+        for (int i = 0; i < KERN_TEST_CRITICAL_LOOPS; i++)
+        {
+            _shared_counter++;
+        }
+        rt_mutex_release(&_mutex);
+
+        _acquired[id]++;
+    }
+
+    rt_sem_release(&_thr_exit_sem);
+}
+
+static void _run_contended(const char *name, void (*entry)(void *))
+{
+    rt_thread_t tid;
+    rt_ubase_t total = 0;
+    rt_uint64_t start, cost;
+
+    _stop = RT_FALSE;
+    _shared_counter = 0;
+    rt_memset(_acquired, 0, sizeof(_acquired));
+
+    /* one more thread than cores, so someone sleeps on the lock */
+    for (int i = 0; i < KERN_TEST_THREADS; i++)
+    {
+        tid = rt_thread_create("flwork", entry, (void *)(rt_ubase_t)i,
+                               UTEST_THR_STACK_SIZE, KERN_TEST_THREAD_PRIO, 5);
+        uassert_not_null(tid);
+        if (tid)
+            rt_thread_startup(tid);
+    }
+
+    start = _now();
+    rt_thread_delay(KERN_TEST_CONTENDED_TICKS);
+    _stop = RT_TRUE;
+
+    for (int i = 0; i < KERN_TEST_THREADS; i++)
+    {
+        rt_sem_take(&_thr_exit_sem, RT_WAITING_FOREVER);
+    }
+    cost = _now() - start;
+
+    for (int i = 0; i < KERN_TEST_THREADS; i++)
+    {
+        total += _acquired[i];
+    }
+
+    /* no update is lost if the lock is mutual exclusive */
+    uassert_int_equal(_shared_counter, total * KERN_TEST_CRITICAL_LOOPS);
+
+    rt_kprintf("contended %s with %d threads: %lu acquisitions", name, KERN_TEST_THREADS, total);
+    if (total)
+        rt_kprintf(", %lu per acquisition", (rt_ubase_t)(cost / total));
+    rt_kprintf("\n");
+}
+
+static void test_fastlock_contended(void)
+{
+    _run_contended("fastlock", _fastlock_worker_entry);
+    _run_contended("mutex", _mutex_worker_entry);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_fastlock_init(&_lock, "fastlock", RT_IPC_FLAG_PRIO);
+    rt_mutex_init(&_mutex, "test", RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_thr_exit_sem, "test", 0, RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_fastlock_detach(&_lock);
+    rt_mutex_detach(&_mutex);
+    rt_sem_detach(&_thr_exit_sem);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_fastlock_basic);
+#ifdef RT_USING_HEAP
+    UTEST_UNIT_RUN(test_fastlock_create);
+#endif
+    UTEST_UNIT_RUN(test_fastlock_wait);
+    UTEST_UNIT_RUN(test_fastlock_uncontended);
+    UTEST_UNIT_RUN(test_fastlock_contended);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.fastlock_tc", utest_tc_init, utest_tc_cleanup, 30);
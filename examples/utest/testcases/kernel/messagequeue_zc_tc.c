@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define MSG_SIZE_MAX        1024
+#define MAX_MSGS            8
+#define BENCH_LOOP_TIMES    10000
+#define BENCH_THREAD_PRIO   (RT_THREAD_PRIORITY_MAX / 3)
+
+static struct rt_messagequeue _mq;
+static rt_uint8_t _mq_buf[RT_MQ_BUF_SIZE(MSG_SIZE_MAX, MAX_MSGS)];
+static rt_uint8_t _msg[MSG_SIZE_MAX];
+static struct rt_semaphore _done_sem;
+static rt_size_t _bench_size;
+
+static void test_mq_zc_order(void)
+{
+    void *slot;
+    rt_ssize_t len;
+
+    /* normal, then urgent: the urgent one is received first */
+    uassert_int_equal(rt_mq_send_reserve(&_mq, &slot, 0), RT_EOK);
+    *(rt_uint32_t *)slot = 1;
+    uassert_int_equal(rt_mq_send_commit(&_mq, slot, sizeof(rt_uint32_t)), RT_EOK);
+
+    uassert_int_equal(rt_mq_send_reserve(&_mq, &slot, 0), RT_EOK);
+    *(rt_uint32_t *)slot = 2;
+    uassert_int_equal(rt_mq_urgent_commit(&_mq, slot, sizeof(rt_uint32_t)), RT_EOK);
+
+    /* a copying sender shares the same queue */
+    *(rt_uint32_t *)_msg = 3;
+    uassert_int_equal(rt_mq_send(&_mq, _msg, sizeof(rt_uint32_t)), RT_EOK);
+
+    len = rt_mq_recv_borrow(&_mq, &slot, 0);
+    uassert_int_equal(len, sizeof(rt_uint32_t));
+    uassert_int_equal(*(rt_uint32_t *)slot, 2);
+    uassert_int_equal(rt_mq_recv_release(&_mq, slot), RT_EOK);
+
+    len = rt_mq_recv_borrow(&_mq, &slot, 0);
+    uassert_int_equal(len, sizeof(rt_uint32_t));
+    uassert_int_equal(*(rt_uint32_t *)slot, 1);
+    uassert_int_equal(rt_mq_recv_release(&_mq, slot), RT_EOK);
+
+    uassert_int_equal(rt_mq_recv(&_mq, _msg, sizeof(_msg), 0), sizeof(rt_uint32_t));
+    uassert_int_equal(*(rt_uint32_t *)_msg, 3);
+
+    uassert_int_equal(rt_mq_recv_borrow(&_mq, &slot, 0), -RT_ETIMEOUT);
+}
+
+#ifdef RT_USING_MESSAGEQUEUE_PRIORITY
+static void test_mq_zc_prio(void)
+{
+    void *slot;
+
+    for (rt_uint32_t prio = 1; prio <= 3; prio++)
+    {
+        uassert_int_equal(rt_mq_send_reserve(&_mq, &slot, 0), RT_EOK);
+        *(rt_uint32_t *)slot = prio;
+        uassert_int_equal(rt_mq_send_commit_prio(&_mq, slot, sizeof(rt_uint32_t), prio), RT_EOK);
+    }
+
+    /* the higher priority ones come first */
+    for (rt_uint32_t prio = 3; prio >= 1; prio--)
+    {
+        uassert_int_equal(rt_mq_recv_borrow(&_mq, &slot, 0), sizeof(rt_uint32_t));
+        uassert_int_equal(*(rt_uint32_t *)slot, prio);
+        rt_mq_recv_release(&_mq, slot);
+    }
+}
+#endif /* RT_USING_MESSAGEQUEUE_PRIORITY */
+
+static void test_mq_zc_full(void)
+{
+    void *slots[MAX_MSGS];
+    void *slot;
+
+    /* a reserved slot is not free even if nothing is committed yet */
+    for (int i = 0; i < MAX_MSGS; i++)
+    {
+        uassert_int_equal(rt_mq_send_reserve(&_mq, &slots[i], 0), RT_EOK);
+    }
+    uassert_int_equal(rt_mq_send_reserve(&_mq, &slot, 0), -RT_EFULL);
+    uassert_int_equal(rt_mq_send(&_mq, _msg, 1), -RT_EFULL);
+
+    /* a bad size gives the slot back */
+    uassert_int_equal(rt_mq_send_commit(&_mq, slots[0], MSG_SIZE_MAX + 1), -RT_ERROR);
+    for (int i = 1; i < MAX_MSGS; i++)
+    {
+        uassert_int_equal(rt_mq_send_cancel(&_mq, slots[i]), RT_EOK);
+    }
+
+    for (int i = 0; i < MAX_MSGS; i++)
+    {
+        uassert_int_equal(rt_mq_send_reserve(&_mq, &slots[i], 0), RT_EOK);
+    }
+    for (int i = 0; i < MAX_MSGS; i++)
+    {
+        rt_mq_send_cancel(&_mq, slots[i]);
+    }
+}
+
+static void _copy_recv_entry(void *param)
+{
+    rt_uint8_t *buf = param;
+
+    for (int i = 0; i < BENCH_LOOP_TIMES; i++)
+    {
+        if (rt_mq_recv(&_mq, buf, MSG_SIZE_MAX, RT_WAITING_FOREVER) != _bench_size)
+            break;
+    }
+    rt_sem_release(&_done_sem);
+}
+
+static void _zc_recv_entry(void *param)
+{
+    void *slot;
+    volatile rt_uint8_t sum = 0;
+
+    for (int i = 0; i < BENCH_LOOP_TIMES; i++)
+    {
+        if (rt_mq_recv_borrow(&_mq, &slot, RT_WAITING_FOREVER) != _bench_size)
+            break;
+        /* processing touches the message in place */
+        sum += ((rt_uint8_t *)slot)[0];
+        rt_mq_recv_release(&_mq, slot);
+    }
+    rt_sem_release(&_done_sem);
+}
+
+static rt_tick_t _bench(rt_bool_t zero_copy, rt_size_t size)
+{
+    static rt_uint8_t recv_buf[MSG_SIZE_MAX];
+    rt_thread_t tid;
+    rt_tick_t start;
+    void *slot;
+
+    _bench_size = size;
+    tid = rt_thread_create("mqzcr", zero_copy ? _zc_recv_entry : _copy_recv_entry, recv_buf,
+                           UTEST_THR_STACK_SIZE, BENCH_THREAD_PRIO, 10);
+    uassert_not_null(tid);
+    if (tid == RT_NULL)
+        return 0;
+    rt_thread_startup(tid);
+
+    start = rt_tick_get();
+    for (int i = 0; i < BENCH_LOOP_TIMES; i++)
+    {
+        if (zero_copy)
+        {
+            rt_mq_send_reserve(&_mq, &slot, RT_WAITING_FOREVER);
+            /* the producer builds the message right in the slot */
+            rt_memset(slot, i, size);
+            rt_mq_send_commit(&_mq, slot, size);
+        }
+        else
+        {
+            rt_memset(_msg, i, size);
+            rt_mq_send_wait(&_mq, _msg, size, RT_WAITING_FOREVER);
+        }
+    }
+    rt_sem_take(&_done_sem, RT_WAITING_FOREVER);
+
+    return rt_tick_get() - start;
+}
+
+static void test_mq_zc_bench(void)
+{
+    rt_tick_t copy_cost, zc_cost;
+
+    for (rt_size_t size = 256; size <= MSG_SIZE_MAX; size *= 2)
+    {
+        copy_cost = _bench(RT_FALSE, size);
+        zc_cost = _bench(RT_TRUE, size);
+
+        rt_kprintf("mq %4d bytes x %d: send/recv %d ticks, reserve/borrow %d ticks\n",
+                   size, BENCH_LOOP_TIMES, copy_cost, zc_cost);
+    }
+    uassert_true(1);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_mq_init(&_mq, "mqzc", _mq_buf, MSG_SIZE_MAX, sizeof(_mq_buf), RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_done_sem, "mqzc", 0, RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_mq_detach(&_mq);
+    rt_sem_detach(&_done_sem);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_mq_zc_order);
+#ifdef RT_USING_MESSAGEQUEUE_PRIORITY
+    UTEST_UNIT_RUN(test_mq_zc_prio);
+#endif
+    UTEST_UNIT_RUN(test_mq_zc_full);
+    UTEST_UNIT_RUN(test_mq_zc_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.messagequeue_zc_tc", utest_tc_init, utest_tc_cleanup, 60);
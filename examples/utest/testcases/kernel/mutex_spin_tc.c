@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define KERN_TEST_MUTEX_TICKS           (RT_TICK_PER_SECOND)
+#define KERN_TEST_CRITICAL_LOOPS        64
+#define KERN_TEST_THREAD_PRIO           (RT_THREAD_PRIORITY_MAX / 3)
+
+static struct rt_mutex _mutex;
+static struct rt_semaphore _thr_exit_sem;
+static volatile rt_bool_t _stop;
+static rt_ubase_t _acquired[RT_CPUS_NR];
+static volatile rt_ubase_t _shared_counter;
+
+/* a short critical section, as the ones in DFS and SAL */
+static void _worker_entry(void *param)
+{
+    int id = (rt_ubase_t)param;
+
+    while (!_stop)
+    {
+        rt_mutex_take(&_mutex, RT_WAITING_FOREVER);
+        for (int i = 0; i < KERN_TEST_CRITICAL_LOOPS; i++)
+        {
+            _shared_counter++;
+        }
+        rt_mutex_release(&_mutex);
+
+        _acquired[id]++;
+    }
+
+    rt_sem_release(&_thr_exit_sem);
+}
+
+static void mutex_short_cs_tc(void)
+{
+    rt_thread_t tid;
+    rt_ubase_t total = 0;
+
+    _stop = RT_FALSE;
+    _shared_counter = 0;
+
+    for (int i = 0; i < RT_CPUS_NR; i++)
+    {
+        tid = rt_thread_create("mtxw", _worker_entry, (void *)(rt_ubase_t)i,
+                               UTEST_THR_STACK_SIZE, KERN_TEST_THREAD_PRIO, 5);
+        uassert_not_null(tid);
+        if (tid)
+        {
+#ifdef RT_USING_SMP
+            rt_thread_control(tid, RT_THREAD_CTRL_BIND_CPU, (void *)(rt_ubase_t)i);
+#endif
+            rt_thread_startup(tid);
+        }
+    }
+
+    rt_thread_delay(KERN_TEST_MUTEX_TICKS);
+    _stop = RT_TRUE;
+
+    for (int i = 0; i < RT_CPUS_NR; i++)
+    {
+        rt_sem_take(&_thr_exit_sem, RT_WAITING_FOREVER);
+        total += _acquired[i];
+    }
+
+    uassert_int_equal(_shared_counter, total * KERN_TEST_CRITICAL_LOOPS);
+
+    rt_kprintf("mutex with %d threads: %lu critical sections/sec\n", RT_CPUS_NR,
+               total * RT_TICK_PER_SECOND / KERN_TEST_MUTEX_TICKS);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_memset(_acquired, 0, sizeof(_acquired));
+    rt_sem_init(&_thr_exit_sem, "test", 0, RT_IPC_FLAG_PRIO);
+    rt_mutex_init(&_mutex, "test", RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_thr_exit_sem);
+    rt_mutex_detach(&_mutex);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(mutex_short_cs_tc);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.mutex_spin_tc", utest_tc_init, utest_tc_cleanup, 30);
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+static struct rt_rwlock _rwlock;
+static struct rt_semaphore _done_sem;
+static rt_err_t _thread_ret;
+static volatile rt_bool_t _writer_got;
+
+static rt_uint8_t _higher_prio(void)
+{
+    rt_uint8_t prio = RT_SCHED_PRIV(rt_thread_self()).current_priority;
+
+    return prio > 0 ? prio - 1 : 0;
+}
+
+static void _start(void (*entry)(void *), void *param)
+{
+    rt_thread_t tid;
+
+    tid = rt_thread_create("rwtest", entry, param, UTEST_THR_STACK_SIZE, _higher_prio(), 10);
+    uassert_not_null(tid);
+    if (tid)
+        rt_thread_startup(tid);
+}
+
+static void _reader_try_entry(void *param)
+{
+    _thread_ret = rt_rwlock_read_take(&_rwlock, 0);
+    if (_thread_ret == RT_EOK)
+        rt_rwlock_read_release(&_rwlock);
+    rt_sem_release(&_done_sem);
+}
+
+static void _writer_entry(void *param)
+{
+    rt_int32_t timeout = (rt_int32_t)(rt_base_t)param;
+
+    _thread_ret = rt_rwlock_write_take(&_rwlock, timeout);
+    if (_thread_ret == RT_EOK)
+    {
+        _writer_got = RT_TRUE;
+        rt_rwlock_write_release(&_rwlock);
+    }
+    rt_sem_release(&_done_sem);
+}
+
+static void test_rwlock_shared_read(void)
+{
+    uassert_int_equal(rt_rwlock_read_take(&_rwlock, RT_WAITING_FOREVER), RT_EOK);
+
+    /* readers share the lock */
+    _start(_reader_try_entry, RT_NULL);
+    rt_sem_take(&_done_sem, RT_WAITING_FOREVER);
+    uassert_int_equal(_thread_ret, RT_EOK);
+
+    /* while a writer is excluded */
+    uassert_int_equal(rt_rwlock_write_take(&_rwlock, 0), -RT_ETIMEOUT);
+
+    uassert_int_equal(rt_rwlock_read_release(&_rwlock), RT_EOK);
+
+    uassert_int_equal(rt_rwlock_write_take(&_rwlock, 0), RT_EOK);
+    uassert_int_equal(rt_rwlock_read_take(&_rwlock, 0), -RT_ETIMEOUT);
+    uassert_int_equal(rt_rwlock_write_release(&_rwlock), RT_EOK);
+}
+
+static void test_rwlock_writer_preferred(void)
+{
+    _writer_got = RT_FALSE;
+    uassert_int_equal(rt_rwlock_read_take(&_rwlock, RT_WAITING_FOREVER), RT_EOK);
+
+    /* the writer blocks on us */
+    _start(_writer_entry, (void *)(rt_base_t)RT_WAITING_FOREVER);
+    rt_thread_delay(2);
+    uassert_false(_writer_got);
+
+    /* a new reader can not overtake the waiting writer */
+    _start(_reader_try_entry, RT_NULL);
+    rt_sem_take(&_done_sem, RT_WAITING_FOREVER);
+    uassert_int_equal(_thread_ret, -RT_ETIMEOUT);
+
+    /* the last reader hands the lock over to the writer */
+    uassert_int_equal(rt_rwlock_read_release(&_rwlock), RT_EOK);
+    rt_sem_take(&_done_sem, RT_WAITING_FOREVER);
+    uassert_int_equal(_thread_ret, RT_EOK);
+    uassert_true(_writer_got);
+}
+
+static void test_rwlock_writer_timeout(void)
+{
+    _writer_got = RT_FALSE;
+    uassert_int_equal(rt_rwlock_read_take(&_rwlock, RT_WAITING_FOREVER), RT_EOK);
+
+    _start(_writer_entry, (void *)(rt_base_t)5);
+    rt_sem_take(&_done_sem, RT_WAITING_FOREVER);
+    uassert_int_equal(_thread_ret, -RT_ETIMEOUT);
+    uassert_false(_writer_got);
+
+    /* the readers are not held off any more */
+    _start(_reader_try_entry, RT_NULL);
+    rt_sem_take(&_done_sem, RT_WAITING_FOREVER);
+    uassert_int_equal(_thread_ret, RT_EOK);
+
+    uassert_int_equal(rt_rwlock_read_release(&_rwlock), RT_EOK);
+}
+
+#ifdef RT_USING_HEAP
+static void test_rwlock_create(void)
+{
+    rt_rwlock_t rwlock;
+
+    rwlock = rt_rwlock_create("rwdyn", RT_IPC_FLAG_PRIO);
+    uassert_not_null(rwlock);
+    if (rwlock == RT_NULL)
+        return;
+
+    uassert_true(rt_object_find("rwdyn", RT_Object_Class_RWLock) == &rwlock->parent);
+    uassert_int_equal(rt_rwlock_write_take(rwlock, 0), RT_EOK);
+    uassert_int_equal(rt_rwlock_write_release(rwlock), RT_EOK);
+    uassert_int_equal(rt_rwlock_delete(rwlock), RT_EOK);
+}
+#endif /* RT_USING_HEAP */
+
+#ifdef RT_USING_RCU
+struct rcu_item
+{
+    int value;
+};
+static struct rcu_item _items[2] = {{1}, {2}};
+static struct rcu_item *_rcu_ptr = &_items[0];
+
+static void test_rcu_synchronize(void)
+{
+    struct rcu_item *item;
+
+    rt_rcu_read_lock();
+    item = rt_rcu_dereference(_rcu_ptr);
+    uassert_int_equal(item->value, 1);
+    rt_rcu_read_unlock();
+
+    rt_rcu_assign_pointer(_rcu_ptr, &_items[1]);
+    rt_rcu_synchronize();
+
+    /* no reader can see the old item now, reuse it */
+    _items[0].value = 0;
+
+    rt_rcu_read_lock();
+    item = rt_rcu_dereference(_rcu_ptr);
+    uassert_int_equal(item->value, 2);
+    rt_rcu_read_unlock();
+}
+#endif /* RT_USING_RCU */
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_rwlock_init(&_rwlock, "rwlock", RT_IPC_FLAG_FIFO);
+    rt_sem_init(&_done_sem, "rwtest", 0, RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_rwlock_detach(&_rwlock);
+    rt_sem_detach(&_done_sem);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_rwlock_shared_read);
+    UTEST_UNIT_RUN(test_rwlock_writer_preferred);
+    UTEST_UNIT_RUN(test_rwlock_writer_timeout);
+#ifdef RT_USING_HEAP
+    UTEST_UNIT_RUN(test_rwlock_create);
+#endif
+#ifdef RT_USING_RCU
+    UTEST_UNIT_RUN(test_rcu_synchronize);
+#endif
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.rwlock_tc", utest_tc_init, utest_tc_cleanup, 10);
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+/*
+ * Two periodic tasks with (C, T) of (11, 20) and (12, 30) ticks, 95% of a core,
+ * working 90% of C. Under rate monotonic priorities the second task finishes
+ * its first job at 30.6 after a release of both, while EDF schedules them.
+ */
+#define KERN_TEST_TASKS_NR              2
+#define KERN_TEST_HYPERPERIODS          10
+#define KERN_TEST_HYPERPERIOD           60
+#define KERN_TEST_WORK_PERCENT          90
+
+static const rt_tick_t _runtime[KERN_TEST_TASKS_NR] = {11, 12};
+static const rt_tick_t _period[KERN_TEST_TASKS_NR] = {20, 30};
+
+static struct rt_semaphore _thr_exit_sem;
+static rt_ubase_t _loops_per_tick;
+static rt_uint32_t _misses[KERN_TEST_TASKS_NR];
+static rt_uint32_t _edf_misses[KERN_TEST_TASKS_NR];
+static volatile rt_bool_t _use_edf;
+static rt_tick_t _start_tick;
+
+static void _burn(rt_ubase_t loops)
+{
+    volatile rt_ubase_t i;
+
+    for (i = 0; i < loops; i++)
+    {
+    }
+}
+
+/* loops of _burn() in one tick, measured with no one else to run */
+static void _calibrate(void)
+{
+    rt_tick_t start;
+    rt_ubase_t loops = 0;
+
+    start = rt_tick_get();
+    while (rt_tick_get() == start)
+    {
+    }
+
+    start = rt_tick_get();
+    while (rt_tick_get() - start < 10)
+    {
+        _burn(100);
+        loops += 100;
+    }
+    _loops_per_tick = loops / 10;
+}
+
+static void _task_entry(void *param)
+{
+    int id = (rt_ubase_t)param;
+    rt_tick_t release, start, jobs;
+    rt_ubase_t work = _loops_per_tick * _runtime[id] * KERN_TEST_WORK_PERCENT / 100;
+    struct rt_thread_deadline_attr attr;
+
+    jobs = KERN_TEST_HYPERPERIODS * KERN_TEST_HYPERPERIOD / _period[id];
+    /* all the tasks are released at the same tick, for the worst case of RM */
+    release = _start_tick;
+    start = release;
+
+    for (rt_tick_t i = 0; i < jobs; i++)
+    {
+        _burn(work);
+
+        /* finished after the start of the next period */
+        if (rt_tick_get() - release > _period[id])
+            _misses[id]++;
+
+        if (_use_edf)
+        {
+            rt_thread_wait_next_period();
+        }
+        else
+        {
+            rt_thread_delay_until(&release, _period[id]);
+        }
+        release = start + (i + 1) * _period[id];
+    }
+
+    if (_use_edf)
+    {
+        rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_GET_DEADLINE, &attr);
+        _edf_misses[id] = attr.misses;
+    }
+
+    rt_sem_release(&_thr_exit_sem);
+}
+
+/* a thread of fixed priority on the EDF level, it runs only in the idle time of EDF threads */
+static void _hog_entry(void *param)
+{
+    rt_tick_t start = rt_tick_get();
+
+    while (rt_tick_get() - start < KERN_TEST_HYPERPERIODS * KERN_TEST_HYPERPERIOD)
+    {
+        _burn(_loops_per_tick / 10);
+    }
+
+    rt_sem_release(&_thr_exit_sem);
+}
+
+/* run the task set, and return the deadline misses seen by the tasks */
+static rt_uint32_t _run(rt_bool_t use_edf)
+{
+    rt_thread_t tid[KERN_TEST_TASKS_NR], hog = RT_NULL;
+    struct rt_thread_deadline_attr attr;
+    rt_uint8_t prio = 0;
+    rt_uint8_t old_prio = RT_SCHED_PRIV(rt_thread_self()).current_priority;
+    int nr = KERN_TEST_TASKS_NR;
+
+    _use_edf = use_edf;
+    rt_memset(_misses, 0, sizeof(_misses));
+    rt_memset(_edf_misses, 0, sizeof(_edf_misses));
+
+    for (int i = 0; i < KERN_TEST_TASKS_NR; i++)
+    {
+        /* the shorter period gets the higher priority */
+        tid[i] = rt_thread_create("edft", _task_entry, (void *)(rt_ubase_t)i,
+                                  UTEST_THR_STACK_SIZE, RT_SCHED_EDF_PRIORITY + i, 5);
+        uassert_not_null(tid[i]);
+        if (tid[i] == RT_NULL)
+            return 0;
+
+#ifdef RT_USING_SMP
+        /* both of them share one core */
+        rt_thread_control(tid[i], RT_THREAD_CTRL_BIND_CPU, (void *)0);
+#endif
+
+        if (use_edf)
+        {
+            attr.runtime = _runtime[i];
+            attr.deadline = _period[i];
+            attr.period = _period[i];
+            uassert_int_equal(rt_thread_control(tid[i], RT_THREAD_CTRL_SET_DEADLINE, &attr), RT_EOK);
+        }
+    }
+
+    if (use_edf)
+    {
+        hog = rt_thread_create("edfh", _hog_entry, RT_NULL,
+                               UTEST_THR_STACK_SIZE, RT_SCHED_EDF_PRIORITY, 5);
+        uassert_not_null(hog);
+#ifdef RT_USING_SMP
+        if (hog)
+            rt_thread_control(hog, RT_THREAD_CTRL_BIND_CPU, (void *)0);
+#endif
+    }
+
+    /* release them at the same time, none of them runs before all are started */
+    rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_CHANGE_PRIORITY, &prio);
+    _start_tick = rt_tick_get();
+    for (int i = 0; i < KERN_TEST_TASKS_NR; i++)
+    {
+        rt_thread_startup(tid[i]);
+    }
+    if (hog)
+    {
+        rt_thread_startup(hog);
+        nr++;
+    }
+    rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_CHANGE_PRIORITY, &old_prio);
+
+    for (int i = 0; i < nr; i++)
+    {
+        rt_sem_take(&_thr_exit_sem, RT_WAITING_FOREVER);
+    }
+
+    rt_kprintf("%s: deadline misses %d/%d and %d/%d", use_edf ? "EDF" : "RM",
+               _misses[0], KERN_TEST_HYPERPERIODS * KERN_TEST_HYPERPERIOD / _period[0],
+               _misses[1], KERN_TEST_HYPERPERIODS * KERN_TEST_HYPERPERIOD / _period[1]);
+    if (use_edf)
+    {
+        rt_kprintf(", counted by kernel %d and %d", _edf_misses[0], _edf_misses[1]);
+    }
+    rt_kprintf("\n");
+
+    return _misses[0] + _misses[1];
+}
+
+/* set half a core on each of nr new threads, return how many are admitted */
+static int _admit_half(int nr, int cpu)
+{
+    rt_thread_t tid[2 * RT_CPUS_NR + 1];
+    struct rt_thread_deadline_attr attr;
+    int admitted = 0;
+
+    attr.runtime = 5;
+    attr.deadline = 10;
+    attr.period = 10;
+    for (int i = 0; i < nr; i++)
+    {
+        tid[i] = rt_thread_create("edfa", _task_entry, RT_NULL, UTEST_THR_STACK_SIZE, RT_THREAD_PRIORITY_MAX - 2, 5);
+        uassert_not_null(tid[i]);
+        if (tid[i] == RT_NULL)
+            break;
+#ifdef RT_USING_SMP
+        rt_thread_control(tid[i], RT_THREAD_CTRL_BIND_CPU, (void *)(rt_ubase_t)cpu);
+#endif
+        if (rt_thread_control(tid[i], RT_THREAD_CTRL_SET_DEADLINE, &attr) == RT_EOK)
+            admitted++;
+    }
+
+    for (int i = 0; i < nr; i++)
+    {
+        if (tid[i])
+            rt_thread_delete(tid[i]);
+    }
+
+    return admitted;
+}
+
+static void edf_admission_tc(void)
+{
+    rt_thread_t tid;
+    struct rt_thread_deadline_attr attr;
+
+    /* runtime must fit in the deadline, and the deadline in the period */
+    tid = rt_thread_create("edfa", _task_entry, RT_NULL, UTEST_THR_STACK_SIZE, RT_THREAD_PRIORITY_MAX - 2, 5);
+    uassert_not_null(tid);
+    if (tid == RT_NULL)
+        return;
+    attr.runtime = 5;
+    attr.deadline = 4;
+    attr.period = 10;
+    uassert_int_equal(rt_thread_control(tid, RT_THREAD_CTRL_SET_DEADLINE, &attr), -RT_EINVAL);
+    rt_thread_delete(tid);
+
+    /* the bandwidth is admitted on each core, the threads bound on one core share it */
+    uassert_int_equal(_admit_half(RT_SCHED_EDF_UTIL_MAX / 50 + 1, 0), RT_SCHED_EDF_UTIL_MAX / 50);
+
+    /* the unbound threads are spread over the cores, none of them gets more than one core */
+    uassert_int_equal(_admit_half(2 * RT_CPUS_NR + 1, RT_CPUS_NR), RT_CPUS_NR * (RT_SCHED_EDF_UTIL_MAX / 50));
+
+    /* the bandwidth is given back on deletion */
+    tid = rt_thread_create("edfa", _task_entry, RT_NULL, UTEST_THR_STACK_SIZE, RT_THREAD_PRIORITY_MAX - 2, 5);
+    uassert_not_null(tid);
+    if (tid == RT_NULL)
+        return;
+    attr.deadline = 10;
+    uassert_int_equal(rt_thread_control(tid, RT_THREAD_CTRL_SET_DEADLINE, &attr), RT_EOK);
+
+    /* and when leaving the EDF class */
+    attr.runtime = 0;
+    uassert_int_equal(rt_thread_control(tid, RT_THREAD_CTRL_SET_DEADLINE, &attr), RT_EOK);
+    uassert_int_equal(RT_SCHED_PRIV(tid).current_priority, RT_THREAD_PRIORITY_MAX - 2);
+    rt_thread_delete(tid);
+}
+
+#if defined(RT_USING_MUTEX) && RT_SCHED_EDF_PRIORITY > 0
+static struct rt_mutex _pi_mutex;
+
+static void _pi_waiter_entry(void *param)
+{
+    rt_mutex_take(&_pi_mutex, RT_WAITING_FOREVER);
+    rt_mutex_release(&_pi_mutex);
+    rt_sem_release(&_thr_exit_sem);
+}
+
+/* joining and leaving the EDF class keeps the priority inherited from a waiter of held mutex */
+static void edf_inherit_tc(void)
+{
+    rt_thread_t waiter;
+    struct rt_thread_deadline_attr attr;
+    rt_thread_t self = rt_thread_self();
+    rt_uint8_t old_prio = RT_SCHED_PRIV(self).init_priority;
+
+    rt_mutex_init(&_pi_mutex, "edfpi", RT_IPC_FLAG_PRIO);
+    rt_mutex_take(&_pi_mutex, RT_WAITING_FOREVER);
+
+    waiter = rt_thread_create("edfw", _pi_waiter_entry, RT_NULL, UTEST_THR_STACK_SIZE, RT_SCHED_EDF_PRIORITY - 1, 5);
+    uassert_not_null(waiter);
+    if (waiter == RT_NULL)
+    {
+        rt_mutex_release(&_pi_mutex);
+        rt_mutex_detach(&_pi_mutex);
+        return;
+    }
+    rt_thread_startup(waiter);
+    rt_thread_delay(2);
+    uassert_int_equal(RT_SCHED_PRIV(self).current_priority, RT_SCHED_EDF_PRIORITY - 1);
+
+    attr.runtime = 5;
+    attr.deadline = 10;
+    attr.period = 10;
+    uassert_int_equal(rt_thread_control(self, RT_THREAD_CTRL_SET_DEADLINE, &attr), RT_EOK);
+    uassert_int_equal(RT_SCHED_PRIV(self).init_priority, RT_SCHED_EDF_PRIORITY);
+    uassert_int_equal(RT_SCHED_PRIV(self).current_priority, RT_SCHED_EDF_PRIORITY - 1);
+
+    /* the boost is dropped to the EDF level on release */
+    rt_mutex_release(&_pi_mutex);
+    rt_sem_take(&_thr_exit_sem, RT_WAITING_FOREVER);
+    uassert_int_equal(RT_SCHED_PRIV(self).current_priority, RT_SCHED_EDF_PRIORITY);
+
+    attr.runtime = 0;
+    uassert_int_equal(rt_thread_control(self, RT_THREAD_CTRL_SET_DEADLINE, &attr), RT_EOK);
+    uassert_int_equal(RT_SCHED_PRIV(self).current_priority, old_prio);
+
+    rt_mutex_detach(&_pi_mutex);
+}
+#endif /* RT_USING_MUTEX && RT_SCHED_EDF_PRIORITY > 0 */
+
+static void edf_periodic_tc(void)
+{
+    rt_uint8_t prio = 0;
+    rt_uint8_t old_prio = RT_SCHED_PRIV(rt_thread_self()).current_priority;
+
+    /* nothing else runs while calibrating */
+    rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_CHANGE_PRIORITY, &prio);
+    _calibrate();
+    rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_CHANGE_PRIORITY, &old_prio);
+
+    /* RM misses deadlines, EDF does not, even with a busy thread on its level */
+    uassert_true(_run(RT_FALSE) > 0);
+    uassert_int_equal(_run(RT_TRUE), 0);
+    uassert_int_equal(_edf_misses[0] + _edf_misses[1], 0);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_sem_init(&_thr_exit_sem, "test", 0, RT_IPC_FLAG_PRIO);
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_thr_exit_sem);
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(edf_admission_tc);
+#if defined(RT_USING_MUTEX) && RT_SCHED_EDF_PRIORITY > 0
+    UTEST_UNIT_RUN(edf_inherit_tc);
+#endif
+    UTEST_UNIT_RUN(edf_periodic_tc);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.scheduler.edf", utest_tc_init, utest_tc_cleanup, 30);
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include "rthw.h"
+#include "utest.h"
+
+#define KERN_TEST_PINGPONG_PAIRS        RT_CPUS_NR
+#define KERN_TEST_PINGPONG_LOOP_TIMES   10000
+#define KERN_TEST_SPIN_THREADS          RT_CPUS_NR
+#define KERN_TEST_SPIN_TICKS            (RT_TICK_PER_SECOND / 2)
+#define KERN_TEST_THREAD_PRIO           (RT_THREAD_PRIORITY_MAX / 3)
+
+static struct rt_semaphore _thr_exit_sem;
+static struct rt_semaphore _ping[KERN_TEST_PINGPONG_PAIRS];
+static struct rt_semaphore _pong[KERN_TEST_PINGPONG_PAIRS];
+static rt_atomic_t _cpu_seen;
+static rt_atomic_t _migrations;
+static volatile rt_bool_t _spin_stop;
+
+/* every round trip is two wakeups and two context switches */
+static void _ping_entry(void *param)
+{
+    int pair = (rt_ubase_t)param;
+
+    for (size_t i = 0; i < KERN_TEST_PINGPONG_LOOP_TIMES; i++)
+    {
+        rt_sem_release(&_ping[pair]);
+        if (rt_sem_take(&_pong[pair], RT_WAITING_FOREVER) != RT_EOK)
+            break;
+    }
+
+    rt_atomic_add(&_migrations, RT_SCHED_CTX(rt_thread_self()).migrations);
+    rt_sem_release(&_thr_exit_sem);
+}
+
+static void _pong_entry(void *param)
+{
+    int pair = (rt_ubase_t)param;
+
+    for (size_t i = 0; i < KERN_TEST_PINGPONG_LOOP_TIMES; i++)
+    {
+        if (rt_sem_take(&_ping[pair], RT_WAITING_FOREVER) != RT_EOK)
+            break;
+        rt_sem_release(&_pong[pair]);
+    }
+
+    rt_atomic_add(&_migrations, RT_SCHED_CTX(rt_thread_self()).migrations);
+    rt_sem_release(&_thr_exit_sem);
+}
+
+static void _spin_entry(void *param)
+{
+    while (!_spin_stop)
+    {
+        rt_atomic_or(&_cpu_seen, 1 << rt_hw_cpu_id());
+    }
+
+    rt_sem_release(&_thr_exit_sem);
+}
+
+static void _start_thread(const char *name, void (*entry)(void *), rt_ubase_t param)
+{
+    rt_thread_t tid;
+
+    tid = rt_thread_create(name, entry, (void *)param, UTEST_THR_STACK_SIZE,
+                           KERN_TEST_THREAD_PRIO, 5);
+    uassert_not_null(tid);
+    if (tid)
+        rt_thread_startup(tid);
+}
+
+static void pingpong_tc(void)
+{
+    rt_tick_t start, cost;
+
+    _migrations = 0;
+    start = rt_tick_get();
+    for (size_t i = 0; i < KERN_TEST_PINGPONG_PAIRS; i++)
+    {
+        _start_thread("ping", _ping_entry, i);
+        _start_thread("pong", _pong_entry, i);
+    }
+
+    for (size_t i = 0; i < KERN_TEST_PINGPONG_PAIRS * 2; i++)
+    {
+        rt_sem_take(&_thr_exit_sem, RT_WAITING_FOREVER);
+    }
+    cost = rt_tick_get() - start;
+
+    rt_kprintf("%d pairs x %d round trips in %d ticks", KERN_TEST_PINGPONG_PAIRS,
+               KERN_TEST_PINGPONG_LOOP_TIMES, cost);
+    if (cost)
+    {
+        rt_kprintf(", %d wakeups/sec",
+                   KERN_TEST_PINGPONG_PAIRS * KERN_TEST_PINGPONG_LOOP_TIMES * 2 * RT_TICK_PER_SECOND / cost);
+    }
+    rt_kprintf(", %d migrations\n", _migrations);
+    uassert_true(1);
+}
+
+static void balance_tc(void)
+{
+    _cpu_seen = 0;
+    _spin_stop = RT_FALSE;
+
+    /* all of them are created on this core, the idle ones have to pull them */
+    for (size_t i = 0; i < KERN_TEST_SPIN_THREADS; i++)
+    {
+        _start_thread("spin", _spin_entry, i);
+    }
+
+    rt_thread_delay(KERN_TEST_SPIN_TICKS);
+    _spin_stop = RT_TRUE;
+
+    for (size_t i = 0; i < KERN_TEST_SPIN_THREADS; i++)
+    {
+        rt_sem_take(&_thr_exit_sem, RT_WAITING_FOREVER);
+    }
+
+    uassert_int_equal(_cpu_seen, (1 << RT_CPUS_NR) - 1);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_sem_init(&_thr_exit_sem, "test", 0, RT_IPC_FLAG_PRIO);
+    for (size_t i = 0; i < KERN_TEST_PINGPONG_PAIRS; i++)
+    {
+        rt_sem_init(&_ping[i], "ping", 0, RT_IPC_FLAG_PRIO);
+        rt_sem_init(&_pong[i], "pong", 0, RT_IPC_FLAG_PRIO);
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_thr_exit_sem);
+    for (size_t i = 0; i < KERN_TEST_PINGPONG_PAIRS; i++)
+    {
+        rt_sem_detach(&_ping[i]);
+        rt_sem_detach(&_pong[i]);
+    }
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(pingpong_tc);
+    UTEST_UNIT_RUN(balance_tc);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.scheduler.percpu_rq", utest_tc_init, utest_tc_cleanup, 30);
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include "rthw.h"
+#include "utest.h"
+
+#define KERN_TEST_CONTENTION_TICKS      (RT_TICK_PER_SECOND)
+#define KERN_TEST_CRITICAL_LOOPS        16
+#define KERN_TEST_THREAD_PRIO           (RT_THREAD_PRIORITY_MAX / 3)
+
+static struct rt_spinlock _lock;
+static struct rt_semaphore _thr_exit_sem;
+static volatile rt_bool_t _stop;
+static rt_ubase_t _acquired[RT_CPUS_NR];
+static volatile rt_ubase_t _shared_counter;
+
+#ifdef RT_USING_LOCKSTAT
+static RT_DEFINE_LOCKSTAT_CLASS(arch_lock);
+#ifdef RT_USING_SPINLOCK_TICKET
+static RT_DEFINE_LOCKSTAT_CLASS(ticket_lock);
+#endif
+#endif /* RT_USING_LOCKSTAT */
+
+/* one hammering thread is bound on every core */
+static void _hammer_entry(void *param)
+{
+    int cpu = (rt_ubase_t)param;
+    rt_base_t level;
+
+    while (!_stop)
+    {
+        level = rt_spin_lock_irqsave(&_lock);
+        for (int i = 0; i < KERN_TEST_CRITICAL_LOOPS; i++)
+        {
+            _shared_counter++;
+        }
+        rt_spin_unlock_irqrestore(&_lock, level);
+
+        _acquired[cpu]++;
+    }
+
+    rt_sem_release(&_thr_exit_sem);
+}
+
+static void _run(const char *name)
+{
+    rt_thread_t tid;
+    rt_ubase_t total = 0, min = ~0UL, max = 0;
+
+    _stop = RT_FALSE;
+    _shared_counter = 0;
+    rt_memset(_acquired, 0, sizeof(_acquired));
+
+    for (int i = 0; i < RT_CPUS_NR; i++)
+    {
+        tid = rt_thread_create("hammer", _hammer_entry, (void *)(rt_ubase_t)i,
+                               UTEST_THR_STACK_SIZE, KERN_TEST_THREAD_PRIO, 5);
+        uassert_not_null(tid);
+        if (tid)
+        {
+            rt_thread_control(tid, RT_THREAD_CTRL_BIND_CPU, (void *)(rt_ubase_t)i);
+            rt_thread_startup(tid);
+        }
+    }
+
+    rt_thread_delay(KERN_TEST_CONTENTION_TICKS);
+    _stop = RT_TRUE;
+
+    for (int i = 0; i < RT_CPUS_NR; i++)
+    {
+        rt_sem_take(&_thr_exit_sem, RT_WAITING_FOREVER);
+    }
+
+    for (int i = 0; i < RT_CPUS_NR; i++)
+    {
+        total += _acquired[i];
+        if (_acquired[i] < min)
+            min = _acquired[i];
+        if (_acquired[i] > max)
+            max = _acquired[i];
+    }
+
+    /* no update is lost if the lock is mutual exclusive */
+    uassert_int_equal(_shared_counter, total * KERN_TEST_CRITICAL_LOOPS);
+
+    rt_kprintf("%s: %lu acquisitions/sec, per-core min %lu max %lu\n", name,
+               total * RT_TICK_PER_SECOND / KERN_TEST_CONTENTION_TICKS, min, max);
+}
+
+static void arch_lock_tc(void)
+{
+    rt_spin_lock_init(&_lock);
+#ifdef RT_USING_SPINLOCK_TICKET
+    _lock.queued = 0;
+#endif
+#ifdef RT_USING_LOCKSTAT
+    rt_spin_lock_set_class(&_lock, &arch_lock);
+#endif
+    _run("arch spinlock");
+}
+
+#ifdef RT_USING_SPINLOCK_TICKET
+static void ticket_lock_tc(void)
+{
+    rt_spin_lock_init_ticket(&_lock);
+#ifdef RT_USING_LOCKSTAT
+    rt_spin_lock_set_class(&_lock, &ticket_lock);
+#endif
+    _run("ticket spinlock");
+}
+#endif /* RT_USING_SPINLOCK_TICKET */
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_sem_init(&_thr_exit_sem, "test", 0, RT_IPC_FLAG_PRIO);
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_thr_exit_sem);
+#ifdef RT_USING_LOCKSTAT
+    rt_lockstat_dump();
+#endif
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(arch_lock_tc);
+#ifdef RT_USING_SPINLOCK_TICKET
+    UTEST_UNIT_RUN(ticket_lock_tc);
+#endif
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.spinlock_contention", utest_tc_init, utest_tc_cleanup, 30);
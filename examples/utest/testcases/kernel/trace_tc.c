@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include "rttrace.h"
+#include "utest.h"
+
+#define TRACE_TEST_ROUNDS           16
+#define TRACE_TEST_RECORDS          100000
+#define TRACE_TEST_DUMP_SIZE        (RT_CPUS_NR * RT_TRACE_BUF_EVENTS * 48 + 16 * 1024)
+
+static struct rt_semaphore _ping;
+static struct rt_semaphore _pong;
+static rt_uint8_t *_dump_buf;
+static rt_size_t _dump_len;
+
+static rt_ssize_t _mem_write(void *ctx, const void *buf, rt_size_t size)
+{
+    if (_dump_len + size > TRACE_TEST_DUMP_SIZE)
+        return -RT_EFULL;
+
+    rt_memcpy(_dump_buf + _dump_len, buf, size);
+    _dump_len += size;
+    return size;
+}
+
+static void _pong_entry(void *param)
+{
+    for (int i = 0; i < TRACE_TEST_ROUNDS; i++)
+    {
+        rt_sem_take(&_ping, RT_WAITING_FOREVER);
+        rt_sem_release(&_pong);
+    }
+}
+
+static void trace_record_tc(void)
+{
+    struct rt_trace_header *header;
+    struct rt_trace_chunk *chunk;
+    struct rt_trace_event *event;
+    rt_size_t offset;
+    int switches = 0, puts = 0, marks = 0;
+    rt_thread_t tid;
+
+    rt_trace_stop();
+    rt_trace_clear();
+    uassert_int_equal(rt_trace_start(), RT_EOK);
+
+    tid = rt_thread_create("tpong", _pong_entry, RT_NULL, UTEST_THR_STACK_SIZE,
+                           RT_SCHED_PRIV(rt_thread_self()).current_priority - 1, 10);
+    uassert_not_null(tid);
+    if (tid == RT_NULL)
+        return;
+    rt_thread_startup(tid);
+
+    rt_trace_mark(1, 0);
+    for (int i = 0; i < TRACE_TEST_ROUNDS; i++)
+    {
+        rt_sem_release(&_ping);
+        rt_sem_take(&_pong, RT_WAITING_FOREVER);
+    }
+    rt_trace_mark(1, 1);
+    rt_trace_stop();
+
+    _dump_len = 0;
+    uassert_int_equal(rt_trace_dump(_mem_write, RT_NULL), RT_EOK);
+
+    header = (struct rt_trace_header *)_dump_buf;
+    uassert_int_equal(header->magic, RT_TRACE_MAGIC);
+    uassert_int_equal(header->event_size, sizeof(struct rt_trace_event));
+    uassert_true(header->clock_res != 0);
+
+    /* walk the chunks */
+    offset = sizeof(*header);
+    while (offset + sizeof(*chunk) <= _dump_len)
+    {
+        chunk = (struct rt_trace_chunk *)(_dump_buf + offset);
+        offset += sizeof(*chunk);
+
+        if (chunk->magic == RT_TRACE_NAME_MAGIC)
+        {
+            offset += chunk->count * header->name_size;
+            continue;
+        }
+
+        uassert_int_equal(chunk->magic, RT_TRACE_EVENT_MAGIC);
+        if (chunk->magic != RT_TRACE_EVENT_MAGIC)
+            break;
+
+        for (rt_uint32_t i = 0; i < chunk->count; i++, offset += header->event_size)
+        {
+            event = (struct rt_trace_event *)(_dump_buf + offset);
+            if (event->type == RT_TRACE_EVENT_SWITCH)
+                switches++;
+            else if (event->type == RT_TRACE_EVENT_IPC_PUT && event->arg0 == (rt_ubase_t)&_ping)
+                puts++;
+            else if (event->type == RT_TRACE_EVENT_MARK)
+                marks++;
+        }
+    }
+    uassert_int_equal(offset, _dump_len);
+
+    /* every round switches to the pong thread and back */
+    uassert_true(switches >= TRACE_TEST_ROUNDS * 2);
+    uassert_int_equal(puts, TRACE_TEST_ROUNDS);
+    uassert_int_equal(marks, 2);
+}
+
+static void trace_overhead_tc(void)
+{
+    rt_tick_t start, cost;
+
+    rt_trace_clear();
+    rt_trace_start();
+
+    start = rt_tick_get();
+    for (int i = 0; i < TRACE_TEST_RECORDS; i++)
+    {
+        rt_trace_mark(2, i);
+    }
+    cost = rt_tick_get() - start;
+
+    rt_trace_stop();
+    rt_trace_clear();
+
+    rt_kprintf("%d trace records in %d ticks", TRACE_TEST_RECORDS, cost);
+    if (cost)
+    {
+        rt_kprintf(", %d ns per record",
+                   (int)((rt_uint64_t)cost * (1000000000 / RT_TICK_PER_SECOND) / TRACE_TEST_RECORDS));
+    }
+    rt_kprintf("\n");
+    uassert_true(1);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    _dump_buf = rt_malloc(TRACE_TEST_DUMP_SIZE);
+    if (_dump_buf == RT_NULL)
+        return -RT_ENOMEM;
+
+    rt_sem_init(&_ping, "tping", 0, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_pong, "tpong", 0, RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_ping);
+    rt_sem_detach(&_pong);
+    rt_free(_dump_buf);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(trace_record_tc);
+    UTEST_UNIT_RUN(trace_overhead_tc);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.trace_tc", utest_tc_init, utest_tc_cleanup, 30);
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+#ifdef RT_USING_CPUTIME
+#include <drivers/cputime.h>
+#endif
+
+#define LATENCY_ROUNDS          200
+#define POLL_TIMEOUT_TICKS      1
+#define PRODUCER_PRIO           (RT_THREAD_PRIORITY_MAX / 3)
+
+#define EVENT_FLAG              (1 << 3)
+
+static struct rt_semaphore _sem;
+static struct rt_event _event;
+static struct rt_mailbox _mb;
+static rt_ubase_t _mb_pool[4];
+static struct rt_semaphore _done_sem;
+static struct rt_wait_any_item _items[3];
+static volatile rt_uint64_t _fire_time;
+static volatile rt_tick_t _fire_tick;
+
+/* cpu cycles if there is a cputime device, otherwise os ticks */
+static rt_uint64_t _now(void)
+{
+#ifdef RT_USING_CPUTIME
+    return clock_cpu_gettime();
+#else
+    return rt_tick_get();
+#endif
+}
+
+static void _fire(int which)
+{
+    _fire_tick = rt_tick_get();
+    _fire_time = _now();
+    switch (which)
+    {
+    case 0:
+        rt_sem_release(&_sem);
+        break;
+    case 1:
+        rt_event_send(&_event, EVENT_FLAG);
+        break;
+    default:
+        rt_mb_send(&_mb, which);
+        break;
+    }
+}
+
+/* consume what the item reports ready */
+static rt_bool_t _take(int which)
+{
+    rt_uint32_t recved;
+    rt_ubase_t value;
+
+    switch (which)
+    {
+    case 0:
+        return rt_sem_take(&_sem, RT_WAITING_NO) == RT_EOK;
+    case 1:
+        return rt_event_recv(&_event, EVENT_FLAG, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                             RT_WAITING_NO, &recved) == RT_EOK;
+    default:
+        return rt_mb_recv(&_mb, &value, RT_WAITING_NO) == RT_EOK;
+    }
+}
+
+static void test_wait_any_ready(void)
+{
+    /* nothing is ready */
+    uassert_int_equal(rt_wait_any(_items, 3, RT_WAITING_NO), -RT_ETIMEOUT);
+    uassert_int_equal(rt_wait_any(_items, 3, 2), -RT_ETIMEOUT);
+
+    /* an event bit not waited for does not fire */
+    rt_event_send(&_event, EVENT_FLAG << 1);
+    uassert_int_equal(rt_wait_any(_items, 3, RT_WAITING_NO), -RT_ETIMEOUT);
+
+    for (int i = 0; i < 3; i++)
+    {
+        _fire(i);
+        uassert_int_equal(rt_wait_any(_items, 3, RT_WAITING_NO), i);
+        uassert_true(_take(i));
+    }
+}
+
+static void _producer_entry(void *param)
+{
+    for (int i = 0; i < LATENCY_ROUNDS; i++)
+    {
+        rt_thread_delay(1 + i % 3);
+        _fire(i % 3);
+    }
+    rt_sem_release(&_done_sem);
+}
+
+static void _start_producer(void)
+{
+    rt_thread_t tid;
+
+    tid = rt_thread_create("waprod", _producer_entry, RT_NULL, UTEST_THR_STACK_SIZE,
+                           PRODUCER_PRIO, 10);
+    uassert_not_null(tid);
+    if (tid)
+        rt_thread_startup(tid);
+}
+
+static void _report(const char *name, rt_uint64_t total, rt_uint64_t max, int rounds)
+{
+    rt_kprintf("%s: %d wakeups, latency avg %lu max %lu %s\n", name, rounds,
+               rounds ? (rt_ubase_t)(total / rounds) : 0, (rt_ubase_t)max,
+#ifdef RT_USING_CPUTIME
+               "cycles"
+#else
+               "ticks"
+#endif
+               );
+}
+
+static void test_wait_any_latency(void)
+{
+    rt_uint64_t latency, total = 0, max = 0;
+    rt_tick_t max_ticks = 0;
+    rt_ssize_t which;
+    int rounds = 0;
+
+    _start_producer();
+    while (rounds < LATENCY_ROUNDS)
+    {
+        which = rt_wait_any(_items, 3, RT_WAITING_FOREVER);
+        if (which < 0)
+            break;
+
+        latency = _now() - _fire_time;
+        if (rt_tick_get() - _fire_tick > max_ticks)
+            max_ticks = rt_tick_get() - _fire_tick;
+        if (_take(which))
+        {
+            total += latency;
+            if (latency > max)
+                max = latency;
+            rounds++;
+        }
+    }
+    rt_sem_take(&_done_sem, RT_WAITING_FOREVER);
+
+    uassert_int_equal(rounds, LATENCY_ROUNDS);
+    _report("rt_wait_any", total, max, rounds);
+    /* woken up by the release itself, only a tick boundary may be crossed */
+    uassert_true(max_ticks <= 1);
+}
+
+static void test_poll_latency(void)
+{
+    rt_uint64_t latency, total = 0, max = 0;
+    rt_ubase_t value;
+    rt_uint32_t recved;
+    int rounds = 0;
+
+    /* the polling approach: a short timeout on each source in turn */
+    _start_producer();
+    while (rounds < LATENCY_ROUNDS)
+    {
+        if (rt_sem_take(&_sem, POLL_TIMEOUT_TICKS) != RT_EOK &&
+            rt_event_recv(&_event, EVENT_FLAG, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                          POLL_TIMEOUT_TICKS, &recved) != RT_EOK &&
+            rt_mb_recv(&_mb, &value, POLL_TIMEOUT_TICKS) != RT_EOK)
+        {
+            continue;
+        }
+
+        latency = _now() - _fire_time;
+        total += latency;
+        if (latency > max)
+            max = latency;
+        rounds++;
+    }
+    rt_sem_take(&_done_sem, RT_WAITING_FOREVER);
+
+    uassert_int_equal(rounds, LATENCY_ROUNDS);
+    _report("polling", total, max, rounds);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_sem_init(&_sem, "wasem", 0, RT_IPC_FLAG_PRIO);
+    rt_event_init(&_event, "waevt", RT_IPC_FLAG_PRIO);
+    rt_mb_init(&_mb, "wamb", _mb_pool, sizeof(_mb_pool) / sizeof(_mb_pool[0]), RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_done_sem, "wadone", 0, RT_IPC_FLAG_PRIO);
+
+    _items[0].object = &_sem.parent.parent;
+    _items[1].object = &_event.parent.parent;
+    _items[1].set = EVENT_FLAG;
+    _items[2].object = &_mb.parent.parent;
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_sem);
+    rt_event_detach(&_event);
+    rt_mb_detach(&_mb);
+    rt_sem_detach(&_done_sem);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_wait_any_ready);
+    UTEST_UNIT_RUN(test_wait_any_latency);
+    UTEST_UNIT_RUN(test_poll_latency);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.wait_any_tc", utest_tc_init, utest_tc_cleanup, 60);
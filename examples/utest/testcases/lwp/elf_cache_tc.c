@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+/**
+ * Load the same executable into a new process repeatedly, once with the
+ * cache of image headers dropped before every load and once with the cache
+ * kept, check the lookups hit and missed and report the exec latency.
+ */
+
+#include <rtthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <lwp.h>
+#include <lwp_user_mm.h>
+#include "utest.h"
+
+#define ELF_ROUNDS  64
+
+extern int lwp_load(const char *filename, struct rt_lwp *lwp, uint8_t *load_addr,
+                    size_t addr_size, struct process_aux *aux);
+extern struct process_aux *lwp_argscopy(struct rt_lwp *lwp, int argc, char **argv, char **envp);
+
+static int _load_once(void **entry)
+{
+    struct rt_lwp *lwp;
+    struct process_aux *aux;
+    char *argv[] = {UTEST_LWP_ELF_PATH, RT_NULL};
+    char *envp[] = {RT_NULL};
+    int ret = -RT_ENOMEM;
+
+    lwp = lwp_create(LWP_CREATE_FLAG_NONE);
+    if (lwp == RT_NULL)
+        return -RT_ENOMEM;
+
+    if (lwp_user_space_init(lwp, 0) == 0)
+    {
+        aux = lwp_argscopy(lwp, 1, argv, envp);
+        if (aux)
+        {
+            ret = lwp_load(UTEST_LWP_ELF_PATH, lwp, RT_NULL, 0, aux);
+            *entry = lwp->text_entry;
+        }
+    }
+    lwp_ref_dec(lwp);
+
+    return ret;
+}
+
+static void elf_cache_exec_tc(void)
+{
+    void *cold_entry = RT_NULL, *warm_entry = RT_NULL;
+    rt_size_t hit, miss, hit_base, miss_base, lookups;
+    rt_tick_t start, cold_cost, warm_cost;
+    struct stat st;
+    int i;
+
+    if (access(UTEST_LWP_ELF_PATH, X_OK) != 0 || stat(UTEST_LWP_ELF_PATH, &st) != 0)
+    {
+        LOG_W("%s not found, skipped", UTEST_LWP_ELF_PATH);
+        return;
+    }
+
+    /* every lookup misses with the cache dropped before */
+    lwp_elf_cache_stat(&hit_base, &miss_base);
+    start = rt_tick_get();
+    for (i = 0; i < ELF_ROUNDS; i++)
+    {
+        lwp_elf_cache_flush();
+        if (_load_once(&cold_entry) != RT_EOK)
+            break;
+    }
+    cold_cost = rt_tick_get() - start;
+    uassert_int_equal(i, ELF_ROUNDS);
+    lwp_elf_cache_stat(&hit, &miss);
+    uassert_int_equal(hit, hit_base);
+
+    /* the image, and the interpreter of it if any; none on a file system without times */
+    lookups = (miss - miss_base) / ELF_ROUNDS;
+    uassert_int_equal(lookups * ELF_ROUNDS, miss - miss_base);
+    if (st.st_mtime != 0)
+        uassert_true(lookups > 0);
+    else
+        LOG_W("%s has no mtime, not cached", UTEST_LWP_ELF_PATH);
+
+    /* the first load fills the cache and the others hit it */
+    hit_base = hit;
+    miss_base = miss;
+    lwp_elf_cache_flush();
+    start = rt_tick_get();
+    for (i = 0; i < ELF_ROUNDS; i++)
+    {
+        if (_load_once(&warm_entry) != RT_EOK)
+            break;
+    }
+    warm_cost = rt_tick_get() - start;
+    uassert_int_equal(i, ELF_ROUNDS);
+    lwp_elf_cache_stat(&hit, &miss);
+    uassert_int_equal(miss - miss_base, lookups);
+    uassert_int_equal(hit - hit_base, lookups * (ELF_ROUNDS - 1));
+
+    /* the latency is only reported, a tick is too coarse to compare them */
+    rt_kprintf("elf cache: %d loads, cold %d ticks, warm %d ticks\n",
+               ELF_ROUNDS, cold_cost, warm_cost);
+
+#ifndef ELF_LOAD_RANDOMIZE
+    /* the image is loaded the same with the headers cached */
+    uassert_true(cold_entry == warm_entry);
+#endif
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(elf_cache_exec_tc);
+}
+UTEST_TC_EXPORT(testcase, "testcases.lwp.elf_cache_tc", utest_tc_init, utest_tc_cleanup, 60);
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+/**
+ * Ping-pong on shared futexes of several processes at the same time, once
+ * with every process hashed to a bucket of its own and once with all of them
+ * crowded into the same bucket. The futexes are driven from kernel threads on
+ * kernel words, the same path as sys_futex() after the key is resolved.
+ */
+
+#include <rtthread.h>
+#include <lwp.h>
+#include "lwp_futex_internal.h"
+#include "utest.h"
+
+#define FTX_PAIRS           4
+#define FTX_ROUNDS          2000
+#define FTX_STACK_SIZE      0x2000
+#define FTX_KEY_TRIES       4096
+
+struct ftx_pair
+{
+    struct rt_lwp *lwp;
+    struct shared_futex_key key;
+    rt_futex_t futex;
+    int word;
+    int rounds;
+};
+
+static struct ftx_pair _pairs[FTX_PAIRS];
+static struct rt_semaphore _done;
+
+static void _ping_entry(void *param)
+{
+    struct ftx_pair *pair = param;
+
+    for (int i = 0; i < FTX_ROUNDS; i++)
+    {
+        pair->word = 1;
+        futex_wake(pair->futex, pair->lwp, 1, 0);
+        while (pair->word == 1)
+            futex_wait(pair->futex, pair->lwp, &pair->word, 1, RT_NULL, 0);
+        pair->rounds++;
+    }
+    rt_sem_release(&_done);
+}
+
+static void _pong_entry(void *param)
+{
+    struct ftx_pair *pair = param;
+
+    for (int i = 0; i < FTX_ROUNDS; i++)
+    {
+        while (pair->word == 0)
+            futex_wait(pair->futex, pair->lwp, &pair->word, 0, RT_NULL, 0);
+        pair->word = 0;
+        futex_wake(pair->futex, pair->lwp, 1, 0);
+    }
+    rt_sem_release(&_done);
+}
+
+/* pick a key per process, in a bucket of its own or all in the same one */
+static rt_bool_t _pick_keys(rt_bool_t collide)
+{
+    struct shared_futex_bucket *used[FTX_PAIRS];
+    struct shared_futex_bucket *bucket;
+    int tries;
+
+    for (int i = 0; i < FTX_PAIRS; i++)
+    {
+        _pairs[i].key.mobj = (rt_mem_obj_t)&_pairs[i];
+        for (tries = 0; tries < FTX_KEY_TRIES; tries++)
+        {
+            _pairs[i].key.offset = tries * sizeof(int);
+            bucket = futex_global_table_bucket(&_pairs[i].key);
+
+            if (i == 0)
+                break;
+            if (collide && bucket == used[0])
+                break;
+            if (!collide)
+            {
+                int j;
+                for (j = 0; j < i && used[j] != bucket; j++)
+                    ;
+                if (j == i)
+                    break;
+            }
+        }
+        if (tries == FTX_KEY_TRIES)
+            return RT_FALSE;
+        used[i] = bucket;
+    }
+
+    return RT_TRUE;
+}
+
+static void _run_pairs(const char *title, rt_bool_t collide)
+{
+    rt_thread_t tid;
+    rt_err_t error;
+    rt_tick_t start, cost;
+    int rounds = 0;
+
+    if (LWP_FUTEX_HASH_BUCKETS < FTX_PAIRS && !collide)
+        return;
+
+    if (!_pick_keys(collide))
+    {
+        uassert_true(0);
+        return;
+    }
+
+    for (int i = 0; i < FTX_PAIRS; i++)
+    {
+        _pairs[i].word = 0;
+        _pairs[i].rounds = 0;
+        _pairs[i].futex = futex_shared_get(&_pairs[i].key, _pairs[i].lwp, &error);
+        uassert_int_equal(error, 0);
+        uassert_not_null(_pairs[i].futex);
+        if (!_pairs[i].futex)
+            return;
+    }
+
+    start = rt_tick_get();
+    for (int i = 0; i < FTX_PAIRS; i++)
+    {
+        tid = rt_thread_create("fping", _ping_entry, &_pairs[i], FTX_STACK_SIZE,
+                               RT_SCHED_PRIV(rt_thread_self()).current_priority + 1, 10);
+        uassert_not_null(tid);
+        rt_thread_startup(tid);
+        tid = rt_thread_create("fpong", _pong_entry, &_pairs[i], FTX_STACK_SIZE,
+                               RT_SCHED_PRIV(rt_thread_self()).current_priority + 1, 10);
+        uassert_not_null(tid);
+        rt_thread_startup(tid);
+    }
+
+    for (int i = 0; i < FTX_PAIRS * 2; i++)
+        rt_sem_take(&_done, RT_WAITING_FOREVER);
+    cost = rt_tick_get() - start;
+
+    for (int i = 0; i < FTX_PAIRS; i++)
+    {
+        rounds += _pairs[i].rounds;
+        rt_custom_object_destroy(_pairs[i].futex->custom_obj);
+        _pairs[i].futex = RT_NULL;
+    }
+    uassert_int_equal(rounds, FTX_PAIRS * FTX_ROUNDS);
+
+    rt_kprintf("%s: %d rounds of %d processes in %d ticks", title, rounds, FTX_PAIRS, cost);
+    if (cost)
+        rt_kprintf(", %d rounds/s", (int)((rt_uint64_t)rounds * RT_TICK_PER_SECOND / cost));
+    rt_kprintf("\n");
+}
+
+static void futex_bucket_spread_tc(void)
+{
+    _run_pairs("spread buckets", RT_FALSE);
+}
+
+static void futex_bucket_collide_tc(void)
+{
+    _run_pairs("one bucket", RT_TRUE);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    for (int i = 0; i < FTX_PAIRS; i++)
+    {
+        _pairs[i].lwp = lwp_create(0);
+        if (_pairs[i].lwp == RT_NULL)
+        {
+            while (i--)
+                lwp_ref_dec(_pairs[i].lwp);
+            return -RT_ENOMEM;
+        }
+    }
+    rt_sem_init(&_done, "ftxdone", 0, RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    for (int i = 0; i < FTX_PAIRS; i++)
+    {
+        lwp_ref_dec(_pairs[i].lwp);
+        _pairs[i].lwp = RT_NULL;
+    }
+    rt_sem_detach(&_done);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(futex_bucket_spread_tc);
+    UTEST_UNIT_RUN(futex_bucket_collide_tc);
+}
+UTEST_TC_EXPORT(testcase, "testcases.lwp.futex_bucket_tc", utest_tc_init, utest_tc_cleanup, 60);
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+/**
+ * The system call ring of a process: the order and results of completions,
+ * the checks of the indexes from user, and the throughput of small I/O in
+ * batches against the one by one calls.
+ */
+
+#include <rtthread.h>
+#include <lwp.h>
+#include <lwp_user_mm.h>
+#include <lwp_sysring.h>
+#include <mm_aspace.h>
+#include <unistd.h>
+#include "utest.h"
+
+#define IO_SIZE         64
+#define BENCH_ROUNDS    20000
+#define BENCH_BATCH     16      /* the entries of ring */
+
+static struct rt_lwp *lwp;
+static void *ubuf;
+static int fds[2] = {-1, -1};
+
+static void *_kaddr(rt_aspace_t aspace, void *va)
+{
+    void *pa = rt_hw_mmu_v2p(aspace, va);
+
+    return pa == ARCH_MAP_FAILED ? RT_NULL : rt_kmem_p2v(pa);
+}
+
+static void _sqe_fill(struct rt_sysring_sqe *sqe, int opcode, int fd, void *addr,
+                      rt_uint32_t len, rt_uint64_t user_data)
+{
+    rt_memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = (rt_ubase_t)addr;
+    sqe->len = len;
+    sqe->user_data = user_data;
+}
+
+/* queue a submission as the process does, by the kernel address of ring */
+static struct rt_sysring_sqe *_sqe_get(struct lwp_sysring *ring)
+{
+    struct rt_sysring_head *head = ring->head;
+
+    return &ring->sqes[head->sq_tail++ & (ring->entries - 1)];
+}
+
+static void sysring_setup_tc(void)
+{
+    struct lwp_sysring *ring;
+
+    uassert_int_equal(lwp_sysring_setup(lwp, 0), -EINVAL);
+    uassert_int_equal(lwp_sysring_setup(lwp, RT_SYSRING_ENTRIES_MAX + 1), -EINVAL);
+
+    uassert_int_equal(lwp_sysring_setup(lwp, 12), 0);
+    ring = lwp->sysring;
+    uassert_true(!!ring);
+    if (!ring)
+        return;
+
+    /* rounded up, and the same pages in the user space */
+    uassert_int_equal(ring->entries, 16);
+    uassert_int_equal(ring->head->entries, 16);
+    uassert_true(_kaddr(lwp->aspace, ring->uaddr) == (void *)ring->head);
+    uassert_true(lwp_user_accessible_ext(lwp, ring->uaddr, sizeof(struct rt_sysring_head)));
+
+    uassert_int_equal(lwp_sysring_setup(lwp, 16), -EBUSY);
+    uassert_true(lwp->sysring == ring);
+}
+
+static void sysring_io_tc(void)
+{
+    struct lwp_sysring *ring = lwp->sysring;
+    struct rt_sysring_head *head;
+    struct rt_sysring_cqe *cqe;
+    char *kbuf;
+
+    if (!ring)
+        return;
+    head = ring->head;
+    kbuf = _kaddr(lwp->aspace, ubuf);
+
+    /* nothing to do */
+    uassert_int_equal(lwp_sysring_enter(lwp, 4), 0);
+
+    rt_memset(kbuf, 0x5a, IO_SIZE);
+    rt_memset(kbuf + IO_SIZE, 0, IO_SIZE);
+    _sqe_fill(_sqe_get(ring), RT_SYSRING_OP_NOP, -1, RT_NULL, 0, 1);
+    _sqe_fill(_sqe_get(ring), RT_SYSRING_OP_WRITE, fds[1], ubuf, IO_SIZE, 2);
+    _sqe_fill(_sqe_get(ring), RT_SYSRING_OP_READ, fds[0], (char *)ubuf + IO_SIZE, IO_SIZE, 3);
+    _sqe_fill(_sqe_get(ring), RT_SYSRING_OP_WRITE, fds[1], (void *)8, IO_SIZE, 4);
+    _sqe_fill(_sqe_get(ring), 0xff, -1, RT_NULL, 0, 5);
+
+    /* to_submit is a limit of the batch */
+    uassert_int_equal(lwp_sysring_enter(lwp, 3), 3);
+    uassert_int_equal(head->sq_head, 3);
+    uassert_int_equal(lwp_sysring_enter(lwp, 8), 2);
+    uassert_int_equal(head->sq_head, 5);
+    uassert_int_equal(head->cq_tail, 5);
+
+    /* completions in the order of submission */
+    cqe = &ring->cqes[0];
+    uassert_true(cqe[0].user_data == 1 && cqe[0].res == 0);
+    uassert_true(cqe[1].user_data == 2 && cqe[1].res == IO_SIZE);
+    uassert_true(cqe[2].user_data == 3 && cqe[2].res == IO_SIZE);
+    uassert_true(cqe[3].user_data == 4 && cqe[3].res == -EFAULT);
+    uassert_true(cqe[4].user_data == 5 && cqe[4].res == -EINVAL);
+    uassert_buf_equal(kbuf, kbuf + IO_SIZE, IO_SIZE);
+    head->cq_head = head->cq_tail;
+
+    /* a bad tail from user is refused without touching the ring */
+    head->sq_tail = head->sq_head + ring->entries + 1;
+    uassert_int_equal(lwp_sysring_enter(lwp, 1), -EINVAL);
+    uassert_int_equal(head->sq_head, 5);
+    head->sq_tail = head->sq_head;
+
+    /* no more than the free completions are consumed */
+    head->cq_head = head->cq_tail - ring->entries + 1;
+    _sqe_fill(_sqe_get(ring), RT_SYSRING_OP_NOP, -1, RT_NULL, 0, 6);
+    _sqe_fill(_sqe_get(ring), RT_SYSRING_OP_NOP, -1, RT_NULL, 0, 7);
+    uassert_int_equal(lwp_sysring_enter(lwp, 2), 1);
+    uassert_int_equal(lwp_sysring_enter(lwp, 1), -EBUSY);
+    head->cq_head = head->cq_tail;
+    uassert_int_equal(lwp_sysring_enter(lwp, 1), 1);
+    head->cq_head = head->cq_tail;
+}
+
+/**
+ * The one by one calls here are the bodies of sys_write() and sys_read(),
+ * without the trap into kernel, so the gain of the ring is a lower bound of
+ * the one seen by a process.
+ */
+static void sysring_bench_tc(void)
+{
+    struct lwp_sysring *ring = lwp->sysring;
+    struct rt_sysring_head *head;
+    rt_tick_t start, call_cost, ring_cost;
+    void *kmem;
+    int i, j;
+
+    if (!ring)
+        return;
+    head = ring->head;
+
+    start = rt_tick_get();
+    for (i = 0; i < BENCH_ROUNDS; i++)
+    {
+        if (!lwp_user_accessible_ext(lwp, ubuf, IO_SIZE))
+            break;
+        kmem = rt_malloc(IO_SIZE);
+        lwp_data_get(lwp, kmem, ubuf, IO_SIZE);
+        write(fds[1], kmem, IO_SIZE);
+        rt_free(kmem);
+
+        if (!lwp_user_accessible_ext(lwp, ubuf, IO_SIZE))
+            break;
+        kmem = rt_malloc(IO_SIZE);
+        read(fds[0], kmem, IO_SIZE);
+        lwp_data_put(lwp, ubuf, kmem, IO_SIZE);
+        rt_free(kmem);
+    }
+    call_cost = rt_tick_get() - start;
+
+    start = rt_tick_get();
+    for (i = 0; i < BENCH_ROUNDS; i += BENCH_BATCH / 2)
+    {
+        for (j = 0; j < BENCH_BATCH / 2; j++)
+        {
+            _sqe_fill(_sqe_get(ring), RT_SYSRING_OP_WRITE, fds[1], ubuf, IO_SIZE, j);
+            _sqe_fill(_sqe_get(ring), RT_SYSRING_OP_READ, fds[0], ubuf, IO_SIZE, j);
+        }
+        if (lwp_sysring_enter(lwp, BENCH_BATCH) != BENCH_BATCH)
+            break;
+        head->cq_head = head->cq_tail;
+    }
+    ring_cost = rt_tick_get() - start;
+    uassert_true(i >= BENCH_ROUNDS);
+
+    rt_kprintf("%d bytes I/O: %d ticks one by one, %d ticks in batches of %d, for %d rounds\n",
+               IO_SIZE, (int)call_cost, (int)ring_cost, BENCH_BATCH, BENCH_ROUNDS);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    lwp = lwp_create(LWP_CREATE_FLAG_ALLOC_PID);
+    if (!lwp)
+        return -RT_ENOMEM;
+    if (lwp_user_space_init(lwp, 0) != 0)
+        return -RT_ERROR;
+
+    ubuf = lwp_map_user(lwp, RT_NULL, ARCH_PAGE_SIZE, 0);
+    if (!ubuf || pipe(fds) != 0)
+        return -RT_ERROR;
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    if (fds[0] >= 0)
+        close(fds[0]);
+    if (fds[1] >= 0)
+        close(fds[1]);
+    fds[0] = fds[1] = -1;
+
+    /* the ring is freed with the user space */
+    if (lwp)
+    {
+        lwp_pid_put(lwp);
+        lwp_ref_dec(lwp);
+        lwp = RT_NULL;
+    }
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(sysring_setup_tc);
+    UTEST_UNIT_RUN(sysring_io_tc);
+    UTEST_UNIT_RUN(sysring_bench_tc);
+}
+UTEST_TC_EXPORT(testcase, "testcases.lwp.sysring_tc", utest_tc_init, utest_tc_cleanup, 60);
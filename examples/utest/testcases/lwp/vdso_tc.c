@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+/**
+ * The pages of vdso data mapped into a process and its forked child, and the
+ * cost of reading the time from the data page against the clock_gettime()
+ * under the system call.
+ */
+
+#include <rtthread.h>
+#include <lwp.h>
+#include <lwp_user_mm.h>
+#include <lwp_vdso.h>
+#include <mm_aspace.h>
+#include "utest.h"
+
+#define BENCH_ROUNDS    100000
+
+static void *_kaddr(rt_aspace_t aspace, void *va)
+{
+    void *pa = rt_hw_mmu_v2p(aspace, va);
+
+    return pa == ARCH_MAP_FAILED ? RT_NULL : rt_kmem_p2v(pa);
+}
+
+static void vdso_map_tc(void)
+{
+    struct rt_lwp *lwp, *child;
+    struct rt_vdso_proc *vp;
+
+    lwp = lwp_create(LWP_CREATE_FLAG_ALLOC_PID);
+    uassert_true(!!lwp);
+    if (!lwp)
+        return;
+    uassert_int_equal(lwp_user_space_init(lwp, 0), 0);
+    uassert_true(lwp->vdso_data && lwp->vdso_proc);
+
+    uassert_true(_kaddr(lwp->aspace, lwp->vdso_data) == lwp_vdso_data_get());
+    vp = _kaddr(lwp->aspace, lwp->vdso_proc);
+    uassert_true(vp == lwp->vdso_kproc);
+    uassert_int_equal(vp->pid, lwp->pid);
+
+    /* the pid is not read from the page while a child of vfork() borrows it */
+    lwp_vdso_vfork(lwp, RT_TRUE);
+    uassert_int_equal(vp->vfork, 1);
+    lwp_vdso_vfork(lwp, RT_FALSE);
+    uassert_int_equal(vp->vfork, 0);
+
+    /* the child shares the time data, but not the process data */
+    child = lwp_create(LWP_CREATE_FLAG_ALLOC_PID);
+    uassert_true(!!child);
+    if (child)
+    {
+        uassert_int_equal(lwp_user_space_init(child, 1), 0);
+        uassert_int_equal(lwp_fork_aspace(child, lwp), 0);
+
+        uassert_true(child->vdso_data == lwp->vdso_data);
+        uassert_true(child->vdso_proc == lwp->vdso_proc);
+        uassert_true(_kaddr(child->aspace, child->vdso_data) == lwp_vdso_data_get());
+        vp = _kaddr(child->aspace, child->vdso_proc);
+        uassert_true(vp == child->vdso_kproc);
+        uassert_true(vp != lwp->vdso_kproc);
+        uassert_int_equal(vp->pid, child->pid);
+
+        lwp_pid_put(child);
+        lwp_ref_dec(child);
+    }
+
+    lwp_pid_put(lwp);
+    lwp_ref_dec(lwp);
+}
+
+static void vdso_time_tc(void)
+{
+    struct rt_vdso_data *vd = lwp_vdso_data_get();
+    struct timespec fast, slow, last = {0};
+    int64_t diff;
+
+    uassert_true(!!vd);
+    if (!vd)
+        return;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        rt_vdso_time_get(vd, 0, &fast);
+        clock_gettime(CLOCK_MONOTONIC, &slow);
+
+        /* the data page lags behind the clock by one update at most */
+        diff = (slow.tv_sec - fast.tv_sec) * RT_VDSO_NSEC_PER_SEC + slow.tv_nsec - fast.tv_nsec;
+        uassert_true(diff >= 0 && diff <= 2 * (int64_t)vd->res_nsec);
+
+        uassert_true(fast.tv_sec > last.tv_sec ||
+                     (fast.tv_sec == last.tv_sec && fast.tv_nsec >= last.tv_nsec));
+        last = fast;
+    }
+
+    /* the realtime is as good as the RTC, in seconds */
+    lwp_vdso_realtime_sync();
+    rt_vdso_time_get(vd, 1, &fast);
+    clock_gettime(CLOCK_REALTIME, &slow);
+    diff = slow.tv_sec - fast.tv_sec;
+    uassert_true(diff >= -1 && diff <= 1);
+
+    uassert_true(rt_vdso_tick_get(vd) <= rt_tick_get());
+}
+
+/**
+ * clock_gettime() here is the body of the system call, without the trap and
+ * the copy to user, so it is a lower bound of the cost of the system call.
+ */
+static void vdso_bench_tc(void)
+{
+    struct rt_vdso_data *vd = lwp_vdso_data_get();
+    struct timespec ts;
+    rt_tick_t start, sys_cost, vdso_cost;
+    int i;
+
+    if (!vd)
+        return;
+
+    start = rt_tick_get();
+    for (i = 0; i < BENCH_ROUNDS; i++)
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+    sys_cost = rt_tick_get() - start;
+
+    start = rt_tick_get();
+    for (i = 0; i < BENCH_ROUNDS; i++)
+        rt_vdso_time_get(vd, 0, &ts);
+    vdso_cost = rt_tick_get() - start;
+
+    /* only reported, a tick is too coarse to compare them */
+    rt_kprintf("clock_gettime: %d rounds, syscall %d ticks, vdso %d ticks\n",
+               BENCH_ROUNDS, sys_cost, vdso_cost);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(vdso_map_tc);
+    UTEST_UNIT_RUN(vdso_time_tc);
+    UTEST_UNIT_RUN(vdso_bench_tc);
+}
+UTEST_TC_EXPORT(testcase, "testcases.lwp.vdso_tc", utest_tc_init, utest_tc_cleanup, 60);
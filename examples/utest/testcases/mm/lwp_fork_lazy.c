@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        test case for lazy fork and fork+exec latency
+ */
+#include "common.h"
+#include "lwp_user_mm.h"
+#include "mm_fault.h"
+#include <mm_aspace.h>
+
+#include <rtthread.h>
+
+#define BENCH_ROUNDS    32
+#define BENCH_SIZE      (4ul << 20)
+#define BENCH_TOUCHED   64
+
+static long fd = -1;
+static long pgoffset = 0;
+static size_t flags = MAP_FIXED | MAP_ANONYMOUS;
+static size_t prot = PROT_READ | PROT_WRITE;
+
+static char *ex_vaddr = (char *)0x100000000;
+static size_t ex_size = 8 * ARCH_PAGE_SIZE;
+
+static struct rt_lwp *lwp;
+
+static int _count_mapped(rt_aspace_t aspace, char *start, size_t size)
+{
+    int count = 0;
+
+    for (char *va = start; va < start + size; va += ARCH_PAGE_SIZE)
+    {
+        if (rt_hw_mmu_v2p(aspace, va) != ARCH_MAP_FAILED)
+            count++;
+    }
+    return count;
+}
+
+static int _fault(rt_aspace_t aspace, char *va, int fault_op)
+{
+    struct rt_aspace_fault_msg msg;
+
+    msg.fault_op = fault_op;
+    msg.fault_vaddr = va;
+    /* a write on a read-only page is an access fault */
+    if (fault_op == MM_FAULT_OP_WRITE && rt_hw_mmu_v2p(aspace, va) != ARCH_MAP_FAILED)
+        msg.fault_type = MM_FAULT_TYPE_ACCESS_FAULT;
+    else
+        msg.fault_type = MM_FAULT_TYPE_PAGE_FAULT;
+    return rt_aspace_fault_try_fix(aspace, &msg);
+}
+
+static char *_kaddr(rt_aspace_t aspace, char *va)
+{
+    return rt_kmem_p2v(rt_hw_mmu_v2p(aspace, va));
+}
+
+static void test_fork_copy_on_write(void)
+{
+    struct rt_lwp *child;
+    char *next_va;
+    void *pa;
+
+    next_va = lwp_mmap2(lwp, ex_vaddr, ex_size, prot, flags, fd, pgoffset);
+    uassert_true(next_va == ex_vaddr);
+
+    for (char *va = ex_vaddr; va < ex_vaddr + ex_size; va += ARCH_PAGE_SIZE)
+    {
+        utest_int_equal(MM_FAULT_FIXABLE_TRUE, _fault(lwp->aspace, va, MM_FAULT_OP_WRITE));
+        rt_memset(_kaddr(lwp->aspace, va), 0x5a, ARCH_PAGE_SIZE);
+    }
+
+    child = lwp_create(0);
+    uassert_true(!!child);
+    if (!child)
+        return;
+    utest_int_equal(0, lwp_user_space_init(child, 1));
+    utest_int_equal(RT_EOK, rt_aspace_fork(&lwp->aspace, &child->aspace));
+
+    /* nothing mapped in child until it touches */
+    utest_int_equal(0, _count_mapped(child->aspace, ex_vaddr, ex_size));
+
+    /* both are sharing the same frame on read */
+    utest_int_equal(MM_FAULT_FIXABLE_TRUE, _fault(lwp->aspace, ex_vaddr, MM_FAULT_OP_READ));
+    utest_int_equal(MM_FAULT_FIXABLE_TRUE, _fault(child->aspace, ex_vaddr, MM_FAULT_OP_READ));
+    pa = rt_hw_mmu_v2p(child->aspace, ex_vaddr);
+    uassert_true(pa == rt_hw_mmu_v2p(lwp->aspace, ex_vaddr));
+
+    /* the first write copies the page */
+    utest_int_equal(MM_FAULT_FIXABLE_TRUE, _fault(lwp->aspace, ex_vaddr, MM_FAULT_OP_WRITE));
+    uassert_true(pa != rt_hw_mmu_v2p(lwp->aspace, ex_vaddr));
+    uassert_true(!memtest(_kaddr(lwp->aspace, ex_vaddr), 0x5a, ARCH_PAGE_SIZE));
+
+    rt_memset(_kaddr(lwp->aspace, ex_vaddr), 0xa5, ARCH_PAGE_SIZE);
+    uassert_true(!memtest(_kaddr(child->aspace, ex_vaddr), 0x5a, ARCH_PAGE_SIZE));
+
+    lwp_ref_dec(child);
+
+    /* clear mapping */
+    utest_int_equal(RT_EOK, rt_aspace_unmap_range(lwp->aspace, ex_vaddr, ex_size));
+}
+
+/**
+ * The kernel side of fork+exec from a parent with a large mapping: a fork
+ * duplicates the aspace and the exec tears it down. The vfork borrowing the
+ * aspace is a syscall of user space, it is not measured here.
+ */
+static void test_fork_exec_bench(void)
+{
+    struct rt_lwp *child;
+    rt_tick_t start, fork_cost;
+    char *next_va;
+    int rounds;
+
+    next_va = lwp_mmap2(lwp, ex_vaddr, BENCH_SIZE, prot, flags, fd, pgoffset);
+    uassert_true(next_va == ex_vaddr);
+    for (int i = 0; i < BENCH_TOUCHED; i++)
+        _fault(lwp->aspace, ex_vaddr + i * (BENCH_SIZE / BENCH_TOUCHED), MM_FAULT_OP_WRITE);
+
+    start = rt_tick_get();
+    for (rounds = 0; rounds < BENCH_ROUNDS; rounds++)
+    {
+        child = lwp_create(0);
+        if (!child)
+            break;
+        if (lwp_user_space_init(child, 1) != 0 ||
+            rt_aspace_fork(&lwp->aspace, &child->aspace) != RT_EOK)
+        {
+            lwp_ref_dec(child);
+            break;
+        }
+        lwp_ref_dec(child);
+    }
+    fork_cost = rt_tick_get() - start;
+    utest_int_equal(BENCH_ROUNDS, rounds);
+
+    rt_kprintf("fork+exec with %d KiB mapped: %d us\n", (int)(BENCH_SIZE >> 10),
+               (int)(fork_cost * 1000000ull / RT_TICK_PER_SECOND / BENCH_ROUNDS));
+
+    utest_int_equal(RT_EOK, rt_aspace_unmap_range(lwp->aspace, ex_vaddr, BENCH_SIZE));
+}
+
+static void testcase_main(void)
+{
+    test_fork_copy_on_write();
+    test_fork_exec_bench();
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    lwp = lwp_create(0);
+    if (lwp)
+        lwp_user_space_init(lwp, 1);
+    else
+        return -RT_ENOMEM;
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    lwp_ref_dec(lwp);
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(testcase_main);
+}
+UTEST_TC_EXPORT(testcase, "testcases.lwp.mman.fork_lazy", utest_tc_init, utest_tc_cleanup, 60);
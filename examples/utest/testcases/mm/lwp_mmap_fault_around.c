@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        test case for fault-around on read fault
+ */
+#include "common.h"
+#include "lwp_user_mm.h"
+#include "mm_fault.h"
+#include <mm_aspace.h>
+
+#include <rtthread.h>
+
+static long fd = -1;
+static long pgoffset = 0;
+static size_t flags = MAP_FIXED | MAP_ANONYMOUS;
+static size_t prot = PROT_READ | PROT_WRITE;
+
+static char *ex_vaddr = (char *)0x100000000;
+static size_t ex_size = 0x10000;
+
+static struct rt_lwp *lwp;
+
+#ifndef RT_MM_FAULT_AROUND_PAGES
+#define RT_MM_FAULT_AROUND_PAGES 1
+#endif
+
+static int _count_mapped(rt_aspace_t aspace, char *start, size_t size)
+{
+    int count = 0;
+
+    for (char *va = start; va < start + size; va += ARCH_PAGE_SIZE)
+    {
+        if (rt_hw_mmu_v2p(aspace, va) != ARCH_MAP_FAILED)
+            count++;
+    }
+    return count;
+}
+
+static void test_mmap_fault_around(void)
+{
+    char *next_va;
+    rt_varea_t varea;
+    struct rt_aspace_fault_msg msg;
+
+    next_va = lwp_mmap2(lwp, ex_vaddr, ex_size, prot, flags, fd, pgoffset);
+    uassert_true(next_va == ex_vaddr);
+    varea = rt_aspace_query(lwp->aspace, ex_vaddr);
+    uassert_true(!!varea);
+
+    /* madvise(MADV_RANDOM) and madvise(MADV_NORMAL) */
+    utest_int_equal(0, lwp_mm_fault_around(lwp, ex_vaddr, ex_size, RT_FALSE));
+    uassert_true(!!(varea->flag & MMF_NO_FAULT_AROUND));
+    utest_int_equal(0, lwp_mm_fault_around(lwp, ex_vaddr, ex_size, RT_TRUE));
+    uassert_true(!(varea->flag & MMF_NO_FAULT_AROUND));
+
+    /* nothing outside a mapping to advise */
+    uassert_true(lwp_mm_fault_around(lwp, ex_vaddr + ex_size, ARCH_PAGE_SIZE, RT_TRUE) != 0);
+
+    /**
+     * none of the neighbours is resident in a fresh anonymous mapping, so
+     * a read fault must not allocate anything more than the faulting page
+     */
+    msg.fault_op = MM_FAULT_OP_READ;
+    msg.fault_type = MM_FAULT_TYPE_PAGE_FAULT;
+    msg.fault_vaddr = ex_vaddr + 2 * ARCH_PAGE_SIZE;
+    utest_int_equal(MM_FAULT_FIXABLE_TRUE, rt_aspace_fault_try_fix(lwp->aspace, &msg));
+    utest_int_equal(1, _count_mapped(lwp->aspace, ex_vaddr, ex_size));
+
+    /* a fault on a mapped page is fixed already, and maps nothing around */
+    utest_int_equal(MM_FAULT_FIXABLE_TRUE, rt_aspace_fault_try_fix(lwp->aspace, &msg));
+    utest_int_equal(1, _count_mapped(lwp->aspace, ex_vaddr, ex_size));
+
+    /* clear mapping */
+    utest_int_equal(RT_EOK, rt_aspace_unmap_range(lwp->aspace, ex_vaddr, ex_size));
+    rt_free(lwp->aspace->private_object);
+    lwp->aspace->private_object = RT_NULL;
+}
+
+/**
+ * The pages of a forked parent stay resident in the backup aspace, so a read
+ * fault in the child maps the whole window around it at once
+ */
+static void test_fault_around_resident(void)
+{
+    struct rt_aspace_fault_msg msg;
+    struct rt_lwp *child, *old;
+    rt_thread_t self = rt_thread_self();
+    rt_base_t around_count;
+    char *next_va;
+    int window;
+
+    next_va = lwp_mmap2(lwp, ex_vaddr, ex_size, prot, flags, fd, pgoffset);
+    uassert_true(next_va == ex_vaddr);
+    msg.fault_op = MM_FAULT_OP_WRITE;
+    msg.fault_type = MM_FAULT_TYPE_PAGE_FAULT;
+    for (char *va = ex_vaddr; va < ex_vaddr + ex_size; va += ARCH_PAGE_SIZE)
+    {
+        msg.fault_vaddr = va;
+        utest_int_equal(MM_FAULT_FIXABLE_TRUE, rt_aspace_fault_try_fix(lwp->aspace, &msg));
+    }
+
+    child = lwp_create(0);
+    uassert_true(!!child);
+    if (!child)
+        return;
+    utest_int_equal(0, lwp_user_space_init(child, 1));
+    utest_int_equal(RT_EOK, rt_aspace_fork(&lwp->aspace, &child->aspace));
+
+    /* ex_vaddr is aligned to any window, which is clipped by the varea */
+    window = RT_MM_FAULT_AROUND_PAGES < 2 ? 1 : RT_MM_FAULT_AROUND_PAGES;
+    if (window > ex_size / ARCH_PAGE_SIZE)
+        window = ex_size / ARCH_PAGE_SIZE;
+
+    /* the fault is accounted to the process owning the aspace */
+    old = self->lwp;
+    self->lwp = child;
+    around_count = rt_atomic_load(&child->fault_around_count);
+
+    msg.fault_op = MM_FAULT_OP_READ;
+    msg.fault_vaddr = ex_vaddr + 2 * ARCH_PAGE_SIZE;
+    utest_int_equal(MM_FAULT_FIXABLE_TRUE, rt_aspace_fault_try_fix(child->aspace, &msg));
+
+    self->lwp = old;
+    utest_int_equal(window, _count_mapped(child->aspace, ex_vaddr, ex_size));
+    for (char *va = ex_vaddr; va < ex_vaddr + window * ARCH_PAGE_SIZE; va += ARCH_PAGE_SIZE)
+        uassert_true(rt_hw_mmu_v2p(child->aspace, va) != ARCH_MAP_FAILED);
+    utest_int_equal(around_count + window - 1, rt_atomic_load(&child->fault_around_count));
+
+    lwp_ref_dec(child);
+
+    /* clear mapping */
+    utest_int_equal(RT_EOK, rt_aspace_unmap_range(lwp->aspace, ex_vaddr, ex_size));
+}
+
+static void testcase_main(void)
+{
+    CONSIST_HEAP(test_mmap_fault_around());
+    test_fault_around_resident();
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    lwp = lwp_create(0);
+    if (lwp)
+        lwp_user_space_init(lwp, 1);
+    else
+        return -RT_ENOMEM;
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    lwp_ref_dec(lwp);
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(testcase_main);
+}
+UTEST_TC_EXPORT(testcase, "testcases.lwp.mman.mmap_anon.fault_around", utest_tc_init, utest_tc_cleanup, 10);
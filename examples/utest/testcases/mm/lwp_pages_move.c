@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        test case for moving pages between lwp
+ */
+#include "common.h"
+#include "lwp_user_mm.h"
+#include "lwp_ipc.h"
+#include <mm_aspace.h>
+#include <fcntl.h>
+
+#include <rtthread.h>
+
+#define MOVE_MAX_SIZE   (256ul << 10)
+#define BENCH_MIN_SIZE  (16ul << 10)
+#define BENCH_ROUNDS    64
+
+static long fd = -1;
+static long pgoffset = 0;
+static size_t flags = MAP_ANONYMOUS;
+static size_t prot = PROT_READ | PROT_WRITE;
+
+static struct rt_lwp *sender;
+static struct rt_lwp *receiver;
+static void *pages[MOVE_MAX_SIZE >> ARCH_PAGE_SHIFT];
+
+/* move the buffer of from into to, return the new address in to */
+static char *_move(struct rt_lwp *from, struct rt_lwp *to, char *buf, size_t size)
+{
+    void *uaddr = RT_NULL;
+
+    if (lwp_pages_detach(from, buf, size, pages) != RT_EOK)
+        return RT_NULL;
+    if (lwp_pages_attach(to, &uaddr, pages, size >> ARCH_PAGE_SHIFT) != RT_EOK)
+    {
+        lwp_pages_put(pages, size >> ARCH_PAGE_SHIFT);
+        return RT_NULL;
+    }
+    return uaddr;
+}
+
+static void test_pages_move(void)
+{
+    size_t size = 4 * ARCH_PAGE_SIZE;
+    char *buf, *moved;
+    char *kbuf;
+
+    kbuf = rt_malloc(size);
+    uassert_true(!!kbuf);
+    if (!kbuf)
+        return;
+
+    buf = lwp_mmap2(sender, RT_NULL, size, prot, flags, fd, pgoffset);
+    uassert_true((long)buf > 0);
+    rt_memset(kbuf, 0x5a, size);
+    utest_int_equal(size, lwp_data_put(sender, buf, kbuf, size));
+
+    /* not page-aligned buffer is rejected, and nothing is taken */
+    utest_int_equal(-RT_EINVAL, lwp_pages_detach(sender, buf + 1, size, pages));
+    utest_int_equal(-RT_EINVAL, lwp_pages_detach(sender, buf, size - 1, pages));
+
+    moved = _move(sender, receiver, buf, size);
+    uassert_true(!!moved);
+
+    /* the sender gives up the buffer */
+    uassert_true(!rt_aspace_query(sender->aspace, buf));
+
+    rt_memset(kbuf, 0, size);
+    utest_int_equal(size, lwp_data_get(receiver, kbuf, moved, size));
+    uassert_true(!memtest(kbuf, 0x5a, size));
+
+    utest_int_equal(RT_EOK, rt_aspace_unmap_range(receiver->aspace, moved, size));
+    rt_free(kbuf);
+}
+
+/* run the channel operations in the context of lwp, return the one replaced */
+static struct rt_lwp *_switch_lwp(struct rt_lwp *lwp)
+{
+    rt_thread_t self = rt_thread_self();
+    struct rt_lwp *old = self->lwp;
+
+    self->lwp = lwp;
+    return old;
+}
+
+static char *_fill_buffer(struct rt_lwp *lwp, size_t size, char *kbuf, int value)
+{
+    char *buf = lwp_mmap2(lwp, RT_NULL, size, prot, flags, fd, pgoffset);
+
+    if ((long)buf <= 0)
+        return RT_NULL;
+    rt_memset(kbuf, value, size);
+    if (lwp_data_put(lwp, buf, kbuf, size) != size)
+        return RT_NULL;
+    return buf;
+}
+
+static void _pages_msg_init(struct rt_channel_msg *msg, void *buf, size_t size)
+{
+    rt_memset(msg, 0, sizeof(*msg));
+    msg->type = RT_CHANNEL_PAGES;
+    msg->u.b.buf = buf;
+    msg->u.b.length = size;
+}
+
+static void test_ipc_pages(void)
+{
+    size_t size = 4 * ARCH_PAGE_SIZE;
+    struct rt_channel_msg msg, ret;
+    struct rt_lwp *old;
+    rt_channel_t ch;
+    char *buf, *kbuf;
+    void *frame;
+    rt_err_t rc;
+
+    kbuf = rt_malloc(size);
+    ch = rt_raw_channel_open("pgmove", O_CREAT | O_EXCL);
+    uassert_true(kbuf && ch);
+    if (!kbuf || !ch)
+        goto _exit;
+
+    /* send and receive, the pages are moved from sender to receiver */
+    buf = _fill_buffer(sender, size, kbuf, 0x5a);
+    uassert_true(!!buf);
+    if (!buf)
+        goto _exit;
+    _pages_msg_init(&msg, buf, size);
+    old = _switch_lwp(sender);
+    rc = rt_raw_channel_send(ch, &msg);
+    _switch_lwp(old);
+    utest_int_equal(RT_EOK, rc);
+    uassert_true(!rt_aspace_query(sender->aspace, buf));
+
+    old = _switch_lwp(receiver);
+    rc = rt_raw_channel_recv_timeout(ch, &ret, 0);
+    _switch_lwp(old);
+    utest_int_equal(RT_EOK, rc);
+    utest_int_equal(RT_CHANNEL_PAGES, ret.type);
+    utest_int_equal(size, ret.u.b.length);
+    if (rc == RT_EOK)
+    {
+        rt_memset(kbuf, 0, size);
+        utest_int_equal(size, lwp_data_get(receiver, kbuf, ret.u.b.buf, size));
+        uassert_true(!memtest(kbuf, 0x5a, size));
+        utest_int_equal(RT_EOK, rt_aspace_unmap_range(receiver->aspace, ret.u.b.buf, size));
+    }
+
+    /* a failed reply gives the pages back to the sender at the same address */
+    buf = _fill_buffer(sender, size, kbuf, 0xa5);
+    uassert_true(!!buf);
+    if (!buf)
+        goto _exit;
+    _pages_msg_init(&msg, buf, size);
+    old = _switch_lwp(sender);
+    rc = rt_raw_channel_reply(ch, &msg);
+    _switch_lwp(old);
+    uassert_true(rc != RT_EOK);
+    uassert_true(msg.u.b.buf == buf);
+    uassert_true(!!rt_aspace_query(sender->aspace, buf));
+    rt_memset(kbuf, 0, size);
+    utest_int_equal(size, lwp_data_get(sender, kbuf, buf, size));
+    uassert_true(!memtest(kbuf, 0xa5, size));
+
+    /* the frames of a message queued are released with the channel */
+    frame = rt_kmem_p2v(rt_hw_mmu_v2p(sender->aspace, buf));
+    _pages_msg_init(&msg, buf, size);
+    old = _switch_lwp(sender);
+    rc = rt_raw_channel_send(ch, &msg);
+    _switch_lwp(old);
+    utest_int_equal(RT_EOK, rc);
+    utest_int_equal(1, rt_page_ref_get(frame, 0));
+    utest_int_equal(RT_EOK, rt_raw_channel_close(ch));
+    ch = RT_NULL;
+    utest_int_equal(0, rt_page_ref_get(frame, 0));
+
+_exit:
+    if (ch)
+        rt_raw_channel_close(ch);
+    rt_free(kbuf);
+}
+
+/* pass the buffer from one lwp to the other through channel, return the bytes passed */
+static size_t _channel_pass(rt_channel_t ch, struct rt_lwp *from, struct rt_lwp *to,
+                            char **buf, char *peer, size_t size, char *kbuf, rt_bool_t move)
+{
+    struct rt_channel_msg msg, ret;
+    struct rt_lwp *old;
+    rt_err_t rc;
+
+    old = _switch_lwp(from);
+    if (move)
+    {
+        _pages_msg_init(&msg, *buf, size);
+    }
+    else
+    {
+        /* the buffer is copied into kernel by sender and out of it by receiver */
+        rt_memset(&msg, 0, sizeof(msg));
+        msg.type = RT_CHANNEL_RAW;
+        msg.u.d = kbuf;
+        lwp_data_get(from, kbuf, *buf, size);
+    }
+    rc = rt_raw_channel_send(ch, &msg);
+    _switch_lwp(to);
+    if (rc == RT_EOK)
+        rc = rt_raw_channel_recv_timeout(ch, &ret, 0);
+    _switch_lwp(old);
+    if (rc != RT_EOK)
+        return 0;
+
+    if (move)
+    {
+        *buf = ret.u.b.buf;
+        return ret.u.b.length;
+    }
+    return lwp_data_put(to, peer, ret.u.d, size);
+}
+
+static void _bench(rt_channel_t ch, size_t size, char *kbuf)
+{
+    rt_tick_t start, copy_cost, move_cost;
+    size_t copied = 0, moved = 0;
+    char *buf, *peer;
+    int rounds;
+
+    buf = _fill_buffer(sender, size, kbuf, 0x5a);
+    peer = lwp_mmap2(receiver, RT_NULL, size, prot, flags, fd, pgoffset);
+    uassert_true(buf && (long)peer > 0);
+    if (!buf || (long)peer <= 0)
+        return;
+
+    start = rt_tick_get();
+    for (rounds = 0; rounds < BENCH_ROUNDS; rounds++)
+    {
+        copied += _channel_pass(ch, sender, receiver, &buf, peer, size, kbuf, RT_FALSE);
+        copied += _channel_pass(ch, receiver, sender, &peer, buf, size, kbuf, RT_FALSE);
+    }
+    copy_cost = rt_tick_get() - start;
+
+    start = rt_tick_get();
+    for (rounds = 0; rounds < BENCH_ROUNDS; rounds++)
+    {
+        moved += _channel_pass(ch, sender, receiver, &buf, RT_NULL, size, kbuf, RT_TRUE);
+        moved += _channel_pass(ch, receiver, sender, &buf, RT_NULL, size, kbuf, RT_TRUE);
+    }
+    move_cost = rt_tick_get() - start;
+
+    /* the timing is only reported, tick granularity is too coarse to compare */
+    utest_int_equal(2 * BENCH_ROUNDS * size, copied);
+    utest_int_equal(2 * BENCH_ROUNDS * size, moved);
+
+    /* at least one tick for the bandwidth */
+    copy_cost = copy_cost ? copy_cost : 1;
+    move_cost = move_cost ? move_cost : 1;
+    rt_kprintf("%4d KiB: copy %6d MiB/s, move %6d MiB/s\n", (int)(size >> 10),
+               (int)((rt_uint64_t)copied * RT_TICK_PER_SECOND / copy_cost >> 20),
+               (int)((rt_uint64_t)moved * RT_TICK_PER_SECOND / move_cost >> 20));
+
+    rt_aspace_unmap_range(sender->aspace, buf, size);
+    rt_aspace_unmap_range(receiver->aspace, peer, size);
+}
+
+static void test_ipc_pages_bench(void)
+{
+    rt_channel_t ch;
+    char *kbuf;
+
+    kbuf = rt_malloc(MOVE_MAX_SIZE);
+    ch = rt_raw_channel_open("pgbench", O_CREAT | O_EXCL);
+    uassert_true(kbuf && ch);
+
+    if (kbuf && ch)
+    {
+        for (size_t size = BENCH_MIN_SIZE; size <= MOVE_MAX_SIZE; size <<= 2)
+            _bench(ch, size, kbuf);
+    }
+
+    if (ch)
+        rt_raw_channel_close(ch);
+    rt_free(kbuf);
+}
+
+static void testcase_main(void)
+{
+    test_pages_move();
+    test_ipc_pages();
+    test_ipc_pages_bench();
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    sender = lwp_create(0);
+    receiver = lwp_create(0);
+    if (!sender || !receiver)
+        return -RT_ENOMEM;
+    lwp_user_space_init(sender, 1);
+    lwp_user_space_init(receiver, 1);
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    if (sender)
+        lwp_ref_dec(sender);
+    if (receiver)
+        lwp_ref_dec(receiver);
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(testcase_main);
+}
+UTEST_TC_EXPORT(testcase, "testcases.lwp.mman.pages_move", utest_tc_init, utest_tc_cleanup, 60);
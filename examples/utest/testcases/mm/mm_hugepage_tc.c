@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        test case for huge page mapping
+ */
+#include "common.h"
+#include "lwp_user_mm.h"
+#include <mm_aspace.h>
+
+#include <rtthread.h>
+
+#define BENCH_SIZE      (16ul << 20)
+#define BENCH_ROUNDS    8
+
+static char *ex_vaddr = (char *)0x100000000;
+static size_t ex_size = 2 * ARCH_HUGE_PAGE_SIZE;
+
+static struct rt_lwp *lwp;
+
+static rt_bool_t _is_contiguous(rt_aspace_t aspace, char *start, size_t size)
+{
+    char *pa = rt_hw_mmu_v2p(aspace, start);
+
+    for (size_t off = 0; off < size; off += ARCH_PAGE_SIZE)
+    {
+        if (rt_hw_mmu_v2p(aspace, start + off) != pa + off)
+            return RT_FALSE;
+    }
+    return RT_TRUE;
+}
+
+static int _count_mapped(rt_aspace_t aspace, char *start, size_t size)
+{
+    int count = 0;
+
+    for (size_t off = 0; off < size; off += ARCH_PAGE_SIZE)
+    {
+        if (rt_hw_mmu_v2p(aspace, start + off) != ARCH_MAP_FAILED)
+            count++;
+    }
+    return count;
+}
+
+static void test_anon_huge_fault(void)
+{
+    char *next_va;
+    struct rt_aspace_fault_msg msg;
+
+    next_va = lwp_mmap2(lwp, ex_vaddr, ex_size, PROT_READ | PROT_WRITE,
+                        MAP_FIXED | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    uassert_true(next_va == ex_vaddr);
+
+    /* a fault in the middle of huge page maps all of it */
+    msg.fault_op = MM_FAULT_OP_WRITE;
+    msg.fault_type = MM_FAULT_TYPE_PAGE_FAULT;
+    msg.fault_vaddr = ex_vaddr + ARCH_HUGE_PAGE_SIZE / 2;
+    utest_int_equal(MM_FAULT_FIXABLE_TRUE, rt_aspace_fault_try_fix(lwp->aspace, &msg));
+
+    if (_count_mapped(lwp->aspace, ex_vaddr, ARCH_HUGE_PAGE_SIZE) == 1)
+    {
+        LOG_W("no free huge page, fall back to page");
+    }
+    else
+    {
+        utest_int_equal(ARCH_HUGE_PAGE_SIZE >> ARCH_PAGE_SHIFT,
+                        _count_mapped(lwp->aspace, ex_vaddr, ARCH_HUGE_PAGE_SIZE));
+        uassert_true(_is_contiguous(lwp->aspace, ex_vaddr, ARCH_HUGE_PAGE_SIZE));
+        utest_int_equal(0, _count_mapped(lwp->aspace, ex_vaddr + ARCH_HUGE_PAGE_SIZE, ARCH_HUGE_PAGE_SIZE));
+
+        /* partial unmap splits the huge page, and the rest is still there */
+        utest_int_equal(RT_EOK, rt_aspace_unmap_range(lwp->aspace, ex_vaddr + ARCH_PAGE_SIZE, ARCH_PAGE_SIZE));
+        utest_int_equal((ARCH_HUGE_PAGE_SIZE >> ARCH_PAGE_SHIFT) - 1,
+                        _count_mapped(lwp->aspace, ex_vaddr, ARCH_HUGE_PAGE_SIZE));
+
+        /* the hole is out of the mapping now */
+        msg.fault_op = MM_FAULT_OP_WRITE;
+        msg.fault_type = MM_FAULT_TYPE_PAGE_FAULT;
+        msg.fault_vaddr = ex_vaddr + ARCH_PAGE_SIZE;
+        utest_int_equal(MM_FAULT_FIXABLE_FALSE, rt_aspace_fault_try_fix(lwp->aspace, &msg));
+    }
+
+    /* clear mapping */
+    utest_int_equal(RT_EOK, rt_aspace_unmap_range(lwp->aspace, ex_vaddr, ex_size));
+    rt_free(lwp->aspace->private_object);
+    lwp->aspace->private_object = RT_NULL;
+}
+
+static void _unmap_kernel(char *vaddr, size_t size)
+{
+    void *pa;
+
+    /* pages provided by dummy mapper are owned by the user of mapping */
+    for (size_t off = 0; off < size; off += ARCH_PAGE_SIZE)
+    {
+        pa = rt_hw_mmu_v2p(&rt_kernel_space, vaddr + off);
+        if (pa != ARCH_MAP_FAILED)
+            rt_pages_free((char *)pa - PV_OFFSET, 0);
+    }
+    rt_aspace_unmap(&rt_kernel_space, vaddr);
+}
+
+static rt_tick_t _bench_memset(const char *title, mm_flag_t flags)
+{
+    void *vaddr = RT_NULL;
+    rt_tick_t start, cost;
+
+    if (rt_aspace_map(&rt_kernel_space, &vaddr, BENCH_SIZE, MMU_MAP_K_RWCB,
+                      flags | MMF_PREFETCH, &rt_mm_dummy_mapper, 0) != RT_EOK)
+    {
+        LOG_W("%s: no memory for benchmark", title);
+        return 0;
+    }
+
+    if (flags & MMF_HUGEPAGE)
+    {
+        uassert_true(!((rt_ubase_t)vaddr & (ARCH_HUGE_PAGE_SIZE - 1)));
+        if (!_is_contiguous(&rt_kernel_space, vaddr, ARCH_HUGE_PAGE_SIZE))
+            LOG_W("%s: no free huge page, fall back to page", title);
+    }
+
+    start = rt_tick_get();
+    for (int i = 0; i < BENCH_ROUNDS; i++)
+        memset(vaddr, i, BENCH_SIZE);
+    cost = rt_tick_get() - start;
+    uassert_true(!memtest(vaddr, BENCH_ROUNDS - 1, BENCH_SIZE));
+
+    rt_kprintf("%s: memset %d MiB %d times in %d ticks\n", title,
+               (int)(BENCH_SIZE >> 20), BENCH_ROUNDS, cost);
+
+    _unmap_kernel(vaddr, BENCH_SIZE);
+    return cost;
+}
+
+static void test_bench_memset(void)
+{
+    _bench_memset("page", 0);
+    _bench_memset("huge page", MMF_HUGEPAGE);
+}
+
+static void testcase_main(void)
+{
+    test_anon_huge_fault();
+    test_bench_memset();
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    lwp = lwp_create(0);
+    if (lwp)
+        lwp_user_space_init(lwp, 1);
+    else
+        return -RT_ENOMEM;
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    lwp_ref_dec(lwp);
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(testcase_main);
+}
+UTEST_TC_EXPORT(testcase, "testcases.mm.aspace_map.huge_page", utest_tc_init, utest_tc_cleanup, 60);
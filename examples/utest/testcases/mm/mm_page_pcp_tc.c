@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        test case for per-CPU page cache
+ */
+
+#include <rtthread.h>
+#include "rthw.h"
+#include "utest.h"
+#include <mm_page.h>
+
+#define PCP_TEST_TICKS          (RT_TICK_PER_SECOND)
+#define PCP_TEST_BURST          8
+#define PCP_TEST_PAGES          (2 * RT_MM_PAGE_PCP_HIGH + 7)
+#define PCP_TEST_THREAD_PRIO    (RT_THREAD_PRIORITY_MAX / 3)
+
+static struct rt_semaphore _thr_exit_sem;
+static volatile rt_bool_t _stop;
+static rt_ubase_t _rounds[RT_CPUS_NR];
+static rt_ubase_t _failed[RT_CPUS_NR];
+
+static void pcp_hot_reuse_tc(void)
+{
+    void *page, *again = RT_NULL;
+
+    /* stay on the cpu, so the page is back on the same cache */
+    rt_enter_critical();
+    page = rt_pages_alloc(0);
+    if (page)
+    {
+        rt_pages_free(page, 0);
+        again = rt_pages_alloc(0);
+    }
+    rt_exit_critical();
+
+    uassert_not_null(page);
+    if (page)
+    {
+        uassert_true(page == again);
+        rt_pages_free(again, 0);
+    }
+}
+
+static void pcp_account_tc(void)
+{
+    void **pages;
+    rt_size_t total, free_before, free_after;
+    int i;
+
+    pages = rt_malloc(PCP_TEST_PAGES * sizeof(void *));
+    uassert_not_null(pages);
+    if (!pages)
+        return;
+
+    rt_page_get_info(&total, &free_before);
+
+    /* run over the refill and drain watermark */
+    for (i = 0; i < PCP_TEST_PAGES; i++)
+    {
+        pages[i] = rt_pages_alloc(0);
+        if (!pages[i])
+            break;
+    }
+    uassert_int_equal(i, PCP_TEST_PAGES);
+    while (i--)
+        uassert_int_equal(rt_pages_free(pages[i], 0), 1);
+
+    /* cached pages are still free pages */
+    rt_page_get_info(&total, &free_after);
+    uassert_int_equal(free_before, free_after);
+
+    rt_free(pages);
+}
+
+/* one thread on every core allocates and frees pages in burst */
+static void _hammer_entry(void *param)
+{
+    int cpu = (rt_ubase_t)param;
+    void *pages[PCP_TEST_BURST];
+
+    while (!_stop)
+    {
+        for (int i = 0; i < PCP_TEST_BURST; i++)
+        {
+            pages[i] = rt_pages_alloc_ext(0, PAGE_ANY_AVAILABLE);
+            if (!pages[i])
+                _failed[cpu]++;
+        }
+        for (int i = 0; i < PCP_TEST_BURST; i++)
+        {
+            if (pages[i])
+                rt_pages_free(pages[i], 0);
+        }
+        _rounds[cpu]++;
+    }
+
+    rt_sem_release(&_thr_exit_sem);
+}
+
+static void pcp_throughput_tc(void)
+{
+    rt_thread_t tid;
+    rt_ubase_t total = 0, failed = 0;
+
+    _stop = RT_FALSE;
+    rt_memset(_rounds, 0, sizeof(_rounds));
+    rt_memset(_failed, 0, sizeof(_failed));
+
+    for (int i = 0; i < RT_CPUS_NR; i++)
+    {
+        tid = rt_thread_create("pghammer", _hammer_entry, (void *)(rt_ubase_t)i,
+                               UTEST_THR_STACK_SIZE, PCP_TEST_THREAD_PRIO, 5);
+        uassert_not_null(tid);
+        if (tid)
+        {
+            rt_thread_control(tid, RT_THREAD_CTRL_BIND_CPU, (void *)(rt_ubase_t)i);
+            rt_thread_startup(tid);
+        }
+    }
+
+    rt_thread_delay(PCP_TEST_TICKS);
+    _stop = RT_TRUE;
+
+    for (int i = 0; i < RT_CPUS_NR; i++)
+    {
+        rt_sem_take(&_thr_exit_sem, RT_WAITING_FOREVER);
+        total += _rounds[i];
+        failed += _failed[i];
+    }
+    uassert_int_equal(failed, 0);
+
+    rt_kprintf("%d cpus: %lu page alloc/free pairs per second\n", RT_CPUS_NR,
+               total * PCP_TEST_BURST * RT_TICK_PER_SECOND / PCP_TEST_TICKS);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_sem_init(&_thr_exit_sem, "pcpexit", 0, RT_IPC_FLAG_PRIO);
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_thr_exit_sem);
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(pcp_hot_reuse_tc);
+    UTEST_UNIT_RUN(pcp_account_tc);
+    UTEST_UNIT_RUN(pcp_throughput_tc);
+}
+UTEST_TC_EXPORT(testcase, "testcases.mm.page_pcp_tc", utest_tc_init, utest_tc_cleanup, 30);
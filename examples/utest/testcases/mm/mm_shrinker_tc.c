@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        test case for reclaim by shrinkers
+ */
+
+#include <rtthread.h>
+#include "rthw.h"
+#include "utest.h"
+#include <mm_page.h>
+#include <mm_shrinker.h>
+
+#define CACHE_PAGES     64
+#define TRY_PAGES       16
+
+/* a fake cache holding the pages, which gives them back on pressure */
+static void *_cache[CACHE_PAGES];
+static rt_size_t _cache_nr;
+static RT_DEFINE_SPINLOCK(_cache_lock);
+
+/* pages to exhaust the page allocator, linked by the first word of page */
+static void *_hog;
+
+static rt_size_t _cache_count(struct rt_shrinker *shrinker)
+{
+    return _cache_nr;
+}
+
+static rt_size_t _cache_scan(struct rt_shrinker *shrinker, rt_size_t nr_to_scan)
+{
+    rt_size_t freed = 0;
+    rt_base_t level;
+    void *page;
+
+    while (freed < nr_to_scan)
+    {
+        level = rt_spin_lock_irqsave(&_cache_lock);
+        page = _cache_nr ? _cache[--_cache_nr] : RT_NULL;
+        rt_spin_unlock_irqrestore(&_cache_lock, level);
+
+        if (!page)
+            break;
+        rt_pages_free(page, 0);
+        freed++;
+    }
+    return freed;
+}
+
+static struct rt_shrinker _cache_shrinker = {
+    .name = "utest",
+    .priority = RT_SHRINKER_PRIO_CACHE,
+    .count = _cache_count,
+    .scan = _cache_scan,
+};
+
+static void _hog_push(void *page)
+{
+    *(void **)page = _hog;
+    _hog = page;
+}
+
+static void _hog_release(void)
+{
+    void *page;
+
+    while (_hog)
+    {
+        page = _hog;
+        _hog = *(void **)page;
+        rt_pages_free(page, 0);
+    }
+}
+
+/* try some allocations under pressure, and keep the pages got */
+static int _try_alloc(void)
+{
+    void *page;
+    int success = 0;
+
+    for (int i = 0; i < TRY_PAGES; i++)
+    {
+        page = rt_pages_alloc_ext(0, PAGE_ANY_AVAILABLE);
+        if (page)
+        {
+            _hog_push(page);
+            success++;
+        }
+    }
+    return success;
+}
+
+static void shrinker_order_tc(void)
+{
+    struct rt_shrinker first = _cache_shrinker;
+    struct rt_shrinker last = _cache_shrinker;
+
+    first.priority = RT_SHRINKER_PRIO_PAGE;
+    last.priority = RT_SHRINKER_PRIO_META + 1;
+
+    rt_shrinker_register(&last);
+    rt_shrinker_register(&_cache_shrinker);
+    rt_shrinker_register(&first);
+
+    uassert_true(rt_list_entry(_cache_shrinker.node.prev, struct rt_shrinker, node)->priority <= _cache_shrinker.priority);
+    uassert_true(_cache_shrinker.node.next == &last.node ||
+                 rt_list_entry(_cache_shrinker.node.next, struct rt_shrinker, node)->priority >= _cache_shrinker.priority);
+
+    rt_shrinker_unregister(&first);
+    rt_shrinker_unregister(&_cache_shrinker);
+    rt_shrinker_unregister(&last);
+}
+
+static void shrinker_pressure_tc(void)
+{
+    void *page;
+    rt_size_t total, free;
+    int without, with;
+
+    /* fill the cache */
+    for (_cache_nr = 0; _cache_nr < CACHE_PAGES; _cache_nr++)
+    {
+        _cache[_cache_nr] = rt_pages_alloc_ext(0, PAGE_ANY_AVAILABLE);
+        if (!_cache[_cache_nr])
+            break;
+    }
+    uassert_int_equal(_cache_nr, CACHE_PAGES);
+
+    /* exhaust the rest, the registered shrinkers have given their pages */
+    while ((page = rt_pages_alloc_ext(0, PAGE_ANY_AVAILABLE)) != RT_NULL)
+        _hog_push(page);
+
+    rt_page_get_info(&total, &free);
+    rt_kprintf("%ld of %ld pages are free under pressure\n", free, total);
+
+    without = _try_alloc();
+
+    rt_shrinker_register(&_cache_shrinker);
+    with = _try_alloc();
+    rt_shrinker_unregister(&_cache_shrinker);
+
+    rt_kprintf("allocation success rate: %d/%d without shrinker, %d/%d with shrinker\n",
+               without, TRY_PAGES, with, TRY_PAGES);
+    rt_kprintf("shrinker reclaimed %ld pages in %ld calls\n",
+               _cache_shrinker.reclaimed, _cache_shrinker.calls);
+
+    uassert_true(with > without);
+    uassert_true(_cache_shrinker.reclaimed > 0);
+
+    _hog_release();
+    _cache_scan(&_cache_shrinker, CACHE_PAGES);
+    uassert_int_equal(_cache_nr, 0);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(shrinker_order_tc);
+    UTEST_UNIT_RUN(shrinker_pressure_tc);
+}
+UTEST_TC_EXPORT(testcase, "testcases.mm.shrinker_tc", utest_tc_init, utest_tc_cleanup, 60);
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdio.h>
+#include <at.h>
+#include "utest.h"
+
+#define AT_REPLAY_DEV_NAME      "at_vmdm"
+#define AT_REPLAY_LOOP_TIMES    200
+#define AT_REPLAY_CHUNK_SIZE    32
+
+/* a transcript captured from a cellular module during a socket download */
+static const char _transcript[] =
+    "+CSQ: 23,99\r\n"
+    "+CREG: 1,\"1A2B\",\"0C3D4E5F\",7\r\n"
+    "+IPD,0,16:0123456789abcdef"
+    "\r\nOK\r\n"
+    "+CGREG: 1\r\n"
+    "+IPD,0,32:0123456789abcdef0123456789abcdef"
+    "RING\r\n"
+    "+CSQ: 22,99\r\n"
+    "+IPD,1,8:abcdefgh"
+    "+CEREG: 1\r\n"
+    "+BENCHEND\r\n";
+
+static struct rt_device _vmodem;
+static const char *_replay_pos;
+static const char *_replay_end;
+static struct rt_semaphore _replay_done;
+static rt_uint32_t _csq_cnt, _reg_cnt, _ring_cnt, _ipd_cnt, _ipd_bytes;
+
+static rt_ssize_t _vmodem_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    rt_size_t len;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    len = _replay_end - _replay_pos;
+    /* a real UART never hands more than its FIFO burst at a time */
+    if (len > AT_REPLAY_CHUNK_SIZE)
+        len = AT_REPLAY_CHUNK_SIZE;
+    if (len > size)
+        len = size;
+    rt_memcpy(buffer, _replay_pos, len);
+    _replay_pos += len;
+    rt_hw_interrupt_enable(level);
+
+    return len;
+}
+
+static rt_ssize_t _vmodem_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    return size;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+const static struct rt_device_ops _vmodem_ops =
+{
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    _vmodem_read,
+    _vmodem_write,
+    RT_NULL
+};
+#endif /* RT_USING_DEVICE_OPS */
+
+static void _vmodem_replay(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    _replay_pos = _transcript;
+    _replay_end = _transcript + sizeof(_transcript) - 1;
+    rt_hw_interrupt_enable(level);
+
+    if (_vmodem.rx_indicate)
+    {
+        _vmodem.rx_indicate(&_vmodem, sizeof(_transcript) - 1);
+    }
+}
+
+static void urc_csq(struct at_client *client, const char *data, rt_size_t size)
+{
+    _csq_cnt++;
+}
+
+static void urc_reg(struct at_client *client, const char *data, rt_size_t size)
+{
+    _reg_cnt++;
+}
+
+static void urc_ring(struct at_client *client, const char *data, rt_size_t size)
+{
+    _ring_cnt++;
+}
+
+static void urc_ipd(struct at_client *client, const char *data, rt_size_t size)
+{
+    int sock = 0, len = 0;
+    char payload[32];
+
+    if (sscanf(data, "+IPD,%d,%d:", &sock, &len) != 2 || len > sizeof(payload))
+        return;
+
+    if (at_client_obj_recv(client, payload, len, 100) == len)
+    {
+        _ipd_cnt++;
+        _ipd_bytes += len;
+    }
+}
+
+static void urc_end(struct at_client *client, const char *data, rt_size_t size)
+{
+    rt_sem_release(&_replay_done);
+}
+
+static void urc_dummy(struct at_client *client, const char *data, rt_size_t size)
+{
+}
+
+/* a table shaped like the ones used by real modem drivers */
+static const struct at_urc _urc_table[] =
+{
+    {"SEND OK",      "\r\n",  urc_dummy},
+    {"SEND FAIL",    "\r\n",  urc_dummy},
+    {"+CMTI:",       "\r\n",  urc_dummy},
+    {"+CLIP:",       "\r\n",  urc_dummy},
+    {"NO CARRIER",   "\r\n",  urc_dummy},
+    {"+QIURC:",      "\r\n",  urc_dummy},
+    {"+CPIN:",       "\r\n",  urc_dummy},
+    {"+PDP DEACT",   "\r\n",  urc_dummy},
+    {"CLOSED",       "\r\n",  urc_dummy},
+    {"+CSQ:",        "\r\n",  urc_csq},
+    {"+CREG:",       "\r\n",  urc_reg},
+    {"+CGREG:",      "\r\n",  urc_reg},
+    {"+CEREG:",      "\r\n",  urc_reg},
+    {"RING",         "\r\n",  urc_ring},
+    {"+IPD",         ":",     urc_ipd},
+    {"+BENCHEND",    "\r\n",  urc_end},
+};
+
+static void test_at_client_replay(void)
+{
+    int i;
+    rt_tick_t start, cost;
+    at_client_t client;
+
+    client = at_client_get(AT_REPLAY_DEV_NAME);
+    uassert_not_null(client);
+    if (client == RT_NULL)
+        return;
+
+    start = rt_tick_get();
+    for (i = 0; i < AT_REPLAY_LOOP_TIMES; i++)
+    {
+        _vmodem_replay();
+        if (rt_sem_take(&_replay_done, rt_tick_from_millisecond(1000)) != RT_EOK)
+            break;
+    }
+    cost = rt_tick_get() - start;
+
+    uassert_int_equal(i, AT_REPLAY_LOOP_TIMES);
+    uassert_int_equal(_csq_cnt, AT_REPLAY_LOOP_TIMES * 2);
+    uassert_int_equal(_reg_cnt, AT_REPLAY_LOOP_TIMES * 3);
+    uassert_int_equal(_ring_cnt, AT_REPLAY_LOOP_TIMES);
+    uassert_int_equal(_ipd_cnt, AT_REPLAY_LOOP_TIMES * 3);
+    uassert_int_equal(_ipd_bytes, AT_REPLAY_LOOP_TIMES * (16 + 32 + 8));
+
+    rt_kprintf("AT replay: %d transcripts (%d bytes) in %d ticks\n",
+               AT_REPLAY_LOOP_TIMES, AT_REPLAY_LOOP_TIMES * (sizeof(_transcript) - 1), cost);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    _csq_cnt = _reg_cnt = _ring_cnt = _ipd_cnt = _ipd_bytes = 0;
+    _replay_pos = _replay_end = _transcript;
+    rt_sem_init(&_replay_done, "at_rply", 0, RT_IPC_FLAG_PRIO);
+
+    if (rt_device_find(AT_REPLAY_DEV_NAME) == RT_NULL)
+    {
+        _vmodem.type = RT_Device_Class_Char;
+#ifdef RT_USING_DEVICE_OPS
+        _vmodem.ops = &_vmodem_ops;
+#else
+        _vmodem.read = _vmodem_read;
+        _vmodem.write = _vmodem_write;
+#endif
+        if (rt_device_register(&_vmodem, AT_REPLAY_DEV_NAME, RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_INT_RX) != RT_EOK)
+            return -RT_ERROR;
+    }
+
+    /* the AT client can not be detached, it is created and given the URC table on the first run */
+    if (at_client_get(AT_REPLAY_DEV_NAME) != RT_NULL)
+        return RT_EOK;
+    if (at_client_init(AT_REPLAY_DEV_NAME, 128, 64) != RT_EOK)
+        return -RT_ERROR;
+
+    return at_obj_set_urc_table(at_client_get(AT_REPLAY_DEV_NAME), _urc_table,
+                                sizeof(_urc_table) / sizeof(_urc_table[0]));
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_replay_done);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_at_client_replay);
+}
+UTEST_TC_EXPORT(testcase, "testcases.net.at_client_replay_tc", utest_tc_init, utest_tc_cleanup, 60);
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdio.h>
+#include <at.h>
+#include <at_socket.h>
+#include <at_device.h>
+#include <netdev.h>
+#include <af_inet.h>
+#include <arpa/inet.h>
+#include "utest.h"
+
+#define AT_VMODEM_UART          "at_vskt"
+#define AT_VMODEM_NAME          "vmdm"
+#define AT_VMODEM_CLASS_ID      0x7F
+#define AT_VMODEM_SOCKETS_NUM   2
+#define AT_VMODEM_UART_BURST    64
+#define AT_VMODEM_SEGMENT       1460
+#define AT_VMODEM_TOTAL         (256 * 1024)
+
+/* scripted modem: "+IPD,<socket>,<len>:<payload>" for every segment of a download */
+static struct rt_device _vuart;
+/* the data delivery is paused by AT socket, the modem keeps sending if it ignores the pause */
+static volatile rt_bool_t _paused, _ignore_pause;
+static volatile rt_size_t _sent;
+static rt_size_t _seg_left;
+static char _hdr[24];
+static rt_size_t _hdr_pos, _hdr_len;
+
+static struct at_device_class _vmodem_class;
+static struct at_device _vmodem;
+static struct netdev _vmodem_netdev;
+
+static rt_ssize_t _vuart_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    char *ptr = (char *)buffer;
+    rt_size_t len = 0;
+
+    if (size > AT_VMODEM_UART_BURST)
+        size = AT_VMODEM_UART_BURST;
+
+    while (len < size)
+    {
+        if (_hdr_pos < _hdr_len)
+        {
+            ptr[len++] = _hdr[_hdr_pos++];
+        }
+        else if (_seg_left > 0)
+        {
+            ptr[len++] = (char)(_sent & 0xFF);
+            _sent++;
+            _seg_left--;
+        }
+        else if (_sent < AT_VMODEM_TOTAL && (!_paused || _ignore_pause))
+        {
+            _seg_left = AT_VMODEM_TOTAL - _sent;
+            if (_seg_left > AT_VMODEM_SEGMENT)
+                _seg_left = AT_VMODEM_SEGMENT;
+            _hdr_len = rt_snprintf(_hdr, sizeof(_hdr), "+IPD,0,%d:", _seg_left);
+            _hdr_pos = 0;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return len;
+}
+
+static rt_ssize_t _vuart_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    return size;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+const static struct rt_device_ops _vuart_ops =
+{
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    _vuart_read,
+    _vuart_write,
+    RT_NULL
+};
+#endif /* RT_USING_DEVICE_OPS */
+
+static void _vuart_kick(void)
+{
+    if (_vuart.rx_indicate)
+    {
+        _vuart.rx_indicate(&_vuart, AT_VMODEM_UART_BURST);
+    }
+}
+
+static void urc_ipd(struct at_client *client, const char *data, rt_size_t size)
+{
+    int sock = 0, len = 0;
+
+    if (sscanf(data, "+IPD,%d,%d:", &sock, &len) != 2 || sock >= AT_VMODEM_SOCKETS_NUM)
+        return;
+
+    at_socket_recv_from_client(&_vmodem.sockets[sock], client, len, 1000);
+}
+
+static const struct at_urc _urc_table[] =
+{
+    {"+IPD", ":", urc_ipd},
+};
+
+static int _vmodem_connect(struct at_socket *socket, char *ip, int32_t port, enum at_socket_type type, rt_bool_t is_client)
+{
+    _sent = _seg_left = _hdr_pos = _hdr_len = 0;
+    _paused = RT_FALSE;
+    _vuart_kick();
+
+    return 0;
+}
+
+static int _vmodem_closesocket(struct at_socket *socket)
+{
+    return 0;
+}
+
+static int _vmodem_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+{
+    return bfsz;
+}
+
+static int _vmodem_domain_resolve(const char *name, char ip[16])
+{
+    return -1;
+}
+
+static void _vmodem_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
+{
+}
+
+static int _vmodem_recv_flowctrl(struct at_socket *socket, rt_bool_t enable)
+{
+    _paused = !enable;
+    if (enable)
+    {
+        _vuart_kick();
+    }
+
+    return 0;
+}
+
+static const struct at_socket_ops _vmodem_socket_ops =
+{
+    .at_connect = _vmodem_connect,
+    .at_closesocket = _vmodem_closesocket,
+    .at_send = _vmodem_send,
+    .at_domain_resolve = _vmodem_domain_resolve,
+    .at_set_event_cb = _vmodem_set_event_cb,
+    .at_recv_flowctrl = _vmodem_recv_flowctrl,
+};
+
+static int _vmodem_init(struct at_device *device)
+{
+    if (at_client_init(AT_VMODEM_UART, 128, 64) != RT_EOK)
+        return -RT_ERROR;
+
+    device->client = at_client_get(AT_VMODEM_UART);
+    at_obj_set_urc_table(device->client, _urc_table, sizeof(_urc_table) / sizeof(_urc_table[0]));
+
+    netdev_register(&_vmodem_netdev, AT_VMODEM_NAME, device);
+    sal_at_netdev_set_pf_info(&_vmodem_netdev);
+    netdev_low_level_set_status(&_vmodem_netdev, RT_TRUE);
+    netdev_low_level_set_link_status(&_vmodem_netdev, RT_TRUE);
+    device->netdev = &_vmodem_netdev;
+
+    return RT_EOK;
+}
+
+static int _vmodem_deinit(struct at_device *device)
+{
+    return RT_EOK;
+}
+
+static int _vmodem_control(struct at_device *device, int cmd, void *arg)
+{
+    return -RT_ERROR;
+}
+
+static const struct at_device_ops _vmodem_device_ops =
+{
+    _vmodem_init,
+    _vmodem_deinit,
+    _vmodem_control,
+};
+
+static void test_at_socket_recv_throughput(void)
+{
+    int sock, len;
+    rt_size_t total = 0;
+    rt_bool_t data_ok = RT_TRUE;
+    rt_tick_t start, cost;
+    struct sockaddr_in addr;
+    static rt_uint8_t buf[1024];
+
+    sock = at_socket(AF_AT, SOCK_STREAM, 0);
+    uassert_true(sock >= 0);
+    if (sock < 0)
+        return;
+
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(80);
+    addr.sin_addr.s_addr = inet_addr("10.0.0.1");
+
+    start = rt_tick_get();
+    uassert_int_equal(at_connect(sock, (struct sockaddr *)&addr, sizeof(addr)), 0);
+
+    while (total < AT_VMODEM_TOTAL)
+    {
+        len = at_recv(sock, buf, sizeof(buf), 0);
+        if (len <= 0)
+            break;
+
+        for (int i = 0; i < len; i++)
+        {
+            if (buf[i] != (rt_uint8_t)((total + i) & 0xFF))
+                data_ok = RT_FALSE;
+        }
+        total += len;
+    }
+    cost = rt_tick_get() - start;
+
+    uassert_int_equal(total, AT_VMODEM_TOTAL);
+    uassert_true(data_ok);
+
+    rt_kprintf("AT socket recv: %d bytes in %d ticks\n", total, cost);
+
+    at_closesocket(sock);
+}
+
+#ifdef AT_SOCKET_USING_RECV_RING
+static void test_at_socket_recv_overrun(void)
+{
+    int sock, len;
+    rt_size_t total = 0, dropped;
+    rt_size_t mem_total, mem_used, mem_max, used_start, used_peak = 0;
+    struct sockaddr_in addr;
+    static rt_uint8_t buf[1024];
+
+    sock = at_socket(AF_AT, SOCK_STREAM, 0);
+    uassert_true(sock >= 0);
+    if (sock < 0)
+        return;
+
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(80);
+    addr.sin_addr.s_addr = inet_addr("10.0.0.1");
+
+    /* the modem overruns the ring and nobody reads the socket */
+    _ignore_pause = RT_TRUE;
+    rt_memory_info(&mem_total, &used_start, &mem_max);
+    uassert_int_equal(at_connect(sock, (struct sockaddr *)&addr, sizeof(addr)), 0);
+
+    for (int i = 0; i < 1000 && _sent < AT_VMODEM_TOTAL; i++)
+    {
+        rt_memory_info(&mem_total, &mem_used, &mem_max);
+        if (mem_used > used_peak)
+            used_peak = mem_used;
+        rt_thread_mdelay(10);
+    }
+    /* let the parser finish the last segment */
+    rt_thread_mdelay(100);
+    rt_memory_info(&mem_total, &mem_used, &mem_max);
+    if (mem_used > used_peak)
+        used_peak = mem_used;
+    _ignore_pause = RT_FALSE;
+
+    uassert_int_equal(_sent, AT_VMODEM_TOTAL);
+    /* only the segment on the way when the ring is full is kept out of the ring */
+    uassert_true(used_peak - used_start <= 2 * AT_VMODEM_SEGMENT);
+
+    while ((len = at_recv(sock, buf, sizeof(buf), MSG_DONTWAIT)) > 0)
+    {
+        total += len;
+    }
+    dropped = at_get_socket(sock)->recv_dropped;
+
+    rt_kprintf("AT socket overrun: %d bytes received, %d bytes dropped, heap +%d bytes\n",
+               total, dropped, used_peak - used_start);
+    uassert_true(dropped > 0);
+    uassert_int_equal(total + dropped, AT_VMODEM_TOTAL);
+
+    at_closesocket(sock);
+}
+#endif /* AT_SOCKET_USING_RECV_RING */
+
+static rt_err_t utest_tc_init(void)
+{
+    if (rt_device_find(AT_VMODEM_UART) == RT_NULL)
+    {
+        _vuart.type = RT_Device_Class_Char;
+#ifdef RT_USING_DEVICE_OPS
+        _vuart.ops = &_vuart_ops;
+#else
+        _vuart.read = _vuart_read;
+        _vuart.write = _vuart_write;
+#endif
+        if (rt_device_register(&_vuart, AT_VMODEM_UART, RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_INT_RX) != RT_EOK)
+            return -RT_ERROR;
+    }
+
+    /* the AT device can not be unregistered, so it is only created once */
+    if (at_device_get_by_name(AT_DEVICE_NAMETYPE_NETDEV, AT_VMODEM_NAME) == RT_NULL)
+    {
+        _vmodem_class.device_ops = &_vmodem_device_ops;
+        _vmodem_class.socket_num = AT_VMODEM_SOCKETS_NUM;
+        _vmodem_class.socket_ops = &_vmodem_socket_ops;
+        at_device_class_register(&_vmodem_class, AT_VMODEM_CLASS_ID);
+
+        if (at_device_register(&_vmodem, AT_VMODEM_NAME, AT_VMODEM_UART, AT_VMODEM_CLASS_ID, RT_NULL) != RT_EOK)
+            return -RT_ERROR;
+    }
+
+    /* make the virtual modem be chosen by at_socket() */
+    netdev_set_default(&_vmodem_netdev);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_at_socket_recv_throughput);
+#ifdef AT_SOCKET_USING_RECV_RING
+    UTEST_UNIT_RUN(test_at_socket_recv_overrun);
+#endif
+}
+UTEST_TC_EXPORT(testcase, "testcases.net.at_socket_recv_tc", utest_tc_init, utest_tc_cleanup, 120);
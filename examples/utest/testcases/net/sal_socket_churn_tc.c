@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sal_socket.h>
+#include <sal_low_lvl.h>
+#include "utest.h"
+
+#define CHURN_PORT              5870
+#define CHURN_CLIENTS           4
+#define CHURN_LOOP_TIMES        100
+#define CHURN_THREAD_PRIORITY   (RT_THREAD_PRIORITY_MAX / 3)
+#define LOOKUP_THREADS          2
+#define LOOKUP_SOCKETS          4
+#define LOOKUP_LOOP_TIMES       2000
+
+static struct rt_semaphore _clients_done;
+static rt_atomic_t _connect_fail;
+static volatile int _lookup_socks[LOOKUP_SOCKETS];
+static volatile rt_bool_t _lookup_stop;
+static rt_atomic_t _lookup_hit;
+
+/* a short HTTP-like exchange: connect, send one byte, wait close */
+static void _client_entry(void *param)
+{
+    int i, sock;
+    char ch = 'x';
+    struct sockaddr_in addr;
+
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(CHURN_PORT);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    for (i = 0; i < CHURN_LOOP_TIMES; i++)
+    {
+        sock = socket(AF_INET, SOCK_STREAM, 0);
+        if (sock < 0)
+        {
+            rt_atomic_add(&_connect_fail, 1);
+            continue;
+        }
+
+        if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) == 0)
+        {
+            send(sock, &ch, 1, 0);
+            recv(sock, &ch, 1, 0);
+        }
+        else
+        {
+            rt_atomic_add(&_connect_fail, 1);
+        }
+        closesocket(sock);
+    }
+
+    rt_sem_release(&_clients_done);
+}
+
+static void test_sal_accept_close_churn(void)
+{
+    int i, server, client;
+    char ch;
+    rt_tick_t start, cost;
+    struct sockaddr_in addr;
+    socklen_t addr_len;
+    struct timeval timeout = {5, 0};
+    rt_thread_t tid;
+    int accepted = 0;
+
+    server = socket(AF_INET, SOCK_STREAM, 0);
+    uassert_true(server >= 0);
+    if (server < 0)
+        return;
+
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(CHURN_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    uassert_int_equal(bind(server, (struct sockaddr *)&addr, sizeof(addr)), 0);
+    uassert_int_equal(listen(server, CHURN_CLIENTS), 0);
+    /* do not block forever if some connection is lost */
+    setsockopt(server, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    start = rt_tick_get();
+    for (i = 0; i < CHURN_CLIENTS; i++)
+    {
+        tid = rt_thread_create("churn", _client_entry, RT_NULL,
+                               UTEST_THR_STACK_SIZE, CHURN_THREAD_PRIORITY, 10);
+        uassert_not_null(tid);
+        if (tid)
+            rt_thread_startup(tid);
+    }
+
+    while (accepted + _connect_fail < CHURN_CLIENTS * CHURN_LOOP_TIMES)
+    {
+        addr_len = sizeof(addr);
+        client = accept(server, (struct sockaddr *)&addr, &addr_len);
+        if (client < 0)
+            break;
+
+        if (recv(client, &ch, 1, 0) == 1)
+            accepted++;
+        closesocket(client);
+    }
+
+    for (i = 0; i < CHURN_CLIENTS; i++)
+    {
+        rt_sem_take(&_clients_done, RT_WAITING_FOREVER);
+    }
+    cost = rt_tick_get() - start;
+    closesocket(server);
+
+    uassert_int_equal(_connect_fail, 0);
+    uassert_int_equal(accepted, CHURN_CLIENTS * CHURN_LOOP_TIMES);
+
+    rt_kprintf("SAL churn: %d connections in %d ticks\n", accepted, cost);
+}
+
+/*
+ * look up the sockets which are being closed and created again by the test thread,
+ * sal_get_socket() asserts on the magic of a socket object freed under it
+ */
+static void _lookup_entry(void *param)
+{
+    int i, socket;
+
+    while (!_lookup_stop)
+    {
+        for (i = 0; i < LOOKUP_SOCKETS; i++)
+        {
+            socket = _lookup_socks[i];
+            if (socket < 0)
+                continue;
+
+            if (sal_get_socket(socket) != RT_NULL)
+                rt_atomic_add(&_lookup_hit, 1);
+        }
+    }
+
+    rt_sem_release(&_clients_done);
+}
+
+static void test_sal_lookup_close_race(void)
+{
+    int i, j, socket;
+    rt_thread_t tid;
+
+    _lookup_stop = RT_FALSE;
+    for (i = 0; i < LOOKUP_SOCKETS; i++)
+    {
+        _lookup_socks[i] = sal_socket(AF_INET, SOCK_DGRAM, 0);
+        uassert_true(_lookup_socks[i] >= 0);
+    }
+
+    for (i = 0; i < LOOKUP_THREADS; i++)
+    {
+        tid = rt_thread_create("lookup", _lookup_entry, RT_NULL,
+                               UTEST_THR_STACK_SIZE, CHURN_THREAD_PRIORITY, 1);
+        uassert_not_null(tid);
+        if (tid)
+            rt_thread_startup(tid);
+    }
+
+    for (i = 0; i < LOOKUP_LOOP_TIMES; i++)
+    {
+        j = i % LOOKUP_SOCKETS;
+        socket = _lookup_socks[j];
+        if (socket >= 0)
+            sal_closesocket(socket);
+        _lookup_socks[j] = sal_socket(AF_INET, SOCK_DGRAM, 0);
+        if ((i & 0x3F) == 0)
+            rt_thread_yield();
+    }
+
+    _lookup_stop = RT_TRUE;
+    for (i = 0; i < LOOKUP_THREADS; i++)
+    {
+        rt_sem_take(&_clients_done, RT_WAITING_FOREVER);
+    }
+
+    for (i = 0; i < LOOKUP_SOCKETS; i++)
+    {
+        if (_lookup_socks[i] >= 0)
+            sal_closesocket(_lookup_socks[i]);
+        _lookup_socks[i] = -1;
+    }
+
+    uassert_true(_lookup_hit > 0);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    _connect_fail = 0;
+    _lookup_hit = 0;
+    rt_sem_init(&_clients_done, "churn", 0, RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_clients_done);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_sal_accept_close_churn);
+    UTEST_UNIT_RUN(test_sal_lookup_close_race);
+}
+UTEST_TC_EXPORT(testcase, "testcases.net.sal_socket_churn_tc", utest_tc_init, utest_tc_cleanup, 120);
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include "utest.h"
+
+#define MMSG_PORT               5871
+#define MMSG_BATCH              8
+#define MMSG_PAYLOAD_SIZE       64
+#define MMSG_TOTAL              (MMSG_BATCH * 1000)
+
+static int _rx, _tx;
+static struct sockaddr_in _addr;
+static rt_uint8_t _tx_buf[MMSG_BATCH][MMSG_PAYLOAD_SIZE];
+static rt_uint8_t _rx_buf[MMSG_BATCH][MMSG_PAYLOAD_SIZE];
+static struct iovec _tx_iov[MMSG_BATCH], _rx_iov[MMSG_BATCH];
+static struct mmsghdr _tx_msg[MMSG_BATCH], _rx_msg[MMSG_BATCH];
+
+static void _msg_setup(void)
+{
+    int i;
+
+    rt_memset(_tx_msg, 0, sizeof(_tx_msg));
+    rt_memset(_rx_msg, 0, sizeof(_rx_msg));
+
+    for (i = 0; i < MMSG_BATCH; i++)
+    {
+        _tx_iov[i].iov_base = _tx_buf[i];
+        _tx_iov[i].iov_len = MMSG_PAYLOAD_SIZE;
+        _tx_msg[i].msg_hdr.msg_name = &_addr;
+        _tx_msg[i].msg_hdr.msg_namelen = sizeof(_addr);
+        _tx_msg[i].msg_hdr.msg_iov = &_tx_iov[i];
+        _tx_msg[i].msg_hdr.msg_iovlen = 1;
+
+        _rx_iov[i].iov_base = _rx_buf[i];
+        _rx_iov[i].iov_len = MMSG_PAYLOAD_SIZE;
+        _rx_msg[i].msg_hdr.msg_iov = &_rx_iov[i];
+        _rx_msg[i].msg_hdr.msg_iovlen = 1;
+    }
+}
+
+/* send one batch of datagrams, the sequence number is kept in the first word */
+static int _send_batch(rt_uint32_t seq, rt_bool_t batch)
+{
+    int i;
+
+    for (i = 0; i < MMSG_BATCH; i++)
+    {
+        rt_uint32_t id = seq + i;
+
+        rt_memcpy(_tx_buf[i], &id, sizeof(id));
+    }
+
+    if (batch)
+        return sendmmsg(_tx, _tx_msg, MMSG_BATCH, 0);
+
+    for (i = 0; i < MMSG_BATCH; i++)
+    {
+        if (sendmsg(_tx, &_tx_msg[i].msg_hdr, 0) != MMSG_PAYLOAD_SIZE)
+            break;
+    }
+
+    return i;
+}
+
+static int _recv_check(rt_uint32_t *expect, int count)
+{
+    int i;
+    rt_uint32_t id;
+
+    for (i = 0; i < count; i++)
+    {
+        rt_memcpy(&id, _rx_buf[i], sizeof(id));
+        if (_rx_msg[i].msg_len != MMSG_PAYLOAD_SIZE || id != *expect)
+            return -1;
+        (*expect)++;
+    }
+
+    return 0;
+}
+
+static rt_tick_t _run(rt_bool_t batch)
+{
+    int ret, got;
+    rt_uint32_t seq, expect = 0;
+    rt_tick_t start;
+
+    start = rt_tick_get();
+    for (seq = 0; seq < MMSG_TOTAL; seq += MMSG_BATCH)
+    {
+        uassert_int_equal(_send_batch(seq, batch), MMSG_BATCH);
+
+        /* the loopback netif delivers asynchronously, wait for the first one only */
+        for (got = 0; got < MMSG_BATCH; got += ret)
+        {
+            if (batch)
+            {
+                ret = recvmmsg(_rx, _rx_msg, MMSG_BATCH - got, MSG_WAITFORONE, RT_NULL);
+            }
+            else
+            {
+                ret = recvmsg(_rx, &_rx_msg[0].msg_hdr, 0);
+                _rx_msg[0].msg_len = ret;
+                ret = (ret < 0) ? ret : 1;
+            }
+            if (ret <= 0 || _recv_check(&expect, ret) != 0)
+            {
+                uassert_true(RT_FALSE);
+                return 0;
+            }
+        }
+    }
+
+    uassert_int_equal(expect, MMSG_TOTAL);
+
+    return rt_tick_get() - start;
+}
+
+static void test_udp_mmsg_rate(void)
+{
+    rt_tick_t single, batch;
+
+    single = _run(RT_FALSE);
+    batch = _run(RT_TRUE);
+
+    rt_kprintf("UDP loopback %d datagrams: recvmsg %d ticks, recvmmsg %d ticks\n",
+               MMSG_TOTAL, single, batch);
+    if (single && batch)
+    {
+        rt_kprintf("datagrams/sec: recvmsg %d, recvmmsg %d\n",
+                   MMSG_TOTAL * RT_TICK_PER_SECOND / single,
+                   MMSG_TOTAL * RT_TICK_PER_SECOND / batch);
+    }
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    struct timeval timeout = {5, 0};
+
+    _addr.sin_family = AF_INET;
+    _addr.sin_port = htons(MMSG_PORT);
+    _addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    _rx = socket(AF_INET, SOCK_DGRAM, 0);
+    _tx = socket(AF_INET, SOCK_DGRAM, 0);
+    if (_rx < 0 || _tx < 0)
+        return -RT_ERROR;
+
+    if (bind(_rx, (struct sockaddr *)&_addr, sizeof(_addr)) != 0)
+        return -RT_ERROR;
+    /* do not block forever if some datagram is lost */
+    setsockopt(_rx, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    _msg_setup();
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    if (_rx >= 0)
+        closesocket(_rx);
+    if (_tx >= 0)
+        closesocket(_tx);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_udp_mmsg_rate);
+}
+UTEST_TC_EXPORT(testcase, "testcases.net.sal_udp_mmsg_tc", utest_tc_init, utest_tc_cleanup, 120);
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <eventfd.h>
+#include <utest.h>
+
+#define POLL_FDS_NUM        512
+#define POLL_LOOP_TIMES     2000
+#define POLL_THREAD_PRIO    (RT_THREAD_PRIORITY_MAX / 3)
+
+static struct pollfd _pfds[POLL_FDS_NUM];
+static int _fds_num;
+static struct rt_semaphore _kick;
+
+/* only a few fds ever become readable, the others stay idle */
+static int _busy_fd(int i)
+{
+    return (i * 131) % _fds_num;
+}
+
+static void _writer_entry(void *param)
+{
+    int i;
+    uint64_t val = 1;
+
+    for (i = 0; i < POLL_LOOP_TIMES; i++)
+    {
+        if (rt_sem_take(&_kick, RT_WAITING_FOREVER) != RT_EOK)
+            break;
+        write(_pfds[_busy_fd(i)].fd, &val, sizeof(val));
+    }
+}
+
+static void test_poll_idle_fds(void)
+{
+    int i, n, ready;
+    uint64_t val;
+    rt_tick_t start, cost;
+    rt_thread_t tid;
+
+    uassert_true(_fds_num > 0);
+    if (_fds_num == 0)
+        return;
+
+    /* nothing is readable yet */
+    uassert_int_equal(poll(_pfds, _fds_num, 0), 0);
+
+    tid = rt_thread_create("pollw", _writer_entry, RT_NULL,
+                           UTEST_THR_STACK_SIZE, POLL_THREAD_PRIO, 10);
+    uassert_not_null(tid);
+    if (tid == RT_NULL)
+        return;
+    rt_thread_startup(tid);
+
+    start = rt_tick_get();
+    for (i = 0; i < POLL_LOOP_TIMES; i++)
+    {
+        rt_sem_release(&_kick);
+
+        /* the writer runs after poll() sleeps, so every round is a wakeup */
+        n = poll(_pfds, _fds_num, 1000);
+        if (n != 1)
+            break;
+
+        ready = _busy_fd(i);
+        if (!(_pfds[ready].revents & POLLIN))
+            break;
+        read(_pfds[ready].fd, &val, sizeof(val));
+    }
+    cost = rt_tick_get() - start;
+
+    uassert_int_equal(i, POLL_LOOP_TIMES);
+
+    rt_kprintf("poll %d fds: %d wakeups in %d ticks\n", _fds_num, i, cost);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    int fd;
+
+    rt_sem_init(&_kick, "pollk", 0, RT_IPC_FLAG_PRIO);
+
+    /* as many as the fd table allows, up to POLL_FDS_NUM */
+    for (_fds_num = 0; _fds_num < POLL_FDS_NUM; _fds_num++)
+    {
+        fd = eventfd(0, O_NONBLOCK);
+        if (fd < 0)
+            break;
+
+        _pfds[_fds_num].fd = fd;
+        _pfds[_fds_num].events = POLLIN;
+        _pfds[_fds_num].revents = 0;
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    while (_fds_num > 0)
+    {
+        close(_pfds[--_fds_num].fd);
+    }
+    rt_sem_detach(&_kick);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_poll_idle_fds);
+}
+UTEST_TC_EXPORT(testcase, "posix.poll_h.poll_idle_fds_tc.c", utest_tc_init, utest_tc_cleanup, 60);
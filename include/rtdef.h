@@ -390,7 +390,9 @@ enum rt_object_class_type
     RT_Object_Class_ProcessGroup  = 0x0e,      /**< The object is a process group */
     RT_Object_Class_Session       = 0x0f,      /**< The object is a session */
     RT_Object_Class_Custom        = 0x10,      /**< The object is a custom object */
-    RT_Object_Class_Unknown       = 0x11,      /**< The object is unknown. */
+    RT_Object_Class_RWLock        = 0x11,      /**< The object is a reader-writer lock. */
+    RT_Object_Class_FastLock      = 0x12,      /**< The object is a fast lock. */
+    RT_Object_Class_Unknown       = 0x13,      /**< The object is unknown. */
     RT_Object_Class_Static        = 0x80       /**< The object is a static object. */
 };
 
@@ -690,6 +692,21 @@ enum
 #define RT_THREAD_CTRL_CHANGE_PRIORITY  0x02                /**< Change thread priority. */
 #define RT_THREAD_CTRL_INFO             0x03                /**< Get thread information. */
 #define RT_THREAD_CTRL_BIND_CPU         0x04                /**< Set thread bind cpu. */
+#define RT_THREAD_CTRL_SET_DEADLINE     0x05                /**< Set EDF parameters of thread. */
+#define RT_THREAD_CTRL_GET_DEADLINE     0x06                /**< Get EDF parameters of thread. */
+
+#ifdef RT_USING_SCHED_EDF
+/**
+ * EDF parameters of thread, for RT_THREAD_CTRL_SET_DEADLINE and RT_THREAD_CTRL_GET_DEADLINE
+ */
+struct rt_thread_deadline_attr
+{
+    rt_tick_t                   runtime;                /**< budget in each period, 0 to leave the EDF class */
+    rt_tick_t                   deadline;               /**< relative deadline, not larger than period */
+    rt_tick_t                   period;                 /**< period of the jobs */
+    rt_uint32_t                 misses;                 /**< deadline misses, output only */
+};
+#endif /* RT_USING_SCHED_EDF */
 
 #ifdef RT_USING_SMP
 
@@ -741,12 +758,18 @@ struct rt_cpu
     #else
         rt_uint32_t             priority_group;
     #endif /* RT_THREAD_PRIORITY_MAX > 32 */
+    #ifdef RT_SCHED_USING_PERCPU_RUNQUEUE
+        rt_uint16_t             nr_ready;   /**< Unbound threads queued on this core */
+    #endif
 
         rt_atomic_t             tick;   /**< Passing tickes on this core */
     );
 
     struct rt_thread            *idle_thread;
     rt_atomic_t                 irq_nest;
+#ifdef RT_USING_RCU
+    rt_atomic_t                 rcu_qs;     /**< Quiescent states passed on this core */
+#endif
 
 #ifdef RT_USING_SMART
     struct rt_spinlock          spinlock;
@@ -988,7 +1011,26 @@ struct rt_ipc_object
     struct rt_object parent;                            /**< inherit from rt_object */
 
     rt_list_t suspend_thread;                 /**< threads pended on this resource */
+#ifdef RT_USING_IPC_WAIT_ANY
+    rt_list_t wait_any_list;                  /**< rt_wait_any() items on this resource */
+#endif /* RT_USING_IPC_WAIT_ANY */
+};
+
+#ifdef RT_USING_IPC_WAIT_ANY
+struct rt_wait_any;
+
+/**
+ * An IPC object waited by rt_wait_any()
+ */
+struct rt_wait_any_item
+{
+    rt_object_t          object;                        /**< semaphore, event, mailbox or messagequeue */
+    rt_uint32_t          set;                           /**< events to wait for, only for event object */
+
+    rt_list_t            node;                          /**< private, node in the object */
+    struct rt_wait_any  *wait;                          /**< private, the waiting context */
 };
+#endif /* RT_USING_IPC_WAIT_ANY */
 
 #ifdef RT_USING_SEMAPHORE
 /**
@@ -1025,6 +1067,44 @@ struct rt_mutex
 typedef struct rt_mutex *rt_mutex_t;
 #endif /* RT_USING_MUTEX */
 
+#ifdef RT_USING_RWLOCK
+/**
+ * Reader-writer lock structure, the writers are preferred
+ */
+struct rt_rwlock
+{
+    struct rt_object     parent;                        /**< inherit from rt_object */
+
+    struct rt_spinlock   spinlock;
+    rt_int32_t           readers;                       /**< readers holding the lock, -1 if held by writer */
+    rt_uint32_t          writers_waiting;               /**< writers suspended on the lock */
+    struct rt_thread    *writer;                        /**< writer holding the lock */
+    rt_list_t            reader_list;                   /**< suspended readers */
+    rt_list_t            writer_list;                   /**< suspended writers */
+};
+typedef struct rt_rwlock *rt_rwlock_t;
+#endif /* RT_USING_RWLOCK */
+
+#ifdef RT_USING_FASTLOCK
+#define RT_FASTLOCK_UNLOCKED            0               /**< fast lock is free */
+#define RT_FASTLOCK_LOCKED              1               /**< fast lock is held, no one is waiting */
+#define RT_FASTLOCK_CONTENDED           2               /**< fast lock is held, someone may be waiting */
+
+/**
+ * Fast lock structure, the uncontended take and release are a single atomic operation
+ */
+struct rt_fastlock
+{
+    struct rt_object     parent;                        /**< inherit from rt_object */
+
+    rt_atomic_t          state;                         /**< RT_FASTLOCK_UNLOCKED/LOCKED/CONTENDED */
+    struct rt_thread    *owner;                         /**< thread holding the lock */
+    struct rt_spinlock   spinlock;                      /**< protects the suspend list */
+    rt_list_t            suspend_list;                  /**< suspended threads */
+};
+typedef struct rt_fastlock *rt_fastlock_t;
+#endif /* RT_USING_FASTLOCK */
+
 #ifdef RT_USING_EVENT
 /**
  * flag definitions in event
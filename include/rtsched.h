@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2024-01-19     Shell        Seperate schduling statements from rt_thread_t
  *                             to rt_sched_thread_ctx. Add definitions of scheduler.
+ * 2026-10-19     agent        add earliest-deadline-first scheduling class
  */
 #ifndef __RT_SCHED_H__
 #define __RT_SCHED_H__
@@ -22,6 +23,32 @@ struct rt_thread;
 
 typedef rt_uint8_t rt_sched_thread_status_t;
 
+#ifdef RT_USING_SCHED_EDF
+/**
+ * Earliest-deadline-first parameters and state of a thread. The runtime is 0
+ * for a thread of the fixed priority class.
+ */
+struct rt_sched_edf
+{
+    rt_tick_t                   runtime;                /**< budget in each period */
+    rt_tick_t                   deadline;               /**< relative deadline */
+    rt_tick_t                   period;                 /**< period */
+    rt_tick_t                   release;                /**< release tick of current job */
+    rt_tick_t                   abs_deadline;           /**< deadline the thread is scheduled by */
+    rt_tick_t                   budget;                 /**< budget left in current server period */
+    rt_uint32_t                 misses;                 /**< jobs finished after their deadlines */
+    rt_uint8_t                  saved_priority;         /**< priority before joining the EDF class */
+    rt_uint8_t                  cpu;                    /**< core the bandwidth is admitted on */
+};
+
+#define _RT_SCHED_THREAD_CTX_EDF_EXT struct rt_sched_edf edf;
+#define RT_SCHED_IS_EDF(thread) (RT_SCHED_PRIV(thread).edf.runtime != 0)
+/* every thread queued on the EDF level goes through rt_sched_edf_enqueue() */
+#define RT_SCHED_ON_EDF_LEVEL(thread) (RT_SCHED_PRIV(thread).current_priority == RT_SCHED_EDF_PRIORITY)
+#else
+#define _RT_SCHED_THREAD_CTX_EDF_EXT
+#endif /* RT_USING_SCHED_EDF */
+
 #ifdef RT_USING_SCHED_THREAD_CTX
 
 /**
@@ -42,6 +69,7 @@ struct rt_sched_thread_priv
 #endif /* RT_THREAD_PRIORITY_MAX > 32 */
     rt_uint32_t                 number_mask;            /**< priority number mask */
 
+    _RT_SCHED_THREAD_CTX_EDF_EXT                        /**< EDF scheduling class */
 };
 
 /**
@@ -59,6 +87,11 @@ struct rt_sched_thread_ctx
 #ifdef RT_USING_SMP
     rt_uint8_t                  bind_cpu;               /**< thread is bind to cpu */
     rt_uint8_t                  oncpu;                  /**< process on cpu */
+    rt_uint8_t                  last_cpu;               /**< the cpu it ran on last time */
+    rt_uint32_t                 migrations;             /**< times it moved to another cpu */
+#ifdef RT_SCHED_USING_PERCPU_RUNQUEUE
+    rt_uint8_t                  home_cpu;               /**< cpu whose run queue holds the unbound thread */
+#endif
 
     rt_base_t                   critical_lock_nest;     /**< critical lock count */
 #endif
@@ -104,7 +137,8 @@ struct rt_sched_thread_ctx
     rt_uint8_t current_priority;        /**< current priority */               \
     rt_uint8_t init_priority;           /**< initialized priority */           \
     _RT_SCHED_THREAD_CTX_PRIO_EXT                                              \
-    rt_uint32_t number_mask;            /**< priority number mask */
+    rt_uint32_t number_mask;            /**< priority number mask */           \
+    _RT_SCHED_THREAD_CTX_EDF_EXT        /**< EDF scheduling class */
 
 #define RT_SCHED_PRIV(thread) (*thread)
 #define RT_SCHED_CTX(thread) (*thread)
@@ -154,6 +188,21 @@ void rt_sched_thread_startup(struct rt_thread *thread);
 /* scheduler related routine */
 void rt_sched_post_ctx_switch(struct rt_thread *thread);
 rt_err_t rt_sched_tick_increase(void);
+#ifdef RT_SCHED_USING_PERCPU_RUNQUEUE
+rt_bool_t rt_sched_balance_tick(void);
+#endif
+
+#ifdef RT_USING_SCHED_EDF
+struct rt_thread_deadline_attr;
+
+/* earliest-deadline-first scheduling class */
+rt_err_t rt_sched_thread_set_deadline(struct rt_thread *thread, const struct rt_thread_deadline_attr *attr);
+rt_err_t rt_sched_thread_get_deadline(struct rt_thread *thread, struct rt_thread_deadline_attr *attr);
+rt_err_t rt_sched_thread_next_period(struct rt_thread *thread, rt_tick_t *release);
+rt_err_t rt_sched_edf_bind_cpu(struct rt_thread *thread, int cpu);
+void rt_sched_edf_enqueue(rt_list_t *queue, struct rt_thread *thread);
+rt_bool_t rt_sched_edf_preempt(struct rt_thread *thread, struct rt_thread *next);
+#endif /* RT_USING_SCHED_EDF */
 
 /* thread status operation */
 rt_uint8_t rt_sched_thread_get_stat(struct rt_thread *thread);
@@ -168,6 +168,9 @@ rt_err_t rt_thread_yield(void);
 rt_err_t rt_thread_delay(rt_tick_t tick);
 rt_err_t rt_thread_delay_until(rt_tick_t *tick, rt_tick_t inc_tick);
 rt_err_t rt_thread_mdelay(rt_int32_t ms);
+#ifdef RT_USING_SCHED_EDF
+rt_err_t rt_thread_wait_next_period(void);
+#endif
 rt_err_t rt_thread_control(rt_thread_t thread, int cmd, void *arg);
 rt_err_t rt_thread_suspend(rt_thread_t thread);
 rt_err_t rt_thread_suspend_with_flag(rt_thread_t thread, int suspend_flag);
@@ -454,6 +457,57 @@ rt_inline rt_ubase_t rt_mutex_get_hold(rt_mutex_t mutex)
 
 #endif /* RT_USING_MUTEX */
 
+#ifdef RT_USING_RWLOCK
+/*
+ * reader-writer lock interface
+ */
+rt_err_t rt_rwlock_init(rt_rwlock_t rwlock, const char *name, rt_uint8_t flag);
+rt_err_t rt_rwlock_detach(rt_rwlock_t rwlock);
+#ifdef RT_USING_HEAP
+rt_rwlock_t rt_rwlock_create(const char *name, rt_uint8_t flag);
+rt_err_t rt_rwlock_delete(rt_rwlock_t rwlock);
+#endif /* RT_USING_HEAP */
+rt_err_t rt_rwlock_read_take(rt_rwlock_t rwlock, rt_int32_t timeout);
+rt_err_t rt_rwlock_read_release(rt_rwlock_t rwlock);
+rt_err_t rt_rwlock_write_take(rt_rwlock_t rwlock, rt_int32_t timeout);
+rt_err_t rt_rwlock_write_release(rt_rwlock_t rwlock);
+#endif /* RT_USING_RWLOCK */
+
+#ifdef RT_USING_FASTLOCK
+/*
+ * fast lock interface
+ */
+rt_err_t rt_fastlock_init(rt_fastlock_t lock, const char *name, rt_uint8_t flag);
+rt_err_t rt_fastlock_detach(rt_fastlock_t lock);
+#ifdef RT_USING_HEAP
+rt_fastlock_t rt_fastlock_create(const char *name, rt_uint8_t flag);
+rt_err_t rt_fastlock_delete(rt_fastlock_t lock);
+#endif /* RT_USING_HEAP */
+rt_err_t rt_fastlock_take(rt_fastlock_t lock, rt_int32_t timeout);
+rt_err_t rt_fastlock_trytake(rt_fastlock_t lock);
+rt_err_t rt_fastlock_release(rt_fastlock_t lock);
+#endif /* RT_USING_FASTLOCK */
+
+#ifdef RT_USING_RCU
+/*
+ * RCU interface, the readers run with the scheduler locked and must not sleep
+ */
+rt_inline void rt_rcu_read_lock(void)
+{
+    rt_enter_critical();
+}
+rt_inline void rt_rcu_read_unlock(void)
+{
+    rt_exit_critical();
+}
+void rt_rcu_quiescent_state(void);
+void rt_rcu_synchronize(void);
+
+/* publish and fetch a pointer of RCU protected structure */
+#define rt_rcu_assign_pointer(p, v) rt_atomic_store((rt_atomic_t *)&(p), (rt_base_t)(v))
+#define rt_rcu_dereference(p)       ((void *)rt_atomic_load((rt_atomic_t *)&(p)))
+#endif /* RT_USING_RCU */
+
 #ifdef RT_USING_EVENT
 /*
  * event interface
@@ -594,8 +648,27 @@ rt_ssize_t rt_mq_recv_prio(rt_mq_t mq,
                            rt_int32_t timeout,
                            int suspend_flag);
 #endif /* RT_USING_MESSAGEQUEUE_PRIORITY */
+
+#ifdef RT_USING_MESSAGEQUEUE_ZEROCOPY
+rt_err_t rt_mq_send_reserve(rt_mq_t mq, void **buffer, rt_int32_t timeout);
+rt_err_t rt_mq_send_commit(rt_mq_t mq, void *buffer, rt_size_t size);
+#ifdef RT_USING_MESSAGEQUEUE_PRIORITY
+rt_err_t rt_mq_send_commit_prio(rt_mq_t mq, void *buffer, rt_size_t size, rt_int32_t prio);
+#endif /* RT_USING_MESSAGEQUEUE_PRIORITY */
+rt_err_t rt_mq_urgent_commit(rt_mq_t mq, void *buffer, rt_size_t size);
+rt_err_t rt_mq_send_cancel(rt_mq_t mq, void *buffer);
+rt_ssize_t rt_mq_recv_borrow(rt_mq_t mq, void **buffer, rt_int32_t timeout);
+rt_err_t rt_mq_recv_release(rt_mq_t mq, void *buffer);
+#endif /* RT_USING_MESSAGEQUEUE_ZEROCOPY */
 #endif /* RT_USING_MESSAGEQUEUE */
 
+#ifdef RT_USING_IPC_WAIT_ANY
+/*
+ * multi-object wait interface
+ */
+rt_ssize_t rt_wait_any(struct rt_wait_any_item *items, rt_size_t count, rt_int32_t timeout);
+#endif /* RT_USING_IPC_WAIT_ANY */
+
 /* defunct */
 void rt_thread_defunct_enqueue(rt_thread_t thread);
 rt_thread_t rt_thread_defunct_dequeue(void);
@@ -611,6 +684,15 @@ void rt_spin_lock(struct rt_spinlock *lock);
 void rt_spin_unlock(struct rt_spinlock *lock);
 rt_base_t rt_spin_lock_irqsave(struct rt_spinlock *lock);
 void rt_spin_unlock_irqrestore(struct rt_spinlock *lock, rt_base_t level);
+#ifdef RT_USING_SPINLOCK_TICKET
+void rt_spin_lock_init_ticket(struct rt_spinlock *lock);
+#endif /* RT_USING_SPINLOCK_TICKET */
+#ifdef RT_USING_LOCKSTAT
+void rt_spin_lock_set_class(struct rt_spinlock *lock, struct rt_lockstat_class *lclass);
+rt_uint64_t rt_lockstat_clock(void);
+void rt_lockstat_dump(void);
+void rt_lockstat_reset(void);
+#endif /* RT_USING_LOCKSTAT */
 #else
 
 rt_inline void rt_spin_lock_init(struct rt_spinlock *lock)
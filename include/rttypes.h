@@ -123,9 +123,40 @@ typedef struct rt_slist_node rt_slist_t;                /**< Type for single lis
 #ifdef RT_USING_SMP
 #include <cpuport.h> /* for spinlock from arch */
 
+#ifdef RT_USING_LOCKSTAT
+/**
+ * Contention statistics shared by the spinlocks of a class
+ */
+struct rt_lockstat_class
+{
+    const char *name;
+    rt_slist_t node;                                    /**< node in the list of classes */
+    rt_atomic_t registered;
+    rt_atomic_t acquired;                               /**< times of acquisition */
+    rt_atomic_t contended;                              /**< times of waiting for others */
+    rt_atomic_t wait_total;                             /**< in rt_lockstat_clock() unit */
+    rt_atomic_t wait_max;
+    rt_atomic_t hold_total;
+    rt_atomic_t hold_max;
+};
+
+#define RT_LOCKSTAT_CLASS_INIT(name) {name}
+#define RT_DEFINE_LOCKSTAT_CLASS(x) struct rt_lockstat_class x = RT_LOCKSTAT_CLASS_INIT(#x)
+#endif /* RT_USING_LOCKSTAT */
+
 struct rt_spinlock
 {
     rt_hw_spinlock_t lock;
+#ifdef RT_USING_SPINLOCK_TICKET
+    rt_atomic_t ticket_next;                            /**< next ticket to hand out */
+    rt_atomic_t ticket_owner;                           /**< ticket being served */
+    rt_uint8_t queued;                                  /**< use ticket instead of arch lock */
+#endif /* RT_USING_SPINLOCK_TICKET */
+#ifdef RT_USING_LOCKSTAT
+    struct rt_lockstat_class *lclass;
+    rt_atomic_t users;                                  /**< holder and waiters */
+    rt_uint64_t acquire_time;
+#endif /* RT_USING_LOCKSTAT */
 #ifdef RT_USING_DEBUG
     rt_uint32_t critical_level;
 #endif /* RT_USING_DEBUG */
@@ -9,6 +9,7 @@
  * 2023-09-15     xqyjlj       perf rt_hw_interrupt_disable/enable
  * 2023-12-10     xqyjlj       spinlock should lock sched
  * 2024-01-25     Shell        Using rt_exit_critical_safe
+ * 2026-10-19     agent        add ticket spinlocks and lock statistics
  */
 #include <rthw.h>
 #include <rtthread.h>
@@ -30,6 +31,225 @@ void *_cpus_lock_pc = 0;
 
 #endif /* RT_DEBUGING_SPINLOCK */
 
+#ifdef RT_USING_SPINLOCK_TICKET
+static void _ticket_lock(struct rt_spinlock *lock)
+{
+    rt_ubase_t ticket, owner;
+    volatile rt_ubase_t backoff;
+
+    ticket = rt_atomic_add(&lock->ticket_next, 1);
+    while ((owner = rt_atomic_load(&lock->ticket_owner)) != ticket)
+    {
+        /* the farther from the holder, the longer before polling again */
+        for (backoff = (ticket - owner) * RT_SPINLOCK_BACKOFF_UNIT; backoff; backoff--)
+        {
+        }
+    }
+}
+
+static void _ticket_unlock(struct rt_spinlock *lock)
+{
+    rt_atomic_add(&lock->ticket_owner, 1);
+}
+#endif /* RT_USING_SPINLOCK_TICKET */
+
+rt_inline void _spin_lock_raw(struct rt_spinlock *lock)
+{
+#ifdef RT_USING_SPINLOCK_TICKET
+    if (lock->queued)
+    {
+        _ticket_lock(lock);
+        return;
+    }
+#endif /* RT_USING_SPINLOCK_TICKET */
+    rt_hw_spin_lock(&lock->lock);
+}
+
+rt_inline void _spin_unlock_raw(struct rt_spinlock *lock)
+{
+#ifdef RT_USING_SPINLOCK_TICKET
+    if (lock->queued)
+    {
+        _ticket_unlock(lock);
+        return;
+    }
+#endif /* RT_USING_SPINLOCK_TICKET */
+    rt_hw_spin_unlock(&lock->lock);
+}
+
+#ifdef RT_USING_LOCKSTAT
+static rt_slist_t _lockstat_classes = RT_SLIST_OBJECT_INIT(_lockstat_classes);
+static RT_DEFINE_SPINLOCK(_lockstat_classes_lock);
+
+/**
+ * @brief   The clock to measure the hold and wait time of spinlocks. The tick
+ *          is used by default, a BSP should provide a finer one.
+ *
+ * @return  Return current time.
+ */
+rt_weak rt_uint64_t rt_lockstat_clock(void)
+{
+    return rt_tick_get();
+}
+
+static void _lockstat_update_max(rt_atomic_t *max, rt_ubase_t value)
+{
+    rt_atomic_t old = rt_atomic_load(max);
+
+    while (value > (rt_ubase_t)old && !rt_atomic_compare_exchange_strong(max, &old, value))
+    {
+    }
+}
+
+static void _spin_lock_acquire(struct rt_spinlock *lock)
+{
+    struct rt_lockstat_class *lclass = lock->lclass;
+    rt_uint64_t start, now;
+
+    if (lclass == RT_NULL)
+    {
+        _spin_lock_raw(lock);
+        return;
+    }
+
+    /* someone is holding or waiting, the clock is only read on contention */
+    if (rt_atomic_add(&lock->users, 1) != 0)
+    {
+        start = rt_lockstat_clock();
+        _spin_lock_raw(lock);
+        now = rt_lockstat_clock();
+
+        rt_atomic_add(&lclass->contended, 1);
+        rt_atomic_add(&lclass->wait_total, (rt_ubase_t)(now - start));
+        _lockstat_update_max(&lclass->wait_max, (rt_ubase_t)(now - start));
+    }
+    else
+    {
+        _spin_lock_raw(lock);
+        now = rt_lockstat_clock();
+    }
+
+    rt_atomic_add(&lclass->acquired, 1);
+    lock->acquire_time = now;
+}
+
+static void _spin_lock_release(struct rt_spinlock *lock)
+{
+    struct rt_lockstat_class *lclass = lock->lclass;
+    rt_ubase_t hold;
+
+    if (lclass == RT_NULL)
+    {
+        _spin_unlock_raw(lock);
+        return;
+    }
+
+    hold = (rt_ubase_t)(rt_lockstat_clock() - lock->acquire_time);
+    rt_atomic_add(&lclass->hold_total, hold);
+    _lockstat_update_max(&lclass->hold_max, hold);
+
+    _spin_unlock_raw(lock);
+    rt_atomic_sub(&lock->users, 1);
+}
+
+/**
+ * @brief   Account a spinlock to a statistics class. It must be called before
+ *          the spinlock is used.
+ *
+ * @param   lock is a pointer to the spinlock.
+ *
+ * @param   lclass is the class, or RT_NULL to stop the accounting.
+ */
+void rt_spin_lock_set_class(struct rt_spinlock *lock, struct rt_lockstat_class *lclass)
+{
+    rt_atomic_t registered = 0;
+
+    if (lclass && rt_atomic_compare_exchange_strong(&lclass->registered, &registered, 1))
+    {
+        rt_spin_lock(&_lockstat_classes_lock);
+        rt_slist_append(&_lockstat_classes, &lclass->node);
+        rt_spin_unlock(&_lockstat_classes_lock);
+    }
+
+    lock->users = 0;
+    lock->lclass = lclass;
+}
+RTM_EXPORT(rt_spin_lock_set_class)
+
+/**
+ * @brief   Print the statistics of all the classes.
+ */
+void rt_lockstat_dump(void)
+{
+    rt_slist_t *node;
+    struct rt_lockstat_class *lclass;
+
+    rt_kprintf("%-16s %10s %10s %10s %10s %10s %10s\n",
+               "class", "acquired", "contended", "wait-total", "wait-max", "hold-total", "hold-max");
+
+    rt_spin_lock(&_lockstat_classes_lock);
+    rt_slist_for_each(node, &_lockstat_classes)
+    {
+        lclass = rt_slist_entry(node, struct rt_lockstat_class, node);
+        rt_kprintf("%-16.16s %10lu %10lu %10lu %10lu %10lu %10lu\n", lclass->name,
+                   (unsigned long)rt_atomic_load(&lclass->acquired),
+                   (unsigned long)rt_atomic_load(&lclass->contended),
+                   (unsigned long)rt_atomic_load(&lclass->wait_total),
+                   (unsigned long)rt_atomic_load(&lclass->wait_max),
+                   (unsigned long)rt_atomic_load(&lclass->hold_total),
+                   (unsigned long)rt_atomic_load(&lclass->hold_max));
+    }
+    rt_spin_unlock(&_lockstat_classes_lock);
+}
+RTM_EXPORT(rt_lockstat_dump)
+
+/**
+ * @brief   Clear the statistics of all the classes.
+ */
+void rt_lockstat_reset(void)
+{
+    rt_slist_t *node;
+    struct rt_lockstat_class *lclass;
+
+    rt_spin_lock(&_lockstat_classes_lock);
+    rt_slist_for_each(node, &_lockstat_classes)
+    {
+        lclass = rt_slist_entry(node, struct rt_lockstat_class, node);
+        rt_atomic_store(&lclass->acquired, 0);
+        rt_atomic_store(&lclass->contended, 0);
+        rt_atomic_store(&lclass->wait_total, 0);
+        rt_atomic_store(&lclass->wait_max, 0);
+        rt_atomic_store(&lclass->hold_total, 0);
+        rt_atomic_store(&lclass->hold_max, 0);
+    }
+    rt_spin_unlock(&_lockstat_classes_lock);
+}
+RTM_EXPORT(rt_lockstat_reset)
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static int list_lockstat(int argc, char *argv[])
+{
+    if (argc > 1 && rt_strcmp(argv[1], "-r") == 0)
+    {
+        rt_lockstat_reset();
+    }
+    else
+    {
+        rt_lockstat_dump();
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(list_lockstat, dump spinlock statistics or reset them with -r);
+#endif /* RT_USING_FINSH */
+
+#else
+#define _spin_lock_acquire(lock) _spin_lock_raw(lock)
+#define _spin_lock_release(lock) _spin_unlock_raw(lock)
+#endif /* RT_USING_LOCKSTAT */
+
 /**
  * @brief   Initialize a static spinlock object.
  *
@@ -38,9 +258,36 @@ void *_cpus_lock_pc = 0;
 void rt_spin_lock_init(struct rt_spinlock *lock)
 {
     rt_hw_spin_lock_init(&lock->lock);
+#ifdef RT_USING_SPINLOCK_TICKET
+    lock->ticket_next = 0;
+    lock->ticket_owner = 0;
+#ifdef RT_SPINLOCK_TICKET_BY_DEFAULT
+    lock->queued = 1;
+#else
+    lock->queued = 0;
+#endif /* RT_SPINLOCK_TICKET_BY_DEFAULT */
+#endif /* RT_USING_SPINLOCK_TICKET */
+#ifdef RT_USING_LOCKSTAT
+    lock->lclass = RT_NULL;
+    lock->users = 0;
+#endif /* RT_USING_LOCKSTAT */
 }
 RTM_EXPORT(rt_spin_lock_init)
 
+#ifdef RT_USING_SPINLOCK_TICKET
+/**
+ * @brief   Initialize a spinlock granted in FIFO order to the waiters.
+ *
+ * @param   lock is a pointer to the spinlock to initialize.
+ */
+void rt_spin_lock_init_ticket(struct rt_spinlock *lock)
+{
+    rt_spin_lock_init(lock);
+    lock->queued = 1;
+}
+RTM_EXPORT(rt_spin_lock_init_ticket)
+#endif /* RT_USING_SPINLOCK_TICKET */
+
 /**
  * @brief   This function will lock the spinlock, will lock the thread scheduler.
  *
@@ -52,7 +299,7 @@ RTM_EXPORT(rt_spin_lock_init)
 void rt_spin_lock(struct rt_spinlock *lock)
 {
     rt_enter_critical();
-    rt_hw_spin_lock(&lock->lock);
+    _spin_lock_acquire(lock);
     RT_SPIN_LOCK_DEBUG(lock);
 }
 RTM_EXPORT(rt_spin_lock)
@@ -66,7 +313,7 @@ void rt_spin_unlock(struct rt_spinlock *lock)
 {
     rt_base_t critical_level;
     RT_SPIN_UNLOCK_DEBUG(lock, critical_level);
-    rt_hw_spin_unlock(&lock->lock);
+    _spin_lock_release(lock);
     rt_exit_critical_safe(critical_level);
 }
 RTM_EXPORT(rt_spin_unlock)
@@ -87,7 +334,7 @@ rt_base_t rt_spin_lock_irqsave(struct rt_spinlock *lock)
 
     level = rt_hw_local_irq_disable();
     rt_enter_critical();
-    rt_hw_spin_lock(&lock->lock);
+    _spin_lock_acquire(lock);
     RT_SPIN_LOCK_DEBUG(lock);
     return level;
 }
@@ -105,7 +352,7 @@ void rt_spin_unlock_irqrestore(struct rt_spinlock *lock, rt_base_t level)
     rt_base_t critical_level;
 
     RT_SPIN_UNLOCK_DEBUG(lock, critical_level);
-    rt_hw_spin_unlock(&lock->lock);
+    _spin_lock_release(lock);
     rt_hw_local_irq_enable(level);
     rt_exit_critical_safe(critical_level);
 }
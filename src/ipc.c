@@ -46,6 +46,11 @@
  * 2022-10-16     Bernard      add prioceiling feature in mutex
  * 2023-04-16     Xin-zheqi    redesigen queue recv and send function return real message size
  * 2023-09-15     xqyjlj       perf rt_hw_interrupt_disable/enable
+ * 2026-10-19     agent        spin on a running mutex owner before sleeping
+ * 2026-10-19     agent        add reader-writer lock and RCU
+ * 2026-10-19     agent        add zero-copy message queue reserve/commit and borrow/release
+ * 2026-10-19     agent        add fast lock
+ * 2026-10-19     agent        add rt_wait_any() to wait on several IPC objects
  */
 
 #include <rtthread.h>
@@ -83,10 +88,61 @@ rt_inline rt_err_t _ipc_object_init(struct rt_ipc_object *ipc)
 {
     /* initialize ipc object */
     rt_list_init(&(ipc->suspend_thread));
+#ifdef RT_USING_IPC_WAIT_ANY
+    rt_list_init(&(ipc->wait_any_list));
+#endif /* RT_USING_IPC_WAIT_ANY */
 
     return RT_EOK;
 }
 
+#ifdef RT_USING_IPC_WAIT_ANY
+/* the context of a thread waiting in rt_wait_any() */
+struct rt_wait_any
+{
+    struct rt_spinlock          spinlock;
+    rt_list_t                   susp_list;              /**< the waiting thread */
+    struct rt_wait_any_item    *fired;                  /**< the first item became ready */
+};
+
+/**
+ * @brief    This function will wake up the threads waiting for an IPC object in rt_wait_any(),
+ *           it's called with the spinlock of the object held when the object becomes ready.
+ *
+ * @param    ipc is a pointer to the IPC object.
+ *
+ * @param    set is the event set of an event object, it's ignored by other objects.
+ *
+ * @return   Return RT_TRUE if any thread is resumed.
+ */
+static rt_bool_t _ipc_wait_any_notify(struct rt_ipc_object *ipc, rt_uint32_t set)
+{
+    struct rt_list_node *node;
+    struct rt_wait_any_item *item;
+    rt_bool_t woken = RT_FALSE;
+
+    rt_list_for_each(node, &(ipc->wait_any_list))
+    {
+        item = rt_list_entry(node, struct rt_wait_any_item, node);
+
+        if (rt_object_get_type(&(ipc->parent)) == RT_Object_Class_Event && !(item->set & set))
+            continue;
+
+        rt_spin_lock(&(item->wait->spinlock));
+        if (item->wait->fired == RT_NULL)
+        {
+            item->wait->fired = item;
+            if (rt_susp_list_dequeue(&(item->wait->susp_list), RT_EOK) != RT_NULL)
+                woken = RT_TRUE;
+        }
+        rt_spin_unlock(&(item->wait->spinlock));
+    }
+
+    return woken;
+}
+#else
+#define _ipc_wait_any_notify(ipc, set)  RT_FALSE
+#endif /* RT_USING_IPC_WAIT_ANY */
+
 
 /**
  * @brief   Dequeue a thread from suspended list and set it to ready. The 2 are
@@ -729,6 +785,8 @@ rt_err_t rt_sem_release(rt_sem_t sem)
             rt_spin_unlock_irqrestore(&(sem->spinlock), level);
             return -RT_EFULL; /* value overflowed */
         }
+
+        need_schedule = _ipc_wait_any_notify(&(sem->parent), 0);
     }
 
     rt_spin_unlock_irqrestore(&(sem->spinlock), level);
@@ -1298,6 +1356,51 @@ RTM_EXPORT(rt_mutex_delete);
 #endif /* RT_USING_HEAP */
 
 
+#ifdef RT_MUTEX_USING_ADAPTIVE_SPIN
+#define _MUTEX_SPIN_BACKOFF_MAX 64
+
+/**
+ * @brief    Spin while the owner of the mutex keeps running on other core, since it is
+ *           likely to release the mutex soon and the sleeping costs two context switches.
+ *           It gives up if the owner is preempted or blocked, if other threads are
+ *           already waiting, or after RT_MUTEX_SPIN_LIMIT polls.
+ *
+ * @note     The spinlock of mutex is held on entry and on exit, it is released while spinning.
+ *
+ * @param    mutex is a pointer to a mutex object.
+ */
+static void _mutex_spin_on_owner(rt_mutex_t mutex)
+{
+    struct rt_thread *owner;
+    rt_uint32_t polls, backoff = 1;
+    volatile rt_uint32_t delay;
+
+    for (polls = 0; polls < RT_MUTEX_SPIN_LIMIT; polls++)
+    {
+        owner = mutex->owner;
+        if (owner == RT_NULL)
+            break;
+
+        /* no synchronization needed, a stale state only ends the spinning earlier or later */
+        if (RT_SCHED_CTX(owner).oncpu == RT_CPU_DETACHED ||
+            (RT_SCHED_CTX(owner).stat & RT_THREAD_STAT_MASK) != RT_THREAD_RUNNING)
+            break;
+
+        /* do not jump the queue of the sleeping waiters */
+        if (!rt_list_isempty(&mutex->parent.suspend_thread))
+            break;
+
+        rt_spin_unlock(&(mutex->spinlock));
+        for (delay = backoff; delay; delay--)
+        {
+        }
+        if (backoff < _MUTEX_SPIN_BACKOFF_MAX)
+            backoff <<= 1;
+        rt_spin_lock(&(mutex->spinlock));
+    }
+}
+#endif /* RT_MUTEX_USING_ADAPTIVE_SPIN */
+
 /**
  * @brief    This function will take a mutex, if the mutex is unavailable, the thread shall wait for
  *           the mutex up to a specified time.
@@ -1362,6 +1465,14 @@ static rt_err_t _rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout, int suspend
     }
     else
     {
+#ifdef RT_MUTEX_USING_ADAPTIVE_SPIN
+        /* the owner running on other core may release it shortly */
+        if (mutex->owner != RT_NULL && timeout != 0)
+        {
+            _mutex_spin_on_owner(mutex);
+        }
+#endif /* RT_MUTEX_USING_ADAPTIVE_SPIN */
+
         /* whether the mutex has owner thread. */
         if (mutex->owner == RT_NULL)
         {
@@ -1735,249 +1846,995 @@ RTM_EXPORT(rt_mutex_control);
 /**@}*/
 #endif /* RT_USING_MUTEX */
 
-#ifdef RT_USING_EVENT
-/**
- * @addtogroup event
- * @{
- */
+#ifdef RT_USING_RWLOCK
+static void _rwlock_object_init(rt_rwlock_t rwlock, rt_uint8_t flag)
+{
+    rt_spin_lock_init(&(rwlock->spinlock));
+    rwlock->readers = 0;
+    rwlock->writers_waiting = 0;
+    rwlock->writer = RT_NULL;
+    rt_list_init(&(rwlock->reader_list));
+    rt_list_init(&(rwlock->writer_list));
+
+    /* the queuing way of the suspended readers and writers */
+    rwlock->parent.flag = flag;
+}
+
+static void _rwlock_before_delete_detach(rt_rwlock_t rwlock)
+{
+    rt_base_t level;
+
+    level = rt_spin_lock_irqsave(&(rwlock->spinlock));
+    /* wakeup all suspended threads */
+    rt_susp_list_resume_all(&(rwlock->reader_list), RT_ERROR);
+    rt_susp_list_resume_all(&(rwlock->writer_list), RT_ERROR);
+    rt_spin_unlock_irqrestore(&(rwlock->spinlock), level);
+}
 
 /**
- * @brief    The function will initialize a static event object.
- *
- * @note     For the static event object, its memory space is allocated by the compiler during compiling,
- *           and shall placed on the read-write data segment or on the uninitialized data segment.
- *           By contrast, the rt_event_create() function will allocate memory space automatically
- *           and initialize the event.
- *
- * @see      rt_event_create()
- *
- * @param    event is a pointer to the event to initialize. It is assumed that storage for the event
- *           will be allocated in your application.
+ * @brief    This function will initialize a static reader-writer lock object. The writers are
+ *           preferred: once a writer is waiting, the new readers wait behind it.
  *
- * @param    name is a pointer to the name that given to the event.
- *
- * @param    flag is the event flag, which determines the queuing way of how multiple threads wait
- *           when the event is not available.
- *           The event flag can be ONE of the following values:
+ * @see      rt_rwlock_create()
  *
- *               RT_IPC_FLAG_PRIO          The pending threads will queue in order of priority.
+ * @param    rwlock is a pointer to the reader-writer lock to initialize.
  *
- *               RT_IPC_FLAG_FIFO          The pending threads will queue in the first-in-first-out method
- *                                         (also known as first-come-first-served (FCFS) scheduling strategy).
+ * @param    name is a pointer to the name that given to the reader-writer lock.
  *
- *               NOTE: RT_IPC_FLAG_FIFO is a non-real-time scheduling mode. It is strongly recommended to
- *               use RT_IPC_FLAG_PRIO to ensure the thread is real-time UNLESS your applications concern about
- *               the first-in-first-out principle, and you clearly understand that all threads involved in
- *               this event will become non-real-time threads.
+ * @param    flag is the queuing way of the waiting readers and writers, which can be
+ *           RT_IPC_FLAG_FIFO or RT_IPC_FLAG_PRIO.
  *
  * @return   Return the operation status. When the return value is RT_EOK, the initialization is successful.
- *           If the return value is any other values, it represents the initialization failed.
- *
- * @warning  This function can ONLY be called from threads.
  */
-rt_err_t rt_event_init(rt_event_t event, const char *name, rt_uint8_t flag)
+rt_err_t rt_rwlock_init(rt_rwlock_t rwlock, const char *name, rt_uint8_t flag)
 {
     /* parameter check */
-    RT_ASSERT(event != RT_NULL);
+    RT_ASSERT(rwlock != RT_NULL);
     RT_ASSERT((flag == RT_IPC_FLAG_FIFO) || (flag == RT_IPC_FLAG_PRIO));
 
     /* initialize object */
-    rt_object_init(&(event->parent.parent), RT_Object_Class_Event, name);
-
-    /* set parent flag */
-    event->parent.parent.flag = flag;
-
-    /* initialize ipc object */
-    _ipc_object_init(&(event->parent));
+    rt_object_init(&(rwlock->parent), RT_Object_Class_RWLock, name);
 
-    /* initialize event */
-    event->set = 0;
-    rt_spin_lock_init(&(event->spinlock));
+    _rwlock_object_init(rwlock, flag);
 
     return RT_EOK;
 }
-RTM_EXPORT(rt_event_init);
-
+RTM_EXPORT(rt_rwlock_init);
 
 /**
- * @brief    This function will detach a static event object.
- *
- * @note     This function is used to detach a static event object which is initialized by rt_event_init() function.
- *           By contrast, the rt_event_delete() function will delete an event object.
- *           When the event is successfully detached, it will resume all suspended threads in the event list.
- *
- * @see      rt_event_delete()
+ * @brief    This function will detach a static reader-writer lock object initialized by
+ *           rt_rwlock_init(), all the waiting threads are resumed with -RT_ERROR.
  *
- * @param    event is a pointer to an event object to be detached.
+ * @see      rt_rwlock_delete()
  *
- * @return   Return the operation status. When the return value is RT_EOK, the initialization is successful.
- *           If the return value is any other values, it means that the event detach failed.
+ * @param    rwlock is a pointer to the reader-writer lock.
  *
- * @warning  This function can ONLY detach a static event initialized by the rt_event_init() function.
- *           If the event is created by the rt_event_create() function, you MUST NOT USE this function to detach it,
- *           ONLY USE the rt_event_delete() function to complete the deletion.
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
  */
-rt_err_t rt_event_detach(rt_event_t event)
+rt_err_t rt_rwlock_detach(rt_rwlock_t rwlock)
 {
-    rt_base_t level;
-
     /* parameter check */
-    RT_ASSERT(event != RT_NULL);
-    RT_ASSERT(rt_object_get_type(&event->parent.parent) == RT_Object_Class_Event);
-    RT_ASSERT(rt_object_is_systemobject(&event->parent.parent));
+    RT_ASSERT(rwlock != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&rwlock->parent) == RT_Object_Class_RWLock);
+    RT_ASSERT(rt_object_is_systemobject(&rwlock->parent));
 
-    level = rt_spin_lock_irqsave(&(event->spinlock));
-    /* resume all suspended thread */
-    rt_susp_list_resume_all(&(event->parent.suspend_thread), RT_ERROR);
-    rt_spin_unlock_irqrestore(&(event->spinlock), level);
+    _rwlock_before_delete_detach(rwlock);
 
-    /* detach event object */
-    rt_object_detach(&(event->parent.parent));
+    /* detach reader-writer lock object */
+    rt_object_detach(&(rwlock->parent));
 
     return RT_EOK;
 }
-RTM_EXPORT(rt_event_detach);
+RTM_EXPORT(rt_rwlock_detach);
 
 #ifdef RT_USING_HEAP
 /**
- * @brief    Creating an event object.
- *
- * @note     For the event object, its memory space is allocated automatically.
- *           By contrast, the rt_event_init() function will initialize a static event object.
- *
- * @see      rt_event_init()
- *
- * @param    name is a pointer to the name that given to the event.
+ * @brief    This function will create a reader-writer lock object.
  *
- * @param    flag is the event flag, which determines the queuing way of how multiple threads wait when the event
- *           is not available.
- *           The event flag can be ONE of the following values:
- *
- *               RT_IPC_FLAG_PRIO          The pending threads will queue in order of priority.
+ * @see      rt_rwlock_init()
  *
- *               RT_IPC_FLAG_FIFO          The pending threads will queue in the first-in-first-out method
- *                                         (also known as first-come-first-served (FCFS) scheduling strategy).
+ * @param    name is a pointer to the name that given to the reader-writer lock.
  *
- *               NOTE: RT_IPC_FLAG_FIFO is a non-real-time scheduling mode. It is strongly recommended to
- *               use RT_IPC_FLAG_PRIO to ensure the thread is real-time UNLESS your applications concern about
- *               the first-in-first-out principle, and you clearly understand that all threads involved in
- *               this event will become non-real-time threads.
+ * @param    flag is the queuing way of the waiting readers and writers, which can be
+ *           RT_IPC_FLAG_FIFO or RT_IPC_FLAG_PRIO.
  *
- * @return   Return a pointer to the event object. When the return value is RT_NULL, it means the creation failed.
+ * @return   Return a pointer to the reader-writer lock object. When the return value is RT_NULL,
+ *           it means the creation failed.
  *
  * @warning  This function can ONLY be called from threads.
  */
-rt_event_t rt_event_create(const char *name, rt_uint8_t flag)
+rt_rwlock_t rt_rwlock_create(const char *name, rt_uint8_t flag)
 {
-    rt_event_t event;
+    struct rt_rwlock *rwlock;
 
     RT_ASSERT((flag == RT_IPC_FLAG_FIFO) || (flag == RT_IPC_FLAG_PRIO));
 
     RT_DEBUG_NOT_IN_INTERRUPT;
 
     /* allocate object */
-    event = (rt_event_t)rt_object_allocate(RT_Object_Class_Event, name);
-    if (event == RT_NULL)
-        return event;
-
-    /* set parent */
-    event->parent.parent.flag = flag;
+    rwlock = (rt_rwlock_t)rt_object_allocate(RT_Object_Class_RWLock, name);
+    if (rwlock == RT_NULL)
+        return rwlock;
 
-    /* initialize ipc object */
-    _ipc_object_init(&(event->parent));
-
-    /* initialize event */
-    event->set = 0;
-    rt_spin_lock_init(&(event->spinlock));
+    _rwlock_object_init(rwlock, flag);
 
-    return event;
+    return rwlock;
 }
-RTM_EXPORT(rt_event_create);
-
+RTM_EXPORT(rt_rwlock_create);
 
 /**
- * @brief    This function will delete an event object and release the memory space.
- *
- * @note     This function is used to delete an event object which is created by the rt_event_create() function.
- *           By contrast, the rt_event_detach() function will detach a static event object.
- *           When the event is successfully deleted, it will resume all suspended threads in the event list.
+ * @brief    This function will delete a reader-writer lock object created by rt_rwlock_create(),
+ *           all the waiting threads are resumed with -RT_ERROR.
  *
- * @see      rt_event_detach()
+ * @see      rt_rwlock_detach()
  *
- * @param    event is a pointer to an event object to be deleted.
+ * @param    rwlock is a pointer to the reader-writer lock.
  *
  * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
- *           If the return value is any other values, it means that the event detach failed.
- *
- * @warning  This function can ONLY delete an event initialized by the rt_event_create() function.
- *           If the event is initialized by the rt_event_init() function, you MUST NOT USE this function to delete it,
- *           ONLY USE the rt_event_detach() function to complete the detachment.
  */
-rt_err_t rt_event_delete(rt_event_t event)
+rt_err_t rt_rwlock_delete(rt_rwlock_t rwlock)
 {
     /* parameter check */
-    RT_ASSERT(event != RT_NULL);
-    RT_ASSERT(rt_object_get_type(&event->parent.parent) == RT_Object_Class_Event);
-    RT_ASSERT(rt_object_is_systemobject(&event->parent.parent) == RT_FALSE);
+    RT_ASSERT(rwlock != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&rwlock->parent) == RT_Object_Class_RWLock);
+    RT_ASSERT(rt_object_is_systemobject(&rwlock->parent) == RT_FALSE);
 
     RT_DEBUG_NOT_IN_INTERRUPT;
 
-    rt_spin_lock(&(event->spinlock));
-    /* resume all suspended thread */
-    rt_susp_list_resume_all(&(event->parent.suspend_thread), RT_ERROR);
-    rt_spin_unlock(&(event->spinlock));
+    _rwlock_before_delete_detach(rwlock);
 
-    /* delete event object */
-    rt_object_delete(&(event->parent.parent));
+    /* delete reader-writer lock object */
+    rt_object_delete(&(rwlock->parent));
 
     return RT_EOK;
 }
-RTM_EXPORT(rt_event_delete);
+RTM_EXPORT(rt_rwlock_delete);
 #endif /* RT_USING_HEAP */
 
+/* suspend on the list, the spinlock of rwlock is held on entry and released on return */
+static rt_err_t _rwlock_wait(rt_rwlock_t rwlock, rt_list_t *list, rt_int32_t timeout, rt_base_t level)
+{
+    rt_err_t ret;
+    struct rt_thread *thread = rt_thread_self();
+
+    thread->error = RT_EOK;
+
+    ret = rt_thread_suspend_to_list(thread, list, rwlock->parent.flag, RT_UNINTERRUPTIBLE);
+    if (ret != RT_EOK)
+    {
+        rt_spin_unlock_irqrestore(&(rwlock->spinlock), level);
+        return ret;
+    }
+
+    if (timeout > 0)
+    {
+        rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, &timeout);
+        rt_timer_start(&(thread->thread_timer));
+    }
+
+    rt_spin_unlock_irqrestore(&(rwlock->spinlock), level);
+
+    rt_schedule();
+
+    /* the lock has been handed over by the releasing thread if no error */
+    ret = thread->error;
+    return ret > 0 ? -ret : ret;
+}
+
+/* admit all the waiting readers, the spinlock of rwlock must be held */
+static rt_bool_t _rwlock_wake_readers(rt_rwlock_t rwlock)
+{
+    rt_bool_t woken = RT_FALSE;
+
+    while (rt_susp_list_dequeue(&(rwlock->reader_list), RT_EOK) != RT_NULL)
+    {
+        rwlock->readers++;
+        woken = RT_TRUE;
+    }
+
+    return woken;
+}
+
+/* hand the lock over to the first waiting writer, the spinlock of rwlock must be held */
+static rt_bool_t _rwlock_wake_writer(rt_rwlock_t rwlock)
+{
+    struct rt_thread *thread;
+
+    if (rwlock->writers_waiting == 0)
+        return RT_FALSE;
+
+    thread = rt_susp_list_dequeue(&(rwlock->writer_list), RT_EOK);
+    if (thread == RT_NULL)
+        return RT_FALSE;
+
+    rwlock->writers_waiting--;
+    rwlock->readers = -1;
+    rwlock->writer = thread;
+
+    return RT_TRUE;
+}
 
 /**
- * @brief    This function will send an event to the event object.
- *           If there is a thread suspended on the event, the thread will be resumed.
+ * @brief    This function will take a reader-writer lock for reading. Many readers can hold it
+ *           together, while it is not held or waited by a writer.
  *
- * @note     When using this function, you need to use the parameter (set) to specify the event flag of the event object,
- *           then the function will traverse the list of suspended threads waiting on the event object.
- *           If there is a thread suspended on the event, and the thread's event_info and the event flag of
- *           the current event object matches, the thread will be resumed.
+ * @param    rwlock is a pointer to the reader-writer lock.
  *
- * @param    event is a pointer to the event object to be sent.
+ * @param    timeout is a timeout period (unit: an OS tick).
  *
- * @param    set is a flag that you will set for this event's flag.
- *           You can set an event flag, or you can set multiple flags through OR logic operation.
+ * @return   Return the operation status. ONLY When the return value is RT_EOK, the operation is successful.
  *
- * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
- *           If the return value is any other values, it means that the event detach failed.
+ * @warning  This function can ONLY be called in the thread context.
  */
-rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set)
+rt_err_t rt_rwlock_read_take(rt_rwlock_t rwlock, rt_int32_t timeout)
 {
-    struct rt_list_node *n;
-    struct rt_thread *thread;
-    rt_sched_lock_level_t slvl;
     rt_base_t level;
-    rt_base_t status;
-    rt_bool_t need_schedule;
-    rt_uint32_t need_clear_set = 0;
-
-    /* parameter check */
-    RT_ASSERT(event != RT_NULL);
-    RT_ASSERT(rt_object_get_type(&event->parent.parent) == RT_Object_Class_Event);
 
-    if (set == 0)
-        return -RT_ERROR;
+    RT_ASSERT(rwlock != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&rwlock->parent) == RT_Object_Class_RWLock);
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
 
-    need_schedule = RT_FALSE;
+    level = rt_spin_lock_irqsave(&(rwlock->spinlock));
 
-    level = rt_spin_lock_irqsave(&(event->spinlock));
+    if (rwlock->readers >= 0 && rwlock->writers_waiting == 0)
+    {
+        rwlock->readers++;
+        rt_spin_unlock_irqrestore(&(rwlock->spinlock), level);
+        return RT_EOK;
+    }
 
-    /* set event */
-    event->set |= set;
+    if (timeout == 0)
+    {
+        rt_spin_unlock_irqrestore(&(rwlock->spinlock), level);
+        return -RT_ETIMEOUT;
+    }
 
-    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(event->parent.parent)));
+    /* the releasing writer counts us in the readers */
+    return _rwlock_wait(rwlock, &(rwlock->reader_list), timeout, level);
+}
+RTM_EXPORT(rt_rwlock_read_take);
+
+/**
+ * @brief    This function will release a reader-writer lock taken for reading.
+ *
+ * @param    rwlock is a pointer to the reader-writer lock.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ */
+rt_err_t rt_rwlock_read_release(rt_rwlock_t rwlock)
+{
+    rt_base_t level;
+    rt_bool_t need_schedule = RT_FALSE;
+
+    RT_ASSERT(rwlock != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&rwlock->parent) == RT_Object_Class_RWLock);
+
+    level = rt_spin_lock_irqsave(&(rwlock->spinlock));
+
+    if (rwlock->readers <= 0)
+    {
+        rt_spin_unlock_irqrestore(&(rwlock->spinlock), level);
+        return -RT_ERROR;
+    }
+
+    rwlock->readers--;
+    if (rwlock->readers == 0)
+    {
+        need_schedule = _rwlock_wake_writer(rwlock);
+    }
+
+    rt_spin_unlock_irqrestore(&(rwlock->spinlock), level);
+
+    if (need_schedule)
+        rt_schedule();
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_rwlock_read_release);
+
+/**
+ * @brief    This function will take a reader-writer lock for writing exclusively.
+ *
+ * @param    rwlock is a pointer to the reader-writer lock.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the operation status. ONLY When the return value is RT_EOK, the operation is successful.
+ *
+ * @warning  This function can ONLY be called in the thread context.
+ */
+rt_err_t rt_rwlock_write_take(rt_rwlock_t rwlock, rt_int32_t timeout)
+{
+    rt_base_t level;
+    rt_err_t ret;
+
+    RT_ASSERT(rwlock != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&rwlock->parent) == RT_Object_Class_RWLock);
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    level = rt_spin_lock_irqsave(&(rwlock->spinlock));
+
+    if (rwlock->readers == 0)
+    {
+        rwlock->readers = -1;
+        rwlock->writer = rt_thread_self();
+        rt_spin_unlock_irqrestore(&(rwlock->spinlock), level);
+        return RT_EOK;
+    }
+
+    if (timeout == 0)
+    {
+        rt_spin_unlock_irqrestore(&(rwlock->spinlock), level);
+        return -RT_ETIMEOUT;
+    }
+
+    /* hold off the new readers from now on */
+    rwlock->writers_waiting++;
+    ret = _rwlock_wait(rwlock, &(rwlock->writer_list), timeout, level);
+    if (ret != RT_EOK)
+    {
+        rt_bool_t need_schedule = RT_FALSE;
+
+        level = rt_spin_lock_irqsave(&(rwlock->spinlock));
+        rwlock->writers_waiting--;
+        /* the readers held off by us can go now */
+        if (rwlock->writers_waiting == 0 && rwlock->readers >= 0)
+        {
+            need_schedule = _rwlock_wake_readers(rwlock);
+        }
+        rt_spin_unlock_irqrestore(&(rwlock->spinlock), level);
+
+        if (need_schedule)
+            rt_schedule();
+    }
+
+    return ret;
+}
+RTM_EXPORT(rt_rwlock_write_take);
+
+/**
+ * @brief    This function will release a reader-writer lock taken for writing. A waiting writer
+ *           is preferred, otherwise all the waiting readers are admitted.
+ *
+ * @param    rwlock is a pointer to the reader-writer lock.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ */
+rt_err_t rt_rwlock_write_release(rt_rwlock_t rwlock)
+{
+    rt_base_t level;
+    rt_bool_t need_schedule;
+
+    RT_ASSERT(rwlock != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&rwlock->parent) == RT_Object_Class_RWLock);
+
+    level = rt_spin_lock_irqsave(&(rwlock->spinlock));
+
+    if (rwlock->readers != -1 || rwlock->writer != rt_thread_self())
+    {
+        rt_spin_unlock_irqrestore(&(rwlock->spinlock), level);
+        return -RT_ERROR;
+    }
+
+    rwlock->writer = RT_NULL;
+    need_schedule = _rwlock_wake_writer(rwlock);
+    if (!need_schedule)
+    {
+        rwlock->readers = 0;
+        need_schedule = _rwlock_wake_readers(rwlock);
+    }
+
+    rt_spin_unlock_irqrestore(&(rwlock->spinlock), level);
+
+    if (need_schedule)
+        rt_schedule();
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_rwlock_write_release);
+#endif /* RT_USING_RWLOCK */
+
+#ifdef RT_USING_FASTLOCK
+static void _fastlock_object_init(rt_fastlock_t lock, rt_uint8_t flag)
+{
+    rt_atomic_store(&(lock->state), RT_FASTLOCK_UNLOCKED);
+    lock->owner = RT_NULL;
+    rt_spin_lock_init(&(lock->spinlock));
+    rt_list_init(&(lock->suspend_list));
+
+    /* the queuing way of the suspended threads */
+    lock->parent.flag = flag;
+}
+
+static void _fastlock_before_delete_detach(rt_fastlock_t lock)
+{
+    rt_base_t level;
+
+    level = rt_spin_lock_irqsave(&(lock->spinlock));
+    /* wakeup all suspended threads */
+    rt_susp_list_resume_all(&(lock->suspend_list), RT_ERROR);
+    rt_spin_unlock_irqrestore(&(lock->spinlock), level);
+}
+
+/**
+ * @brief    This function will initialize a static fast lock object. It's a non-recursive lock
+ *           for threads, taking and releasing it without contention is a single atomic operation.
+ *
+ * @note     There is no priority inheritance on a fast lock, use rt_mutex if it's needed.
+ *
+ * @see      rt_fastlock_create()
+ *
+ * @param    lock is a pointer to the fast lock to initialize.
+ *
+ * @param    name is a pointer to the name that given to the fast lock.
+ *
+ * @param    flag is the queuing way of the waiting threads, which can be RT_IPC_FLAG_FIFO
+ *           or RT_IPC_FLAG_PRIO.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the initialization is successful.
+ */
+rt_err_t rt_fastlock_init(rt_fastlock_t lock, const char *name, rt_uint8_t flag)
+{
+    /* parameter check */
+    RT_ASSERT(lock != RT_NULL);
+    RT_ASSERT((flag == RT_IPC_FLAG_FIFO) || (flag == RT_IPC_FLAG_PRIO));
+
+    /* initialize object */
+    rt_object_init(&(lock->parent), RT_Object_Class_FastLock, name);
+
+    _fastlock_object_init(lock, flag);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_fastlock_init);
+
+/**
+ * @brief    This function will detach a static fast lock object initialized by rt_fastlock_init(),
+ *           all the waiting threads are resumed with -RT_ERROR.
+ *
+ * @see      rt_fastlock_delete()
+ *
+ * @param    lock is a pointer to the fast lock.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ */
+rt_err_t rt_fastlock_detach(rt_fastlock_t lock)
+{
+    /* parameter check */
+    RT_ASSERT(lock != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&lock->parent) == RT_Object_Class_FastLock);
+    RT_ASSERT(rt_object_is_systemobject(&lock->parent));
+
+    _fastlock_before_delete_detach(lock);
+
+    /* detach fast lock object */
+    rt_object_detach(&(lock->parent));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_fastlock_detach);
+
+#ifdef RT_USING_HEAP
+/**
+ * @brief    This function will create a fast lock object.
+ *
+ * @see      rt_fastlock_init()
+ *
+ * @param    name is a pointer to the name that given to the fast lock.
+ *
+ * @param    flag is the queuing way of the waiting threads, which can be RT_IPC_FLAG_FIFO
+ *           or RT_IPC_FLAG_PRIO.
+ *
+ * @return   Return a pointer to the fast lock object. When the return value is RT_NULL,
+ *           it means the creation failed.
+ *
+ * @warning  This function can ONLY be called from threads.
+ */
+rt_fastlock_t rt_fastlock_create(const char *name, rt_uint8_t flag)
+{
+    struct rt_fastlock *lock;
+
+    RT_ASSERT((flag == RT_IPC_FLAG_FIFO) || (flag == RT_IPC_FLAG_PRIO));
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    /* allocate object */
+    lock = (rt_fastlock_t)rt_object_allocate(RT_Object_Class_FastLock, name);
+    if (lock == RT_NULL)
+        return lock;
+
+    _fastlock_object_init(lock, flag);
+
+    return lock;
+}
+RTM_EXPORT(rt_fastlock_create);
+
+/**
+ * @brief    This function will delete a fast lock object created by rt_fastlock_create(),
+ *           all the waiting threads are resumed with -RT_ERROR.
+ *
+ * @see      rt_fastlock_detach()
+ *
+ * @param    lock is a pointer to the fast lock.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ */
+rt_err_t rt_fastlock_delete(rt_fastlock_t lock)
+{
+    /* parameter check */
+    RT_ASSERT(lock != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&lock->parent) == RT_Object_Class_FastLock);
+    RT_ASSERT(rt_object_is_systemobject(&lock->parent) == RT_FALSE);
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    _fastlock_before_delete_detach(lock);
+
+    /* delete fast lock object */
+    rt_object_delete(&(lock->parent));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_fastlock_delete);
+#endif /* RT_USING_HEAP */
+
+/* the lock is held by another thread: mark it contended and sleep until it is released */
+static rt_err_t _fastlock_take_slow(rt_fastlock_t lock, rt_int32_t timeout)
+{
+    rt_base_t level;
+    rt_err_t ret;
+    rt_uint32_t tick_delta = 0;
+    struct rt_thread *thread = rt_thread_self();
+
+    /* it's not a recursive lock */
+    if (lock->owner == thread)
+        return -RT_ERROR;
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    /* whoever turns the lock from unlocked to contended owns it */
+    while (rt_atomic_exchange(&(lock->state), RT_FASTLOCK_CONTENDED) != RT_FASTLOCK_UNLOCKED)
+    {
+        if (timeout == 0)
+            return -RT_ETIMEOUT;
+
+        level = rt_spin_lock_irqsave(&(lock->spinlock));
+
+        /* released after the exchange, the releaser may have found no one to wake */
+        if (rt_atomic_load(&(lock->state)) != RT_FASTLOCK_CONTENDED)
+        {
+            rt_spin_unlock_irqrestore(&(lock->spinlock), level);
+            continue;
+        }
+
+        thread->error = RT_EOK;
+        ret = rt_thread_suspend_to_list(thread, &(lock->suspend_list), lock->parent.flag, RT_UNINTERRUPTIBLE);
+        if (ret != RT_EOK)
+        {
+            rt_spin_unlock_irqrestore(&(lock->spinlock), level);
+            return ret;
+        }
+
+        if (timeout > 0)
+        {
+            tick_delta = rt_tick_get();
+            rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, &timeout);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        rt_spin_unlock_irqrestore(&(lock->spinlock), level);
+
+        rt_schedule();
+
+        if (thread->error != RT_EOK)
+        {
+            ret = thread->error;
+            return ret > 0 ? -ret : ret;
+        }
+
+        /* woken by a release, compete for the lock again */
+        if (timeout > 0)
+        {
+            tick_delta = rt_tick_get() - tick_delta;
+            timeout -= tick_delta;
+            if (timeout < 0)
+                timeout = 0;
+        }
+    }
+
+    lock->owner = thread;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief    This function will take a fast lock. If the lock is free, it's taken by one atomic
+ *           compare-and-swap, otherwise the thread is suspended on the lock.
+ *
+ * @param    lock is a pointer to the fast lock.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the operation status. ONLY When the return value is RT_EOK, the operation is successful.
+ *           -RT_ETIMEOUT means the lock is not available within the timeout period.
+ *
+ * @warning  This function can ONLY be called in the thread context.
+ */
+rt_err_t rt_fastlock_take(rt_fastlock_t lock, rt_int32_t timeout)
+{
+    rt_atomic_t expected = RT_FASTLOCK_UNLOCKED;
+
+    RT_ASSERT(lock != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&lock->parent) == RT_Object_Class_FastLock);
+
+    if (rt_atomic_compare_exchange_strong(&(lock->state), &expected, RT_FASTLOCK_LOCKED))
+    {
+        lock->owner = rt_thread_self();
+        return RT_EOK;
+    }
+
+    return _fastlock_take_slow(lock, timeout);
+}
+RTM_EXPORT(rt_fastlock_take);
+
+/**
+ * @brief    This function will try to take a fast lock without waiting.
+ *
+ * @see      rt_fastlock_take()
+ */
+rt_err_t rt_fastlock_trytake(rt_fastlock_t lock)
+{
+    return rt_fastlock_take(lock, RT_WAITING_NO);
+}
+RTM_EXPORT(rt_fastlock_trytake);
+
+/**
+ * @brief    This function will release a fast lock. If no thread is waiting, it's released by one
+ *           atomic compare-and-swap, otherwise the first waiting thread is resumed to compete for it.
+ *
+ * @param    lock is a pointer to the fast lock.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           -RT_ERROR means the lock is not held by current thread.
+ */
+rt_err_t rt_fastlock_release(rt_fastlock_t lock)
+{
+    rt_base_t level;
+    struct rt_thread *thread;
+    rt_atomic_t expected = RT_FASTLOCK_LOCKED;
+
+    RT_ASSERT(lock != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&lock->parent) == RT_Object_Class_FastLock);
+
+    if (lock->owner != rt_thread_self())
+        return -RT_ERROR;
+
+    lock->owner = RT_NULL;
+
+    if (rt_atomic_compare_exchange_strong(&(lock->state), &expected, RT_FASTLOCK_UNLOCKED))
+        return RT_EOK;
+
+    /* contended, release it before looking for the waiter, see _fastlock_take_slow() */
+    rt_atomic_store(&(lock->state), RT_FASTLOCK_UNLOCKED);
+
+    level = rt_spin_lock_irqsave(&(lock->spinlock));
+    thread = rt_susp_list_dequeue(&(lock->suspend_list), RT_EOK);
+    rt_spin_unlock_irqrestore(&(lock->spinlock), level);
+
+    if (thread != RT_NULL)
+        rt_schedule();
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_fastlock_release);
+#endif /* RT_USING_FASTLOCK */
+
+#ifdef RT_USING_RCU
+/**
+ * @brief    This function reports a quiescent state of current core, where no RCU reader is
+ *           running. It is invoked by the scheduler on context switch and on tick.
+ */
+void rt_rcu_quiescent_state(void)
+{
+#ifdef RT_USING_SMP
+    rt_atomic_add(&(rt_cpu_self()->rcu_qs), 1);
+#endif /* RT_USING_SMP */
+}
+
+/**
+ * @brief    This function waits for a grace period, after which all the RCU readers running
+ *           at the time of the call are finished. An object removed from a RCU protected
+ *           structure can be freed after it returns.
+ *
+ * @note     Since the readers can not be preempted, a core has left all its readers once it
+ *           reports a quiescent state. On a single core, no reader is running when it is called.
+ *
+ * @warning  This function can ONLY be called in the thread context, out of any RCU reader.
+ */
+void rt_rcu_synchronize(void)
+{
+#ifdef RT_USING_SMP
+    int cpu;
+    rt_ubase_t snap[RT_CPUS_NR];
+    rt_ubase_t pending = 0;
+
+    RT_DEBUG_SCHEDULER_AVAILABLE(RT_TRUE);
+
+    for (cpu = 0; cpu < RT_CPUS_NR; cpu++)
+    {
+        snap[cpu] = rt_atomic_load(&(rt_cpu_index(cpu)->rcu_qs));
+        pending |= 1ul << cpu;
+    }
+    /* we are running on this core, so it is quiescent already */
+    pending &= ~(1ul << rt_hw_cpu_id());
+
+    while (pending)
+    {
+        for (cpu = 0; cpu < RT_CPUS_NR; cpu++)
+        {
+            if ((pending & (1ul << cpu)) &&
+                rt_atomic_load(&(rt_cpu_index(cpu)->rcu_qs)) != snap[cpu])
+            {
+                pending &= ~(1ul << cpu);
+            }
+        }
+
+        if (pending)
+        {
+            rt_thread_delay(1);
+        }
+    }
+#else
+    RT_DEBUG_SCHEDULER_AVAILABLE(RT_TRUE);
+#endif /* RT_USING_SMP */
+}
+RTM_EXPORT(rt_rcu_synchronize);
+#endif /* RT_USING_RCU */
+
+#ifdef RT_USING_EVENT
+/**
+ * @addtogroup event
+ * @{
+ */
+
+/**
+ * @brief    The function will initialize a static event object.
+ *
+ * @note     For the static event object, its memory space is allocated by the compiler during compiling,
+ *           and shall placed on the read-write data segment or on the uninitialized data segment.
+ *           By contrast, the rt_event_create() function will allocate memory space automatically
+ *           and initialize the event.
+ *
+ * @see      rt_event_create()
+ *
+ * @param    event is a pointer to the event to initialize. It is assumed that storage for the event
+ *           will be allocated in your application.
+ *
+ * @param    name is a pointer to the name that given to the event.
+ *
+ * @param    flag is the event flag, which determines the queuing way of how multiple threads wait
+ *           when the event is not available.
+ *           The event flag can be ONE of the following values:
+ *
+ *               RT_IPC_FLAG_PRIO          The pending threads will queue in order of priority.
+ *
+ *               RT_IPC_FLAG_FIFO          The pending threads will queue in the first-in-first-out method
+ *                                         (also known as first-come-first-served (FCFS) scheduling strategy).
+ *
+ *               NOTE: RT_IPC_FLAG_FIFO is a non-real-time scheduling mode. It is strongly recommended to
+ *               use RT_IPC_FLAG_PRIO to ensure the thread is real-time UNLESS your applications concern about
+ *               the first-in-first-out principle, and you clearly understand that all threads involved in
+ *               this event will become non-real-time threads.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the initialization is successful.
+ *           If the return value is any other values, it represents the initialization failed.
+ *
+ * @warning  This function can ONLY be called from threads.
+ */
+rt_err_t rt_event_init(rt_event_t event, const char *name, rt_uint8_t flag)
+{
+    /* parameter check */
+    RT_ASSERT(event != RT_NULL);
+    RT_ASSERT((flag == RT_IPC_FLAG_FIFO) || (flag == RT_IPC_FLAG_PRIO));
+
+    /* initialize object */
+    rt_object_init(&(event->parent.parent), RT_Object_Class_Event, name);
+
+    /* set parent flag */
+    event->parent.parent.flag = flag;
+
+    /* initialize ipc object */
+    _ipc_object_init(&(event->parent));
+
+    /* initialize event */
+    event->set = 0;
+    rt_spin_lock_init(&(event->spinlock));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_event_init);
+
+
+/**
+ * @brief    This function will detach a static event object.
+ *
+ * @note     This function is used to detach a static event object which is initialized by rt_event_init() function.
+ *           By contrast, the rt_event_delete() function will delete an event object.
+ *           When the event is successfully detached, it will resume all suspended threads in the event list.
+ *
+ * @see      rt_event_delete()
+ *
+ * @param    event is a pointer to an event object to be detached.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the initialization is successful.
+ *           If the return value is any other values, it means that the event detach failed.
+ *
+ * @warning  This function can ONLY detach a static event initialized by the rt_event_init() function.
+ *           If the event is created by the rt_event_create() function, you MUST NOT USE this function to detach it,
+ *           ONLY USE the rt_event_delete() function to complete the deletion.
+ */
+rt_err_t rt_event_detach(rt_event_t event)
+{
+    rt_base_t level;
+
+    /* parameter check */
+    RT_ASSERT(event != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&event->parent.parent) == RT_Object_Class_Event);
+    RT_ASSERT(rt_object_is_systemobject(&event->parent.parent));
+
+    level = rt_spin_lock_irqsave(&(event->spinlock));
+    /* resume all suspended thread */
+    rt_susp_list_resume_all(&(event->parent.suspend_thread), RT_ERROR);
+    rt_spin_unlock_irqrestore(&(event->spinlock), level);
+
+    /* detach event object */
+    rt_object_detach(&(event->parent.parent));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_event_detach);
+
+#ifdef RT_USING_HEAP
+/**
+ * @brief    Creating an event object.
+ *
+ * @note     For the event object, its memory space is allocated automatically.
+ *           By contrast, the rt_event_init() function will initialize a static event object.
+ *
+ * @see      rt_event_init()
+ *
+ * @param    name is a pointer to the name that given to the event.
+ *
+ * @param    flag is the event flag, which determines the queuing way of how multiple threads wait when the event
+ *           is not available.
+ *           The event flag can be ONE of the following values:
+ *
+ *               RT_IPC_FLAG_PRIO          The pending threads will queue in order of priority.
+ *
+ *               RT_IPC_FLAG_FIFO          The pending threads will queue in the first-in-first-out method
+ *                                         (also known as first-come-first-served (FCFS) scheduling strategy).
+ *
+ *               NOTE: RT_IPC_FLAG_FIFO is a non-real-time scheduling mode. It is strongly recommended to
+ *               use RT_IPC_FLAG_PRIO to ensure the thread is real-time UNLESS your applications concern about
+ *               the first-in-first-out principle, and you clearly understand that all threads involved in
+ *               this event will become non-real-time threads.
+ *
+ * @return   Return a pointer to the event object. When the return value is RT_NULL, it means the creation failed.
+ *
+ * @warning  This function can ONLY be called from threads.
+ */
+rt_event_t rt_event_create(const char *name, rt_uint8_t flag)
+{
+    rt_event_t event;
+
+    RT_ASSERT((flag == RT_IPC_FLAG_FIFO) || (flag == RT_IPC_FLAG_PRIO));
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    /* allocate object */
+    event = (rt_event_t)rt_object_allocate(RT_Object_Class_Event, name);
+    if (event == RT_NULL)
+        return event;
+
+    /* set parent */
+    event->parent.parent.flag = flag;
+
+    /* initialize ipc object */
+    _ipc_object_init(&(event->parent));
+
+    /* initialize event */
+    event->set = 0;
+    rt_spin_lock_init(&(event->spinlock));
+
+    return event;
+}
+RTM_EXPORT(rt_event_create);
+
+
+/**
+ * @brief    This function will delete an event object and release the memory space.
+ *
+ * @note     This function is used to delete an event object which is created by the rt_event_create() function.
+ *           By contrast, the rt_event_detach() function will detach a static event object.
+ *           When the event is successfully deleted, it will resume all suspended threads in the event list.
+ *
+ * @see      rt_event_detach()
+ *
+ * @param    event is a pointer to an event object to be deleted.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is any other values, it means that the event detach failed.
+ *
+ * @warning  This function can ONLY delete an event initialized by the rt_event_create() function.
+ *           If the event is initialized by the rt_event_init() function, you MUST NOT USE this function to delete it,
+ *           ONLY USE the rt_event_detach() function to complete the detachment.
+ */
+rt_err_t rt_event_delete(rt_event_t event)
+{
+    /* parameter check */
+    RT_ASSERT(event != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&event->parent.parent) == RT_Object_Class_Event);
+    RT_ASSERT(rt_object_is_systemobject(&event->parent.parent) == RT_FALSE);
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    rt_spin_lock(&(event->spinlock));
+    /* resume all suspended thread */
+    rt_susp_list_resume_all(&(event->parent.suspend_thread), RT_ERROR);
+    rt_spin_unlock(&(event->spinlock));
+
+    /* delete event object */
+    rt_object_delete(&(event->parent.parent));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_event_delete);
+#endif /* RT_USING_HEAP */
+
+
+/**
+ * @brief    This function will send an event to the event object.
+ *           If there is a thread suspended on the event, the thread will be resumed.
+ *
+ * @note     When using this function, you need to use the parameter (set) to specify the event flag of the event object,
+ *           then the function will traverse the list of suspended threads waiting on the event object.
+ *           If there is a thread suspended on the event, and the thread's event_info and the event flag of
+ *           the current event object matches, the thread will be resumed.
+ *
+ * @param    event is a pointer to the event object to be sent.
+ *
+ * @param    set is a flag that you will set for this event's flag.
+ *           You can set an event flag, or you can set multiple flags through OR logic operation.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is any other values, it means that the event detach failed.
+ */
+rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set)
+{
+    struct rt_list_node *n;
+    struct rt_thread *thread;
+    rt_sched_lock_level_t slvl;
+    rt_base_t level;
+    rt_base_t status;
+    rt_bool_t need_schedule;
+    rt_uint32_t need_clear_set = 0;
+
+    /* parameter check */
+    RT_ASSERT(event != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&event->parent.parent) == RT_Object_Class_Event);
+
+    if (set == 0)
+        return -RT_ERROR;
+
+    need_schedule = RT_FALSE;
+
+    level = rt_spin_lock_irqsave(&(event->spinlock));
+
+    /* set event */
+    event->set |= set;
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(event->parent.parent)));
 
     rt_sched_lock(&slvl);
     if (!rt_list_isempty(&event->parent.suspend_thread))
@@ -2042,6 +2899,9 @@ rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set)
     }
 
     rt_sched_unlock(slvl);
+
+    if (_ipc_wait_any_notify(&(event->parent), event->set))
+        need_schedule = RT_TRUE;
     rt_spin_unlock_irqrestore(&(event->spinlock), level);
 
     /* do a schedule */
@@ -2668,7 +3528,8 @@ static rt_err_t _rt_mb_send_wait(rt_mailbox_t mb,
     }
 
     /* resume suspended thread */
-    if (!rt_list_isempty(&mb->parent.suspend_thread))
+    if (_ipc_wait_any_notify(&(mb->parent), 0) ||
+        !rt_list_isempty(&mb->parent.suspend_thread))
     {
         rt_susp_list_dequeue(&(mb->parent.suspend_thread), RT_EOK);
 
@@ -2792,7 +3653,8 @@ rt_err_t rt_mb_urgent(rt_mailbox_t mb, rt_ubase_t value)
     mb->entry ++;
 
     /* resume suspended thread */
-    if (!rt_list_isempty(&mb->parent.suspend_thread))
+    if (_ipc_wait_any_notify(&(mb->parent), 0) ||
+        !rt_list_isempty(&mb->parent.suspend_thread))
     {
         rt_susp_list_dequeue(&(mb->parent.suspend_thread), RT_EOK);
 
@@ -3333,44 +4195,27 @@ RTM_EXPORT(rt_mq_delete);
 #endif /* RT_USING_HEAP */
 
 /**
- * @brief    This function will send a message to the messagequeue object. If
- *           there is a thread suspended on the messagequeue, the thread will be
- *           resumed.
- *
- * @note     When using this function to send a message, if the messagequeue is
- *           fully used, the current thread will wait for a timeout. If reaching
- *           the timeout and there is still no space available, the sending
- *           thread will be resumed and an error code will be returned. By
- *           contrast, the _rt_mq_send_wait() function will return an error code
- *           immediately without waiting when the messagequeue if fully used.
- *
- * @see      _rt_mq_send_wait()
+ * @brief    This function will take a free message node from the messagequeue,
+ *           waiting for a receiver to give one back if the messagequeue is full.
  *
- * @param    mq is a pointer to the messagequeue object to be sent.
- *
- * @param    buffer is the content of the message.
+ * @note     The node is owned by the caller until it is linked into the queue
+ *           by _mq_link_msg() or given back by _mq_put_free().
  *
- * @param    size is the length of the message(Unit: Byte).
+ * @param    mq is a pointer to the messagequeue object.
  *
- * @param    prio is message priority, A larger value indicates a higher priority
+ * @param    msg_ptr is a pointer to store the free message node.
  *
  * @param    timeout is a timeout period (unit: an OS tick).
  *
  * @param    suspend_flag status flag of the thread to be suspended.
  *
  * @return   Return the operation status. When the return value is RT_EOK, the
- *           operation is successful. If the return value is any other values,
- *           it means that the messagequeue detach failed.
- *
- * @warning  This function can be called in interrupt context and thread
- * context.
+ *           operation is successful.
  */
-static rt_err_t _rt_mq_send_wait(rt_mq_t mq,
-                                 const void *buffer,
-                                 rt_size_t size,
-                                 rt_int32_t prio,
-                                 rt_int32_t timeout,
-                                 int suspend_flag)
+static rt_err_t _mq_get_free(rt_mq_t mq,
+                             struct rt_mq_message **msg_ptr,
+                             rt_int32_t timeout,
+                             int suspend_flag)
 {
     rt_base_t level;
     struct rt_mq_message *msg;
@@ -3378,28 +4223,11 @@ static rt_err_t _rt_mq_send_wait(rt_mq_t mq,
     struct rt_thread *thread;
     rt_err_t ret;
 
-    RT_UNUSED(prio);
-
-    /* parameter check */
-    RT_ASSERT(mq != RT_NULL);
-    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
-    RT_ASSERT(buffer != RT_NULL);
-    RT_ASSERT(size != 0);
-
-    /* current context checking */
-    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
-
-    /* greater than one message size */
-    if (size > mq->msg_size)
-        return -RT_ERROR;
-
     /* initialize delta tick */
     tick_delta = 0;
     /* get current thread */
     thread = rt_thread_self();
 
-    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
-
     level = rt_spin_lock_irqsave(&(mq->spinlock));
 
     /* get a free list, there must be an empty item */
@@ -3481,80 +4309,351 @@ static rt_err_t _rt_mq_send_wait(rt_mq_t mq,
 
     /* the msg is the new tailer of list, the next shall be NULL */
     msg->next = RT_NULL;
+    *msg_ptr = msg;
 
-    /* add the length */
-    ((struct rt_mq_message *)msg)->length = size;
-    /* copy buffer */
-    rt_memcpy(GET_MESSAGEBYTE_ADDR(msg), buffer, size);
+    return RT_EOK;
+}
+
+/**
+ * @brief    This function will link a filled message node into the messagequeue
+ *           and resume a thread suspended on receiving.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    msg is the message node got by _mq_get_free().
+ *
+ * @param    prio is message priority, A larger value indicates a higher priority
+ *
+ * @param    urgent is RT_TRUE to place the message at the head of the queue.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the
+ *           operation is successful.
+ */
+static rt_err_t _mq_link_msg(rt_mq_t mq,
+                             struct rt_mq_message *msg,
+                             rt_int32_t prio,
+                             rt_bool_t urgent)
+{
+    rt_base_t level;
+
+    RT_UNUSED(prio);
 
-    /* disable interrupt */
     level = rt_spin_lock_irqsave(&(mq->spinlock));
-#ifdef RT_USING_MESSAGEQUEUE_PRIORITY
-    msg->prio = prio;
-    if (mq->msg_queue_head == RT_NULL)
+
+    if (urgent)
+    {
+        /* link msg to the beginning of message queue */
+        msg->next = (struct rt_mq_message *)mq->msg_queue_head;
         mq->msg_queue_head = msg;
 
-    struct rt_mq_message *node, *prev_node = RT_NULL;
-    for (node = mq->msg_queue_head; node != RT_NULL; node = node->next)
+        /* if there is no tail */
+        if (mq->msg_queue_tail == RT_NULL)
+            mq->msg_queue_tail = msg;
+    }
+    else
     {
-        if (node->prio < msg->prio)
+#ifdef RT_USING_MESSAGEQUEUE_PRIORITY
+        msg->prio = prio;
+        if (mq->msg_queue_head == RT_NULL)
+            mq->msg_queue_head = msg;
+
+        struct rt_mq_message *node, *prev_node = RT_NULL;
+        for (node = mq->msg_queue_head; node != RT_NULL; node = node->next)
         {
-            if (prev_node == RT_NULL)
-                mq->msg_queue_head = msg;
-            else
-                prev_node->next = msg;
-            msg->next = node;
-            break;
+            if (node->prio < msg->prio)
+            {
+                if (prev_node == RT_NULL)
+                    mq->msg_queue_head = msg;
+                else
+                    prev_node->next = msg;
+                msg->next = node;
+                break;
+            }
+            if (node->next == RT_NULL)
+            {
+                if (node != msg)
+                    node->next = msg;
+                mq->msg_queue_tail = msg;
+                break;
+            }
+            prev_node = node;
         }
-        if (node->next == RT_NULL)
+#else
+        /* link msg to message queue */
+        if (mq->msg_queue_tail != RT_NULL)
         {
-            if (node != msg)
-                node->next = msg;
-            mq->msg_queue_tail = msg;
-            break;
+            /* if the tail exists, */
+            ((struct rt_mq_message *)mq->msg_queue_tail)->next = msg;
+        }
+
+        /* set new tail */
+        mq->msg_queue_tail = msg;
+        /* if the head is empty, set head */
+        if (mq->msg_queue_head == RT_NULL)
+            mq->msg_queue_head = msg;
+#endif
+    }
+
+    if(mq->entry < RT_MQ_ENTRY_MAX)
+    {
+        /* increase message entry */
+        mq->entry ++;
+    }
+    else
+    {
+        rt_spin_unlock_irqrestore(&(mq->spinlock), level);
+        return -RT_EFULL; /* value overflowed */
+    }
+
+    /* resume suspended thread */
+    if (_ipc_wait_any_notify(&(mq->parent), 0) ||
+        !rt_list_isempty(&mq->parent.suspend_thread))
+    {
+        rt_susp_list_dequeue(&(mq->parent.suspend_thread), RT_EOK);
+
+        rt_spin_unlock_irqrestore(&(mq->spinlock), level);
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+    rt_spin_unlock_irqrestore(&(mq->spinlock), level);
+
+    return RT_EOK;
+}
+
+/**
+ * @brief    This function will unlink the first message node from the
+ *           messagequeue, waiting for a sender if the messagequeue is empty.
+ *
+ * @note     The node is owned by the caller until it is given back by
+ *           _mq_put_free().
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    msg_ptr is a pointer to store the message node.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @param    suspend_flag status flag of the thread to be suspended.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the
+ *           operation is successful.
+ */
+static rt_err_t _mq_get_msg(rt_mq_t mq,
+                            struct rt_mq_message **msg_ptr,
+                            rt_int32_t timeout,
+                            int suspend_flag)
+{
+    struct rt_thread *thread;
+    rt_base_t level;
+    struct rt_mq_message *msg;
+    rt_uint32_t tick_delta;
+    rt_err_t ret;
+
+    /* initialize delta tick */
+    tick_delta = 0;
+    /* get current thread */
+    thread = rt_thread_self();
+
+    level = rt_spin_lock_irqsave(&(mq->spinlock));
+
+    /* for non-blocking call */
+    if (mq->entry == 0 && timeout == 0)
+    {
+        rt_spin_unlock_irqrestore(&(mq->spinlock), level);
+
+        return -RT_ETIMEOUT;
+    }
+
+    /* message queue is empty */
+    while (mq->entry == 0)
+    {
+        /* reset error number in thread */
+        thread->error = -RT_EINTR;
+
+        /* no waiting, return timeout */
+        if (timeout == 0)
+        {
+            /* enable interrupt */
+            rt_spin_unlock_irqrestore(&(mq->spinlock), level);
+
+            thread->error = -RT_ETIMEOUT;
+
+            return -RT_ETIMEOUT;
+        }
+
+        /* suspend current thread */
+        ret = rt_thread_suspend_to_list(thread, &(mq->parent.suspend_thread),
+                                        mq->parent.parent.flag, suspend_flag);
+        if (ret != RT_EOK)
+        {
+            rt_spin_unlock_irqrestore(&(mq->spinlock), level);
+            return ret;
+        }
+
+        /* has waiting time, start thread timer */
+        if (timeout > 0)
+        {
+            /* get the start tick of timer */
+            tick_delta = rt_tick_get();
+
+            LOG_D("set thread:%s to timer list",
+                  thread->parent.name);
+
+            /* reset the timeout of thread timer and start it */
+            rt_timer_control(&(thread->thread_timer),
+                             RT_TIMER_CTRL_SET_TIME,
+                             &timeout);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        rt_spin_unlock_irqrestore(&(mq->spinlock), level);
+
+        /* re-schedule */
+        rt_schedule();
+
+        /* recv message */
+        if (thread->error != RT_EOK)
+        {
+            /* return error */
+            return thread->error;
+        }
+
+        level = rt_spin_lock_irqsave(&(mq->spinlock));
+
+        /* if it's not waiting forever and then re-calculate timeout tick */
+        if (timeout > 0)
+        {
+            tick_delta = rt_tick_get() - tick_delta;
+            timeout -= tick_delta;
+            if (timeout < 0)
+                timeout = 0;
         }
-        prev_node = node;
-    }
-#else
-    /* link msg to message queue */
-    if (mq->msg_queue_tail != RT_NULL)
-    {
-        /* if the tail exists, */
-        ((struct rt_mq_message *)mq->msg_queue_tail)->next = msg;
     }
 
-    /* set new tail */
-    mq->msg_queue_tail = msg;
-    /* if the head is empty, set head */
-    if (mq->msg_queue_head == RT_NULL)
-        mq->msg_queue_head = msg;
-#endif
+    /* get message from queue */
+    msg = (struct rt_mq_message *)mq->msg_queue_head;
 
-    if(mq->entry < RT_MQ_ENTRY_MAX)
-    {
-        /* increase message entry */
-        mq->entry ++;
-    }
-    else
+    /* move message queue head */
+    mq->msg_queue_head = msg->next;
+    /* reach queue tail, set to NULL */
+    if (mq->msg_queue_tail == msg)
+        mq->msg_queue_tail = RT_NULL;
+
+    /* decrease message entry */
+    if(mq->entry > 0)
     {
-        rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-        return -RT_EFULL; /* value overflowed */
+        mq->entry --;
     }
 
+    rt_spin_unlock_irqrestore(&(mq->spinlock), level);
+
+    *msg_ptr = msg;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief    This function will give a message node back to the free list of
+ *           the messagequeue and resume a thread suspended on sending.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    msg is the message node to be given back.
+ */
+static void _mq_put_free(rt_mq_t mq, struct rt_mq_message *msg)
+{
+    rt_base_t level;
+
+    level = rt_spin_lock_irqsave(&(mq->spinlock));
+    /* put message to free list */
+    msg->next = (struct rt_mq_message *)mq->msg_queue_free;
+    mq->msg_queue_free = msg;
+
     /* resume suspended thread */
-    if (!rt_list_isempty(&mq->parent.suspend_thread))
+    if (!rt_list_isempty(&(mq->suspend_sender_thread)))
     {
-        rt_susp_list_dequeue(&(mq->parent.suspend_thread), RT_EOK);
+        rt_susp_list_dequeue(&(mq->suspend_sender_thread), RT_EOK);
 
         rt_spin_unlock_irqrestore(&(mq->spinlock), level);
 
         rt_schedule();
 
-        return RT_EOK;
+        return;
     }
+
     rt_spin_unlock_irqrestore(&(mq->spinlock), level);
+}
 
-    return RT_EOK;
+/**
+ * @brief    This function will send a message to the messagequeue object. If
+ *           there is a thread suspended on the messagequeue, the thread will be
+ *           resumed.
+ *
+ * @note     When using this function to send a message, if the messagequeue is
+ *           fully used, the current thread will wait for a timeout. If reaching
+ *           the timeout and there is still no space available, the sending
+ *           thread will be resumed and an error code will be returned. By
+ *           contrast, the _rt_mq_send_wait() function will return an error code
+ *           immediately without waiting when the messagequeue if fully used.
+ *
+ * @see      _rt_mq_send_wait()
+ *
+ * @param    mq is a pointer to the messagequeue object to be sent.
+ *
+ * @param    buffer is the content of the message.
+ *
+ * @param    size is the length of the message(Unit: Byte).
+ *
+ * @param    prio is message priority, A larger value indicates a higher priority
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @param    suspend_flag status flag of the thread to be suspended.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the
+ *           operation is successful. If the return value is any other values,
+ *           it means that the messagequeue detach failed.
+ *
+ * @warning  This function can be called in interrupt context and thread
+ * context.
+ */
+static rt_err_t _rt_mq_send_wait(rt_mq_t mq,
+                                 const void *buffer,
+                                 rt_size_t size,
+                                 rt_int32_t prio,
+                                 rt_int32_t timeout,
+                                 int suspend_flag)
+{
+    struct rt_mq_message *msg;
+    rt_err_t ret;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    /* greater than one message size */
+    if (size > mq->msg_size)
+        return -RT_ERROR;
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+
+    ret = _mq_get_free(mq, &msg, timeout, suspend_flag);
+    if (ret != RT_EOK)
+        return ret;
+
+    /* add the length */
+    ((struct rt_mq_message *)msg)->length = size;
+    /* copy buffer */
+    rt_memcpy(GET_MESSAGEBYTE_ADDR(msg), buffer, size);
+
+    return _mq_link_msg(mq, msg, prio, RT_FALSE);
 }
 
 rt_err_t rt_mq_send_wait(rt_mq_t     mq,
@@ -3642,8 +4741,8 @@ RTM_EXPORT(rt_mq_send_killable);
  */
 rt_err_t rt_mq_urgent(rt_mq_t mq, const void *buffer, rt_size_t size)
 {
-    rt_base_t level;
     struct rt_mq_message *msg;
+    rt_err_t ret;
 
     /* parameter check */
     RT_ASSERT(mq != RT_NULL);
@@ -3657,63 +4756,17 @@ rt_err_t rt_mq_urgent(rt_mq_t mq, const void *buffer, rt_size_t size)
 
     RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
 
-    level = rt_spin_lock_irqsave(&(mq->spinlock));
-
-    /* get a free list, there must be an empty item */
-    msg = (struct rt_mq_message *)mq->msg_queue_free;
-    /* message queue is full */
-    if (msg == RT_NULL)
-    {
-        rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-
-        return -RT_EFULL;
-    }
-    /* move free list pointer */
-    mq->msg_queue_free = msg->next;
-
-    rt_spin_unlock_irqrestore(&(mq->spinlock), level);
+    /* message queue is full, the urgent message never waits */
+    ret = _mq_get_free(mq, &msg, 0, RT_UNINTERRUPTIBLE);
+    if (ret != RT_EOK)
+        return ret;
 
     /* add the length */
     ((struct rt_mq_message *)msg)->length = size;
     /* copy buffer */
     rt_memcpy(GET_MESSAGEBYTE_ADDR(msg), buffer, size);
 
-    level = rt_spin_lock_irqsave(&(mq->spinlock));
-
-    /* link msg to the beginning of message queue */
-    msg->next = (struct rt_mq_message *)mq->msg_queue_head;
-    mq->msg_queue_head = msg;
-
-    /* if there is no tail */
-    if (mq->msg_queue_tail == RT_NULL)
-        mq->msg_queue_tail = msg;
-
-    if(mq->entry < RT_MQ_ENTRY_MAX)
-    {
-        /* increase message entry */
-        mq->entry ++;
-    }
-    else
-    {
-        rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-        return -RT_EFULL; /* value overflowed */
-    }
-
-    /* resume suspended thread */
-    if (!rt_list_isempty(&mq->parent.suspend_thread))
-    {
-        rt_susp_list_dequeue(&(mq->parent.suspend_thread), RT_EOK);
-
-        rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-
-        rt_schedule();
-
-        return RT_EOK;
-    }
-
-    rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-
-    return RT_EOK;
+    return _mq_link_msg(mq, msg, 0, RT_TRUE);
 }
 RTM_EXPORT(rt_mq_urgent);
 
@@ -3754,122 +4807,26 @@ static rt_ssize_t _rt_mq_recv(rt_mq_t mq,
                               rt_int32_t timeout,
                               int suspend_flag)
 {
-    struct rt_thread *thread;
-    rt_base_t level;
     struct rt_mq_message *msg;
-    rt_uint32_t tick_delta;
     rt_err_t ret;
     rt_size_t len;
 
     RT_UNUSED(prio);
 
-    /* parameter check */
-    RT_ASSERT(mq != RT_NULL);
-    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
-    RT_ASSERT(buffer != RT_NULL);
-    RT_ASSERT(size != 0);
-
-    /* current context checking */
-    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
-
-    /* initialize delta tick */
-    tick_delta = 0;
-    /* get current thread */
-    thread = rt_thread_self();
-    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
-
-    level = rt_spin_lock_irqsave(&(mq->spinlock));
-
-    /* for non-blocking call */
-    if (mq->entry == 0 && timeout == 0)
-    {
-        rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-
-        return -RT_ETIMEOUT;
-    }
-
-    /* message queue is empty */
-    while (mq->entry == 0)
-    {
-        /* reset error number in thread */
-        thread->error = -RT_EINTR;
-
-        /* no waiting, return timeout */
-        if (timeout == 0)
-        {
-            /* enable interrupt */
-            rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-
-            thread->error = -RT_ETIMEOUT;
-
-            return -RT_ETIMEOUT;
-        }
-
-        /* suspend current thread */
-        ret = rt_thread_suspend_to_list(thread, &(mq->parent.suspend_thread),
-                                        mq->parent.parent.flag, suspend_flag);
-        if (ret != RT_EOK)
-        {
-            rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-            return ret;
-        }
-
-        /* has waiting time, start thread timer */
-        if (timeout > 0)
-        {
-            /* get the start tick of timer */
-            tick_delta = rt_tick_get();
-
-            LOG_D("set thread:%s to timer list",
-                  thread->parent.name);
-
-            /* reset the timeout of thread timer and start it */
-            rt_timer_control(&(thread->thread_timer),
-                             RT_TIMER_CTRL_SET_TIME,
-                             &timeout);
-            rt_timer_start(&(thread->thread_timer));
-        }
-
-        rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-
-        /* re-schedule */
-        rt_schedule();
-
-        /* recv message */
-        if (thread->error != RT_EOK)
-        {
-            /* return error */
-            return thread->error;
-        }
-
-        level = rt_spin_lock_irqsave(&(mq->spinlock));
-
-        /* if it's not waiting forever and then re-calculate timeout tick */
-        if (timeout > 0)
-        {
-            tick_delta = rt_tick_get() - tick_delta;
-            timeout -= tick_delta;
-            if (timeout < 0)
-                timeout = 0;
-        }
-    }
-
-    /* get message from queue */
-    msg = (struct rt_mq_message *)mq->msg_queue_head;
-
-    /* move message queue head */
-    mq->msg_queue_head = msg->next;
-    /* reach queue tail, set to NULL */
-    if (mq->msg_queue_tail == msg)
-        mq->msg_queue_tail = RT_NULL;
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
 
-    /* decrease message entry */
-    if(mq->entry > 0)
-    {
-        mq->entry --;
-    }
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
 
-    rt_spin_unlock_irqrestore(&(mq->spinlock), level);
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
+
+    ret = _mq_get_msg(mq, &msg, timeout, suspend_flag);
+    if (ret != RT_EOK)
+        return ret;
 
     /* get real message length */
     len = ((struct rt_mq_message *)msg)->length;
@@ -3883,29 +4840,10 @@ static rt_ssize_t _rt_mq_recv(rt_mq_t mq,
     if (prio != RT_NULL)
         *prio = msg->prio;
 #endif
-    level = rt_spin_lock_irqsave(&(mq->spinlock));
-    /* put message to free list */
-    msg->next = (struct rt_mq_message *)mq->msg_queue_free;
-    mq->msg_queue_free = msg;
-
-    /* resume suspended thread */
-    if (!rt_list_isempty(&(mq->suspend_sender_thread)))
-    {
-        rt_susp_list_dequeue(&(mq->suspend_sender_thread), RT_EOK);
-
-        rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-
-        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
-
-        rt_schedule();
-
-        return len;
-    }
-
-    rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-
     RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
 
+    _mq_put_free(mq, msg);
+
     return len;
 }
 
@@ -3955,6 +4893,223 @@ rt_ssize_t rt_mq_recv_prio(rt_mq_t mq,
 }
 #endif
 RTM_EXPORT(rt_mq_recv_killable);
+
+#ifdef RT_USING_MESSAGEQUEUE_ZEROCOPY
+/* the message node of a slot handed out by reserve or borrow */
+static struct rt_mq_message *_mq_slot_to_msg(rt_mq_t mq, void *buffer)
+{
+    struct rt_mq_message *msg = (struct rt_mq_message *)buffer - 1;
+    rt_size_t msg_stride = RT_ALIGN(mq->msg_size, RT_ALIGN_SIZE) + sizeof(struct rt_mq_message);
+
+    RT_ASSERT((rt_uint8_t *)msg >= (rt_uint8_t *)mq->msg_pool);
+    RT_ASSERT((rt_uint8_t *)msg < (rt_uint8_t *)mq->msg_pool + mq->max_msgs * msg_stride);
+    RT_ASSERT(((rt_uint8_t *)msg - (rt_uint8_t *)mq->msg_pool) % msg_stride == 0);
+    RT_UNUSED(msg_stride);
+
+    return msg;
+}
+
+/**
+ * @brief    This function will reserve a message slot in the messagequeue, so
+ *           that the sender can fill the message in place instead of copying it.
+ *
+ * @note     The slot is msg_size bytes long and stays with the caller until it
+ *           is passed to rt_mq_send_commit(), rt_mq_urgent_commit() or
+ *           rt_mq_send_cancel(). If the messagequeue is full, the caller waits
+ *           for a slot up to timeout ticks.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is a pointer to store the address of the reserved slot.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the
+ *           operation is successful. -RT_EFULL means that no slot is free.
+ *
+ * @warning  This function can be called in interrupt context with a zero timeout.
+ */
+rt_err_t rt_mq_send_reserve(rt_mq_t mq, void **buffer, rt_int32_t timeout)
+{
+    struct rt_mq_message *msg;
+    rt_err_t ret;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    ret = _mq_get_free(mq, &msg, timeout, RT_UNINTERRUPTIBLE);
+    if (ret != RT_EOK)
+        return ret;
+
+    *buffer = GET_MESSAGEBYTE_ADDR(msg);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_send_reserve);
+
+static rt_err_t _rt_mq_send_commit(rt_mq_t mq, void *buffer, rt_size_t size,
+                                   rt_int32_t prio, rt_bool_t urgent)
+{
+    struct rt_mq_message *msg;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    msg = _mq_slot_to_msg(mq, buffer);
+
+    /* the reservation is given back on a bad size */
+    if (size == 0 || size > mq->msg_size)
+    {
+        _mq_put_free(mq, msg);
+        return -RT_ERROR;
+    }
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+
+    msg->length = size;
+
+    return _mq_link_msg(mq, msg, prio, urgent);
+}
+
+/**
+ * @brief    This function will send the message filled in a reserved slot.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is the slot got by rt_mq_send_reserve().
+ *
+ * @param    size is the length of the message(Unit: Byte).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the
+ *           operation is successful. The slot belongs to the messagequeue again
+ *           whatever the return value is.
+ */
+rt_err_t rt_mq_send_commit(rt_mq_t mq, void *buffer, rt_size_t size)
+{
+    return _rt_mq_send_commit(mq, buffer, size, 0, RT_FALSE);
+}
+RTM_EXPORT(rt_mq_send_commit);
+
+#ifdef RT_USING_MESSAGEQUEUE_PRIORITY
+rt_err_t rt_mq_send_commit_prio(rt_mq_t mq, void *buffer, rt_size_t size, rt_int32_t prio)
+{
+    return _rt_mq_send_commit(mq, buffer, size, prio, RT_FALSE);
+}
+RTM_EXPORT(rt_mq_send_commit_prio);
+#endif /* RT_USING_MESSAGEQUEUE_PRIORITY */
+
+/**
+ * @brief    This function will send the message filled in a reserved slot as
+ *           an urgent message, which is placed at the head of the messagequeue.
+ *
+ * @see      rt_mq_send_commit()
+ */
+rt_err_t rt_mq_urgent_commit(rt_mq_t mq, void *buffer, rt_size_t size)
+{
+    return _rt_mq_send_commit(mq, buffer, size, 0, RT_TRUE);
+}
+RTM_EXPORT(rt_mq_urgent_commit);
+
+/**
+ * @brief    This function will give a reserved slot back without sending it.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is the slot got by rt_mq_send_reserve().
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the
+ *           operation is successful.
+ */
+rt_err_t rt_mq_send_cancel(rt_mq_t mq, void *buffer)
+{
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    _mq_put_free(mq, _mq_slot_to_msg(mq, buffer));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_send_cancel);
+
+/**
+ * @brief    This function will receive a message from the messagequeue without
+ *           copying it out, the receiver works on the slot in place.
+ *
+ * @note     The slot is taken off the messagequeue in the same order as
+ *           rt_mq_recv() does, so priority and urgent messages come first. It
+ *           stays with the caller until rt_mq_recv_release() is called, which
+ *           means a borrowed slot can not be used by a sender in the meantime.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is a pointer to store the address of the message.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the real length of the message. When the return value is
+ *           larger than zero, the operation is successful.
+ */
+rt_ssize_t rt_mq_recv_borrow(rt_mq_t mq, void **buffer, rt_int32_t timeout)
+{
+    struct rt_mq_message *msg;
+    rt_err_t ret;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
+
+    ret = _mq_get_msg(mq, &msg, timeout, RT_UNINTERRUPTIBLE);
+    if (ret != RT_EOK)
+        return ret;
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+
+    *buffer = GET_MESSAGEBYTE_ADDR(msg);
+
+    return msg->length;
+}
+RTM_EXPORT(rt_mq_recv_borrow);
+
+/**
+ * @brief    This function will give a borrowed message slot back to the
+ *           messagequeue, a sender waiting for a free slot will be resumed.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is the slot got by rt_mq_recv_borrow().
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the
+ *           operation is successful.
+ */
+rt_err_t rt_mq_recv_release(rt_mq_t mq, void *buffer)
+{
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    _mq_put_free(mq, _mq_slot_to_msg(mq, buffer));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_recv_release);
+#endif /* RT_USING_MESSAGEQUEUE_ZEROCOPY */
+
 /**
  * @brief    This function will set some extra attributions of a messagequeue object.
  *
@@ -4022,4 +5177,165 @@ RTM_EXPORT(rt_mq_control);
 
 /**@}*/
 #endif /* RT_USING_MESSAGEQUEUE */
+
+#ifdef RT_USING_IPC_WAIT_ANY
+/* the spinlock of the object waited by an item, RT_NULL if it can't be waited */
+static struct rt_spinlock *_wait_any_spinlock(struct rt_wait_any_item *item)
+{
+    switch (rt_object_get_type(item->object))
+    {
+#ifdef RT_USING_SEMAPHORE
+    case RT_Object_Class_Semaphore:
+        return &(((rt_sem_t)item->object)->spinlock);
+#endif
+#ifdef RT_USING_EVENT
+    case RT_Object_Class_Event:
+        return item->set ? &(((rt_event_t)item->object)->spinlock) : RT_NULL;
+#endif
+#ifdef RT_USING_MAILBOX
+    case RT_Object_Class_MailBox:
+        return &(((rt_mailbox_t)item->object)->spinlock);
+#endif
+#ifdef RT_USING_MESSAGEQUEUE
+    case RT_Object_Class_MessageQueue:
+        return &(((rt_mq_t)item->object)->spinlock);
+#endif
+    default:
+        return RT_NULL;
+    }
+}
+
+/* whether the object can be taken without waiting, the spinlock of object is held */
+static rt_bool_t _wait_any_ready(struct rt_wait_any_item *item)
+{
+    switch (rt_object_get_type(item->object))
+    {
+#ifdef RT_USING_SEMAPHORE
+    case RT_Object_Class_Semaphore:
+        return ((rt_sem_t)item->object)->value > 0;
+#endif
+#ifdef RT_USING_EVENT
+    case RT_Object_Class_Event:
+        return (((rt_event_t)item->object)->set & item->set) != 0;
+#endif
+#ifdef RT_USING_MAILBOX
+    case RT_Object_Class_MailBox:
+        return ((rt_mailbox_t)item->object)->entry > 0;
+#endif
+#ifdef RT_USING_MESSAGEQUEUE
+    case RT_Object_Class_MessageQueue:
+        return ((rt_mq_t)item->object)->entry > 0;
+#endif
+    default:
+        return RT_FALSE;
+    }
+}
+
+/**
+ * @brief    This function will wait until any one of several IPC objects becomes ready, that is,
+ *           a semaphore has value, an event has one of the given bits set, or a mailbox or a
+ *           messagequeue has a message.
+ *
+ * @note     Nothing is taken from the ready object. The caller takes it with RT_WAITING_NO, which
+ *           may fail if another thread takes it first, and then waits again.
+ *           The objects must not be detached or deleted while they are waited.
+ *
+ * @param    items is an array of the objects to wait for. For an event object, the set field
+ *           is the events to wait for, any one of them is enough.
+ *
+ * @param    count is the number of items.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the index of the ready item when the value is not negative. -RT_ETIMEOUT means
+ *           no object is ready in the timeout period, -RT_EINVAL means an item can't be waited.
+ */
+rt_ssize_t rt_wait_any(struct rt_wait_any_item *items, rt_size_t count, rt_int32_t timeout)
+{
+    struct rt_wait_any wait;
+    struct rt_thread *thread;
+    struct rt_spinlock *lock;
+    rt_base_t level;
+    rt_size_t i;
+    rt_err_t ret;
+
+    RT_ASSERT(items != RT_NULL);
+    RT_ASSERT(count != 0);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    for (i = 0; i < count; i++)
+    {
+        RT_ASSERT(items[i].object != RT_NULL);
+        if (_wait_any_spinlock(&items[i]) == RT_NULL)
+            return -RT_EINVAL;
+    }
+
+    thread = rt_thread_self();
+    rt_spin_lock_init(&(wait.spinlock));
+    rt_list_init(&(wait.susp_list));
+    wait.fired = RT_NULL;
+
+    /* hook on all the objects before checking them, so no wakeup is missed */
+    for (i = 0; i < count; i++)
+    {
+        lock = _wait_any_spinlock(&items[i]);
+        level = rt_spin_lock_irqsave(lock);
+
+        items[i].wait = &wait;
+        rt_list_insert_before(&(((struct rt_ipc_object *)items[i].object)->wait_any_list), &(items[i].node));
+
+        rt_spin_lock(&(wait.spinlock));
+        if (wait.fired == RT_NULL && _wait_any_ready(&items[i]))
+            wait.fired = &items[i];
+        rt_spin_unlock(&(wait.spinlock));
+
+        rt_spin_unlock_irqrestore(lock, level);
+    }
+
+    ret = -RT_ETIMEOUT;
+    level = rt_spin_lock_irqsave(&(wait.spinlock));
+    if (wait.fired != RT_NULL || timeout == 0)
+    {
+        rt_spin_unlock_irqrestore(&(wait.spinlock), level);
+    }
+    else
+    {
+        thread->error = RT_EOK;
+        ret = rt_thread_suspend_to_list(thread, &(wait.susp_list), RT_IPC_FLAG_FIFO, RT_UNINTERRUPTIBLE);
+        if (ret == RT_EOK && timeout > 0)
+        {
+            rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, &timeout);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        rt_spin_unlock_irqrestore(&(wait.spinlock), level);
+
+        if (ret == RT_EOK)
+        {
+            rt_schedule();
+
+            ret = thread->error;
+            ret = ret > 0 ? -ret : ret;
+        }
+    }
+
+    /* no one touches the wait context after it's unhooked from all the objects */
+    for (i = 0; i < count; i++)
+    {
+        lock = _wait_any_spinlock(&items[i]);
+        level = rt_spin_lock_irqsave(lock);
+        rt_list_remove(&(items[i].node));
+        rt_spin_unlock_irqrestore(lock, level);
+    }
+
+    /* an object may become ready just after the timeout */
+    if (wait.fired != RT_NULL)
+        return wait.fired - items;
+
+    return ret;
+}
+RTM_EXPORT(rt_wait_any);
+#endif /* RT_USING_IPC_WAIT_ANY */
 /**@}*/
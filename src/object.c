@@ -80,6 +80,12 @@ enum rt_object_info_type
 #endif
 #ifdef RT_USING_HEAP
     RT_Object_Info_Custom,                             /**< The object is a custom object */
+#endif
+#ifdef RT_USING_RWLOCK
+    RT_Object_Info_RWLock,                             /**< The object is a reader-writer lock. */
+#endif
+#ifdef RT_USING_FASTLOCK
+    RT_Object_Info_FastLock,                           /**< The object is a fast lock. */
 #endif
     RT_Object_Info_Unknown,                            /**< The object is unknown. */
 };
@@ -142,6 +148,14 @@ static struct rt_object_information _object_container[RT_Object_Info_Unknown] =
 #ifdef RT_USING_HEAP
     {RT_Object_Class_Custom, _OBJ_CONTAINER_LIST_INIT(RT_Object_Info_Custom), sizeof(struct rt_custom_object), RT_SPINLOCK_INIT},
 #endif
+#ifdef RT_USING_RWLOCK
+    /* initialize object container - reader-writer lock */
+    {RT_Object_Class_RWLock, _OBJ_CONTAINER_LIST_INIT(RT_Object_Info_RWLock), sizeof(struct rt_rwlock), RT_SPINLOCK_INIT},
+#endif
+#ifdef RT_USING_FASTLOCK
+    /* initialize object container - fast lock */
+    {RT_Object_Class_FastLock, _OBJ_CONTAINER_LIST_INIT(RT_Object_Info_FastLock), sizeof(struct rt_fastlock), RT_SPINLOCK_INIT},
+#endif
 };
 
 #if defined(RT_USING_HOOK) && defined(RT_HOOK_USING_FUNC_PTR)
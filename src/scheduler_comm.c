@@ -8,6 +8,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2024-01-18     Shell        Separate scheduling related codes from thread.c, scheduler_.*
+ * 2026-10-19     agent        add load balancing and RCU quiescent state on tick
+ * 2026-10-19     agent        add earliest-deadline-first scheduling class
  */
 
 #define DBG_TAG           "kernel.sched"
@@ -16,6 +18,323 @@
 
 #include <rtthread.h>
 
+#ifdef RT_USING_SCHED_EDF
+
+#if RT_SCHED_EDF_PRIORITY >= RT_THREAD_PRIORITY_MAX
+#error "RT_SCHED_EDF_PRIORITY must be lower than RT_THREAD_PRIORITY_MAX"
+#endif
+
+/* bandwidth admitted to the EDF threads on each core, in per mille */
+static rt_uint32_t _edf_bandwidth[RT_CPUS_NR];
+
+#define _EDF_BANDWIDTH(runtime, period) \
+    ((rt_uint32_t)(((rt_uint64_t)(runtime) * 1000 + (period) - 1) / (period)))
+
+/* whether tick a is before tick b, the tick may wrap around */
+rt_inline rt_bool_t _edf_before(rt_tick_t a, rt_tick_t b)
+{
+    return a != b && (rt_tick_t)(b - a) < RT_TICK_MAX / 2;
+}
+
+/**
+ * The core an EDF thread is admitted on: the bound one, or the one with the
+ * least EDF bandwidth for an unbound thread. The old bandwidth of thread is
+ * given back by the caller already.
+ */
+static int _edf_admit_cpu(struct rt_thread *thread)
+{
+    int cpu = 0;
+
+#ifdef RT_USING_SMP
+    if (RT_SCHED_CTX(thread).bind_cpu < RT_CPUS_NR)
+    {
+        return RT_SCHED_CTX(thread).bind_cpu;
+    }
+
+    for (int i = 1; i < RT_CPUS_NR; i++)
+    {
+        if (_edf_bandwidth[i] < _edf_bandwidth[cpu])
+        {
+            cpu = i;
+        }
+    }
+#endif /* RT_USING_SMP */
+
+    return cpu;
+}
+
+/* change the base priority, a priority boosted by a held mutex is kept until it's released */
+static void _edf_set_base_priority(struct rt_thread *thread, rt_uint8_t priority)
+{
+    rt_uint8_t current = RT_SCHED_PRIV(thread).current_priority;
+    rt_bool_t boosted = current < RT_SCHED_PRIV(thread).init_priority;
+
+    RT_SCHED_PRIV(thread).init_priority = priority;
+    if (boosted && current < priority)
+    {
+        priority = current;
+    }
+    rt_sched_thread_change_priority(thread, priority);
+}
+
+/**
+ * @brief Set the EDF parameters of a thread, or move it back to the fixed
+ *        priority class with a zero runtime. The parameters are refused if the
+ *        EDF bandwidth of the core the thread is admitted on would exceed
+ *        RT_SCHED_EDF_UTIL_MAX percent.
+ *
+ * @note Caller must hold the scheduler lock
+ */
+rt_err_t rt_sched_thread_set_deadline(struct rt_thread *thread, const struct rt_thread_deadline_attr *attr)
+{
+    struct rt_sched_edf *edf = &RT_SCHED_PRIV(thread).edf;
+    rt_uint32_t old_bw = 0, new_bw = 0;
+    rt_tick_t now;
+    int cpu;
+
+    RT_SCHED_DEBUG_IS_LOCKED;
+
+    if (attr->runtime != 0)
+    {
+        if (attr->period == 0 || attr->deadline == 0 ||
+            attr->deadline > attr->period || attr->runtime > attr->deadline)
+        {
+            return -RT_EINVAL;
+        }
+        new_bw = _EDF_BANDWIDTH(attr->runtime, attr->period);
+    }
+
+    if (RT_SCHED_IS_EDF(thread))
+    {
+        old_bw = _EDF_BANDWIDTH(edf->runtime, edf->period);
+    }
+
+    /* admission control, global EDF gives no guarantee above one core of bandwidth */
+    _edf_bandwidth[edf->cpu] -= old_bw;
+    cpu = _edf_admit_cpu(thread);
+    if (_edf_bandwidth[cpu] + new_bw > RT_SCHED_EDF_UTIL_MAX * 10)
+    {
+        _edf_bandwidth[edf->cpu] += old_bw;
+        return -RT_EFULL;
+    }
+    _edf_bandwidth[cpu] += new_bw;
+    edf->cpu = cpu;
+
+    if (attr->runtime == 0)
+    {
+        if (old_bw != 0)
+        {
+            edf->runtime = 0;
+            _edf_set_base_priority(thread, edf->saved_priority);
+        }
+        return RT_EOK;
+    }
+
+    if (old_bw == 0)
+    {
+        edf->saved_priority = RT_SCHED_PRIV(thread).init_priority;
+        edf->misses = 0;
+    }
+
+    /* the first job is released right now */
+    now = rt_tick_get();
+    edf->runtime = attr->runtime;
+    edf->deadline = attr->deadline;
+    edf->period = attr->period;
+    edf->release = now;
+    edf->abs_deadline = now + attr->deadline;
+    edf->budget = attr->runtime;
+
+    /* a ready thread is queued again in deadline order */
+    _edf_set_base_priority(thread, RT_SCHED_EDF_PRIORITY);
+
+    return RT_EOK;
+}
+
+/**
+ * @brief Move the admitted bandwidth of an EDF thread to the core it's going
+ *        to be bound on, it's refused if the core has no room for it.
+ *
+ * @note Caller must hold the scheduler lock
+ */
+rt_err_t rt_sched_edf_bind_cpu(struct rt_thread *thread, int cpu)
+{
+    struct rt_sched_edf *edf = &RT_SCHED_PRIV(thread).edf;
+    rt_uint32_t bw;
+
+    RT_SCHED_DEBUG_IS_LOCKED;
+
+    if (!RT_SCHED_IS_EDF(thread) || cpu >= RT_CPUS_NR || cpu == edf->cpu)
+    {
+        return RT_EOK;
+    }
+
+    bw = _EDF_BANDWIDTH(edf->runtime, edf->period);
+    if (_edf_bandwidth[cpu] + bw > RT_SCHED_EDF_UTIL_MAX * 10)
+    {
+        return -RT_EFULL;
+    }
+    _edf_bandwidth[edf->cpu] -= bw;
+    _edf_bandwidth[cpu] += bw;
+    edf->cpu = cpu;
+
+    return RT_EOK;
+}
+
+/**
+ * @note Caller must hold the scheduler lock
+ */
+rt_err_t rt_sched_thread_get_deadline(struct rt_thread *thread, struct rt_thread_deadline_attr *attr)
+{
+    struct rt_sched_edf *edf = &RT_SCHED_PRIV(thread).edf;
+
+    RT_SCHED_DEBUG_IS_LOCKED;
+
+    attr->runtime = edf->runtime;
+    attr->deadline = RT_SCHED_IS_EDF(thread) ? edf->deadline : 0;
+    attr->period = RT_SCHED_IS_EDF(thread) ? edf->period : 0;
+    attr->misses = edf->misses;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief Finish the current job of an EDF thread. A miss is counted if it's
+ *        finished after the deadline, and the releases already too late for
+ *        their deadlines are skipped and counted as misses as well.
+ *
+ * @param release is the tick to release the next job.
+ *
+ * @note Caller must hold the scheduler lock
+ */
+rt_err_t rt_sched_thread_next_period(struct rt_thread *thread, rt_tick_t *release)
+{
+    struct rt_sched_edf *edf = &RT_SCHED_PRIV(thread).edf;
+    rt_tick_t now;
+
+    RT_SCHED_DEBUG_IS_LOCKED;
+
+    if (!RT_SCHED_IS_EDF(thread))
+    {
+        return -RT_EINVAL;
+    }
+
+    now = rt_tick_get();
+    if (_edf_before(edf->release + edf->deadline, now))
+    {
+        edf->misses++;
+    }
+
+    edf->release += edf->period;
+    while (_edf_before(edf->release + edf->deadline, now))
+    {
+        edf->release += edf->period;
+        edf->misses++;
+    }
+
+    edf->abs_deadline = edf->release + edf->deadline;
+    edf->budget = edf->runtime;
+    *release = edf->release;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief Insert a thread to the ready queue of the EDF level. The EDF threads
+ *        are ordered by absolute deadline, ahead of the threads of the fixed
+ *        priority class on the same level, which keep their round-robin order
+ *        behind them.
+ *
+ * @note Caller must hold the scheduler lock
+ */
+void rt_sched_edf_enqueue(rt_list_t *queue, struct rt_thread *thread)
+{
+    struct rt_sched_edf *edf = &RT_SCHED_PRIV(thread).edf;
+    struct rt_list_node *node;
+    struct rt_thread *queued;
+    rt_tick_t now;
+
+    if (!RT_SCHED_IS_EDF(thread))
+    {
+        /* there is no time slices left(YIELD), inserting thread before ready list */
+        if ((RT_SCHED_CTX(thread).stat & RT_THREAD_STAT_YIELD_MASK) != 0)
+        {
+            rt_list_insert_before(queue, &RT_THREAD_LIST_NODE(thread));
+            return;
+        }
+
+        /* or the first one after the EDF threads */
+        rt_list_for_each(node, queue)
+        {
+            if (!RT_SCHED_IS_EDF(RT_THREAD_LIST_NODE_ENTRY(node)))
+            {
+                break;
+            }
+        }
+        rt_list_insert_before(node, &RT_THREAD_LIST_NODE(thread));
+        return;
+    }
+
+    /* wake up after the deadline, the server starts a new period */
+    now = rt_tick_get();
+    if (!_edf_before(now, edf->abs_deadline))
+    {
+        edf->abs_deadline = now + edf->deadline;
+        edf->budget = edf->runtime;
+    }
+
+    rt_list_for_each(node, queue)
+    {
+        queued = RT_THREAD_LIST_NODE_ENTRY(node);
+        if (!RT_SCHED_IS_EDF(queued) ||
+            _edf_before(edf->abs_deadline, RT_SCHED_PRIV(queued).edf.abs_deadline))
+        {
+            break;
+        }
+    }
+    rt_list_insert_before(node, &RT_THREAD_LIST_NODE(thread));
+}
+
+/**
+ * @brief Whether the next thread of the same priority goes before the running
+ *        thread, an EDF thread with an earlier deadline or one over a thread
+ *        of the fixed priority class.
+ */
+rt_bool_t rt_sched_edf_preempt(struct rt_thread *thread, struct rt_thread *next)
+{
+    if (next == RT_NULL || !RT_SCHED_IS_EDF(next))
+    {
+        return RT_FALSE;
+    }
+
+    return !RT_SCHED_IS_EDF(thread) ||
+           _edf_before(RT_SCHED_PRIV(next).edf.abs_deadline, RT_SCHED_PRIV(thread).edf.abs_deadline);
+}
+
+/* charge a tick to the budget, the deadline is postponed when it's used up */
+static rt_bool_t _sched_edf_tick(struct rt_thread *thread)
+{
+    struct rt_sched_edf *edf = &RT_SCHED_PRIV(thread).edf;
+
+    if (edf->budget > 0)
+    {
+        edf->budget--;
+    }
+
+    if (edf->budget == 0)
+    {
+        edf->abs_deadline += edf->period;
+        edf->budget = edf->runtime;
+
+        /* queue it again by the new deadline */
+        rt_sched_thread_yield(thread);
+        return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+#endif /* RT_USING_SCHED_EDF */
+
 void rt_sched_thread_init_ctx(struct rt_thread *thread, rt_uint32_t tick, rt_uint8_t priority)
 {
     /* setup thread status */
@@ -25,8 +344,18 @@ void rt_sched_thread_init_ctx(struct rt_thread *thread, rt_uint32_t tick, rt_uin
     /* not bind on any cpu */
     RT_SCHED_CTX(thread).bind_cpu = RT_CPUS_NR;
     RT_SCHED_CTX(thread).oncpu = RT_CPU_DETACHED;
+    RT_SCHED_CTX(thread).last_cpu = RT_CPUS_NR;
+    RT_SCHED_CTX(thread).migrations = 0;
+#ifdef RT_SCHED_USING_PERCPU_RUNQUEUE
+    RT_SCHED_CTX(thread).home_cpu = RT_CPUS_NR;
+#endif
 #endif /* RT_USING_SMP */
 
+#ifdef RT_USING_SCHED_EDF
+    /* in the fixed priority class */
+    rt_memset(&RT_SCHED_PRIV(thread).edf, 0, sizeof(RT_SCHED_PRIV(thread).edf));
+#endif
+
     rt_sched_thread_init_priv(thread, tick, priority);
 }
 
@@ -87,6 +416,17 @@ rt_err_t rt_sched_thread_close(struct rt_thread *thread)
 {
     RT_SCHED_DEBUG_IS_LOCKED;
     RT_SCHED_CTX(thread).stat = RT_THREAD_CLOSE;
+
+#ifdef RT_USING_SCHED_EDF
+    /* give the bandwidth back */
+    if (RT_SCHED_IS_EDF(thread))
+    {
+        _edf_bandwidth[RT_SCHED_PRIV(thread).edf.cpu] -=
+            _EDF_BANDWIDTH(RT_SCHED_PRIV(thread).edf.runtime, RT_SCHED_PRIV(thread).edf.period);
+        RT_SCHED_PRIV(thread).edf.runtime = 0;
+    }
+#endif /* RT_USING_SCHED_EDF */
+
     return RT_EOK;
 }
 
@@ -148,23 +488,54 @@ rt_err_t rt_sched_tick_increase(void)
 {
     struct rt_thread *thread;
     rt_sched_lock_level_t slvl;
+    rt_bool_t need_resched = RT_FALSE;
 
     thread = rt_thread_self();
 
+#if defined(RT_USING_RCU) && defined(RT_USING_SMP)
+    /* the interrupted thread is not in a reader if the scheduler is not locked */
+    if (rt_critical_level() == 0)
+    {
+        rt_rcu_quiescent_state();
+    }
+#endif /* RT_USING_RCU && RT_USING_SMP */
+
     rt_sched_lock(&slvl);
 
-    RT_SCHED_PRIV(thread).remaining_tick--;
-    if (RT_SCHED_PRIV(thread).remaining_tick)
+#ifdef RT_USING_SCHED_EDF
+    /* an EDF thread runs out of its budget instead of time slices */
+    if (RT_SCHED_IS_EDF(thread))
     {
-        rt_sched_unlock(slvl);
+        need_resched = _sched_edf_tick(thread);
     }
     else
+#endif /* RT_USING_SCHED_EDF */
     {
-        rt_sched_thread_yield(thread);
+        RT_SCHED_PRIV(thread).remaining_tick--;
+        if (RT_SCHED_PRIV(thread).remaining_tick == 0)
+        {
+            rt_sched_thread_yield(thread);
+            need_resched = RT_TRUE;
+        }
+    }
+
+#ifdef RT_SCHED_USING_PERCPU_RUNQUEUE
+    /* a thread pulled from other core may preempt current thread */
+    if (rt_sched_balance_tick())
+    {
+        need_resched = RT_TRUE;
+    }
+#endif /* RT_SCHED_USING_PERCPU_RUNQUEUE */
 
+    if (need_resched)
+    {
         /* request a rescheduling even though we are probably in an ISR */
         rt_sched_unlock_n_resched(slvl);
     }
+    else
+    {
+        rt_sched_unlock(slvl);
+    }
 
     return RT_EOK;
 }
@@ -33,6 +33,10 @@
  * 2023-12-10     xqyjlj       use rt_hw_spinlock
  * 2024-01-05     Shell        Fixup of data racing in rt_critical_level
  * 2024-01-18     Shell        support rt_sched_thread of scheduling status for better mt protection
+ * 2026-10-19     agent        add per-cpu run queues of unbound threads with load balancing
+ * 2026-10-19     agent        place woken threads by cache affinity and count migrations
+ * 2026-10-19     agent        report RCU quiescent state on context switch
+ * 2026-10-19     agent        order EDF threads by deadline
  */
 
 #include <rtthread.h>
@@ -225,7 +229,14 @@ static struct rt_thread* _scheduler_get_highest_priority_thread(rt_ubase_t *high
     local_highest_ready_priority = _get_local_highest_ready_prio(pcpu);
 
     /* get highest ready priority thread */
-    if (highest_ready_priority < local_highest_ready_priority)
+    if (highest_ready_priority < local_highest_ready_priority
+#ifdef RT_USING_SCHED_EDF
+        /* the earlier deadline goes first on the same level */
+        || (highest_ready_priority == local_highest_ready_priority && highest_ready_priority != -1 &&
+            rt_sched_edf_preempt(RT_THREAD_LIST_NODE_ENTRY(pcpu->priority_table[highest_ready_priority].next),
+                                 RT_THREAD_LIST_NODE_ENTRY(rt_thread_priority_table[highest_ready_priority].next)))
+#endif /* RT_USING_SCHED_EDF */
+        )
     {
         *highest_prio = highest_ready_priority;
 
@@ -251,6 +262,259 @@ static struct rt_thread* _scheduler_get_highest_priority_thread(rt_ubase_t *high
     return highest_priority_thread;
 }
 
+/* dedicate the core to a thread, and count a migration if it ran elsewhere last time */
+rt_inline void _sched_set_oncpu(struct rt_thread *thread, int cpu_id)
+{
+    RT_SCHED_CTX(thread).oncpu = cpu_id;
+    if (RT_SCHED_CTX(thread).last_cpu != cpu_id)
+    {
+        if (RT_SCHED_CTX(thread).last_cpu != RT_CPUS_NR)
+        {
+            RT_SCHED_CTX(thread).migrations++;
+        }
+        RT_SCHED_CTX(thread).last_cpu = cpu_id;
+    }
+}
+
+#ifdef RT_SCHED_USING_PERCPU_RUNQUEUE
+/* the core whose ready queue holds the thread */
+#define SCHED_QUEUE_CPU(thread)                              \
+    (RT_SCHED_CTX(thread).bind_cpu != RT_CPUS_NR ?           \
+     RT_SCHED_CTX(thread).bind_cpu : RT_SCHED_CTX(thread).home_cpu)
+
+/* queued unbound threads plus the running one if the core is not idle */
+rt_inline int _sched_cpu_load(struct rt_cpu *pcpu)
+{
+    return pcpu->nr_ready + (pcpu->current_thread != pcpu->idle_thread);
+}
+
+/**
+ * @brief   choose the core queuing an unbound thread
+ *
+ * The core it ran on last time is preferred if it is idle, since the cache
+ * may still be warm. Otherwise the core of the waker is taken if the thread
+ * can preempt there, so a consumer shares the cache with its producer.
+ * Failing that, the least loaded core it can preempt on is picked. If no
+ * core can be preempted, it waits on its previous core.
+ *
+ * @note    caller must holding the `_mp_scheduler_lock` lock
+ */
+static int _sched_select_cpu_locked(struct rt_thread *thread)
+{
+    int cpu, best_cpu, load, best_load;
+    int prev_cpu = RT_SCHED_CTX(thread).last_cpu;
+    int waker_cpu = rt_hw_cpu_id();
+    rt_uint8_t prio = RT_SCHED_PRIV(thread).current_priority;
+    struct rt_cpu *pcpu;
+
+    if (prev_cpu < RT_CPUS_NR && _sched_cpu_load(rt_cpu_index(prev_cpu)) == 0)
+    {
+        return prev_cpu;
+    }
+
+    if (prio < rt_cpu_index(waker_cpu)->current_priority)
+    {
+        return waker_cpu;
+    }
+
+    best_cpu = prev_cpu;
+    best_load = -1;
+    for (cpu = 0; cpu < RT_CPUS_NR; cpu++)
+    {
+        pcpu = rt_cpu_index(cpu);
+        if (prio >= pcpu->current_priority)
+            continue;
+
+        load = _sched_cpu_load(pcpu);
+        if (best_load < 0 || load < best_load)
+        {
+            best_cpu = cpu;
+            best_load = load;
+        }
+    }
+
+    if (best_cpu >= RT_CPUS_NR)
+    {
+        /* never ran before and no core can be preempted */
+        best_cpu = waker_cpu;
+    }
+
+    return best_cpu;
+}
+
+static void _sched_enqueue_locked(struct rt_thread *thread, int cpu_id, int queue_cpu);
+static void _sched_remove_thread_locked(struct rt_thread *thread);
+
+/**
+ * @brief   migrate the highest priority unbound thread queued on a core
+ *
+ * @param   src the core to take the thread from
+ * @param   prio_limit only a thread of a priority higher than this is taken
+ * @param   cpu_id the pulling core
+ *
+ * @return  the pulled thread, or RT_NULL if there is none
+ *
+ * @note    caller must holding the `_mp_scheduler_lock` lock
+ */
+static struct rt_thread *_sched_take_locked(struct rt_cpu *src, rt_ubase_t prio_limit, int cpu_id)
+{
+    rt_ubase_t prio;
+    struct rt_list_node *node;
+    struct rt_thread *thread;
+
+    for (prio = 0; prio < prio_limit; prio++)
+    {
+        rt_list_for_each(node, &src->priority_table[prio])
+        {
+            thread = RT_THREAD_LIST_NODE_ENTRY(node);
+            if (RT_SCHED_CTX(thread).bind_cpu != RT_CPUS_NR)
+                continue;
+
+            /* migrate to the pulling core, it stays READY */
+            _sched_remove_thread_locked(thread);
+            RT_SCHED_CTX(thread).home_cpu = cpu_id;
+            rt_cpu_index(cpu_id)->nr_ready++;
+            _sched_enqueue_locked(thread, cpu_id, cpu_id);
+
+            return thread;
+        }
+    }
+
+    return RT_NULL;
+}
+
+/**
+ * @brief   pull the highest priority unbound thread of the busiest core
+ *
+ * @param   cpu_id the pulling core
+ * @param   imbalance the minimal difference of queued threads to pull
+ *
+ * @return  the pulled thread, or RT_NULL if the load is balanced
+ *
+ * @note    caller must holding the `_mp_scheduler_lock` lock
+ */
+static struct rt_thread *_sched_pull_locked(int cpu_id, int imbalance)
+{
+    int cpu, busiest = -1;
+    struct rt_cpu *pcpu = rt_cpu_index(cpu_id);
+
+    for (cpu = 0; cpu < RT_CPUS_NR; cpu++)
+    {
+        if (cpu == cpu_id)
+            continue;
+        if (busiest < 0 || rt_cpu_index(cpu)->nr_ready > rt_cpu_index(busiest)->nr_ready)
+            busiest = cpu;
+    }
+
+    if (busiest < 0 || rt_cpu_index(busiest)->nr_ready < pcpu->nr_ready + imbalance)
+        return RT_NULL;
+
+    return _sched_take_locked(rt_cpu_index(busiest), RT_THREAD_PRIORITY_MAX, cpu_id);
+}
+
+/**
+ * @brief   pull an unbound thread waiting on another core with a priority
+ *          higher than the one running on the pulling core
+ *
+ * @param   cpu_id the pulling core
+ * @param   prio the priority of the thread running on the pulling core
+ *
+ * @return  the pulled thread, or RT_NULL if no waiting thread beats it
+ *
+ * @note    caller must holding the `_mp_scheduler_lock` lock
+ */
+static struct rt_thread *_sched_pull_prio_locked(int cpu_id, rt_ubase_t prio)
+{
+    int cpu, best = -1;
+    rt_base_t highest, best_prio = prio;
+
+    for (cpu = 0; cpu < RT_CPUS_NR; cpu++)
+    {
+        if (cpu == cpu_id)
+            continue;
+        highest = _get_local_highest_ready_prio(rt_cpu_index(cpu));
+        if (highest >= 0 && highest < best_prio)
+        {
+            best = cpu;
+            best_prio = highest;
+        }
+    }
+
+    if (best < 0)
+        return RT_NULL;
+
+    return _sched_take_locked(rt_cpu_index(best), prio, cpu_id);
+}
+
+/**
+ * @brief   periodic load balancing of the per-cpu run queues
+ *
+ * @return  RT_TRUE if a thread was pulled to current core and a rescheduling
+ *          is required
+ *
+ * @note    caller must holding the scheduler lock
+ */
+rt_bool_t rt_sched_balance_tick(void)
+{
+    int cpu_id = rt_hw_cpu_id();
+    struct rt_cpu *pcpu = rt_cpu_self();
+
+    RT_SCHED_DEBUG_IS_LOCKED;
+
+    if (rt_atomic_load(&(pcpu->tick)) % RT_SCHED_BALANCE_INTERVAL)
+        return RT_FALSE;
+
+    /* a thread waiting on another core which would preempt the current one goes first */
+    if (_sched_pull_prio_locked(cpu_id, RT_SCHED_PRIV(pcpu->current_thread).current_priority))
+        return RT_TRUE;
+
+    /* an idle core takes any waiting thread, a busy one only evens out the queues */
+    return _sched_pull_locked(cpu_id,
+                              pcpu->current_thread == pcpu->idle_thread ? 1 : 2) != RT_NULL;
+}
+#endif /* RT_SCHED_USING_PERCPU_RUNQUEUE */
+
+/**
+ * @brief   insert a READY thread to the ready queue of a core
+ *
+ * @note    caller must holding the `_mp_scheduler_lock` lock
+ */
+static void _sched_enqueue_locked(struct rt_thread *thread, int cpu_id, int queue_cpu)
+{
+    struct rt_cpu *pcpu = rt_cpu_index(queue_cpu);
+
+#if RT_THREAD_PRIORITY_MAX > 32
+    pcpu->ready_table[RT_SCHED_PRIV(thread).number] |= RT_SCHED_PRIV(thread).high_mask;
+#endif /* RT_THREAD_PRIORITY_MAX > 32 */
+    pcpu->priority_group |= RT_SCHED_PRIV(thread).number_mask;
+
+#ifdef RT_USING_SCHED_EDF
+    /* EDF threads are ordered by their deadlines, ahead of the others on that level */
+    if (RT_SCHED_ON_EDF_LEVEL(thread))
+    {
+        rt_sched_edf_enqueue(&(pcpu->priority_table[RT_SCHED_PRIV(thread).current_priority]), thread);
+    }
+    else
+#endif /* RT_USING_SCHED_EDF */
+    /* there is no time slices left(YIELD), inserting thread before ready list*/
+    if((RT_SCHED_CTX(thread).stat & RT_THREAD_STAT_YIELD_MASK) != 0)
+    {
+        rt_list_insert_before(&(pcpu->priority_table[RT_SCHED_PRIV(thread).current_priority]),
+                              &RT_THREAD_LIST_NODE(thread));
+    }
+    /* there are some time slices left, inserting thread after ready list to schedule it firstly at next time*/
+    else
+    {
+        rt_list_insert_after(&(pcpu->priority_table[RT_SCHED_PRIV(thread).current_priority]),
+                             &RT_THREAD_LIST_NODE(thread));
+    }
+
+    if (cpu_id != queue_cpu)
+    {
+        rt_hw_ipi_send(RT_SCHEDULE_IPI, 1 << queue_cpu);
+    }
+}
+
 /**
  * @brief   set READY and insert thread to ready queue
  *
@@ -283,6 +547,16 @@ static void _sched_insert_thread_locked(struct rt_thread *thread)
     cpu_id   = rt_hw_cpu_id();
     bind_cpu = RT_SCHED_CTX(thread).bind_cpu;
 
+#ifdef RT_SCHED_USING_PERCPU_RUNQUEUE
+    /* unbound thread is queued on its home core, and only that core is notified */
+    if (bind_cpu == RT_CPUS_NR)
+    {
+        bind_cpu = _sched_select_cpu_locked(thread);
+        RT_SCHED_CTX(thread).home_cpu = bind_cpu;
+        rt_cpu_index(bind_cpu)->nr_ready++;
+    }
+#endif /* RT_SCHED_USING_PERCPU_RUNQUEUE */
+
     /* insert thread to ready list */
     if (bind_cpu == RT_CPUS_NR)
     {
@@ -291,6 +565,14 @@ static void _sched_insert_thread_locked(struct rt_thread *thread)
 #endif /* RT_THREAD_PRIORITY_MAX > 32 */
         rt_thread_ready_priority_group |= RT_SCHED_PRIV(thread).number_mask;
 
+#ifdef RT_USING_SCHED_EDF
+        /* EDF threads are ordered by their deadlines, ahead of the others on that level */
+        if (RT_SCHED_ON_EDF_LEVEL(thread))
+        {
+            rt_sched_edf_enqueue(&(rt_thread_priority_table[RT_SCHED_PRIV(thread).current_priority]), thread);
+        }
+        else
+#endif /* RT_USING_SCHED_EDF */
         /* there is no time slices left(YIELD), inserting thread before ready list*/
         if((RT_SCHED_CTX(thread).stat & RT_THREAD_STAT_YIELD_MASK) != 0)
         {
@@ -309,31 +591,7 @@ static void _sched_insert_thread_locked(struct rt_thread *thread)
     }
     else
     {
-        struct rt_cpu *pcpu = rt_cpu_index(bind_cpu);
-
-#if RT_THREAD_PRIORITY_MAX > 32
-        pcpu->ready_table[RT_SCHED_PRIV(thread).number] |= RT_SCHED_PRIV(thread).high_mask;
-#endif /* RT_THREAD_PRIORITY_MAX > 32 */
-        pcpu->priority_group |= RT_SCHED_PRIV(thread).number_mask;
-
-        /* there is no time slices left(YIELD), inserting thread before ready list*/
-        if((RT_SCHED_CTX(thread).stat & RT_THREAD_STAT_YIELD_MASK) != 0)
-        {
-            rt_list_insert_before(&(rt_cpu_index(bind_cpu)->priority_table[RT_SCHED_PRIV(thread).current_priority]),
-                                  &RT_THREAD_LIST_NODE(thread));
-        }
-        /* there are some time slices left, inserting thread after ready list to schedule it firstly at next time*/
-        else
-        {
-            rt_list_insert_after(&(rt_cpu_index(bind_cpu)->priority_table[RT_SCHED_PRIV(thread).current_priority]),
-                                 &RT_THREAD_LIST_NODE(thread));
-        }
-
-        if (cpu_id != bind_cpu)
-        {
-            cpu_mask = 1 << bind_cpu;
-            rt_hw_ipi_send(RT_SCHEDULE_IPI, cpu_mask);
-        }
+        _sched_enqueue_locked(thread, cpu_id, bind_cpu);
     }
 
     LOG_D("insert thread[%.*s], the priority: %d",
@@ -343,6 +601,8 @@ static void _sched_insert_thread_locked(struct rt_thread *thread)
 /* remove thread from ready queue */
 static void _sched_remove_thread_locked(struct rt_thread *thread)
 {
+    int queue_cpu;
+
     LOG_D("%s [%.*s], the priority: %d", __func__,
           RT_NAME_MAX, thread->parent.name,
           RT_SCHED_PRIV(thread).current_priority);
@@ -350,7 +610,17 @@ static void _sched_remove_thread_locked(struct rt_thread *thread)
     /* remove thread from ready list */
     rt_list_remove(&RT_THREAD_LIST_NODE(thread));
 
+#ifdef RT_SCHED_USING_PERCPU_RUNQUEUE
+    queue_cpu = SCHED_QUEUE_CPU(thread);
     if (RT_SCHED_CTX(thread).bind_cpu == RT_CPUS_NR)
+    {
+        rt_cpu_index(queue_cpu)->nr_ready--;
+    }
+#else
+    queue_cpu = RT_SCHED_CTX(thread).bind_cpu;
+#endif /* RT_SCHED_USING_PERCPU_RUNQUEUE */
+
+    if (queue_cpu == RT_CPUS_NR)
     {
         if (rt_list_isempty(&(rt_thread_priority_table[RT_SCHED_PRIV(thread).current_priority])))
         {
@@ -367,7 +637,7 @@ static void _sched_remove_thread_locked(struct rt_thread *thread)
     }
     else
     {
-        struct rt_cpu *pcpu = rt_cpu_index(RT_SCHED_CTX(thread).bind_cpu);
+        struct rt_cpu *pcpu = rt_cpu_index(queue_cpu);
 
         if (rt_list_isempty(&(pcpu->priority_table[RT_SCHED_PRIV(thread).current_priority])))
         {
@@ -414,6 +684,9 @@ void rt_system_scheduler_init(void)
         pcpu->current_priority = RT_THREAD_PRIORITY_MAX - 1;
         pcpu->current_thread = RT_NULL;
         pcpu->priority_group = 0;
+#ifdef RT_SCHED_USING_PERCPU_RUNQUEUE
+        pcpu->nr_ready = 0;
+#endif
 
 #if RT_THREAD_PRIORITY_MAX > 32
         rt_memset(pcpu->ready_table, 0, sizeof(pcpu->ready_table));
@@ -466,7 +739,10 @@ void rt_system_scheduler_start(void)
     _sched_remove_thread_locked(to_thread);
 
     /* dedigate current core to `to_thread` */
-    RT_SCHED_CTX(to_thread).oncpu = rt_hw_cpu_id();
+    _sched_set_oncpu(to_thread, rt_hw_cpu_id());
+#ifdef RT_SCHED_USING_PERCPU_RUNQUEUE
+    RT_SCHED_CTX(to_thread).home_cpu = rt_hw_cpu_id();
+#endif
     RT_SCHED_CTX(to_thread).stat = RT_THREAD_RUNNING;
 
     LOG_D("[cpu#%d] switch to priority#%d thread:%.*s(sp:0x%08x)",
@@ -565,6 +841,19 @@ static rt_thread_t _prepare_context_switch_locked(int cpu_id,
     rt_thread_t to_thread = RT_NULL;
     rt_ubase_t highest_ready_priority;
 
+#ifdef RT_SCHED_USING_PERCPU_RUNQUEUE
+    if (current_thread == pcpu->idle_thread ||
+        (RT_SCHED_CTX(current_thread).stat & RT_THREAD_STAT_MASK) != RT_THREAD_RUNNING)
+    {
+        /* the core is going to be idle, pull a waiting thread from the busiest core */
+        if (pcpu->nr_ready == 0)
+            _sched_pull_locked(cpu_id, 1);
+        /* or a thread waiting on another core which beats the local ones */
+        else
+            _sched_pull_prio_locked(cpu_id, _get_local_highest_ready_prio(pcpu));
+    }
+#endif /* RT_SCHED_USING_PERCPU_RUNQUEUE */
+
     /* quickly check if any other ready threads queuing */
     if (rt_thread_ready_priority_group != 0 || pcpu->priority_group != 0)
     {
@@ -588,7 +877,11 @@ static rt_thread_t _prepare_context_switch_locked(int cpu_id,
                 }
                 /* or no higher-priority thread existed and it has remaining ticks */
                 else if (RT_SCHED_PRIV(current_thread).current_priority == highest_ready_priority &&
-                         (RT_SCHED_CTX(current_thread).stat & RT_THREAD_STAT_YIELD_MASK) == 0)
+                         (RT_SCHED_CTX(current_thread).stat & RT_THREAD_STAT_YIELD_MASK) == 0
+#ifdef RT_USING_SCHED_EDF
+                         && !rt_sched_edf_preempt(current_thread, to_thread)
+#endif
+                        )
                 {
                     to_thread = current_thread;
                 }
@@ -616,18 +909,26 @@ static rt_thread_t _prepare_context_switch_locked(int cpu_id,
          * core for any observers if they properly do the synchronization
          * (take the SCHEDULER_LOCK).
          */
-        RT_SCHED_CTX(to_thread).oncpu = cpu_id;
+        _sched_set_oncpu(to_thread, cpu_id);
 
         /* check if context switch is required */
         if (to_thread != current_thread)
         {
             pcpu->current_priority = (rt_uint8_t)highest_ready_priority;
 
+#ifdef RT_USING_RCU
+            /* the readers never switch out, so this core has left them */
+            rt_atomic_add(&(pcpu->rcu_qs), 1);
+#endif /* RT_USING_RCU */
+
             RT_OBJECT_HOOK_CALL(rt_scheduler_hook, (current_thread, to_thread));
 
             /* remove to_thread from ready queue and update its status to RUNNING */
             _sched_remove_thread_locked(to_thread);
             RT_SCHED_CTX(to_thread).stat = RT_THREAD_RUNNING | (RT_SCHED_CTX(to_thread).stat & ~RT_THREAD_STAT_MASK);
+#ifdef RT_SCHED_USING_PERCPU_RUNQUEUE
+            RT_SCHED_CTX(to_thread).home_cpu = cpu_id;
+#endif
 
             RT_SCHEDULER_STACK_CHECK(to_thread);
 
@@ -1218,6 +1519,15 @@ rt_err_t rt_sched_thread_bind_cpu(struct rt_thread *thread, int cpu)
 
     rt_sched_lock(&slvl);
 
+#ifdef RT_USING_SCHED_EDF
+    /* the bandwidth of an EDF thread goes with it */
+    if (rt_sched_edf_bind_cpu(thread, cpu) != RT_EOK)
+    {
+        rt_sched_unlock(slvl);
+        return -RT_EFULL;
+    }
+#endif /* RT_USING_SCHED_EDF */
+
     thread_stat = rt_sched_thread_get_stat(thread);
 
     if (thread_stat == RT_THREAD_READY)
@@ -30,6 +30,7 @@
  * 2022-01-07     Gabriel      Moving __on_rt_xxxxx_hook to scheduler.c
  * 2023-03-27     rose_man     Split into scheduler upc and scheduler_mp.c
  * 2023-10-17     ChuShicheng  Modify the timing of clearing RT_THREAD_STAT_YIELD flag bits
+ * 2026-10-19     agent        order EDF threads by deadline
  */
 
 #include <rtthread.h>
@@ -225,7 +226,11 @@ void rt_schedule(void)
                 {
                     to_thread = rt_current_thread;
                 }
-                else if (RT_SCHED_PRIV(rt_current_thread).current_priority == highest_ready_priority && (RT_SCHED_CTX(rt_current_thread).stat & RT_THREAD_STAT_YIELD_MASK) == 0)
+                else if (RT_SCHED_PRIV(rt_current_thread).current_priority == highest_ready_priority && (RT_SCHED_CTX(rt_current_thread).stat & RT_THREAD_STAT_YIELD_MASK) == 0
+#ifdef RT_USING_SCHED_EDF
+                         && !rt_sched_edf_preempt(rt_current_thread, to_thread)
+#endif
+                        )
                 {
                     to_thread = rt_current_thread;
                 }
@@ -385,6 +390,14 @@ void rt_sched_insert_thread(struct rt_thread *thread)
 
     /* READY thread, insert to ready queue */
     RT_SCHED_CTX(thread).stat = RT_THREAD_READY | (RT_SCHED_CTX(thread).stat & ~RT_THREAD_STAT_MASK);
+#ifdef RT_USING_SCHED_EDF
+    /* EDF threads are ordered by their deadlines, ahead of the others on that level */
+    if (RT_SCHED_ON_EDF_LEVEL(thread))
+    {
+        rt_sched_edf_enqueue(&(rt_thread_priority_table[RT_SCHED_PRIV(thread).current_priority]), thread);
+    }
+    else
+#endif /* RT_USING_SCHED_EDF */
     /* there is no time slices left(YIELD), inserting thread before ready list*/
     if((RT_SCHED_CTX(thread).stat & RT_THREAD_STAT_YIELD_MASK) != 0)
     {
@@ -35,6 +35,7 @@
  * 2023-09-15     xqyjlj       perf rt_hw_interrupt_disable/enable
  * 2023-12-10     xqyjlj       fix thread_exit/detach/delete
  *                             fix rt_thread_delay
+ * 2026-10-19     agent        add deadline control and rt_thread_wait_next_period
  */
 
 #include <rthw.h>
@@ -747,6 +748,41 @@ rt_err_t rt_thread_mdelay(rt_int32_t ms)
 }
 RTM_EXPORT(rt_thread_mdelay);
 
+#ifdef RT_USING_SCHED_EDF
+/**
+ * @brief   This function will finish the current job of an EDF thread and let it
+ *          sleep until the release of the next job.
+ *
+ * @return  Return the operation status. If the return value is RT_EOK, the function is successfully executed.
+ *          If the return value is -RT_EINVAL, the current thread is not an EDF thread.
+ */
+rt_err_t rt_thread_wait_next_period(void)
+{
+    struct rt_thread *thread;
+    rt_sched_lock_level_t slvl;
+    rt_tick_t release, period;
+    rt_err_t error;
+
+    thread = rt_thread_self();
+    RT_ASSERT(thread != RT_NULL);
+
+    rt_sched_lock(&slvl);
+    error = rt_sched_thread_next_period(thread, &release);
+    period = RT_SCHED_PRIV(thread).edf.period;
+    rt_sched_unlock(slvl);
+
+    if (error != RT_EOK)
+    {
+        return error;
+    }
+
+    /* sleep only if the next job is not released yet */
+    release -= period;
+    return rt_thread_delay_until(&release, period);
+}
+RTM_EXPORT(rt_thread_wait_next_period);
+#endif /* RT_USING_SCHED_EDF */
+
 #ifdef RT_USING_SMP
 #endif
 
@@ -765,6 +801,10 @@ RTM_EXPORT(rt_thread_mdelay);
  *
  *              RT_THREAD_CTRL_BIND_CPU for bind the thread to a CPU.
  *
+ *              RT_THREAD_CTRL_SET_DEADLINE for setting the EDF parameters of thread.
+ *
+ *              RT_THREAD_CTRL_GET_DEADLINE for getting the EDF parameters and deadline misses.
+ *
  * @param   arg is the argument of control command.
  *
  * @return  Return the operation status. If the return value is RT_EOK, the function is successfully executed.
@@ -819,6 +859,26 @@ rt_err_t rt_thread_control(rt_thread_t thread, int cmd, void *arg)
             return rt_sched_thread_bind_cpu(thread, cpu);
         }
 
+#ifdef RT_USING_SCHED_EDF
+        case RT_THREAD_CTRL_SET_DEADLINE:
+        case RT_THREAD_CTRL_GET_DEADLINE:
+        {
+            rt_err_t error;
+            rt_sched_lock_level_t slvl;
+
+            RT_ASSERT(arg != RT_NULL);
+
+            rt_sched_lock(&slvl);
+            if (cmd == RT_THREAD_CTRL_SET_DEADLINE)
+                error = rt_sched_thread_set_deadline(thread, (struct rt_thread_deadline_attr *)arg);
+            else
+                error = rt_sched_thread_get_deadline(thread, (struct rt_thread_deadline_attr *)arg);
+            rt_sched_unlock(slvl);
+
+            return error;
+        }
+#endif /* RT_USING_SCHED_EDF */
+
     default:
         break;
     }